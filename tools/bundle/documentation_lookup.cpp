@@ -0,0 +1,108 @@
+//
+//  documentation_lookup.cpp
+//  swiftUIManual tools
+//
+
+#include "bundle/documentation_lookup.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+
+#include "common/md5.h"
+
+namespace manual {
+
+namespace {
+
+constexpr const char* kIndexDatabase = "index";
+constexpr const char* kInformationDatabase = "information";
+
+LmdbDatabase openDatabase(const LmdbTransaction& transaction, const char* name) {
+    LmdbDatabase database;
+    if (!transaction.open(name, database)) throw std::runtime_error(std::string("data.mdb has no database ") + name);
+    return database;
+}
+
+} // namespace
+
+DocumentationLookup::DocumentationLookup(const std::string& indexDirectory, std::string_view language)
+    : environment_(indexDirectory + "/data.mdb"),
+      navigatorFile_(indexDirectory + "/navigator.index"),
+      navigator_(navigatorFile_.bytes()),
+      language_(language) {
+    languagePrefix_ = language_;
+    std::transform(languagePrefix_.begin(), languagePrefix_.end(), languagePrefix_.begin(),
+                   [](unsigned char c) { return char(std::tolower(c)); });
+
+    LmdbTransaction transaction = environment_.begin();
+    LmdbDatabase information = openDatabase(transaction, kInformationDatabase);
+    std::string_view value;
+    if (transaction.get(information, "bundleIdentifier", value)) bundleIdentifier_ = value;
+    // DocC `PathHasher`는 MD5(앞 6바이트)와 FNV-1 두 가지다.
+    if (transaction.get(information, "pathHasher", value) && value != "MD5") {
+        if (value != "FNV-1") throw std::runtime_error("data.mdb uses an unknown path hasher");
+        md5Paths_ = false;
+    }
+}
+
+std::string DocumentationLookup::stableHash(std::string_view text) {
+    std::uint32_t hash = 2166136261u;
+    for (unsigned char c : text) {
+        hash *= 16777619u;
+        hash ^= c;
+    }
+    static const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    char buffer[8];
+    std::size_t at = sizeof buffer;
+    do {
+        buffer[--at] = digits[hash % 36];
+        hash /= 36;
+    } while (hash != 0);
+    return std::string(buffer + at, sizeof buffer - at);
+}
+
+std::string DocumentationLookup::hashPath(std::string_view path) const {
+    std::string key = languagePrefix_;
+    key += path;
+    return md5Paths_ ? md5Hex(key, 6) : stableHash(key);
+}
+
+std::uint32_t DocumentationLookup::nodeForKey(std::string_view key) const {
+    LmdbTransaction transaction = environment_.begin();
+    std::string_view value;
+    if (!transaction.get(openDatabase(transaction, kIndexDatabase), key, value) || value.size() != 4) return kNoNode;
+    std::uint32_t node;
+    std::memcpy(&node, value.data(), sizeof node);
+    return node;
+}
+
+std::uint32_t DocumentationLookup::nodeForUsr(std::string_view usr) const {
+    std::string key = language_;
+    key += '-';
+    key += stableHash(usr);
+    return nodeForKey(key);
+}
+
+std::uint32_t DocumentationLookup::nodeForPath(std::string_view path) const { return nodeForKey(hashPath(path)); }
+
+std::string_view DocumentationLookup::pathOf(std::uint32_t node) const {
+    if (node == kNoNode) return {};
+    LmdbTransaction transaction = environment_.begin();
+    std::string_view value;
+    if (!transaction.get(openDatabase(transaction, kIndexDatabase), std::string_view(reinterpret_cast<const char*>(&node), sizeof node),
+                         value)) {
+        return {};
+    }
+    // 값은 `swift/documentation/...`처럼 언어 접두어가 붙은 경로다.
+    if (value.substr(0, languagePrefix_.size()) == languagePrefix_) value.remove_prefix(languagePrefix_.size());
+    return value;
+}
+
+std::string_view DocumentationLookup::titleOf(std::uint32_t node) const {
+    if (node == kNoNode || node >= navigator_.size()) return {};
+    return navigator_[node].title;
+}
+
+} // namespace manual
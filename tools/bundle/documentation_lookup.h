@@ -0,0 +1,60 @@
+//
+//  documentation_lookup.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "bundle/lmdb.h"
+#include "bundle/navigator_index.h"
+#include "common/mapped_file.h"
+
+namespace manual {
+
+/// `docs/index`의 `data.mdb`로 USR과 경로, 노드 번호를 오가고 `navigator.index`에서 제목을 읽는다.
+///
+/// 노드 번호는 두 파일이 같이 쓴다. 조회마다 읽기 트랜잭션을 새로 시작하지만 메타 페이지 두 장을 보는 것뿐이라
+/// 잠금이 없고, 돌려주는 문자열은 모두 매핑한 파일을 가리킨다.
+class DocumentationLookup {
+public:
+    /// `indexDirectory`(`docs/index`)를 연다. 파일이 없거나 형식이 다르면 예외를 던진다.
+    explicit DocumentationLookup(const std::string& indexDirectory, std::string_view language = "Swift");
+
+    const LmdbEnvironment& environment() const { return environment_; }
+    const NavigatorIndex& navigator() const { return navigator_; }
+    std::string_view bundleIdentifier() const { return bundleIdentifier_; }
+
+    /// `s:7SwiftUI4EdgeO` 같은 USR의 노드. 없으면 `kNoNode`.
+    std::uint32_t nodeForUsr(std::string_view usr) const;
+    /// `/documentation/swiftuimanual/contentview` 같은 경로의 노드. 없으면 `kNoNode`.
+    std::uint32_t nodeForPath(std::string_view path) const;
+
+    /// 노드의 경로. 없으면 빈 문자열.
+    std::string_view pathOf(std::uint32_t node) const;
+    /// 노드의 제목. 없으면 빈 문자열.
+    std::string_view titleOf(std::uint32_t node) const;
+
+    std::string_view pathForUsr(std::string_view usr) const { return pathOf(nodeForUsr(usr)); }
+    std::string_view titleForPath(std::string_view path) const { return titleOf(nodeForPath(path)); }
+
+    /// DocC `String.stableHashString`: 32비트 FNV-1을 36진수로 쓴 것.
+    static std::string stableHash(std::string_view text);
+
+private:
+    std::uint32_t nodeForKey(std::string_view key) const;
+    std::string hashPath(std::string_view path) const;
+
+    LmdbEnvironment environment_;
+    MappedFile navigatorFile_;
+    NavigatorIndex navigator_;
+    std::string language_;         // USR 키 앞부분(`Swift`)
+    std::string languagePrefix_;   // 경로 키 앞부분(`swift`)
+    std::string bundleIdentifier_;
+    bool md5Paths_ = true;
+};
+
+} // namespace manual
@@ -0,0 +1,549 @@
+//
+//  html_prerender.cpp
+//  swiftUIManual tools
+//
+
+#include "bundle/html_prerender.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "common/mapped_file.h"
+#include "common/thread_pool.h"
+
+namespace fs = std::filesystem;
+
+namespace manual {
+
+namespace {
+
+constexpr std::size_t kPagesPerTask = 16;
+constexpr std::string_view kAppOpen = "<div id=\"app\">";
+constexpr std::string_view kBeginMark = "<!--prerender-->";
+constexpr std::string_view kEndMark = "<!--/prerender-->";
+// Vue 앱이 올라오기 전까지만 보이므로 DocC 스타일을 흉내 내지 않고 읽을 만한 정도로만 꾸민다.
+constexpr std::string_view kStyle =
+    "<style>.prerendered{max-width:980px;margin:40px auto;padding:0 22px;font-family:\"SF Pro Text\","
+    "\"Helvetica Neue\",Helvetica,Arial,sans-serif;line-height:1.5}.prerendered pre{overflow-x:auto;"
+    "padding:12px;border-radius:8px;background:var(--color-code-background,#f5f5f7)}"
+    ".prerendered .eyebrow{color:#6e6e73;margin:0}.prerendered ul.availability{display:flex;gap:1em;"
+    "list-style:none;padding:0;color:#6e6e73}</style>";
+
+const JsonValue* member(const JsonValue* value, std::string_view key) {
+    return value != nullptr ? value->get(key) : nullptr;
+}
+
+std::string_view stringMember(const JsonValue& value, std::string_view key) {
+    const JsonValue* found = value.get(key);
+    return found != nullptr && found->isString() ? found->text : std::string_view();
+}
+
+bool isArray(const JsonValue* value) { return value != nullptr && value->isArray(); }
+
+/// `javascript:` 같은 주소를 링크로 만들지 않도록, 스킴이 없거나 http·https·mailto인 주소만 받는다.
+/// 첫 `/`·`?`·`#`보다 `:`가 앞서면 그 앞이 스킴이다. 공백이나 제어 문자가 섞인 스킴은 목록에 없으므로 걸러진다.
+bool isSafeHref(std::string_view url) {
+    std::size_t colon = url.find_first_of(":/?#");
+    if (colon == std::string_view::npos || url[colon] != ':') return true;
+    std::string_view scheme = url.substr(0, colon);
+    std::string lower(scheme.size(), '\0');
+    std::transform(scheme.begin(), scheme.end(), lower.begin(),
+                   [](unsigned char c) { return char(std::tolower(c)); });
+    return lower == "http" || lower == "https" || lower == "mailto";
+}
+
+/// 껍데기에서 `var baseUrl = "/swiftui/"`의 값.
+std::string_view shellBaseUrl(std::string_view shell) {
+    constexpr std::string_view kPrefix = "var baseUrl = \"";
+    std::size_t begin = shell.find(kPrefix);
+    if (begin == std::string_view::npos) return "/";
+    begin += kPrefix.size();
+    std::size_t end = shell.find('"', begin);
+    return end == std::string_view::npos ? "/" : shell.substr(begin, end - begin);
+}
+
+/// 앞서 넣은 본문을 빼고, `<title>`과 `#app` 안을 이 페이지 것으로 채운다.
+void fillShell(std::string& shell, std::string_view title, std::string_view body) {
+    std::size_t begin = shell.find(kBeginMark);
+    if (begin != std::string::npos) {
+        std::size_t end = shell.find(kEndMark, begin);
+        if (end != std::string::npos) shell.erase(begin, end + kEndMark.size() - begin);
+    }
+    if (!title.empty()) {
+        std::size_t open = shell.find("<title>");
+        std::size_t close = open == std::string::npos ? open : shell.find("</title>", open);
+        if (close != std::string::npos) {
+            std::string text;
+            appendHtmlEscaped(text, title);
+            text += " | Documentation";
+            shell.replace(open + 7, close - open - 7, text);
+        }
+    }
+    std::size_t app = shell.find(kAppOpen);
+    if (app == std::string::npos) throw std::runtime_error("no <div id=\"app\"> in shell");
+    std::string block;
+    block.reserve(body.size() + kBeginMark.size() + kEndMark.size() + kStyle.size());
+    block += kBeginMark;
+    block += kStyle;
+    block += body;
+    block += kEndMark;
+    shell.insert(app + kAppOpen.size(), block);
+}
+
+} // namespace
+
+void appendHtmlEscaped(std::string& out, std::string_view text) {
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        std::string_view entity;
+        switch (text[i]) {
+        case '<': entity = "&lt;"; break;
+        case '>': entity = "&gt;"; break;
+        case '&': entity = "&amp;"; break;
+        case '"': entity = "&quot;"; break;
+        default: continue;
+        }
+        out.append(text.data() + start, i - start);
+        out += entity;
+        start = i + 1;
+    }
+    out.append(text.data() + start, text.size() - start);
+}
+
+void appendHighlightedSwift(std::string& out, std::string_view code, std::vector<HighlightSpan>& spans) {
+    highlightSwift(code, spans);
+    std::size_t written = 0;
+    for (const HighlightSpan& span : spans) {
+        appendHtmlEscaped(out, code.substr(written, span.begin - written));
+        out += "<span class=\"";
+        out += highlightClassName(span.kind);
+        out += "\">";
+        appendHtmlEscaped(out, code.substr(span.begin, span.end - span.begin));
+        out += "</span>";
+        written = span.end;
+    }
+    appendHtmlEscaped(out, code.substr(written));
+}
+
+// MARK: - 페이지
+
+HtmlPageRenderer::HtmlPageRenderer(std::string_view baseUrl) : baseUrl_(baseUrl) {
+    while (!baseUrl_.empty() && baseUrl_.back() == '/') baseUrl_.pop_back();
+}
+
+std::string_view HtmlPageRenderer::title(const JsonValue& root) {
+    const JsonValue* metadata = root.get("metadata");
+    return metadata != nullptr ? stringMember(*metadata, "title") : std::string_view();
+}
+
+void HtmlPageRenderer::render(const JsonValue& root, std::string& out) {
+    out_ = &out;
+    references_ = root.get("references");
+    const JsonValue* metadata = root.get("metadata");
+
+    out += "<main class=\"prerendered\"><article>";
+    if (metadata != nullptr) {
+        if (std::string_view role = stringMember(*metadata, "roleHeading"); !role.empty()) {
+            out += "<p class=\"eyebrow\">";
+            appendHtmlEscaped(out, role);
+            out += "</p>";
+        }
+        out += "<h1>";
+        appendHtmlEscaped(out, stringMember(*metadata, "title"));
+        out += "</h1>";
+    }
+    if (const JsonValue* abstract = root.get("abstract"); isArray(abstract)) {
+        out += "<div class=\"abstract\"><p>";
+        renderInline(*abstract);
+        out += "</p></div>";
+    }
+    if (const JsonValue* platforms = member(metadata, "platforms"); isArray(platforms)) {
+        out += "<ul class=\"availability\">";
+        for (const auto& platform : platforms->elements) {
+            out += "<li>";
+            appendHtmlEscaped(out, stringMember(platform, "name"));
+            if (std::string_view introduced = stringMember(platform, "introducedAt"); !introduced.empty()) {
+                out += ' ';
+                appendHtmlEscaped(out, introduced);
+                out += '+';
+            }
+            const JsonValue* beta = platform.get("beta");
+            if (beta != nullptr && beta->boolean) out += " Beta";
+            out += "</li>";
+        }
+        out += "</ul>";
+    }
+    if (const JsonValue* summary = root.get("deprecationSummary"); isArray(summary)) {
+        out += "<div class=\"deprecated\"><p><strong>Deprecated</strong></p>";
+        renderBlocks(*summary);
+        out += "</div>";
+    }
+    if (const JsonValue* sections = root.get("primaryContentSections"); isArray(sections)) {
+        for (const auto& section : sections->elements) {
+            std::string_view kind = stringMember(section, "kind");
+            if (kind == "declarations") {
+                renderDeclarations(section);
+            } else if (kind == "content") {
+                if (const JsonValue* content = section.get("content"); isArray(content)) {
+                    out += "<section class=\"content\">";
+                    renderBlocks(*content);
+                    out += "</section>";
+                }
+            } else if (kind == "parameters") {
+                const JsonValue* parameters = section.get("parameters");
+                if (!isArray(parameters)) continue;
+                out += "<section class=\"parameters\"><h2>Parameters</h2><dl>";
+                for (const auto& parameter : parameters->elements) {
+                    out += "<dt><code>";
+                    appendHtmlEscaped(out, stringMember(parameter, "name"));
+                    out += "</code></dt><dd>";
+                    if (const JsonValue* content = parameter.get("content"); isArray(content)) renderBlocks(*content);
+                    out += "</dd>";
+                }
+                out += "</dl></section>";
+            }
+        }
+    }
+    if (const JsonValue* topics = root.get("topicSections"); isArray(topics)) renderTopics(*topics, "Topics");
+    if (const JsonValue* relationships = root.get("relationshipsSections"); isArray(relationships)) {
+        renderTopics(*relationships, "Relationships");
+    }
+    if (const JsonValue* seeAlso = root.get("seeAlsoSections"); isArray(seeAlso)) renderTopics(*seeAlso, "See Also");
+    out += "</article></main>";
+    out_ = nullptr;
+    references_ = nullptr;
+}
+
+void HtmlPageRenderer::renderDeclarations(const JsonValue& section) {
+    const JsonValue* declarations = section.get("declarations");
+    if (!isArray(declarations)) return;
+    std::string& out = *out_;
+    out += "<section class=\"declaration\"><h2>Declaration</h2>";
+    for (const auto& declaration : declarations->elements) {
+        const JsonValue* tokens = declaration.get("tokens");
+        if (!isArray(tokens)) continue;
+        out += "<pre class=\"source\"><code>";
+        for (const auto& token : tokens->elements) {
+            std::string_view kind = stringMember(token, "kind");
+            std::string_view text = stringMember(token, "text");
+            if (kind == "text") {
+                appendHtmlEscaped(out, text);
+                continue;
+            }
+            const JsonValue* target = nullptr;
+            if (std::string_view identifier = stringMember(token, "identifier"); !identifier.empty()) {
+                target = reference(identifier);
+            }
+            std::string_view url = target != nullptr ? stringMember(*target, "url") : std::string_view();
+            if (!url.empty()) {
+                out += "<a href=\"";
+                appendHref(url);
+                out += "\">";
+            }
+            // 종류는 클래스 이름으로만 쓰므로 영숫자와 `-` 말고는 버려 속성 밖으로 나가지 못하게 한다.
+            out += "<span class=\"token-";
+            for (char c : kind) {
+                if (std::isalnum(static_cast<unsigned char>(c)) || c == '-') out += c;
+            }
+            out += "\">";
+            appendHtmlEscaped(out, text);
+            out += "</span>";
+            if (!url.empty()) out += "</a>";
+        }
+        out += "</code></pre>";
+    }
+    out += "</section>";
+}
+
+void HtmlPageRenderer::renderBlocks(const JsonValue& blocks) {
+    for (const auto& block : blocks.elements) renderBlock(block);
+}
+
+void HtmlPageRenderer::renderBlock(const JsonValue& block) {
+    std::string& out = *out_;
+    std::string_view type = stringMember(block, "type");
+    if (type == "paragraph") {
+        out += "<p>";
+        if (const JsonValue* content = block.get("inlineContent"); isArray(content)) renderInline(*content);
+        out += "</p>";
+    } else if (type == "heading") {
+        const JsonValue* level = block.get("level");
+        char digit = level != nullptr && level->text.size() == 1 && level->text[0] >= '1' && level->text[0] <= '6'
+                         ? level->text[0]
+                         : '2';
+        out += "<h";
+        out += digit;
+        if (std::string_view anchor = stringMember(block, "anchor"); !anchor.empty()) {
+            out += " id=\"";
+            appendHtmlEscaped(out, anchor);
+            out += '"';
+        }
+        out += '>';
+        appendHtmlEscaped(out, stringMember(block, "text"));
+        out += "</h";
+        out += digit;
+        out += '>';
+    } else if (type == "codeListing") {
+        const JsonValue* code = block.get("code");
+        if (!isArray(code)) return;
+        std::string source;
+        for (const auto& line : code->elements) {
+            if (!source.empty()) source += '\n';
+            source += line.text;
+        }
+        std::string_view syntax = stringMember(block, "syntax");
+        out += "<pre class=\"code-listing\"><code class=\"hljs";
+        if (!syntax.empty()) {
+            out += " language-";
+            appendHtmlEscaped(out, syntax);
+        }
+        out += "\">";
+        if (syntax == "swift") {
+            appendHighlightedSwift(out, source, spans_);
+        } else {
+            appendHtmlEscaped(out, source);
+        }
+        out += "</code></pre>";
+    } else if (type == "unorderedList" || type == "orderedList") {
+        const JsonValue* items = block.get("items");
+        if (!isArray(items)) return;
+        out += type == "orderedList" ? "<ol>" : "<ul>";
+        for (const auto& item : items->elements) {
+            out += "<li>";
+            if (const JsonValue* content = item.get("content"); isArray(content)) renderBlocks(*content);
+            out += "</li>";
+        }
+        out += type == "orderedList" ? "</ol>" : "</ul>";
+    } else if (type == "aside") {
+        std::string_view style = stringMember(block, "style");
+        std::string_view name = stringMember(block, "name");
+        out += "<aside class=\"";
+        appendHtmlEscaped(out, style);
+        out += "\"><p><strong>";
+        appendHtmlEscaped(out, name.empty() ? style : name);
+        out += "</strong></p>";
+        if (const JsonValue* content = block.get("content"); isArray(content)) renderBlocks(*content);
+        out += "</aside>";
+    } else if (type == "table") {
+        const JsonValue* rows = block.get("rows");
+        if (!isArray(rows)) return;
+        bool headerRow = stringMember(block, "header") == "row";
+        out += "<table>";
+        for (std::size_t row = 0; row < rows->elements.size(); ++row) {
+            const JsonValue& cells = rows->elements[row];
+            if (!cells.isArray()) continue;
+            std::string_view cell = headerRow && row == 0 ? "th" : "td";
+            out += "<tr>";
+            for (const auto& content : cells.elements) {
+                out += '<';
+                out += cell;
+                out += '>';
+                if (content.isArray()) renderBlocks(content);
+                out += "</";
+                out += cell;
+                out += '>';
+            }
+            out += "</tr>";
+        }
+        out += "</table>";
+    } else if (type == "termList") {
+        const JsonValue* items = block.get("items");
+        if (!isArray(items)) return;
+        out += "<dl>";
+        for (const auto& item : items->elements) {
+            out += "<dt>";
+            if (const JsonValue* term = member(item.get("term"), "inlineContent"); isArray(term)) renderInline(*term);
+            out += "</dt><dd>";
+            if (const JsonValue* content = member(item.get("definition"), "content"); isArray(content)) {
+                renderBlocks(*content);
+            }
+            out += "</dd>";
+        }
+        out += "</dl>";
+    }
+}
+
+void HtmlPageRenderer::renderInline(const JsonValue& content) {
+    std::string& out = *out_;
+    for (const auto& item : content.elements) {
+        std::string_view type = stringMember(item, "type");
+        if (type == "text") {
+            appendHtmlEscaped(out, stringMember(item, "text"));
+        } else if (type == "codeVoice") {
+            out += "<code>";
+            appendHtmlEscaped(out, stringMember(item, "code"));
+            out += "</code>";
+        } else if (type == "reference") {
+            std::string_view identifier = stringMember(item, "identifier");
+            const JsonValue* target = reference(identifier);
+            std::string_view title = stringMember(item, "overridingTitle");
+            if (title.empty() && target != nullptr) title = stringMember(*target, "title");
+            if (title.empty()) title = identifier;
+            std::string_view url = target != nullptr ? stringMember(*target, "url") : std::string_view();
+            bool symbol = target != nullptr && stringMember(*target, "kind") == "symbol";
+            if (!url.empty()) {
+                out += "<a href=\"";
+                appendHref(url);
+                out += "\">";
+            }
+            if (symbol) out += "<code>";
+            appendHtmlEscaped(out, title);
+            if (symbol) out += "</code>";
+            if (!url.empty()) out += "</a>";
+        } else if (type == "link") {
+            std::string_view destination = stringMember(item, "destination");
+            std::string_view title = stringMember(item, "title");
+            bool safe = isSafeHref(destination);
+            if (safe) {
+                out += "<a href=\"";
+                appendHtmlEscaped(out, destination);
+                out += "\">";
+            }
+            appendHtmlEscaped(out, title.empty() ? destination : title);
+            if (safe) out += "</a>";
+        } else {
+            std::string_view tag;
+            if (type == "emphasis") tag = "em";
+            else if (type == "strong" || type == "inlineHead") tag = "strong";
+            else if (type == "newTerm") tag = "dfn";
+            else if (type == "subscript") tag = "sub";
+            else if (type == "superscript") tag = "sup";
+            else if (type == "strikethrough") tag = "s";
+            const JsonValue* inner = item.get("inlineContent");
+            if (tag.empty() || !isArray(inner)) continue;
+            out += '<';
+            out += tag;
+            out += '>';
+            renderInline(*inner);
+            out += "</";
+            out += tag;
+            out += '>';
+        }
+    }
+}
+
+void HtmlPageRenderer::renderTopics(const JsonValue& sections, std::string_view heading) {
+    if (sections.elements.size() == 0) return;
+    std::string& out = *out_;
+    out += "<section class=\"topics\"><h2>";
+    out += heading;
+    out += "</h2>";
+    for (const auto& section : sections.elements) {
+        if (std::string_view title = stringMember(section, "title"); !title.empty()) {
+            out += "<h3>";
+            appendHtmlEscaped(out, title);
+            out += "</h3>";
+        }
+        const JsonValue* identifiers = section.get("identifiers");
+        if (!isArray(identifiers)) continue;
+        out += "<ul>";
+        for (const auto& identifier : identifiers->elements) {
+            out += "<li>";
+            renderLink(identifier.text, true);
+            out += "</li>";
+        }
+        out += "</ul>";
+    }
+    out += "</section>";
+}
+
+void HtmlPageRenderer::renderLink(std::string_view identifier, bool withAbstract) {
+    std::string& out = *out_;
+    const JsonValue* target = reference(identifier);
+    if (target == nullptr) {
+        out += "<code>";
+        appendHtmlEscaped(out, identifier);
+        out += "</code>";
+        return;
+    }
+    std::string_view url = stringMember(*target, "url");
+    if (!url.empty()) {
+        out += "<a href=\"";
+        appendHref(url);
+        out += "\">";
+    }
+    out += "<code>";
+    // 심벌은 `func padding(…)`처럼 조각으로, 나머지는 제목으로 쓴다.
+    const JsonValue* fragments = target->get("fragments");
+    if (isArray(fragments) && fragments->elements.size() > 0) {
+        for (const auto& fragment : fragments->elements) appendHtmlEscaped(out, stringMember(fragment, "text"));
+    } else {
+        appendHtmlEscaped(out, stringMember(*target, "title"));
+    }
+    out += "</code>";
+    if (!url.empty()) out += "</a>";
+    const JsonValue* abstract = target->get("abstract");
+    if (withAbstract && isArray(abstract) && abstract->elements.size() > 0) {
+        out += "<p>";
+        renderInline(*abstract);
+        out += "</p>";
+    }
+}
+
+void HtmlPageRenderer::appendHref(std::string_view url) {
+    if (!url.empty() && url[0] == '/') appendHtmlEscaped(*out_, baseUrl_);
+    appendHtmlEscaped(*out_, url);
+}
+
+const JsonValue* HtmlPageRenderer::reference(std::string_view identifier) const {
+    return identifier.empty() ? nullptr : member(references_, identifier);
+}
+
+// MARK: - 사이트
+
+PrerenderStats prerenderSite(const std::string& docsDirectory, const std::string& outDirectory, ThreadPool& pool) {
+    fs::path data = fs::path(docsDirectory) / "data";
+    std::vector<std::string> pages;   // `documentation/x/y`
+    std::string prefix = data.generic_string();
+    for (const auto& entry : fs::recursive_directory_iterator(data / "documentation")) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json") continue;
+        std::string path = entry.path().generic_string();
+        std::size_t skip = prefix.size();
+        while (skip < path.size() && path[skip] == '/') ++skip;
+        pages.push_back(path.substr(skip, path.size() - skip - 5));
+    }
+    std::sort(pages.begin(), pages.end());
+
+    std::atomic<std::size_t> written{0};
+    std::atomic<std::size_t> missing{0};
+    std::atomic<std::uint64_t> bytes{0};
+    pool.parallelFor((pages.size() + kPagesPerTask - 1) / kPagesPerTask, [&](std::size_t task) {
+        Arena arena(1 << 16);
+        std::string shell;
+        std::string body;
+        std::size_t end = std::min(pages.size(), (task + 1) * kPagesPerTask);
+        for (std::size_t i = task * kPagesPerTask; i < end; ++i) {
+            fs::path shellPath = fs::path(docsDirectory) / pages[i] / "index.html";
+            std::error_code error;
+            if (!fs::is_regular_file(shellPath, error)) {
+                ++missing;
+                continue;
+            }
+            // 제자리에 쓸 수도 있으니 껍데기는 복사해 두고 매핑을 닫는다.
+            shell.assign(MappedFile(shellPath.string()).bytes());
+            MappedFile json((data / (pages[i] + ".json")).string());
+            JsonValue root = parseJson(json.bytes(), arena);
+
+            body.clear();
+            HtmlPageRenderer(shellBaseUrl(shell)).render(root, body);
+            fillShell(shell, HtmlPageRenderer::title(root), body);
+
+            fs::path target = fs::path(outDirectory) / pages[i] / "index.html";
+            fs::create_directories(target.parent_path());
+            std::ofstream out(target, std::ios::binary | std::ios::trunc);
+            out.write(shell.data(), std::streamsize(shell.size()));
+            if (!out) throw std::runtime_error("cannot write " + target.string());
+            ++written;
+            bytes += shell.size();
+            arena.release();
+        }
+    });
+    return {written.load(), missing.load(), bytes.load()};
+}
+
+} // namespace manual
@@ -0,0 +1,71 @@
+//
+//  html_prerender.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/json.h"
+#include "interface/highlighter.h"
+
+namespace manual {
+
+class ThreadPool;
+
+/// `<`, `>`, `&`, `"`를 엔티티로 바꿔 `out` 뒤에 붙인다.
+void appendHtmlEscaped(std::string& out, std::string_view text);
+
+/// Swift 코드 조각을 highlight.js(`highlight-js-custom-swift`)와 같은 `hljs-*` 클래스의 `<span>`으로 감싸 붙인다.
+/// `spans`는 구간을 담을 작업 버퍼로, 재사용하면 할당이 없다.
+void appendHighlightedSwift(std::string& out, std::string_view code, std::vector<HighlightSpan>& spans);
+
+/// 렌더 JSON 한 페이지를 정적 HTML 조각으로 쓴다.
+///
+/// 제목과 역할, 요약, 폐기 안내, 가용성, 선언부(토큰 종류별 `token-*` 클래스), 본문 블록(문단, 제목, 목록,
+/// 코드 목록, 참고, 표), 토픽·관계·함께 보기 구역을 쓴다. 링크는 페이지의 `references`로 풀고,
+/// `baseUrl`(`/swiftui/`)을 앞에 붙인다. 외부 `link`는 http·https·mailto와 상대 주소만 링크로 쓰고
+/// 나머지는 글자로 쓴다. 모르는 블록과 인라인 값은 건너뛴다.
+class HtmlPageRenderer {
+public:
+    explicit HtmlPageRenderer(std::string_view baseUrl);
+
+    /// `root`의 본문을 `out` 뒤에 붙인다.
+    void render(const JsonValue& root, std::string& out);
+    /// `metadata.title`. 없으면 빈 문자열.
+    static std::string_view title(const JsonValue& root);
+
+private:
+    void renderDeclarations(const JsonValue& section);
+    void renderBlocks(const JsonValue& blocks);
+    void renderBlock(const JsonValue& block);
+    void renderInline(const JsonValue& content);
+    void renderTopics(const JsonValue& sections, std::string_view heading);
+    void renderLink(std::string_view identifier, bool withAbstract);
+    void appendHref(std::string_view url);
+    const JsonValue* reference(std::string_view identifier) const;
+
+    std::string baseUrl_;   // 끝의 `/`를 뗀 것
+    std::string* out_ = nullptr;
+    const JsonValue* references_ = nullptr;
+    std::vector<HighlightSpan> spans_;
+};
+
+struct PrerenderStats {
+    std::size_t pages = 0;
+    std::size_t missingShells = 0;   // `documentation/…/index.html`이 없어 건너뛴 페이지
+    std::uint64_t bytes = 0;          // 쓴 HTML
+};
+
+/// `docsDirectory/data/documentation` 아래 모든 페이지를 미리 렌더링해 `outDirectory`의 같은 경로 `index.html`에 쓴다.
+///
+/// 페이지마다 원래 껍데기(`docsDirectory/documentation/…/index.html`)의 `<div id="app">` 안에 본문을 넣고
+/// `<title>`을 페이지 제목으로 바꾼다. Vue 앱이 올라오면 `#app`을 통째로 바꾸므로 JS가 도는 화면은 그대로다.
+/// 넣은 본문은 주석 표시로 감싸므로 `outDirectory`가 `docsDirectory`여도 다시 돌리면 앞의 결과를 바꿔 쓴다.
+PrerenderStats prerenderSite(const std::string& docsDirectory, const std::string& outDirectory, ThreadPool& pool);
+
+} // namespace manual
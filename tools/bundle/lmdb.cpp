@@ -0,0 +1,201 @@
+//
+//  lmdb.cpp
+//  swiftUIManual tools
+//
+
+#include "bundle/lmdb.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace manual {
+
+namespace {
+
+// lmdb/mdb.c의 64비트 배치를 따른다.
+constexpr std::size_t kPageHeader = 16;
+constexpr std::size_t kNodeHeader = 8;
+constexpr std::uint32_t kMagic = 0xBEEFC0DE;
+constexpr std::uint32_t kVersion = 1;
+
+constexpr std::uint16_t kPageBranch = 0x01;
+constexpr std::uint16_t kPageLeaf = 0x02;
+constexpr std::uint16_t kPageOverflow = 0x04;
+constexpr std::uint16_t kPageMeta = 0x08;
+
+constexpr std::uint16_t kNodeBigData = 0x01;
+constexpr std::uint16_t kNodeSubData = 0x02;
+constexpr std::uint16_t kNodeDupData = 0x04;
+
+constexpr std::uint16_t kReverseKey = 0x02;
+constexpr std::uint16_t kDupSort = 0x04;
+constexpr std::uint16_t kIntegerKey = 0x08;
+
+constexpr std::size_t kMetaOffset = kPageHeader;
+constexpr std::size_t kFreeDatabase = kMetaOffset + 24;
+constexpr std::size_t kMainDatabase = kFreeDatabase + 48;
+constexpr std::size_t kTxnId = kMainDatabase + 48 + 8;
+
+template <class T>
+T load(const char* at) {
+    T value;
+    std::memcpy(&value, at, sizeof value);
+    return value;
+}
+
+[[noreturn]] void malformed(const char* what) { throw std::runtime_error(std::string("malformed data.mdb: ") + what); }
+
+LmdbDatabase loadDatabase(const char* at) {
+    LmdbDatabase database;
+    database.flags = load<std::uint16_t>(at + 4);
+    database.depth = load<std::uint16_t>(at + 6);
+    if (database.depth > LmdbDatabase::kMaxDepth) malformed("tree depth");
+    database.entries = load<std::uint64_t>(at + 32);
+    database.root = load<std::uint64_t>(at + 40);
+    return database;
+}
+
+/// 데이터베이스의 키 비교 함수(`mdb_cmp_memn`, `mdb_cmp_int`)를 흉내 낸다.
+int compareKeys(std::uint16_t flags, std::string_view lhs, std::string_view rhs) {
+    if ((flags & kIntegerKey) != 0 && lhs.size() == rhs.size() && (lhs.size() == 4 || lhs.size() == 8)) {
+        std::uint64_t a = lhs.size() == 4 ? load<std::uint32_t>(lhs.data()) : load<std::uint64_t>(lhs.data());
+        std::uint64_t b = rhs.size() == 4 ? load<std::uint32_t>(rhs.data()) : load<std::uint64_t>(rhs.data());
+        return a < b ? -1 : a > b ? 1 : 0;
+    }
+    int order = std::memcmp(lhs.data(), rhs.data(), lhs.size() < rhs.size() ? lhs.size() : rhs.size());
+    if (order != 0) return order;
+    return lhs.size() < rhs.size() ? -1 : lhs.size() > rhs.size() ? 1 : 0;
+}
+
+} // namespace
+
+// MARK: - LmdbEnvironment
+
+LmdbEnvironment::LmdbEnvironment(const std::string& path) : file_(path, MappedFile::Access::Random) {
+    if (file_.size() < kTxnId + 8) malformed("truncated");
+    // 첫 메타 페이지의 FREE_DBI `md_pad`에 페이지 크기가 들어 있다.
+    pageSize_ = load<std::uint32_t>(file_.data() + kFreeDatabase);
+    if (pageSize_ < 512 || (pageSize_ & (pageSize_ - 1)) != 0 || file_.size() < pageSize_ * 2) malformed("page size");
+}
+
+const char* LmdbEnvironment::page(std::uint64_t number) const {
+    if (number >= pageCount()) malformed("page number");
+    return file_.data() + number * pageSize_;
+}
+
+LmdbTransaction LmdbEnvironment::begin() const {
+    // 두 메타 페이지 중 커밋이 더 최근인 쪽이 현재 상태다.
+    const char* best = nullptr;
+    for (std::uint64_t number = 0; number < 2; ++number) {
+        const char* meta = page(number);
+        if ((load<std::uint16_t>(meta + 10) & kPageMeta) == 0) continue;
+        if (load<std::uint32_t>(meta + kMetaOffset) != kMagic) continue;
+        if (load<std::uint32_t>(meta + kMetaOffset + 4) != kVersion) continue;
+        if (best == nullptr || load<std::uint64_t>(meta + kTxnId) > load<std::uint64_t>(best + kTxnId)) best = meta;
+    }
+    if (best == nullptr) malformed("no valid meta page");
+    return LmdbTransaction(this, load<std::uint64_t>(best + kTxnId), loadDatabase(best + kMainDatabase));
+}
+
+// MARK: - LmdbTransaction
+
+const char* LmdbTransaction::checkedPage(std::uint64_t number, std::uint16_t kind) const {
+    const char* page = environment_->page(number);
+    if ((load<std::uint16_t>(page + 10) & kind) == 0) malformed("unexpected page type");
+    return page;
+}
+
+std::size_t LmdbTransaction::nodeCount(const char* page) const {
+    auto lower = load<std::uint16_t>(page + 12);
+    if (lower < kPageHeader || lower > environment_->pageSize()) malformed("page bounds");
+    return (lower - kPageHeader) / 2;
+}
+
+const char* LmdbTransaction::node(const char* page, std::size_t index) const {
+    auto offset = load<std::uint16_t>(page + kPageHeader + index * 2);
+    if (offset < kPageHeader || offset + kNodeHeader > environment_->pageSize()) malformed("node offset");
+    const char* node = page + offset;
+    if (offset + kNodeHeader + load<std::uint16_t>(node + 6) > environment_->pageSize()) malformed("node key");
+    return node;
+}
+
+std::string_view LmdbTransaction::nodeKey(const char* node) const {
+    return {node + kNodeHeader, load<std::uint16_t>(node + 6)};
+}
+
+std::string_view LmdbTransaction::nodeValue(const char* page, const char* node) const {
+    auto flags = load<std::uint16_t>(node + 4);
+    std::size_t size = load<std::uint16_t>(node) | std::size_t(load<std::uint16_t>(node + 2)) << 16;
+    const char* data = node + kNodeHeader + load<std::uint16_t>(node + 6);
+    if ((flags & kNodeDupData) != 0) throw std::runtime_error("data.mdb: duplicate-sorted values are not supported");
+    if ((flags & kNodeBigData) != 0) {
+        // 큰 값은 연속한 오버플로 페이지에 머리 뒤부터 이어진다.
+        if (std::size_t(data - page) + 8 > environment_->pageSize()) malformed("node overflow page");
+        std::uint64_t number = load<std::uint64_t>(data);
+        const char* overflow = checkedPage(number, kPageOverflow);
+        std::size_t pages = load<std::uint32_t>(overflow + 12);
+        if (number + pages > environment_->pageCount() || kPageHeader + size > pages * environment_->pageSize()) {
+            malformed("overflow size");
+        }
+        return {overflow + kPageHeader, size};
+    }
+    if (std::size_t(data - page) + size > environment_->pageSize()) malformed("node value");
+    return {data, size};
+}
+
+std::uint64_t LmdbTransaction::childPage(const char* node) const {
+    return std::uint64_t(load<std::uint16_t>(node)) | std::uint64_t(load<std::uint16_t>(node + 2)) << 16 |
+           std::uint64_t(load<std::uint16_t>(node + 4)) << 32;
+}
+
+bool LmdbTransaction::open(std::string_view name, LmdbDatabase& database) const {
+    std::string_view value;
+    if (!get(main_, name, value)) return false;
+    if (value.size() < 48) malformed("sub-database record");
+    database = loadDatabase(value.data());
+    return true;
+}
+
+bool LmdbTransaction::get(const LmdbDatabase& database, std::string_view key, std::string_view& value) const {
+    if ((database.flags & (kReverseKey | kDupSort)) != 0) {
+        throw std::runtime_error("data.mdb: reverse-key and duplicate-sorted databases are not supported");
+    }
+    if (database.root == LmdbDatabase::kNoPage) return false;
+
+    const char* page = checkedPage(database.root, kPageBranch | kPageLeaf);
+    for (std::uint16_t level = 0; (load<std::uint16_t>(page + 10) & kPageBranch) != 0; ++level) {
+        if (level > database.depth) malformed("tree depth");
+        // 첫 노드의 키는 비어 있고 "가장 작은 값"을 뜻한다. 키 이하인 마지막 노드로 내려간다.
+        std::size_t count = nodeCount(page);
+        if (count == 0) malformed("empty branch");
+        std::size_t low = 1, high = count;
+        while (low < high) {
+            std::size_t middle = (low + high) / 2;
+            if (compareKeys(database.flags, nodeKey(node(page, middle)), key) <= 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        page = checkedPage(childPage(node(page, low - 1)), kPageBranch | kPageLeaf);
+    }
+
+    std::size_t low = 0, high = nodeCount(page);
+    while (low < high) {
+        std::size_t middle = (low + high) / 2;
+        const char* item = node(page, middle);
+        int order = compareKeys(database.flags, nodeKey(item), key);
+        if (order == 0) {
+            value = nodeValue(page, item);
+            return true;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return false;
+}
+
+} // namespace manual
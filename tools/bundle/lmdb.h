@@ -0,0 +1,110 @@
+//
+//  lmdb.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "common/mapped_file.h"
+
+namespace manual {
+
+/// LMDB 데이터베이스 하나(`MDB_db`)의 루트 정보.
+struct LmdbDatabase {
+    static constexpr std::uint64_t kNoPage = ~std::uint64_t(0);
+    /// 읽을 수 있는 트리 깊이의 상한(bplist와 같다). 4KB 페이지라면 열 단계로도 수십억 항목을 담는다.
+    static constexpr std::uint16_t kMaxDepth = 64;
+
+    std::uint16_t flags = 0;
+    std::uint16_t depth = 0;
+    std::uint64_t entries = 0;
+    std::uint64_t root = kNoPage;
+};
+
+class LmdbTransaction;
+
+/// 읽기 전용으로 매핑한 LMDB 환경(`data.mdb`).
+///
+/// 번들의 `data.mdb`는 빌드가 끝난 뒤 바뀌지 않으므로 잠금 파일과 리더 표를 쓰지 않는다.
+/// 트랜잭션은 시작할 때 고른 메타 페이지만 기억하는 값이라, 스레드마다 따로 열어도 공유하는 상태가 없다.
+class LmdbEnvironment {
+public:
+    /// `data.mdb` 파일을 연다. 형식이 맞지 않으면 `std::runtime_error`를 던진다.
+    explicit LmdbEnvironment(const std::string& path);
+
+    LmdbTransaction begin() const;
+    std::size_t pageSize() const { return pageSize_; }
+    std::size_t pageCount() const { return file_.size() / pageSize_; }
+
+private:
+    friend class LmdbTransaction;
+
+    const char* page(std::uint64_t number) const;
+
+    MappedFile file_;
+    std::size_t pageSize_ = 0;
+};
+
+/// 읽기 트랜잭션. 돌려주는 값은 모두 매핑을 가리키며 환경이 살아 있는 동안 유효하다.
+class LmdbTransaction {
+public:
+    std::uint64_t id() const { return txnId_; }
+    const LmdbDatabase& main() const { return main_; }
+
+    /// 이름 붙은 데이터베이스(`mdb_dbi_open`). 없으면 `false`를 돌려준다.
+    bool open(std::string_view name, LmdbDatabase& database) const;
+
+    /// `key`의 값(`mdb_get`). 없으면 `false`를 돌려준다.
+    bool get(const LmdbDatabase& database, std::string_view key, std::string_view& value) const;
+
+    /// 모든 항목을 키 순서로 `body(key, value)`에 넘긴다.
+    template <class Body>
+    void forEach(const LmdbDatabase& database, Body&& body) const {
+        // 올바른 트리라면 페이지마다 한 번씩만 들른다. 같은 페이지를 여러 번 가리키는 파일이 지수적으로 불어나지 않게
+        // 들른 페이지 수를 파일의 페이지 수로 묶는다.
+        std::uint64_t pages = environment_->pageCount();
+        if (database.root != LmdbDatabase::kNoPage) visit(database.root, database.depth, body, pages);
+    }
+
+private:
+    friend class LmdbEnvironment;
+
+    LmdbTransaction(const LmdbEnvironment* environment, std::uint64_t txnId, const LmdbDatabase& main)
+        : environment_(environment), txnId_(txnId), main_(main) {}
+
+    template <class Body>
+    void visit(std::uint64_t page, std::uint16_t depth, Body& body, std::uint64_t& pages) const;
+
+    std::size_t nodeCount(const char* page) const;
+    const char* node(const char* page, std::size_t index) const;
+    std::string_view nodeKey(const char* node) const;
+    std::string_view nodeValue(const char* page, const char* node) const;
+    std::uint64_t childPage(const char* node) const;
+    const char* checkedPage(std::uint64_t number, std::uint16_t kind) const;
+
+    const LmdbEnvironment* environment_;
+    std::uint64_t txnId_;
+    LmdbDatabase main_;
+};
+
+template <class Body>
+void LmdbTransaction::visit(std::uint64_t number, std::uint16_t depth, Body& body, std::uint64_t& pages) const {
+    if (pages-- == 0) throw std::runtime_error("malformed data.mdb: page visited twice");
+    const char* page = checkedPage(number, depth > 1 ? 0x01 : 0x02);
+    std::size_t count = nodeCount(page);
+    for (std::size_t i = 0; i < count; ++i) {
+        const char* item = node(page, i);
+        if (depth > 1) {
+            visit(childPage(item), std::uint16_t(depth - 1), body, pages);
+        } else {
+            body(nodeKey(item), nodeValue(page, item));
+        }
+    }
+}
+
+} // namespace manual
@@ -0,0 +1,212 @@
+//
+//  navigator_index.cpp
+//  swiftUIManual tools
+//
+
+#include "bundle/navigator_index.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "common/hash.h"
+#include "common/json.h"
+
+namespace manual {
+
+namespace {
+
+constexpr std::size_t kRecordHeader = 8;   // 부모 번호, 항목 길이
+constexpr std::size_t kItemHeader = 34;    // 페이지 종류, 언어, 플랫폼, 가용성, 제목 길이, 경로 길이
+
+template <class T>
+T load(const char* at) {
+    T value;
+    std::memcpy(&value, at, sizeof value);
+    return value;
+}
+
+constexpr int kMaxDepth = 64;   // bplist와 같은 상한. DocC 사이드바는 열 단계를 넘지 않는다
+
+[[noreturn]] void malformed(const char* what) {
+    throw std::runtime_error(std::string("malformed navigator.index: ") + what);
+}
+
+bool isVisible(const std::uint64_t* visible, std::uint32_t node) {
+    return visible == nullptr || (visible[node / 64] >> (node % 64) & 1) != 0;
+}
+
+} // namespace
+
+std::string_view navigatorTypeName(NavigatorPageType type) {
+    switch (type) {
+    case NavigatorPageType::Root: return "root";
+    case NavigatorPageType::Article: return "article";
+    case NavigatorPageType::Tutorial: return "tutorial";
+    case NavigatorPageType::Section: return "section";
+    case NavigatorPageType::Learn: return "learn";
+    case NavigatorPageType::Overview: return "overview";
+    case NavigatorPageType::Resources: return "resources";
+    case NavigatorPageType::Symbol: return "symbol";
+    case NavigatorPageType::Framework: return "module";
+    case NavigatorPageType::Class: return "class";
+    case NavigatorPageType::Structure: return "struct";
+    case NavigatorPageType::Protocol: return "protocol";
+    case NavigatorPageType::Enumeration: return "enum";
+    case NavigatorPageType::Function: return "func";
+    case NavigatorPageType::Extension: return "extension";
+    case NavigatorPageType::LocalVariable:
+    case NavigatorPageType::GlobalVariable:
+    case NavigatorPageType::InstanceVariable:
+    case NavigatorPageType::TypeVariable: return "var";
+    case NavigatorPageType::TypeAlias: return "typealias";
+    case NavigatorPageType::AssociatedType: return "associatedtype";
+    case NavigatorPageType::Operator: return "op";
+    case NavigatorPageType::Macro: return "macro";
+    case NavigatorPageType::Union: return "union";
+    case NavigatorPageType::EnumerationCase: return "case";
+    case NavigatorPageType::Initializer: return "init";
+    case NavigatorPageType::InstanceMethod:
+    case NavigatorPageType::TypeMethod: return "method";
+    case NavigatorPageType::InstanceProperty:
+    case NavigatorPageType::TypeProperty: return "property";
+    case NavigatorPageType::InstanceSubscript:
+    case NavigatorPageType::TypeSubscript: return "subscript";
+    case NavigatorPageType::LanguageGroup: return "languageGroup";
+    case NavigatorPageType::GroupMarker: return "groupMarker";
+    }
+    return "symbol";
+}
+
+NavigatorIndex::NavigatorIndex(std::string_view bytes) : bytes_(bytes) {
+    std::vector<std::uint32_t> lastChild;
+    for (std::size_t at = 0; at < bytes.size();) {
+        if (bytes.size() - at < kRecordHeader + kItemHeader) malformed("truncated record");
+        auto parent = load<std::uint32_t>(bytes.data() + at);
+        auto length = load<std::uint32_t>(bytes.data() + at + 4);
+        auto titleLength = load<std::uint64_t>(bytes.data() + at + kRecordHeader + 18);
+        auto pathLength = load<std::uint64_t>(bytes.data() + at + kRecordHeader + 26);
+        if (length > bytes.size() - at - kRecordHeader || length < kItemHeader ||
+            titleLength > length - kItemHeader || pathLength != length - kItemHeader - titleLength) {
+            malformed("record length");
+        }
+
+        auto node = std::uint32_t(offsets_.size());
+        offsets_.push_back(std::uint32_t(at));
+        firstChild_.push_back(kNoNode);
+        nextSibling_.push_back(kNoNode);
+        lastChild.push_back(kNoNode);
+        // 루트의 부모 칸은 0이지만 의미가 없다. 나머지는 앞서 나온 노드를 가리켜야 한다.
+        if (node != 0) {
+            if (parent >= node) malformed("parent");
+            if (lastChild[parent] == kNoNode) {
+                firstChild_[parent] = node;
+            } else {
+                nextSibling_[lastChild[parent]] = node;
+            }
+            lastChild[parent] = node;
+        }
+        at += kRecordHeader + length;
+    }
+    if (offsets_.empty()) malformed("empty");
+
+    std::size_t capacity = 16;
+    while (capacity < offsets_.size() * 2) capacity *= 2;
+    slots_.assign(capacity, 0);
+    for (std::uint32_t node = 0; node < offsets_.size(); ++node) {
+        std::string_view path = (*this)[node].path;
+        if (path.empty()) continue;
+        for (std::size_t slot = fnv1a(path) & (capacity - 1);; slot = (slot + 1) & (capacity - 1)) {
+            if (slots_[slot] == 0) {
+                slots_[slot] = node + 1;
+                break;
+            }
+            if ((*this)[slots_[slot] - 1].path == path) break;
+        }
+    }
+}
+
+NavigatorNode NavigatorIndex::operator[](std::uint32_t node) const {
+    const char* at = bytes_.data() + offsets_[node];
+    const char* item = at + kRecordHeader;
+    NavigatorNode result;
+    result.parent = node == 0 ? kNoNode : load<std::uint32_t>(at);
+    result.pageType = NavigatorPageType(std::uint8_t(item[0]));
+    result.languageId = std::uint8_t(item[1]);
+    result.platformMask = load<std::uint64_t>(item + 2);
+    result.availabilityId = load<std::uint64_t>(item + 10);
+    auto titleLength = std::size_t(load<std::uint64_t>(item + 18));
+    auto pathLength = std::size_t(load<std::uint64_t>(item + 26));
+    result.title = {item + kItemHeader, titleLength};
+    result.path = {item + kItemHeader + titleLength, pathLength};
+    return result;
+}
+
+std::uint32_t NavigatorIndex::find(std::string_view path) const {
+    std::size_t mask = slots_.size() - 1;
+    for (std::size_t slot = fnv1a(path) & mask; slots_[slot] != 0; slot = (slot + 1) & mask) {
+        if ((*this)[slots_[slot] - 1].path == path) return slots_[slot] - 1;
+    }
+    return kNoNode;
+}
+
+void NavigatorIndex::renderIndexJson(std::string& out, const std::uint64_t* visible) const {
+    out.clear();
+    out += "{\"interfaceLanguages\":{";
+    bool firstLanguage = true;
+    for (std::uint32_t group : children(0)) {
+        NavigatorNode language = (*this)[group];
+        if (!firstLanguage) out += ',';
+        firstLanguage = false;
+        // 언어 번호는 DocC `InterfaceLanguage`의 마스크다.
+        appendJsonString(out, language.languageId == 1   ? std::string_view("swift")
+                              : language.languageId == 2 ? std::string_view("occ")
+                                                         : language.title);
+        out += ":[";
+        bool first = true;
+        for (std::uint32_t child : children(group)) {
+            if (!isVisible(visible, child)) continue;
+            if (!first) out += ',';
+            first = false;
+            appendNode(child, out, visible, 0);
+        }
+        out += ']';
+    }
+    out += "},\"schemaVersion\":{\"major\":0,\"minor\":1,\"patch\":0}}";
+}
+
+void NavigatorIndex::appendNodeJson(std::uint32_t node, std::string& out, const std::uint64_t* visible) const {
+    appendNode(node, out, visible, 0);
+}
+
+void NavigatorIndex::appendNode(std::uint32_t node, std::string& out, const std::uint64_t* visible, int depth) const {
+    if (depth > kMaxDepth) malformed("nesting");
+    NavigatorNode item = (*this)[node];
+    out += '{';
+    // 보이는 자식이 하나도 없으면 잎 노드처럼 `children`을 쓰지 않는다.
+    bool first = true;
+    for (std::uint32_t child : children(node)) {
+        if (!isVisible(visible, child)) continue;
+        out += first ? "\"children\":[" : ",";
+        first = false;
+        appendNode(child, out, visible, depth + 1);
+    }
+    if (!first) out += "],";
+    // 묶음 표식의 경로는 조각 식별자일 뿐이라 `index.json`에는 쓰지 않는다.
+    if (item.pageType != NavigatorPageType::GroupMarker && !item.path.empty()) {
+        out += "\"path\":";
+        appendJsonString(out, item.path);
+        out += ',';
+    }
+    out += "\"title\":";
+    appendJsonString(out, item.title);
+    out += ",\"type\":";
+    appendJsonString(out, navigatorTypeName(item.pageType));
+    out += '}';
+}
+
+std::size_t NavigatorIndex::memoryUsage() const {
+    return (offsets_.capacity() + firstChild_.capacity() + nextSibling_.capacity() + slots_.capacity()) *
+           sizeof(std::uint32_t);
+}
+
+} // namespace manual
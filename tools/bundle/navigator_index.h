@@ -0,0 +1,127 @@
+//
+//  navigator_index.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace manual {
+
+/// DocC `NavigatorIndex.PageType`. 번들에 쓰인 값 그대로다.
+enum class NavigatorPageType : std::uint8_t {
+    Root = 0,
+    Article = 1,
+    Tutorial = 2,
+    Section = 3,
+    Learn = 4,
+    Overview = 5,
+    Resources = 6,
+    Symbol = 7,
+    Framework = 10,
+    Class = 20,
+    Structure = 21,
+    Protocol = 22,
+    Enumeration = 23,
+    Function = 24,
+    Extension = 25,
+    LocalVariable = 26,
+    GlobalVariable = 27,
+    TypeAlias = 28,
+    AssociatedType = 29,
+    Operator = 30,
+    Macro = 31,
+    Union = 32,
+    EnumerationCase = 33,
+    Initializer = 34,
+    InstanceMethod = 35,
+    InstanceProperty = 36,
+    InstanceSubscript = 37,
+    InstanceVariable = 38,
+    TypeMethod = 39,
+    TypeProperty = 40,
+    TypeSubscript = 41,
+    TypeVariable = 42,
+    LanguageGroup = 127,
+    GroupMarker = 255,
+};
+
+/// `index.json`의 `type` 값(`struct`, `init`, `groupMarker` 등).
+std::string_view navigatorTypeName(NavigatorPageType type);
+
+constexpr std::uint32_t kNoNode = 0xFFFFFFFF;
+
+/// 레코드 하나를 풀어 놓은 것. 문자열은 매핑한 파일을 그대로 가리킨다.
+struct NavigatorNode {
+    std::uint32_t parent = kNoNode;
+    NavigatorPageType pageType = NavigatorPageType::Root;
+    std::uint8_t languageId = 0;
+    std::uint64_t platformMask = 0;
+    std::uint64_t availabilityId = 0;   // `availability.index`의 번호
+    std::string_view title;
+    std::string_view path;
+};
+
+/// DocC `navigator.index`를 복사 없이 읽는다.
+///
+/// 파일은 `부모 번호(u32) 길이(u32) 항목` 레코드를 너비 우선 순서로 이어 쓴 것이고, 첫 레코드가 루트다.
+/// 여는 동안 레코드 시작 위치와 첫 자식/다음 형제, 경로 해시 표만 만들고 제목과 경로는 파일을 가리킨다.
+class NavigatorIndex {
+public:
+    class ChildIterator {
+    public:
+        ChildIterator(const NavigatorIndex* index, std::uint32_t node) : index_(index), node_(node) {}
+        std::uint32_t operator*() const { return node_; }
+        ChildIterator& operator++() {
+            node_ = index_->nextSibling_[node_];
+            return *this;
+        }
+        bool operator!=(const ChildIterator& other) const { return node_ != other.node_; }
+
+    private:
+        const NavigatorIndex* index_;
+        std::uint32_t node_;
+    };
+
+    struct Children {
+        ChildIterator first;
+        ChildIterator begin() const { return first; }
+        ChildIterator end() const { return {nullptr, kNoNode}; }
+    };
+
+    /// `bytes`는 인덱스보다 오래 살아 있어야 한다. 형식이 맞지 않으면 `std::runtime_error`를 던진다.
+    explicit NavigatorIndex(std::string_view bytes);
+
+    std::size_t size() const { return offsets_.size(); }
+    NavigatorNode operator[](std::uint32_t node) const;
+    Children children(std::uint32_t node) const { return {ChildIterator(this, firstChild_[node])}; }
+    bool hasChildren(std::uint32_t node) const { return firstChild_[node] != kNoNode; }
+
+    /// `path`(`/documentation/...`)인 첫 노드. 같은 페이지가 여러 곳에 나오면 파일에서 먼저 나온 쪽이다.
+    std::uint32_t find(std::string_view path) const;
+
+    /// `index.json`과 같은 바이트를 `out`에 쓴다. `out`의 용량을 재사용하므로 두 번째 호출부터는 할당하지 않는다.
+    /// `visible`(노드 번호 비트 집합)을 주면 비트가 꺼진 노드와 그 자손은 빼고 쓴다.
+    void renderIndexJson(std::string& out, const std::uint64_t* visible = nullptr) const;
+    /// `node`와 그 자손을 `index.json`의 노드 객체 하나로 `out` 뒤에 붙인다.
+    /// 64단계보다 깊게 중첩되어 있으면 `std::runtime_error`를 던진다.
+    void appendNodeJson(std::uint32_t node, std::string& out, const std::uint64_t* visible = nullptr) const;
+
+    /// 오프셋과 링크, 해시 표가 차지하는 바이트 수.
+    std::size_t memoryUsage() const;
+
+private:
+    void appendNode(std::uint32_t node, std::string& out, const std::uint64_t* visible, int depth) const;
+
+    std::string_view bytes_;
+    std::vector<std::uint32_t> offsets_;
+    std::vector<std::uint32_t> firstChild_;
+    std::vector<std::uint32_t> nextSibling_;
+    std::vector<std::uint32_t> slots_;   // 노드 번호 + 1. 0은 빈 칸이다.
+};
+
+} // namespace manual
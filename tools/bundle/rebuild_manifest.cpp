@@ -0,0 +1,207 @@
+//
+//  rebuild_manifest.cpp
+//  swiftUIManual tools
+//
+
+#include "bundle/rebuild_manifest.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "common/arena.h"
+#include "common/hash.h"
+#include "common/json.h"
+#include "common/mapped_file.h"
+#include "interface/symbol_table.h"
+
+namespace manual {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* kManifestHeader = "swiftui-rebuild 1";
+constexpr std::string_view kInheritedPrefix = "Inherited from ";
+
+/// `doc://com.doldamul.swiftUIManual/documentation/swiftUIManual/ContentView`를
+/// `documentation/swiftuimanual/contentview`로 바꾼다.
+std::string pageForReference(std::string_view reference) {
+    std::size_t scheme = reference.find("://");
+    if (scheme == std::string_view::npos) return {};
+    std::size_t slash = reference.find('/', scheme + 3);
+    if (slash == std::string_view::npos) return {};
+    std::string page(reference.substr(slash + 1));
+    std::transform(page.begin(), page.end(), page.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+    return page;
+}
+
+void sortUnique(std::vector<std::string>& values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+} // namespace
+
+std::vector<DeclRecord> hashDeclarations(const SymbolTable& table) {
+    const TokenStream& stream = table.tokens();
+    std::vector<DeclRecord> records;
+    records.reserve(table.topLevel().size());
+    for (std::uint32_t index : table.topLevel()) {
+        const Decl& decl = table[index];
+        // 문서 주석은 앞 선언 구간에 붙어 있으므로 바로 앞의 주석 토큰까지 거슬러 올라간다.
+        std::uint32_t begin = decl.firstToken;
+        while (begin > 0 && stream.tokens[begin - 1].kind == TokenKind::Comment) --begin;
+        std::uint64_t hash = fnv1a("");
+        for (std::uint32_t token = begin; token < decl.endToken; ++token) {
+            hash = fnv1a(stream.text(stream.tokens[token]), hash);
+            hash = fnv1a(std::string_view(" ", 1), hash);
+        }
+        DeclRecord record;
+        record.hash = hash;
+        record.label = std::string(declKindName(decl.kind)) + " " + std::string(table.qualifiedName(decl));
+        records.push_back(std::move(record));
+    }
+    return records;
+}
+
+std::size_t attachPages(std::vector<DeclRecord>& records, const SymbolTable& table, const std::string& dataDirectory) {
+    // 선언 번호 → 그 선언을 담은 최상위 선언의 기록
+    std::unordered_map<std::uint32_t, std::size_t> recordForTopLevel;
+    for (std::size_t i = 0; i < table.topLevel().size(); ++i) recordForTopLevel[table.topLevel()[i]] = i;
+
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::recursive_directory_iterator(dataDirectory)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    std::size_t unmatched = 0;
+    Arena arena(256 * 1024);
+    for (const auto& path : files) {
+        MappedFile file(path.string());
+        arena.release();
+        JsonValue root = parseJson(file.bytes(), arena);
+        const JsonValue* abstract = root.get("abstract");
+        if (abstract == nullptr || abstract->elements.size() < 2) continue;
+        const JsonValue* prefix = abstract->elements[0].get("text");
+        const JsonValue* code = abstract->elements[1].get("code");
+        if (prefix == nullptr || code == nullptr || prefix->text.substr(0, kInheritedPrefix.size()) != kInheritedPrefix) {
+            continue;
+        }
+
+        fs::path relative = fs::relative(path, dataDirectory);
+        relative.replace_extension();
+        std::string page = relative.generic_string();
+        std::vector<std::string> parents;
+        const JsonValue* hierarchy = root.get("hierarchy");
+        const JsonValue* paths = hierarchy != nullptr ? hierarchy->get("paths") : nullptr;
+        if (paths != nullptr) {
+            for (const auto& chain : paths->elements) {
+                for (const auto& reference : chain.elements) parents.push_back(pageForReference(reference.text));
+            }
+        }
+
+        Span<const std::uint32_t> matches = table.find(code->text);
+        if (matches.empty()) ++unmatched;
+        for (std::uint32_t index : matches) {
+            std::uint32_t top = index;
+            while (table[top].parent != kNoDecl) top = std::uint32_t(table[top].parent);
+            DeclRecord& record = records[recordForTopLevel.at(top)];
+            record.pages.push_back(page);
+            record.aggregates.insert(record.aggregates.end(), parents.begin(), parents.end());
+        }
+    }
+    for (auto& record : records) {
+        sortUnique(record.pages);
+        sortUnique(record.aggregates);
+    }
+    return unmatched;
+}
+
+// MARK: - RebuildManifest
+
+void RebuildManifest::write(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    out << kManifestHeader << '\n' << "unmatched " << unmatchedPages << '\n';
+    char hash[17];
+    for (const auto& record : decls) {
+        std::snprintf(hash, sizeof hash, "%016" PRIx64, record.hash);
+        out << "decl " << hash << ' ' << record.label << '\n';
+        for (const auto& page : record.pages) out << "page " << page << '\n';
+        for (const auto& page : record.aggregates) out << "parent " << page << '\n';
+    }
+    if (!out) throw std::runtime_error("cannot write " + path);
+}
+
+RebuildManifest RebuildManifest::read(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot read " + path);
+    std::string line;
+    if (!std::getline(in, line) || line != kManifestHeader) throw std::runtime_error(path + " is not a rebuild manifest");
+    RebuildManifest manifest;
+    while (std::getline(in, line)) {
+        std::size_t space = line.find(' ');
+        std::string_view keyword = std::string_view(line).substr(0, space);
+        std::string value = space == std::string::npos ? std::string() : line.substr(space + 1);
+        if (keyword == "unmatched") {
+            manifest.unmatchedPages = std::stoul(value);
+        } else if (keyword == "decl" && value.size() > 17) {
+            DeclRecord record;
+            record.hash = std::stoull(value.substr(0, 16), nullptr, 16);
+            record.label = value.substr(17);
+            manifest.decls.push_back(std::move(record));
+        } else if (keyword == "page" && !manifest.decls.empty()) {
+            manifest.decls.back().pages.push_back(value);
+        } else if (keyword == "parent" && !manifest.decls.empty()) {
+            manifest.decls.back().aggregates.push_back(value);
+        } else if (!line.empty()) {
+            throw std::runtime_error(path + ": unexpected line: " + line);
+        }
+    }
+    return manifest;
+}
+
+// MARK: - 계획
+
+RebuildPlan planRebuild(const RebuildManifest& previous, const std::vector<DeclRecord>& current) {
+    RebuildPlan plan;
+    // 같은 내용의 선언이 여러 번 나올 수 있으므로 해시마다 남은 개수를 센다.
+    std::unordered_map<std::uint64_t, std::size_t> remaining;
+    for (const auto& record : current) ++remaining[record.hash];
+
+    std::unordered_map<std::string, std::vector<const DeclRecord*>> previousByLabel;
+    for (const auto& record : previous.decls) {
+        previousByLabel[record.label].push_back(&record);
+        auto found = remaining.find(record.hash);
+        if (found != remaining.end() && found->second > 0) {
+            --found->second;
+            ++plan.unchanged;
+            continue;
+        }
+        ++plan.removed;
+        plan.pages.insert(plan.pages.end(), record.pages.begin(), record.pages.end());
+        plan.pages.insert(plan.pages.end(), record.aggregates.begin(), record.aggregates.end());
+    }
+
+    for (const auto& record : current) {
+        auto found = remaining.find(record.hash);
+        if (found->second == 0) continue;
+        --found->second;
+        plan.added.push_back(record.label);
+        auto siblings = previousByLabel.find(record.label);
+        if (siblings == previousByLabel.end()) continue;
+        for (const DeclRecord* sibling : siblings->second) {
+            plan.pages.insert(plan.pages.end(), sibling->aggregates.begin(), sibling->aggregates.end());
+        }
+    }
+    sortUnique(plan.pages);
+    return plan;
+}
+
+} // namespace manual
@@ -0,0 +1,53 @@
+//
+//  rebuild_manifest.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace manual {
+
+class SymbolTable;
+
+/// 최상위 선언 하나의 내용 해시와, 그 선언에서 나온 렌더 페이지들.
+struct DeclRecord {
+    std::uint64_t hash = 0;
+    std::string label;                     // `extension View`처럼 사람이 읽을 이름
+    std::vector<std::string> pages;        // `documentation/swiftuimanual/contentview/padding(_:_:)`
+    std::vector<std::string> aggregates;   // 위 페이지들을 나열하는 상위 페이지
+};
+
+/// 선언 → 페이지 의존 그래프. 문서를 빌드할 때마다 저장해 두고 다음 SDK와 비교한다.
+struct RebuildManifest {
+    std::vector<DeclRecord> decls;
+    std::size_t unmatchedPages = 0;   // 어느 선언에서 왔는지 찾지 못한 상속 페이지 수
+
+    /// 텍스트 파일로 쓴다. 실패하면 `std::runtime_error`를 던진다.
+    void write(const std::string& path) const;
+    static RebuildManifest read(const std::string& path);
+};
+
+/// 최상위 선언마다 해시를 만든다. 바로 앞의 주석과 속성까지 포함하고 토큰 사이 공백은 무시한다.
+std::vector<DeclRecord> hashDeclarations(const SymbolTable& table);
+
+/// `dataDirectory`(`docs/data`)의 상속 페이지("Inherited from `View.padding(_:_:)`")를 선언에 연결한다.
+/// 한정 이름이 여러 선언(오버로드, 여러 확장)에 걸리면 모두에 연결한다. 찾지 못한 페이지 수를 돌려준다.
+std::size_t attachPages(std::vector<DeclRecord>& records, const SymbolTable& table, const std::string& dataDirectory);
+
+/// 이전 빌드와 새 인터페이스를 비교한 결과.
+struct RebuildPlan {
+    std::vector<std::string> pages;    // 다시 만들 페이지. 정렬되어 있고 중복이 없다.
+    std::vector<std::string> added;    // 이전에 없던 선언의 이름
+    std::size_t unchanged = 0;
+    std::size_t removed = 0;           // 바뀌었거나 사라진 이전 선언
+};
+
+/// 해시가 그대로인 선언은 건너뛰고, 사라진 해시의 페이지와 그 상위 페이지만 다시 만든다.
+/// 새 선언은 아직 페이지가 없으므로, 같은 이름의 이전 선언이 쓰던 상위 페이지를 다시 만든다.
+RebuildPlan planRebuild(const RebuildManifest& previous, const std::vector<DeclRecord>& current);
+
+} // namespace manual
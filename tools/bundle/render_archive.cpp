@@ -0,0 +1,527 @@
+//
+//  render_archive.cpp
+//  swiftUIManual tools
+//
+
+#include "bundle/render_archive.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+#include "common/hash.h"
+
+namespace manual {
+
+using namespace render_encoding;
+
+namespace {
+
+struct Header {
+    char magic[4];
+    std::uint32_t formatVersion;
+    std::uint32_t documentCount;
+    std::uint32_t stringCount;
+    std::uint32_t stringBytes;
+    std::uint32_t valueBytes;
+    std::uint32_t fragmentCount;
+    std::uint32_t fragmentBytes;   // 값 영역 앞부분 중 조각이 차지하는 길이
+};
+static_assert(sizeof(Header) == 32, "머리는 32바이트");
+
+constexpr char kMagic[4] = {'R', 'N', 'D', 'A'};
+constexpr std::uint32_t kFormatVersion = 2;
+
+[[noreturn]] void malformed(const char* what) {
+    throw std::runtime_error(std::string("malformed render archive: ") + what);
+}
+
+std::size_t align8(std::size_t size) { return (size + 7) & ~std::size_t(7); }
+
+void writeVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out += char(std::uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    out += char(value);
+}
+
+/// 다시 쓰면 원문과 같아지는 정수(`0`, `-12`, 선행 0 없음)만 varint로 담는다.
+bool canonicalInteger(std::string_view text, std::int64_t& value) {
+    std::string_view digits = text.substr(text.size() > 0 && text[0] == '-' ? 1 : 0);
+    if (digits.empty() || digits.size() > 18 || (digits[0] == '0' && digits.size() > 1)) return false;
+    if (text[0] == '-' && digits == "0") return false;
+    std::int64_t magnitude = 0;
+    for (char c : digits) {
+        if (c < '0' || c > '9') return false;
+        magnitude = magnitude * 10 + (c - '0');
+    }
+    value = text[0] == '-' ? -magnitude : magnitude;
+    return true;
+}
+
+/// 선언 토큰 배열인지. 키가 정확히 `kind`, `text`, (`preciseIdentifier`) 순서여야 무손실로 되살릴 수 있다.
+bool isTokenArray(const JsonValue& value) {
+    if (!value.isArray() || value.elements.empty()) return false;
+    for (const auto& element : value.elements) {
+        if (!element.isObject()) return false;
+        const Span<JsonMember>& members = element.members;
+        if (members.size() != 2 && members.size() != 3) return false;
+        if (members[0].key != "kind" || !members[0].value.isString()) return false;
+        if (members[1].key != "text" || !members[1].value.isString()) return false;
+        if (members.size() == 3 && (members[2].key != "preciseIdentifier" || !members[2].value.isString())) return false;
+    }
+    return true;
+}
+
+std::size_t tokenKindCode(std::string_view kind) {
+    for (std::size_t code = 1; code < kTokenKindCount; ++code) {
+        if (kTokenKinds[code] == kind) return code;
+    }
+    return 0;
+}
+
+class Encoder {
+public:
+    void count(const JsonValue& value) {
+        switch (value.type) {
+        case JsonValue::Type::Number: {
+            std::int64_t integer;
+            if (!canonicalInteger(value.text, integer)) ++frequency_[value.text];
+            break;
+        }
+        case JsonValue::Type::String: ++frequency_[value.text]; break;
+        case JsonValue::Type::Array:
+            if (isTokenArray(value)) {
+                for (const auto& token : value.elements) {
+                    if (tokenKindCode(token.members[0].value.text) == 0) ++frequency_[token.members[0].value.text];
+                    ++frequency_[token.members[1].value.text];
+                    if (token.members.size() == 3) ++frequency_[token.members[2].value.text];
+                }
+            } else {
+                for (const auto& element : value.elements) count(element);
+            }
+            break;
+        case JsonValue::Type::Object:
+            for (const auto& member : value.members) {
+                ++frequency_[member.key];
+                count(member.value);
+            }
+            break;
+        default: break;
+        }
+    }
+
+    void countName(std::string_view name) { ++frequency_[name]; }
+
+    /// 많이 쓰인 문자열부터 번호를 준다. 같은 횟수면 사전순으로 정해 출력이 항상 같다.
+    void assignIds() {
+        strings_.reserve(frequency_.size());
+        for (const auto& entry : frequency_) strings_.push_back(entry.first);
+        std::sort(strings_.begin(), strings_.end(), [this](std::string_view lhs, std::string_view rhs) {
+            std::uint32_t a = frequency_[lhs], b = frequency_[rhs];
+            return a != b ? a > b : lhs < rhs;
+        });
+        for (std::size_t id = 0; id < strings_.size(); ++id) ids_[strings_[id]] = std::uint32_t(id);
+    }
+
+    const std::vector<std::string_view>& strings() const { return strings_; }
+    std::uint32_t id(std::string_view text) const { return ids_.at(text); }
+
+    void encode(const JsonValue& value, std::string& out) {
+        switch (value.type) {
+        case JsonValue::Type::Null: out += char(kNull); break;
+        case JsonValue::Type::Bool: out += char(value.boolean ? kTrue : kFalse); break;
+        case JsonValue::Type::Number: {
+            std::int64_t integer;
+            if (canonicalInteger(value.text, integer)) {
+                out += char(kInteger);
+                writeVarint(out, (std::uint64_t(integer) << 1) ^ std::uint64_t(integer >> 63));
+            } else {
+                out += char(kNumber);
+                writeVarint(out, id(value.text));
+            }
+            break;
+        }
+        case JsonValue::Type::String:
+            out += char(kString);
+            writeVarint(out, id(value.text));
+            break;
+        case JsonValue::Type::Array: {
+            if (isTokenArray(value)) {
+                out += char(kTokens);
+                writeVarint(out, fragment(value));
+                break;
+            }
+            // 건너뛰기를 위해 바이트 길이를 앞에 쓰므로, 항목을 먼저 따로 인코딩한다.
+            std::string body;
+            for (const auto& element : value.elements) encode(element, body);
+            out += char(kArray);
+            writeVarint(out, value.elements.size());
+            writeVarint(out, body.size());
+            out += body;
+            break;
+        }
+        case JsonValue::Type::Object: {
+            std::string body;
+            for (const auto& member : value.members) {
+                writeVarint(body, id(member.key));
+                encode(member.value, body);
+            }
+            out += char(kObject);
+            writeVarint(out, value.members.size());
+            writeVarint(out, body.size());
+            out += body;
+            break;
+        }
+        }
+    }
+
+    const std::string& fragments() const { return fragments_; }
+    const std::vector<std::uint32_t>& fragmentOffsets() const { return fragmentOffsets_; }
+    const std::vector<std::uint64_t>& fragmentHashes() const { return fragmentHashes_; }
+
+private:
+    /// 토큰 배열을 조각 저장소에 넣고 번호를 돌려준다. 인코딩한 바이트가 같으면 같은 조각이다.
+    std::uint32_t fragment(const JsonValue& value) {
+        std::string body;
+        writeVarint(body, value.elements.size());
+        std::uint64_t hash = fnv1a("");
+        for (const auto& token : value.elements) {
+            std::size_t code = tokenKindCode(token.members[0].value.text);
+            writeVarint(body, (code << 1) | (token.members.size() == 3 ? 1 : 0));
+            if (code == 0) writeVarint(body, id(token.members[0].value.text));
+            writeVarint(body, id(token.members[1].value.text));
+            if (token.members.size() == 3) writeVarint(body, id(token.members[2].value.text));
+            // 해시는 문자열 번호가 아니라 내용으로 만들어서 다른 아카이브와도 비교할 수 있게 한다.
+            for (const auto& member : token.members) hash = fnv1a(std::string_view("\0", 1), fnv1a(member.value.text, hash));
+        }
+        auto [entry, inserted] = fragmentIds_.emplace(std::move(body), std::uint32_t(fragmentOffsets_.size()));
+        if (inserted) {
+            fragmentOffsets_.push_back(std::uint32_t(fragments_.size()));
+            fragmentHashes_.push_back(hash);
+            fragments_ += entry->first;
+        }
+        return entry->second;
+    }
+
+    std::unordered_map<std::string_view, std::uint32_t> frequency_;
+    std::unordered_map<std::string_view, std::uint32_t> ids_;
+    std::vector<std::string_view> strings_;
+    std::unordered_map<std::string, std::uint32_t> fragmentIds_;
+    std::string fragments_;
+    std::vector<std::uint32_t> fragmentOffsets_;
+    std::vector<std::uint64_t> fragmentHashes_;
+};
+
+} // namespace
+
+// MARK: - RenderArchiveBuilder
+
+void RenderArchiveBuilder::add(std::string_view name, std::string_view json) {
+    std::string_view text = arena_.copy(json);
+    documents_.push_back({arena_.copy(name), parseJson(text, arena_)});
+}
+
+std::string RenderArchiveBuilder::serialize() const {
+    Encoder encoder;
+    for (const auto& document : documents_) {
+        encoder.countName(document.name);
+        encoder.count(document.root);
+    }
+    encoder.assignIds();
+
+    std::vector<const Document*> order;
+    for (const auto& document : documents_) order.push_back(&document);
+    std::sort(order.begin(), order.end(), [](const Document* lhs, const Document* rhs) { return lhs->name < rhs->name; });
+
+    std::string values;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> documents;
+    for (const Document* document : order) {
+        documents.emplace_back(encoder.id(document->name), std::uint32_t(values.size()));
+        encoder.encode(document->root, values);
+    }
+    // 조각을 값 영역 앞에 두므로 문서 위치를 그만큼 민다.
+    const std::string& fragments = encoder.fragments();
+    std::vector<std::uint32_t> documentTable;
+    for (const auto& [name, offset] : documents) {
+        documentTable.push_back(name);
+        documentTable.push_back(std::uint32_t(fragments.size() + offset));
+    }
+    std::vector<std::uint32_t> fragmentOffsets = encoder.fragmentOffsets();
+    fragmentOffsets.push_back(std::uint32_t(fragments.size()));
+
+    std::vector<std::uint32_t> offsets;
+    std::string strings;
+    for (std::string_view text : encoder.strings()) {
+        offsets.push_back(std::uint32_t(strings.size()));
+        strings += text;
+    }
+    offsets.push_back(std::uint32_t(strings.size()));
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof kMagic);
+    header.formatVersion = kFormatVersion;
+    header.documentCount = std::uint32_t(order.size());
+    header.stringCount = std::uint32_t(encoder.strings().size());
+    header.stringBytes = std::uint32_t(strings.size());
+    header.valueBytes = std::uint32_t(fragments.size() + values.size());
+    header.fragmentCount = std::uint32_t(encoder.fragmentHashes().size());
+    header.fragmentBytes = std::uint32_t(fragments.size());
+
+    std::string out;
+    auto append = [&out](const void* data, std::size_t size) {
+        out.append(static_cast<const char*>(data), size);
+        out.resize(align8(out.size()), '\0');
+    };
+    append(&header, sizeof header);
+    append(offsets.data(), offsets.size() * sizeof(std::uint32_t));
+    append(strings.data(), strings.size());
+    append(fragmentOffsets.data(), fragmentOffsets.size() * sizeof(std::uint32_t));
+    append(encoder.fragmentHashes().data(), encoder.fragmentHashes().size() * sizeof(std::uint64_t));
+    append(documentTable.data(), documentTable.size() * sizeof(std::uint32_t));
+    out += fragments;
+    append(values.data(), values.size());
+    return out;
+}
+
+// MARK: - RenderArchive
+
+RenderArchive::RenderArchive(std::string_view bytes) {
+    if (bytes.size() < sizeof(Header)) malformed("truncated");
+    Header header;
+    std::memcpy(&header, bytes.data(), sizeof header);
+    if (std::memcmp(header.magic, kMagic, sizeof kMagic) != 0 || header.formatVersion != kFormatVersion) {
+        malformed("header");
+    }
+    documentCount_ = header.documentCount;
+    stringCount_ = header.stringCount;
+    valueBytes_ = header.valueBytes;
+
+    std::size_t at = sizeof(Header);
+    auto section = [&](std::size_t size) {
+        std::size_t start = at;
+        at = align8(at + size);
+        if (start + size > bytes.size()) malformed("truncated");
+        return bytes.data() + start;
+    };
+    stringOffsets_ = reinterpret_cast<const std::uint32_t*>(section((stringCount_ + 1) * sizeof(std::uint32_t)));
+    strings_ = section(header.stringBytes);
+    fragmentCount_ = header.fragmentCount;
+    fragmentOffsets_ = reinterpret_cast<const std::uint32_t*>(section((fragmentCount_ + 1) * sizeof(std::uint32_t)));
+    fragmentHashes_ = reinterpret_cast<const std::uint64_t*>(section(fragmentCount_ * sizeof(std::uint64_t)));
+    documents_ = reinterpret_cast<const std::uint32_t*>(section(documentCount_ * 2 * sizeof(std::uint32_t)));
+    values_ = reinterpret_cast<const std::uint8_t*>(section(valueBytes_));
+    // 위치 표는 늘어나기만 하고 마지막 항목이 영역 길이여야 한다. 그래야 이웃한 두 항목의 차가 길이가 된다.
+    if (stringOffsets_[stringCount_] != header.stringBytes) malformed("string table");
+    for (std::size_t i = 0; i < stringCount_; ++i) {
+        if (stringOffsets_[i] > stringOffsets_[i + 1]) malformed("string table");
+    }
+    if (fragmentOffsets_[fragmentCount_] != header.fragmentBytes || header.fragmentBytes > valueBytes_) {
+        malformed("fragment table");
+    }
+    for (std::size_t i = 0; i < fragmentCount_; ++i) {
+        if (fragmentOffsets_[i] > fragmentOffsets_[i + 1]) malformed("fragment table");
+    }
+    for (std::size_t i = 0; i < documentCount_; ++i) {
+        checkedString(documents_[i * 2]);
+        if (documents_[i * 2 + 1] < header.fragmentBytes || documents_[i * 2 + 1] >= valueBytes_) {
+            malformed("document offset");
+        }
+    }
+}
+
+std::uint32_t RenderArchive::checkedString(std::uint64_t id) const {
+    if (id >= stringCount_) malformed("string id");
+    return std::uint32_t(id);
+}
+
+std::uint64_t RenderArchive::fragmentHash(std::size_t fragment) const {
+    std::uint64_t hash;
+    std::memcpy(&hash, fragmentHashes_ + fragment, sizeof hash);
+    return hash;
+}
+
+std::string_view RenderArchive::name(std::size_t document) const { return string(documents_[document * 2]); }
+
+RenderValue RenderArchive::root(std::size_t document) const {
+    return RenderValue(this, values_ + documents_[document * 2 + 1]);
+}
+
+std::size_t RenderArchive::find(std::string_view target) const {
+    std::size_t low = 0, high = documentCount_;
+    while (low < high) {
+        std::size_t middle = (low + high) / 2;
+        std::string_view candidate = name(middle);
+        if (candidate == target) return middle;
+        if (candidate < target) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return documentCount_;
+}
+
+// MARK: - RenderValue
+
+std::uint8_t RenderValue::tag() const {
+    if (at_ >= archive_->values_ + archive_->valueBytes_) malformed("truncated value");
+    return *at_;
+}
+
+RenderValue::Type RenderValue::type() const {
+    switch (tag()) {
+    case kNull: return Type::Null;
+    case kFalse:
+    case kTrue: return Type::Bool;
+    case kInteger: return Type::Integer;
+    case kNumber: return Type::Number;
+    case kString: return Type::String;
+    case kArray: return Type::Array;
+    case kObject: return Type::Object;
+    case kTokens: return Type::Tokens;
+    }
+    malformed("tag");
+}
+
+bool RenderValue::boolean() const { return tag() == kTrue; }
+
+std::int64_t RenderValue::integer() const {
+    if (tag() != kInteger) return 0;
+    const std::uint8_t* at = at_ + 1;
+    std::uint64_t zigzag = readVarint(at, archive_->values_ + archive_->valueBytes_);
+    return std::int64_t(zigzag >> 1) ^ -std::int64_t(zigzag & 1);
+}
+
+std::string_view RenderValue::text() const {
+    std::uint8_t tag = this->tag();
+    if (tag != kString && tag != kNumber) return {};
+    const std::uint8_t* at = at_ + 1;
+    return archive_->string(archive_->checkedString(readVarint(at, archive_->values_ + archive_->valueBytes_)));
+}
+
+std::size_t RenderValue::size() const {
+    std::uint8_t tag = this->tag();
+    if (tag != kArray && tag != kObject && tag != kTokens) return 0;
+    std::size_t count = 0;
+    payload(count);
+    return count;
+}
+
+const std::uint8_t* RenderValue::payload(std::size_t& count) const {
+    const std::uint8_t* end = archive_->values_ + archive_->valueBytes_;
+    const std::uint8_t* at = at_ + 1;
+    if (tag() == kTokens) {
+        std::uint64_t fragment = readVarint(at, end);
+        if (fragment >= archive_->fragmentCount_) malformed("fragment id");
+        at = archive_->values_ + archive_->fragmentOffsets_[fragment];
+        count = std::size_t(readVarint(at, end));
+        return at;
+    }
+    count = std::size_t(readVarint(at, end));
+    readVarint(at, end);
+    return at;
+}
+
+const std::uint8_t* RenderValue::skip(const std::uint8_t* at) const {
+    const std::uint8_t* end = archive_->values_ + archive_->valueBytes_;
+    if (at >= end) malformed("truncated value");
+    switch (*at++) {
+    case kNull:
+    case kFalse:
+    case kTrue: return at;
+    case kInteger:
+    case kNumber:
+    case kString:
+    case kTokens: readVarint(at, end); return at;
+    case kArray:
+    case kObject: {
+        readVarint(at, end);
+        std::uint64_t length = readVarint(at, end);
+        if (length > std::uint64_t(end - at)) malformed("container length");
+        return at + length;
+    }
+    }
+    malformed("tag");
+}
+
+const std::uint8_t* RenderValue::readToken(const std::uint8_t* at, RenderToken& token) const {
+    const std::uint8_t* end = archive_->values_ + archive_->valueBytes_;
+    std::uint64_t header = readVarint(at, end);
+    std::uint64_t code = header >> 1;
+    if (code >= kTokenKindCount) malformed("token kind");
+    token.kind = code == 0 ? archive_->string(archive_->checkedString(readVarint(at, end))) : kTokenKinds[code];
+    token.text = archive_->string(archive_->checkedString(readVarint(at, end)));
+    token.preciseIdentifier = {};
+    token.hasPreciseIdentifier = (header & 1) != 0;
+    if (token.hasPreciseIdentifier) token.preciseIdentifier = archive_->string(archive_->checkedString(readVarint(at, end)));
+    return at;
+}
+
+RenderValue RenderValue::get(std::string_view key) const {
+    if (type() != Type::Object) return {};
+    std::size_t count = 0;
+    const std::uint8_t* at = payload(count);
+    const std::uint8_t* end = archive_->values_ + archive_->valueBytes_;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (archive_->string(archive_->checkedString(readVarint(at, end))) == key) return RenderValue(archive_, at);
+        at = skip(at);
+    }
+    return {};
+}
+
+void RenderValue::appendJson(std::string& out) const {
+    switch (type()) {
+    case Type::Null: out += "null"; break;
+    case Type::Bool: out += boolean() ? "true" : "false"; break;
+    case Type::Integer: out += std::to_string(integer()); break;
+    case Type::Number: out += text(); break;
+    case Type::String: appendJsonString(out, text()); break;
+    case Type::Array: {
+        out += '[';
+        bool first = true;
+        forEachElement([&](const RenderValue& element) {
+            if (!first) out += ',';
+            first = false;
+            element.appendJson(out);
+        });
+        out += ']';
+        break;
+    }
+    case Type::Object: {
+        out += '{';
+        bool first = true;
+        forEachMember([&](std::string_view key, const RenderValue& value) {
+            if (!first) out += ',';
+            first = false;
+            appendJsonString(out, key, false);
+            out += ':';
+            value.appendJson(out);
+        });
+        out += '}';
+        break;
+    }
+    case Type::Tokens: {
+        out += '[';
+        bool first = true;
+        forEachToken([&](const RenderToken& token) {
+            if (!first) out += ',';
+            first = false;
+            out += "{\"kind\":";
+            appendJsonString(out, token.kind);
+            out += ",\"text\":";
+            appendJsonString(out, token.text);
+            if (token.hasPreciseIdentifier) {
+                out += ",\"preciseIdentifier\":";
+                appendJsonString(out, token.preciseIdentifier);
+            }
+            out += '}';
+        });
+        out += ']';
+        break;
+    }
+    }
+}
+
+} // namespace manual
@@ -0,0 +1,201 @@
+//
+//  render_archive.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/arena.h"
+#include "common/json.h"
+
+namespace manual {
+
+/// 선언 토큰 하나(`{"kind":…,"text":…,"preciseIdentifier":…}`).
+struct RenderToken {
+    std::string_view kind;
+    std::string_view text;
+    std::string_view preciseIdentifier;
+    bool hasPreciseIdentifier = false;
+};
+
+class RenderArchive;
+
+/// 아카이브 안의 값 하나를 가리키는 커서. 풀지 않고 필요한 만큼만 읽으며 할당하지 않는다.
+class RenderValue {
+public:
+    /// `Tokens`는 선언 토큰 배열을 따로 압축한 것이다. JSON으로는 객체 배열이다.
+    enum class Type : std::uint8_t { Null, Bool, Integer, Number, String, Array, Object, Tokens };
+
+    RenderValue() = default;
+    RenderValue(const RenderArchive* archive, const std::uint8_t* at) : archive_(archive), at_(at) {}
+
+    bool valid() const { return at_ != nullptr; }
+    Type type() const;
+    bool boolean() const;
+    std::int64_t integer() const;
+    /// String의 내용 또는 Number의 원문.
+    std::string_view text() const;
+    /// 배열, 객체, 토큰 배열의 항목 수.
+    std::size_t size() const;
+
+    /// 객체에서 `key`의 값. 없으면 `valid()`가 거짓인 값.
+    RenderValue get(std::string_view key) const;
+
+    template <class Body>
+    void forEachElement(Body&& body) const;
+    template <class Body>
+    void forEachMember(Body&& body) const;
+    template <class Body>
+    void forEachToken(Body&& body) const;
+
+    /// 원래 JSON과 같은 바이트를 `out` 뒤에 붙인다.
+    void appendJson(std::string& out) const;
+
+private:
+    /// 값의 첫 바이트. 커서가 값 영역 밖이면 `std::runtime_error`를 던진다.
+    std::uint8_t tag() const;
+    const std::uint8_t* payload(std::size_t& count) const;
+    const std::uint8_t* skip(const std::uint8_t* at) const;
+    const std::uint8_t* readToken(const std::uint8_t* at, RenderToken& token) const;
+
+    const RenderArchive* archive_ = nullptr;
+    const std::uint8_t* at_ = nullptr;
+};
+
+/// 여러 렌더 JSON을 한 아카이브로 묶는다.
+///
+/// 모든 문서가 문자열 표 하나를 같이 쓰고, 자주 나오는 문자열일수록 작은 번호(1바이트 varint)를 받는다.
+/// 선언 토큰 배열은 내용으로 주소를 매긴 조각 저장소에 한 번만 두고, 문서는 조각 번호로 가리킨다.
+/// 키 순서와 숫자 원문을 보존하므로 `RenderValue::appendJson`은 원래 파일과 같은 바이트를 낸다.
+class RenderArchiveBuilder {
+public:
+    /// `json`을 복사해 파싱해 둔다. 형식이 맞지 않으면 `std::runtime_error`를 던진다.
+    void add(std::string_view name, std::string_view json);
+    std::size_t size() const { return documents_.size(); }
+    std::string serialize() const;
+
+private:
+    struct Document {
+        std::string_view name;
+        JsonValue root;
+    };
+
+    Arena arena_{1 << 20};
+    std::vector<Document> documents_;
+};
+
+/// 직렬화한 아카이브를 복사 없이 읽는다.
+class RenderArchive {
+public:
+    /// `bytes`는 아카이브보다 오래 살아 있어야 한다. 형식이 맞지 않으면 `std::runtime_error`를 던진다.
+    explicit RenderArchive(std::string_view bytes);
+
+    std::size_t size() const { return documentCount_; }
+    std::size_t stringCount() const { return stringCount_; }
+    /// 서로 다른 토큰 배열의 수. 같은 선언 조각은 문서가 몇 개든 한 번만 저장한다.
+    std::size_t fragmentCount() const { return fragmentCount_; }
+    /// 조각 내용(종류, 텍스트, USR)의 64비트 해시. 아카이브가 달라도 같은 조각이면 같다.
+    std::uint64_t fragmentHash(std::size_t fragment) const;
+    std::string_view name(std::size_t document) const;
+    RenderValue root(std::size_t document) const;
+    /// 이름으로 문서를 찾는다. 없으면 `size()`.
+    std::size_t find(std::string_view name) const;
+
+    std::string_view string(std::uint32_t id) const {
+        return {strings_ + stringOffsets_[id], stringOffsets_[id + 1] - stringOffsets_[id]};
+    }
+    std::uint32_t checkedString(std::uint64_t id) const;
+
+private:
+    friend class RenderValue;
+
+    std::size_t documentCount_ = 0;
+    std::size_t stringCount_ = 0;
+    const std::uint32_t* stringOffsets_ = nullptr;
+    const char* strings_ = nullptr;
+    std::size_t fragmentCount_ = 0;
+    const std::uint32_t* fragmentOffsets_ = nullptr;   // 값 영역 안의 조각 위치
+    const std::uint64_t* fragmentHashes_ = nullptr;
+    const std::uint32_t* documents_ = nullptr;         // 문서마다 (이름 번호, 값 위치)
+    const std::uint8_t* values_ = nullptr;             // 조각들 뒤에 문서 값들이 온다
+    std::size_t valueBytes_ = 0;
+};
+
+// MARK: - 인코딩 세부
+
+namespace render_encoding {
+
+enum Tag : std::uint8_t {
+    kNull,
+    kFalse,
+    kTrue,
+    kInteger,   // 지그재그 varint
+    kNumber,    // 원문의 문자열 번호
+    kString,
+    kArray,     // 개수, 바이트 길이, 항목들
+    kObject,    // 개수, 바이트 길이, (키 번호, 값)들
+    kTokens,    // 조각 번호. 조각은 개수, 토큰들이다.
+};
+
+/// 토큰 종류 번호. 0은 문자열 표에서 이름을 따로 읽는다.
+constexpr std::string_view kTokenKinds[] = {
+    "",       "keyword", "identifier", "typeIdentifier", "externalParam", "internalParam", "text",
+    "genericParameter", "attribute", "number", "string", "label",
+};
+constexpr std::size_t kTokenKindCount = sizeof(kTokenKinds) / sizeof(kTokenKinds[0]);
+
+inline std::uint64_t readVarint(const std::uint8_t*& at, const std::uint8_t* end) {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; at < end && shift < 64; shift += 7) {
+        std::uint8_t byte = *at++;
+        value |= std::uint64_t(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return value;
+    }
+    throw std::runtime_error("malformed render archive: varint");
+}
+
+} // namespace render_encoding
+
+template <class Body>
+void RenderValue::forEachElement(Body&& body) const {
+    if (type() != Type::Array) return;
+    std::size_t count = 0;
+    const std::uint8_t* at = payload(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        body(RenderValue(archive_, at));
+        at = skip(at);
+    }
+}
+
+template <class Body>
+void RenderValue::forEachMember(Body&& body) const {
+    if (type() != Type::Object) return;
+    std::size_t count = 0;
+    const std::uint8_t* at = payload(count);
+    const std::uint8_t* end = archive_->values_ + archive_->valueBytes_;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string_view key = archive_->string(archive_->checkedString(render_encoding::readVarint(at, end)));
+        body(key, RenderValue(archive_, at));
+        at = skip(at);
+    }
+}
+
+template <class Body>
+void RenderValue::forEachToken(Body&& body) const {
+    if (type() != Type::Tokens) return;
+    std::size_t count = 0;
+    const std::uint8_t* at = payload(count);
+    RenderToken token;
+    for (std::size_t i = 0; i < count; ++i) {
+        at = readToken(at, token);
+        body(token);
+    }
+}
+
+} // namespace manual
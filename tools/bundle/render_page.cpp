@@ -0,0 +1,538 @@
+//
+//  render_page.cpp
+//  swiftUIManual tools
+//
+
+#include "bundle/render_page.h"
+
+#include <initializer_list>
+
+#include "common/json_writer.h"
+
+namespace manual {
+
+namespace {
+
+constexpr std::string_view kPlatformKeys[RenderPlatform::FieldCount] = {
+    "name", "introducedAt", "deprecatedAt", "message", "renamed", "beta", "unavailable", "deprecated",
+};
+
+constexpr std::string_view kReferenceKeys[RenderReference::FieldCount] = {
+    "role", "title", "identifier", "kind", "type", "url", "fragments", "navigatorTitle", "abstract", "deprecated",
+};
+
+constexpr std::string_view kMetadataKeys[RenderMetadata::FieldCount] = {
+    "role", "title", "roleHeading", "symbolKind", "externalID", "extendedModule",
+    "modules", "fragments", "navigatorTitle", "platforms",
+};
+
+template <std::size_t N>
+int fieldIndex(const std::string_view (&keys)[N], std::string_view key) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (keys[i] == key) return int(i);
+    }
+    return -1;
+}
+
+/// 객체의 키가 정확히 `keys` 순서인지.
+bool hasKeys(const JsonValue& value, std::initializer_list<std::string_view> keys) {
+    if (!value.isObject() || value.members.size() != keys.size()) return false;
+    std::size_t i = 0;
+    for (std::string_view key : keys) {
+        if (value.members[i++].key != key) return false;
+    }
+    return true;
+}
+
+std::uint32_t offset(std::size_t size) { return std::uint32_t(size); }
+
+} // namespace
+
+// MARK: - 읽기
+
+RenderPage::Mark RenderPage::mark() const {
+    return {tokens_.size(),   strings_.size(),   declarations_.size(), sections_.size(),
+            variants_.size(), platforms_.size(), inlines_.size(),      references_.size()};
+}
+
+void RenderPage::rollback(const Mark& mark) {
+    tokens_.resize(mark.tokens);
+    strings_.resize(mark.strings);
+    declarations_.resize(mark.declarations);
+    sections_.resize(mark.sections);
+    variants_.resize(mark.variants);
+    platforms_.resize(mark.platforms);
+    inlines_.resize(mark.inlines);
+    references_.resize(mark.references);
+}
+
+void RenderPage::read(const JsonValue& root) {
+    members_.clear();
+    tokens_.clear();
+    strings_.clear();
+    declarations_.clear();
+    sections_.clear();
+    variants_.clear();
+    platforms_.clear();
+    inlines_.clear();
+    references_.clear();
+    rawRoot_ = nullptr;
+    if (!root.isObject()) {
+        rawRoot_ = &root;
+        return;
+    }
+    for (const auto& member : root.members) {
+        Kind kind = Kind::Raw;
+        Mark before = mark();
+        bool typed = false;
+        if (member.key == "references") {
+            kind = Kind::References;
+            typed = readReferences(member.value);
+        } else if (member.key == "abstract") {
+            kind = Kind::Abstract;
+            typed = readInlines(member.value, abstract_);
+        } else if (member.key == "primaryContentSections") {
+            kind = Kind::PrimaryContentSections;
+            typed = readSections(member.value);
+        } else if (member.key == "variants") {
+            kind = Kind::Variants;
+            typed = readVariants(member.value);
+        } else if (member.key == "identifier") {
+            kind = Kind::Identifier;
+            typed = readIdentifier(member.value);
+        } else if (member.key == "metadata") {
+            kind = Kind::Metadata;
+            typed = readMetadata(member.value);
+        }
+        if (!typed) {
+            rollback(before);
+            kind = Kind::Raw;
+        }
+        members_.push_back({kind, member.key, &member.value});
+    }
+}
+
+std::size_t RenderPage::typedMemberCount() const {
+    std::size_t count = 0;
+    for (const auto& member : members_) count += member.kind != Kind::Raw;
+    return count;
+}
+
+bool RenderPage::readTokens(const JsonValue& value, RenderRange& range) {
+    if (!value.isArray()) return false;
+    range.begin = offset(tokens_.size());
+    for (const auto& element : value.elements) {
+        if (!element.isObject() || (element.members.size() != 2 && element.members.size() != 3)) return false;
+        const auto& members = element.members;
+        if (members[0].key != "kind" || !members[0].value.isString()) return false;
+        if (members[1].key != "text" || !members[1].value.isString()) return false;
+        RenderToken token;
+        token.kind = members[0].value.text;
+        token.text = members[1].value.text;
+        if (members.size() == 3) {
+            if (members[2].key != "preciseIdentifier" || !members[2].value.isString()) return false;
+            token.preciseIdentifier = members[2].value.text;
+            token.hasPreciseIdentifier = true;
+        }
+        tokens_.push_back(token);
+    }
+    range.count = offset(tokens_.size()) - range.begin;
+    return true;
+}
+
+bool RenderPage::readStrings(const JsonValue& value, RenderRange& range) {
+    if (!value.isArray()) return false;
+    range.begin = offset(strings_.size());
+    for (const auto& element : value.elements) {
+        if (!element.isString()) return false;
+        strings_.push_back(element.text);
+    }
+    range.count = offset(strings_.size()) - range.begin;
+    return true;
+}
+
+bool RenderPage::readInlines(const JsonValue& value, RenderRange& range) {
+    if (!value.isArray()) return false;
+    range.begin = offset(inlines_.size());
+    for (const auto& element : value.elements) {
+        if (!element.isObject() || element.members.size() != 2) return false;
+        const auto& members = element.members;
+        if (members[0].key != "type" || !members[1].value.isString()) return false;
+        RenderInline item;
+        if (members[0].value.text == "text" && members[1].key == "text") {
+            item.kind = RenderInline::Text;
+        } else if (members[0].value.text == "code" && members[1].key == "code") {
+            item.kind = RenderInline::Code;
+        } else {
+            return false;
+        }
+        item.text = members[1].value.text;
+        inlines_.push_back(item);
+    }
+    range.count = offset(inlines_.size()) - range.begin;
+    return true;
+}
+
+bool RenderPage::readReferences(const JsonValue& value) {
+    if (!value.isObject()) return false;
+    references_.reserve(value.members.size());
+    for (const auto& member : value.members) {
+        Mark before = mark();
+        Reference reference{member.key, nullptr, {}};
+        if (!readReference(member.value, reference.typed)) {
+            rollback(before);
+            reference.raw = &member.value;
+        }
+        references_.push_back(reference);
+    }
+    return true;
+}
+
+bool RenderPage::readReference(const JsonValue& value, RenderReference& reference) {
+    if (!value.isObject() || value.members.size() > RenderReference::FieldCount) return false;
+    for (const auto& member : value.members) {
+        int field = fieldIndex(kReferenceKeys, member.key);
+        if (field < 0) return false;
+        for (std::uint8_t i = 0; i < reference.fieldCount; ++i) {
+            if (reference.order[i] == field) return false;
+        }
+        reference.order[reference.fieldCount++] = std::uint8_t(field);
+        if (field < RenderReference::kStringFields) {
+            if (!member.value.isString()) return false;
+            reference.strings[field] = member.value.text;
+            continue;
+        }
+        switch (field) {
+        case RenderReference::Fragments:
+            if (!readTokens(member.value, reference.fragments)) return false;
+            break;
+        case RenderReference::NavigatorTitle:
+            if (!readTokens(member.value, reference.navigatorTitle)) return false;
+            break;
+        case RenderReference::Abstract:
+            if (!readInlines(member.value, reference.abstract)) return false;
+            break;
+        case RenderReference::Deprecated:
+            if (member.value.type != JsonValue::Type::Bool) return false;
+            reference.deprecated = member.value.boolean;
+            break;
+        }
+    }
+    return true;
+}
+
+bool RenderPage::readSections(const JsonValue& value) {
+    if (!value.isArray()) return false;
+    for (const auto& section : value.elements) {
+        if (!hasKeys(section, {"kind", "declarations"}) || section.members[0].value.text != "declarations" ||
+            !section.members[1].value.isArray()) {
+            sections_.push_back({{}, &section});
+            continue;
+        }
+        Section typed{{offset(declarations_.size()), 0}, nullptr};
+        for (const auto& declaration : section.members[1].value.elements) {
+            if (!hasKeys(declaration, {"tokens", "languages", "platforms"})) return false;
+            RenderDeclaration decl;
+            if (!readTokens(declaration.members[0].value, decl.tokens) ||
+                !readStrings(declaration.members[1].value, decl.languages) ||
+                !readStrings(declaration.members[2].value, decl.platforms)) {
+                return false;
+            }
+            declarations_.push_back(decl);
+        }
+        typed.declarations.count = offset(declarations_.size()) - typed.declarations.begin;
+        sections_.push_back(typed);
+    }
+    return true;
+}
+
+bool RenderPage::readVariants(const JsonValue& value) {
+    if (!value.isArray()) return false;
+    for (const auto& variant : value.elements) {
+        if (!hasKeys(variant, {"paths", "traits"}) || !variant.members[1].value.isArray()) return false;
+        Variant typed;
+        if (!readStrings(variant.members[0].value, typed.paths)) return false;
+        typed.traits.begin = offset(strings_.size());
+        for (const auto& trait : variant.members[1].value.elements) {
+            if (!hasKeys(trait, {"interfaceLanguage"}) || !trait.members[0].value.isString()) return false;
+            strings_.push_back(trait.members[0].value.text);
+        }
+        typed.traits.count = offset(strings_.size()) - typed.traits.begin;
+        variants_.push_back(typed);
+    }
+    return true;
+}
+
+bool RenderPage::readIdentifier(const JsonValue& value) {
+    if (!hasKeys(value, {"url", "interfaceLanguage"})) return false;
+    if (!value.members[0].value.isString() || !value.members[1].value.isString()) return false;
+    identifierUrl_ = value.members[0].value.text;
+    identifierLanguage_ = value.members[1].value.text;
+    return true;
+}
+
+bool RenderPage::readPlatform(const JsonValue& value, RenderPlatform& platform) {
+    if (!value.isObject() || value.members.size() > RenderPlatform::FieldCount) return false;
+    platform = RenderPlatform{};
+    for (const auto& member : value.members) {
+        int field = fieldIndex(kPlatformKeys, member.key);
+        if (field < 0) return false;
+        if (field < RenderPlatform::kStringFields) {
+            if (!member.value.isString()) return false;
+            platform.strings[field] = member.value.text;
+        } else {
+            if (member.value.type != JsonValue::Type::Bool) return false;
+            platform.flags[field - RenderPlatform::kStringFields] = member.value.boolean;
+        }
+        for (std::uint8_t i = 0; i < platform.fieldCount; ++i) {
+            if (platform.order[i] == field) return false;   // 중복 키
+        }
+        platform.order[platform.fieldCount++] = std::uint8_t(field);
+    }
+    return true;
+}
+
+bool RenderPage::readMetadata(const JsonValue& value) {
+    if (!value.isObject() || value.members.size() > RenderMetadata::FieldCount) return false;
+    RenderMetadata& metadata = metadata_;
+    metadata = RenderMetadata{};
+    for (const auto& member : value.members) {
+        int field = fieldIndex(kMetadataKeys, member.key);
+        if (field < 0) return false;
+        for (std::uint8_t i = 0; i < metadata.fieldCount; ++i) {
+            if (metadata.order[i] == field) return false;
+        }
+        metadata.order[metadata.fieldCount++] = std::uint8_t(field);
+        if (field < RenderMetadata::kStringFields) {
+            if (!member.value.isString()) return false;
+            metadata.strings[field] = member.value.text;
+            continue;
+        }
+        switch (field) {
+        case RenderMetadata::Modules:
+            if (!member.value.isArray()) return false;
+            metadata.modules.begin = offset(strings_.size());
+            for (const auto& module : member.value.elements) {
+                if (!hasKeys(module, {"name"}) || !module.members[0].value.isString()) return false;
+                strings_.push_back(module.members[0].value.text);
+            }
+            metadata.modules.count = offset(strings_.size()) - metadata.modules.begin;
+            break;
+        case RenderMetadata::Fragments:
+            if (!readTokens(member.value, metadata.fragments)) return false;
+            break;
+        case RenderMetadata::NavigatorTitle:
+            if (!readTokens(member.value, metadata.navigatorTitle)) return false;
+            break;
+        case RenderMetadata::Platforms:
+            if (!member.value.isArray()) return false;
+            metadata.platforms.begin = offset(platforms_.size());
+            for (const auto& element : member.value.elements) {
+                RenderPlatform platform;
+                if (!readPlatform(element, platform)) return false;
+                platforms_.push_back(platform);
+            }
+            metadata.platforms.count = offset(platforms_.size()) - metadata.platforms.begin;
+            break;
+        }
+    }
+    return true;
+}
+
+// MARK: - 쓰기
+
+namespace {
+
+/// 아래 쓰기 함수들은 키가 상수인 구간을 통째로 붙이고, 문자열 값만 이스케이프한다.
+void writeStrings(JsonWriter& writer, const std::vector<std::string_view>& strings, RenderRange range) {
+    std::string& out = writer.valueBuffer();
+    out += '[';
+    for (std::uint32_t i = 0; i < range.count; ++i) {
+        if (i != 0) out += ',';
+        appendJsonString(out, strings[range.begin + i]);
+    }
+    out += ']';
+}
+
+void writeTokens(JsonWriter& writer, const std::vector<RenderToken>& tokens, RenderRange range) {
+    std::string& out = writer.valueBuffer();
+    out += '[';
+    for (std::uint32_t i = 0; i < range.count; ++i) {
+        const RenderToken& token = tokens[range.begin + i];
+        out += i == 0 ? "{\"kind\":" : ",{\"kind\":";
+        appendJsonString(out, token.kind);
+        out += ",\"text\":";
+        appendJsonString(out, token.text);
+        if (token.hasPreciseIdentifier) {
+            out += ",\"preciseIdentifier\":";
+            appendJsonString(out, token.preciseIdentifier);
+        }
+        out += '}';
+    }
+    out += ']';
+}
+
+void writeInlines(JsonWriter& writer, const std::vector<RenderInline>& inlines, RenderRange range) {
+    std::string& out = writer.valueBuffer();
+    out += '[';
+    for (std::uint32_t i = 0; i < range.count; ++i) {
+        const RenderInline& item = inlines[range.begin + i];
+        if (i != 0) out += ',';
+        out += item.kind == RenderInline::Code ? "{\"type\":\"code\",\"code\":" : "{\"type\":\"text\",\"text\":";
+        appendJsonString(out, item.text);
+        out += '}';
+    }
+    out += ']';
+}
+
+void writePlatform(JsonWriter& writer, const RenderPlatform& platform) {
+    writer.beginObject();
+    for (std::uint8_t i = 0; i < platform.fieldCount; ++i) {
+        std::uint8_t field = platform.order[i];
+        writer.key(kPlatformKeys[field]);
+        if (field < RenderPlatform::kStringFields) {
+            writer.string(platform.strings[field]);
+        } else {
+            writer.boolean(platform.flags[field - RenderPlatform::kStringFields]);
+        }
+    }
+    writer.endObject();
+}
+
+} // namespace
+
+void RenderPage::writeReference(JsonWriter& writer, const RenderReference& reference) const {
+    writer.beginObject();
+    for (std::uint8_t i = 0; i < reference.fieldCount; ++i) {
+        std::uint8_t field = reference.order[i];
+        writer.key(kReferenceKeys[field]);
+        if (field < RenderReference::kStringFields) {
+            writer.string(reference.strings[field]);
+            continue;
+        }
+        switch (field) {
+        case RenderReference::Fragments: writeTokens(writer, tokens_, reference.fragments); break;
+        case RenderReference::NavigatorTitle: writeTokens(writer, tokens_, reference.navigatorTitle); break;
+        case RenderReference::Abstract: writeInlines(writer, inlines_, reference.abstract); break;
+        case RenderReference::Deprecated: writer.boolean(reference.deprecated); break;
+        }
+    }
+    writer.endObject();
+}
+
+void RenderPage::write(std::string& out) const {
+    JsonWriter writer(out);
+    if (rawRoot_ != nullptr) {
+        writer.value(*rawRoot_);
+        return;
+    }
+    writer.beginObject();
+    for (const auto& member : members_) {
+        writer.key(member.key);
+        switch (member.kind) {
+        case Kind::Raw: writer.value(*member.raw); break;
+        case Kind::References:
+            writer.beginObject();
+            for (const auto& reference : references_) {
+                writer.key(reference.key);
+                if (reference.raw != nullptr) {
+                    writer.value(*reference.raw);
+                } else {
+                    writeReference(writer, reference.typed);
+                }
+            }
+            writer.endObject();
+            break;
+        case Kind::Abstract: writeInlines(writer, inlines_, abstract_); break;
+        case Kind::PrimaryContentSections:
+            writer.beginArray();
+            for (const auto& section : sections_) {
+                if (section.raw != nullptr) {
+                    writer.value(*section.raw);
+                    continue;
+                }
+                writer.beginObject();
+                writer.field("kind", "declarations");
+                writer.key("declarations");
+                writer.beginArray();
+                for (std::uint32_t i = 0; i < section.declarations.count; ++i) {
+                    const RenderDeclaration& declaration = declarations_[section.declarations.begin + i];
+                    writer.beginObject();
+                    writer.key("tokens");
+                    writeTokens(writer, tokens_, declaration.tokens);
+                    writer.key("languages");
+                    writeStrings(writer, strings_, declaration.languages);
+                    writer.key("platforms");
+                    writeStrings(writer, strings_, declaration.platforms);
+                    writer.endObject();
+                }
+                writer.endArray();
+                writer.endObject();
+            }
+            writer.endArray();
+            break;
+        case Kind::Variants:
+            writer.beginArray();
+            for (const auto& variant : variants_) {
+                writer.beginObject();
+                writer.key("paths");
+                writeStrings(writer, strings_, variant.paths);
+                writer.key("traits");
+                std::string& traits = writer.valueBuffer();
+                traits += '[';
+                for (std::uint32_t i = 0; i < variant.traits.count; ++i) {
+                    traits += i == 0 ? "{\"interfaceLanguage\":" : ",{\"interfaceLanguage\":";
+                    appendJsonString(traits, strings_[variant.traits.begin + i]);
+                    traits += '}';
+                }
+                traits += ']';
+                writer.endObject();
+            }
+            writer.endArray();
+            break;
+        case Kind::Identifier:
+            writer.beginObject();
+            writer.field("url", identifierUrl_);
+            writer.field("interfaceLanguage", identifierLanguage_);
+            writer.endObject();
+            break;
+        case Kind::Metadata:
+            writer.beginObject();
+            for (std::uint8_t i = 0; i < metadata_.fieldCount; ++i) {
+                std::uint8_t field = metadata_.order[i];
+                writer.key(kMetadataKeys[field]);
+                if (field < RenderMetadata::kStringFields) {
+                    writer.string(metadata_.strings[field]);
+                    continue;
+                }
+                switch (field) {
+                case RenderMetadata::Modules: {
+                    std::string& modules = writer.valueBuffer();
+                    modules += '[';
+                    for (std::uint32_t m = 0; m < metadata_.modules.count; ++m) {
+                        modules += m == 0 ? "{\"name\":" : ",{\"name\":";
+                        appendJsonString(modules, strings_[metadata_.modules.begin + m]);
+                        modules += '}';
+                    }
+                    modules += ']';
+                    break;
+                }
+                case RenderMetadata::Fragments: writeTokens(writer, tokens_, metadata_.fragments); break;
+                case RenderMetadata::NavigatorTitle: writeTokens(writer, tokens_, metadata_.navigatorTitle); break;
+                case RenderMetadata::Platforms:
+                    writer.beginArray();
+                    for (std::uint32_t p = 0; p < metadata_.platforms.count; ++p) {
+                        writePlatform(writer, platforms_[metadata_.platforms.begin + p]);
+                    }
+                    writer.endArray();
+                    break;
+                }
+            }
+            writer.endObject();
+            break;
+        }
+    }
+    writer.endObject();
+}
+
+} // namespace manual
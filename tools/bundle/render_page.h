@@ -0,0 +1,164 @@
+//
+//  render_page.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bundle/render_archive.h"
+#include "common/json.h"
+
+namespace manual {
+
+class JsonWriter;
+
+/// 페이지의 평평한 배열 안에서 연속한 구간.
+struct RenderRange {
+    std::uint32_t begin = 0;
+    std::uint32_t count = 0;
+};
+
+/// 선언부 하나(`{"tokens":…,"languages":…,"platforms":…}`).
+struct RenderDeclaration {
+    RenderRange tokens;
+    RenderRange languages;
+    RenderRange platforms;
+};
+
+/// `metadata.platforms`의 항목. DocC가 사전으로 인코딩하므로 키 순서가 항목마다 달라 읽은 순서를 기억한다.
+struct RenderPlatform {
+    enum Field : std::uint8_t {
+        Name, IntroducedAt, DeprecatedAt, Message, Renamed,   // 문자열
+        Beta, Unavailable, Deprecated,                        // 불리언
+        FieldCount
+    };
+    static constexpr int kStringFields = Beta;
+
+    std::string_view strings[kStringFields];
+    bool flags[FieldCount - kStringFields] = {};
+    std::uint8_t order[FieldCount] = {};
+    std::uint8_t fieldCount = 0;
+};
+
+/// 페이지의 `metadata`. 역시 키 순서가 페이지마다 다르다.
+struct RenderMetadata {
+    enum Field : std::uint8_t {
+        Role, Title, RoleHeading, SymbolKind, ExternalID, ExtendedModule,   // 문자열
+        Modules, Fragments, NavigatorTitle, Platforms,
+        FieldCount
+    };
+    static constexpr int kStringFields = Modules;
+
+    std::string_view strings[kStringFields];
+    RenderRange modules;          // 모듈 이름
+    RenderRange fragments;        // 토큰
+    RenderRange navigatorTitle;   // 토큰
+    RenderRange platforms;
+    std::uint8_t order[FieldCount] = {};
+    std::uint8_t fieldCount = 0;
+};
+
+/// 인라인 내용 하나(`{"type":"text","text":…}` 또는 `{"type":"code","code":…}`).
+struct RenderInline {
+    enum Kind : std::uint8_t { Text, Code };
+    Kind kind = Text;
+    std::string_view text;
+};
+
+/// `references`의 항목. 키가 빠지거나 순서가 다른 경우가 있어 `RenderMetadata`처럼 읽은 순서를 기억한다.
+struct RenderReference {
+    enum Field : std::uint8_t {
+        Role, Title, Identifier, Kind, Type, Url,   // 문자열
+        Fragments, NavigatorTitle,                  // 토큰
+        Abstract, Deprecated,
+        FieldCount
+    };
+    static constexpr int kStringFields = Fragments;
+
+    std::string_view strings[kStringFields];
+    RenderRange fragments;
+    RenderRange navigatorTitle;
+    RenderRange abstract;   // 인라인 내용
+    bool deprecated = false;
+    std::uint8_t order[FieldCount] = {};
+    std::uint8_t fieldCount = 0;
+};
+
+/// DocC 렌더 JSON 한 페이지를 스키마에 맞춰 읽고 쓴다.
+///
+/// `references`, `abstract`, `primaryContentSections`, `variants`, `identifier`, `metadata`는 타입이 있는 구조로
+/// 풀어 쓰기 전용 코드가 키를 상수로 내보내고, 나머지 멤버(`hierarchy` 등)와 스키마를 벗어난 값은 파싱한 값을
+/// 그대로 쓴다. `references`는 항목 단위로 되돌리므로 모양이 다른 항목 하나 때문에 전체가 범용 경로로 가지 않는다.
+/// 어느 쪽이든 결과는 원래 파일과 같은 바이트다. 페이지 객체를 재사용하면 배열 용량이 남아 할당이 없다.
+class RenderPage {
+public:
+    /// `root`를 읽는다. 페이지는 `root`(와 그 아레나)보다 오래 쓸 수 없다.
+    void read(const JsonValue& root);
+    /// 페이지를 `out` 뒤에 붙인다.
+    void write(std::string& out) const;
+
+    /// 타입 있는 구조로 읽은 최상위 멤버 수.
+    std::size_t typedMemberCount() const;
+    std::size_t memberCount() const { return members_.size(); }
+
+private:
+    enum class Kind : std::uint8_t { Raw, References, Abstract, PrimaryContentSections, Variants, Identifier, Metadata };
+
+    struct Member {
+        Kind kind;
+        std::string_view key;
+        const JsonValue* raw;
+    };
+    struct Section {
+        RenderRange declarations;
+        const JsonValue* raw;   // `declarations`가 아닌 구역
+    };
+    struct Variant {
+        RenderRange paths;
+        RenderRange traits;   // 인터페이스 언어
+    };
+    struct Reference {
+        std::string_view key;
+        const JsonValue* raw;   // 스키마를 벗어난 항목
+        RenderReference typed;
+    };
+    struct Mark {
+        std::size_t tokens, strings, declarations, sections, variants, platforms, inlines, references;
+    };
+
+    Mark mark() const;
+    void rollback(const Mark& mark);
+    bool readTokens(const JsonValue& value, RenderRange& range);
+    bool readStrings(const JsonValue& value, RenderRange& range);
+    bool readInlines(const JsonValue& value, RenderRange& range);
+    bool readReferences(const JsonValue& value);
+    bool readReference(const JsonValue& value, RenderReference& reference);
+    bool readSections(const JsonValue& value);
+    bool readVariants(const JsonValue& value);
+    bool readIdentifier(const JsonValue& value);
+    bool readMetadata(const JsonValue& value);
+    bool readPlatform(const JsonValue& value, RenderPlatform& platform);
+    void writeReference(JsonWriter& writer, const RenderReference& reference) const;
+
+    const JsonValue* rawRoot_ = nullptr;   // 객체가 아닌 최상위 값
+    std::vector<Member> members_;
+    std::vector<RenderToken> tokens_;
+    std::vector<std::string_view> strings_;
+    std::vector<RenderDeclaration> declarations_;
+    std::vector<Section> sections_;
+    std::vector<Variant> variants_;
+    std::vector<RenderPlatform> platforms_;
+    std::vector<RenderInline> inlines_;
+    std::vector<Reference> references_;
+    RenderRange abstract_;
+    std::string_view identifierUrl_;
+    std::string_view identifierLanguage_;
+    RenderMetadata metadata_;
+};
+
+} // namespace manual
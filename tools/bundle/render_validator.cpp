@@ -0,0 +1,507 @@
+//
+//  render_validator.cpp
+//  swiftUIManual tools
+//
+
+#include "bundle/render_validator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "common/arena.h"
+#include "common/json.h"
+#include "common/mapped_file.h"
+#include "common/thread_pool.h"
+
+namespace fs = std::filesystem;
+
+namespace manual {
+
+namespace {
+
+constexpr std::string_view kIssueKindNames[] = {"syntax", "schema", "reference", "precise-identifier", "variant-path"};
+constexpr std::string_view kPageKinds[] = {"symbol", "article", "tutorial", "overview", "section"};
+constexpr std::string_view kSynthesized = "::SYNTHESIZED::";
+constexpr std::size_t kPagesPerTask = 32;
+
+/// 다른 페이지를 봐야 확인할 수 있는 연결 하나.
+struct PendingLink {
+    RenderIssueKind kind;
+    std::string pointer;
+    std::string target;
+};
+
+/// 한 페이지를 읽고 남긴 것. 문제 목록과, 모든 페이지를 읽은 뒤 확인할 연결들.
+struct PageReport {
+    std::string path;
+    std::uint64_t bytes = 0;
+    std::string externalId;
+    std::vector<RenderIssue> issues;
+    std::vector<PendingLink> links;
+};
+
+/// 페이지 하나를 검사한다. JSON Pointer는 값을 내려갈 때 덧붙이고 올라올 때 잘라 내므로 문제가 없으면 할당이 없다.
+class PageChecker {
+public:
+    explicit PageChecker(PageReport& report) : report_(report) {}
+
+    void check(const JsonValue& root) {
+        if (!root.isObject()) return issue(RenderIssueKind::Schema, "top level is not an object");
+
+        checkSchemaVersion(root.get("schemaVersion"));
+        const JsonValue* kind = member(root, "kind", JsonValue::Type::String);
+        if (kind != nullptr && std::find(std::begin(kPageKinds), std::end(kPageKinds), kind->text) == std::end(kPageKinds)) {
+            issue(RenderIssueKind::Schema, "/kind", "unknown page kind \"" + std::string(kind->text) + "\"");
+        }
+        if (const JsonValue* identifier = member(root, "identifier", JsonValue::Type::Object)) {
+            Scope scope(*this, "identifier");
+            const JsonValue* url = member(*identifier, "url", JsonValue::Type::String);
+            if (url != nullptr && url->text.compare(0, 6, "doc://") != 0) issue(RenderIssueKind::Schema, "/url", "not a doc:// URL");
+            member(*identifier, "interfaceLanguage", JsonValue::Type::String);
+        }
+
+        references_ = member(root, "references", JsonValue::Type::Object);
+        if (references_ != nullptr) checkReferences(*references_);
+        if (const JsonValue* metadata = member(root, "metadata", JsonValue::Type::Object)) checkMetadata(*metadata);
+        if (const JsonValue* hierarchy = member(root, "hierarchy", JsonValue::Type::Object)) {
+            Scope scope(*this, "hierarchy");
+            if (const JsonValue* paths = optionalMember(*hierarchy, "paths", JsonValue::Type::Array)) {
+                Scope inner(*this, "paths");
+                forEach(*paths, [this](const JsonValue& path) {
+                    if (!expect(path, JsonValue::Type::Array)) return;
+                    forEach(path, [this](const JsonValue& identifier) { checkIdentifier(identifier); });
+                });
+            }
+        }
+        member(root, "sections", JsonValue::Type::Array);
+        if (const JsonValue* variants = member(root, "variants", JsonValue::Type::Array)) checkVariants(*variants);
+        if (const JsonValue* sections = optionalMember(root, "primaryContentSections", JsonValue::Type::Array)) {
+            Scope scope(*this, "primaryContentSections");
+            forEach(*sections, [this](const JsonValue& section) { checkContentSection(section); });
+        }
+        for (const char* name : {"topicSections", "seeAlsoSections", "relationshipsSections"}) {
+            if (const JsonValue* sections = optionalMember(root, name, JsonValue::Type::Array)) {
+                Scope scope(*this, name);
+                forEach(*sections, [this](const JsonValue& section) { checkTaskGroup(section); });
+            }
+        }
+
+        // 나머지 본문(요약, 폐기 안내, 토픽 참조 안의 요약까지)에 나오는 인라인 참조를 훑는다.
+        for (const JsonMember& field : root.members) {
+            if (field.key == "primaryContentSections" || field.key == "hierarchy") continue;
+            Scope scope(*this, field.key);
+            checkInlineReferences(field.value);
+        }
+    }
+
+private:
+    /// `pointer_`에 한 단계를 덧붙였다가 끝날 때 되돌린다.
+    class Scope {
+    public:
+        Scope(PageChecker& checker, std::string_view token) : checker_(checker), mark_(checker.pointer_.size()) {
+            checker.pointer_ += '/';
+            for (char c : token) {
+                if (c == '~') checker.pointer_ += "~0";
+                else if (c == '/') checker.pointer_ += "~1";
+                else checker.pointer_ += c;
+            }
+        }
+        Scope(PageChecker& checker, std::size_t index) : checker_(checker), mark_(checker.pointer_.size()) {
+            checker.pointer_ += '/';
+            checker.pointer_ += std::to_string(index);
+        }
+        ~Scope() { checker_.pointer_.resize(mark_); }
+
+    private:
+        PageChecker& checker_;
+        std::size_t mark_;
+    };
+
+    void issue(RenderIssueKind kind, std::string message) { issue(kind, "", std::move(message)); }
+    void issue(RenderIssueKind kind, std::string_view suffix, std::string message) {
+        report_.issues.push_back({kind, report_.path, pointer_ + std::string(suffix), std::move(message)});
+    }
+    void link(RenderIssueKind kind, std::string_view target) {
+        report_.links.push_back({kind, pointer_, std::string(target)});
+    }
+
+    static std::string_view typeName(JsonValue::Type type) {
+        constexpr std::string_view names[] = {"null", "boolean", "number", "string", "array", "object"};
+        return names[std::size_t(type)];
+    }
+
+    bool expect(const JsonValue& value, JsonValue::Type type) {
+        if (value.type == type) return true;
+        issue(RenderIssueKind::Schema, "expected " + std::string(typeName(type)) + ", found " + std::string(typeName(value.type)));
+        return false;
+    }
+
+    const JsonValue* optionalMember(const JsonValue& object, std::string_view key, JsonValue::Type type) {
+        const JsonValue* value = object.get(key);
+        if (value == nullptr) return nullptr;
+        Scope scope(*this, key);
+        return expect(*value, type) ? value : nullptr;
+    }
+
+    const JsonValue* member(const JsonValue& object, std::string_view key, JsonValue::Type type) {
+        if (object.get(key) == nullptr) {
+            issue(RenderIssueKind::Schema, "missing \"" + std::string(key) + "\"");
+            return nullptr;
+        }
+        return optionalMember(object, key, type);
+    }
+
+    template <class Body>
+    void forEach(const JsonValue& array, Body&& body) {
+        for (std::size_t i = 0; i < array.elements.size(); ++i) {
+            Scope scope(*this, i);
+            body(array.elements[i]);
+        }
+    }
+
+    void checkSchemaVersion(const JsonValue* version) {
+        if (version == nullptr) return issue(RenderIssueKind::Schema, "missing \"schemaVersion\"");
+        Scope scope(*this, "schemaVersion");
+        if (!expect(*version, JsonValue::Type::Object)) return;
+        std::string text;
+        for (const char* part : {"major", "minor", "patch"}) {
+            const JsonValue* number = member(*version, part, JsonValue::Type::Number);
+            if (number == nullptr) return;
+            if (!text.empty()) text += '.';
+            text += number->text;
+        }
+        if (text != "0.3.0") issue(RenderIssueKind::Schema, "schema version " + text + ", expected 0.3.0");
+    }
+
+    /// `references`의 키로 풀리는 식별자인지.
+    void checkIdentifier(const JsonValue& identifier) {
+        if (!expect(identifier, JsonValue::Type::String)) return;
+        if (references_ == nullptr || references_->get(identifier.text) == nullptr) {
+            issue(RenderIssueKind::Reference, "unresolved identifier " + std::string(identifier.text));
+        }
+    }
+
+    void checkReferences(const JsonValue& references) {
+        Scope scope(*this, "references");
+        for (const JsonMember& entry : references.members) {
+            Scope inner(*this, entry.key);
+            if (!expect(entry.value, JsonValue::Type::Object)) continue;
+            const JsonValue* type = member(entry.value, "type", JsonValue::Type::String);
+            if (type == nullptr || type->text != "topic") continue;
+            const JsonValue* identifier = member(entry.value, "identifier", JsonValue::Type::String);
+            if (identifier != nullptr && identifier->text != entry.key) {
+                issue(RenderIssueKind::Schema, "/identifier", "does not match its key");
+            }
+            member(entry.value, "title", JsonValue::Type::String);
+            member(entry.value, "kind", JsonValue::Type::String);
+            if (const JsonValue* url = member(entry.value, "url", JsonValue::Type::String)) {
+                // 번들 안의 문서 경로만 확인한다. 조각(`#…`)은 페이지 안의 위치라 떼어 낸다.
+                std::string_view target = url->text.substr(0, url->text.find('#'));
+                if (target.compare(0, 15, "/documentation/") == 0 || target.compare(0, 11, "/tutorials/") == 0) {
+                    Scope field(*this, "url");
+                    link(RenderIssueKind::Reference, target);
+                }
+            }
+        }
+    }
+
+    void checkMetadata(const JsonValue& metadata) {
+        Scope scope(*this, "metadata");
+        optionalMember(metadata, "title", JsonValue::Type::String);
+        if (const JsonValue* externalId = optionalMember(metadata, "externalID", JsonValue::Type::String)) {
+            report_.externalId = std::string(externalId->text);
+        }
+        if (const JsonValue* modules = optionalMember(metadata, "modules", JsonValue::Type::Array)) {
+            Scope inner(*this, "modules");
+            forEach(*modules, [this](const JsonValue& module) {
+                if (!expect(module, JsonValue::Type::Object)) return;
+                if (const JsonValue* name = member(module, "name", JsonValue::Type::String)) {
+                    // 이 모듈의 Swift USR 접두사: `s:13swiftUIManual`
+                    modulePrefixes_.push_back("s:" + std::to_string(name->text.size()) + std::string(name->text));
+                }
+            });
+        }
+        if (const JsonValue* platforms = optionalMember(metadata, "platforms", JsonValue::Type::Array)) {
+            Scope inner(*this, "platforms");
+            forEach(*platforms, [this](const JsonValue& platform) {
+                if (expect(platform, JsonValue::Type::Object)) member(platform, "name", JsonValue::Type::String);
+            });
+        }
+        if (const JsonValue* fragments = optionalMember(metadata, "fragments", JsonValue::Type::Array)) {
+            Scope inner(*this, "fragments");
+            forEach(*fragments, [this](const JsonValue& token) { checkToken(token); });
+        }
+    }
+
+    void checkVariants(const JsonValue& variants) {
+        Scope scope(*this, "variants");
+        bool self = false;
+        forEach(variants, [&](const JsonValue& variant) {
+            if (!expect(variant, JsonValue::Type::Object)) return;
+            member(variant, "traits", JsonValue::Type::Array);
+            const JsonValue* paths = member(variant, "paths", JsonValue::Type::Array);
+            if (paths == nullptr) return;
+            Scope inner(*this, "paths");
+            forEach(*paths, [&](const JsonValue& path) {
+                if (!expect(path, JsonValue::Type::String)) return;
+                if (path.text == report_.path) {
+                    self = true;
+                } else {
+                    link(RenderIssueKind::VariantPath, path.text);
+                }
+            });
+        });
+        if (!self) issue(RenderIssueKind::VariantPath, "no variant points back to " + report_.path);
+    }
+
+    void checkToken(const JsonValue& token) {
+        if (!expect(token, JsonValue::Type::Object)) return;
+        member(token, "kind", JsonValue::Type::String);
+        member(token, "text", JsonValue::Type::String);
+        if (const JsonValue* identifier = token.get("identifier")) {
+            Scope scope(*this, "identifier");
+            checkIdentifier(*identifier);
+        }
+        if (const JsonValue* usr = optionalMember(token, "preciseIdentifier", JsonValue::Type::String)) {
+            bool local = std::any_of(modulePrefixes_.begin(), modulePrefixes_.end(), [usr](const std::string& prefix) {
+                return usr->text.compare(0, prefix.size(), prefix) == 0;
+            });
+            if (local) {
+                Scope scope(*this, "preciseIdentifier");
+                link(RenderIssueKind::PreciseIdentifier, usr->text);
+            }
+        }
+    }
+
+    void checkContentSection(const JsonValue& section) {
+        if (!expect(section, JsonValue::Type::Object)) return;
+        const JsonValue* kind = member(section, "kind", JsonValue::Type::String);
+        if (kind != nullptr && kind->text == "declarations") {
+            const JsonValue* declarations = member(section, "declarations", JsonValue::Type::Array);
+            if (declarations == nullptr) return;
+            Scope scope(*this, "declarations");
+            forEach(*declarations, [this](const JsonValue& declaration) {
+                if (!expect(declaration, JsonValue::Type::Object)) return;
+                const JsonValue* tokens = member(declaration, "tokens", JsonValue::Type::Array);
+                if (tokens == nullptr) return;
+                Scope inner(*this, "tokens");
+                forEach(*tokens, [this](const JsonValue& token) { checkToken(token); });
+            });
+            return;
+        }
+        checkInlineReferences(section);
+    }
+
+    void checkTaskGroup(const JsonValue& group) {
+        if (!expect(group, JsonValue::Type::Object)) return;
+        const JsonValue* identifiers = member(group, "identifiers", JsonValue::Type::Array);
+        if (identifiers == nullptr) return;
+        Scope scope(*this, "identifiers");
+        forEach(*identifiers, [this](const JsonValue& identifier) { checkIdentifier(identifier); });
+    }
+
+    /// 인라인 내용의 `{"type":"reference","identifier":…}`를 찾아 확인한다.
+    void checkInlineReferences(const JsonValue& value) {
+        if (value.isArray()) {
+            forEach(value, [this](const JsonValue& element) { checkInlineReferences(element); });
+            return;
+        }
+        if (!value.isObject()) return;
+        const JsonValue* type = value.get("type");
+        if (type != nullptr && type->isString() && type->text == "reference") {
+            if (const JsonValue* identifier = member(value, "identifier", JsonValue::Type::String)) {
+                Scope scope(*this, "identifier");
+                checkIdentifier(*identifier);
+            }
+        }
+        for (const JsonMember& field : value.members) {
+            if (field.value.isArray() || field.value.isObject()) {
+                Scope scope(*this, field.key);
+                checkInlineReferences(field.value);
+            }
+        }
+    }
+
+    PageReport& report_;
+    std::string pointer_;
+    const JsonValue* references_ = nullptr;
+    std::vector<std::string> modulePrefixes_;
+};
+
+std::vector<fs::path> renderFiles(const std::string& dataDirectory) {
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::recursive_directory_iterator(dataDirectory)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+/// `data/documentation/x/y.json` → `/documentation/x/y`. 파일은 `dataDirectory`를 훑어 얻은 것이라
+/// 앞부분을 잘라 내기만 하면 된다(`fs::relative`는 경로 단계마다 `stat`을 부른다).
+std::string pagePath(const fs::path& file, const std::string& dataDirectory) {
+    std::string path = file.generic_string();
+    std::size_t skip = fs::path(dataDirectory).generic_string().size();
+    while (skip < path.size() && path[skip] == '/') ++skip;
+    return "/" + path.substr(skip, path.size() - skip - 5);
+}
+
+} // namespace
+
+std::string_view renderIssueKindName(RenderIssueKind kind) { return kIssueKindNames[std::size_t(kind)]; }
+
+std::size_t RenderValidation::issueCount() const {
+    std::size_t total = 0;
+    for (std::size_t count : counts) total += count;
+    return total;
+}
+
+RenderValidation validateRenderPages(const std::string& dataDirectory, ThreadPool& pool, std::size_t maxIssues) {
+    std::vector<fs::path> files = renderFiles(dataDirectory);
+    std::vector<PageReport> reports(files.size());
+
+    // 페이지 수십 개를 한 작업으로 묶어 아레나 하나를 돌려 쓴다.
+    pool.parallelFor((files.size() + kPagesPerTask - 1) / kPagesPerTask, [&](std::size_t task) {
+        Arena arena(1 << 16);
+        std::size_t end = std::min(files.size(), (task + 1) * kPagesPerTask);
+        for (std::size_t i = task * kPagesPerTask; i < end; ++i) {
+            PageReport& report = reports[i];
+            report.path = pagePath(files[i], dataDirectory);
+            MappedFile file(files[i].string());
+            report.bytes = file.size();
+            JsonValue root;
+            try {
+                root = parseJson(file.bytes(), arena);
+            } catch (const std::runtime_error& error) {
+                report.issues.push_back({RenderIssueKind::Syntax, report.path, "", error.what()});
+                arena.release();
+                continue;
+            }
+            PageChecker(report).check(root);
+            arena.release();
+        }
+    });
+
+    std::unordered_set<std::string_view> paths;
+    std::unordered_set<std::string_view> symbols;
+    paths.reserve(reports.size());
+    symbols.reserve(reports.size());
+    for (const PageReport& report : reports) {
+        paths.insert(report.path);
+        if (report.externalId.empty()) continue;
+        // 기본 구현 페이지(`…::SYNTHESIZED::…`)도 앞부분 USR로 찾을 수 있다.
+        std::string_view usr = report.externalId;
+        symbols.insert(usr);
+        symbols.insert(usr.substr(0, usr.find(kSynthesized)));
+    }
+
+    RenderValidation result;
+    result.pages = reports.size();
+    for (PageReport& report : reports) {
+        result.bytes += report.bytes;
+        for (PendingLink& link : report.links) {
+            bool resolved = link.kind == RenderIssueKind::PreciseIdentifier ? symbols.count(link.target) != 0
+                                                                            : paths.count(link.target) != 0;
+            if (resolved) continue;
+            std::string message = link.kind == RenderIssueKind::PreciseIdentifier ? "no symbol page for " : "no page at ";
+            report.issues.push_back({link.kind, report.path, std::move(link.pointer), message + link.target});
+        }
+        for (RenderIssue& issue : report.issues) {
+            ++result.counts[std::size_t(issue.kind)];
+            if (result.issues.size() < maxIssues) result.issues.push_back(std::move(issue));
+        }
+    }
+    return result;
+}
+
+RenderCorpusStats writeRenderCorpus(const std::string& dataDirectory, const std::string& outDirectory,
+                                    std::size_t pages, ThreadPool& pool) {
+    std::vector<fs::path> files = renderFiles(dataDirectory);
+    if (files.empty()) throw std::runtime_error("no render JSON under " + dataDirectory);
+    pages = (pages + files.size() - 1) / files.size() * files.size();
+
+    std::vector<std::string> sources(files.size());
+    std::vector<std::string> relative(files.size());
+    std::string module;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        MappedFile file(files[i].string());
+        sources[i] = std::string(file.bytes());
+        relative[i] = pagePath(files[i], dataDirectory).substr(1) + ".json";
+        if (module.empty()) {
+            Arena arena;
+            const JsonValue* metadata = parseJson(sources[i], arena).get("metadata");
+            const JsonValue* modules = metadata != nullptr ? metadata->get("modules") : nullptr;
+            if (modules != nullptr && modules->isArray() && modules->elements.size() > 0) {
+                const JsonValue* name = modules->elements[0].get("name");
+                if (name != nullptr && name->isString()) module = std::string(name->text);
+            }
+        }
+    }
+    if (module.empty()) throw std::runtime_error("cannot find the module name in " + dataDirectory);
+    std::string lower = module;
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+
+    // 복제본 `k`의 치환 목록. 같은 위치에서는 앞 항목이 먼저다(USR의 길이 접두사를 함께 바꾼다).
+    auto rename = [&](std::string_view text, std::size_t copy, std::string& out) {
+        std::string suffix = std::to_string(copy);
+        std::pair<std::string, std::string> patterns[] = {
+            {std::to_string(module.size()) + module, std::to_string(module.size() + suffix.size()) + module + suffix},
+            {module, module + suffix},
+            {lower, lower + suffix},
+        };
+        out.clear();
+        std::size_t at = 0;
+        while (at < text.size()) {
+            std::size_t next = std::string_view::npos;
+            const std::pair<std::string, std::string>* chosen = nullptr;
+            for (const auto& pattern : patterns) {
+                std::size_t found = text.find(pattern.first, at);
+                if (found < next) {
+                    next = found;
+                    chosen = &pattern;
+                }
+            }
+            if (chosen == nullptr) break;
+            out.append(text.data() + at, next - at);
+            out += chosen->second;
+            at = next + chosen->first.size();
+        }
+        out.append(text.data() + at, text.size() - at);
+    };
+
+    std::atomic<std::uint64_t> written{0};
+    std::mutex directories;
+    pool.parallelFor((pages + kPagesPerTask - 1) / kPagesPerTask, [&](std::size_t task) {
+        std::string name, bytes;
+        std::size_t end = std::min(pages, (task + 1) * kPagesPerTask);
+        for (std::size_t page = task * kPagesPerTask; page < end; ++page) {
+            std::size_t source = page % files.size();
+            std::size_t copy = page / files.size();
+            if (copy == 0) {
+                name = relative[source];
+                bytes = sources[source];
+            } else {
+                rename(relative[source], copy, name);
+                rename(sources[source], copy, bytes);
+            }
+            fs::path target = fs::path(outDirectory) / name;
+            {
+                std::lock_guard<std::mutex> lock(directories);
+                fs::create_directories(target.parent_path());
+            }
+            std::ofstream out(target, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), std::streamsize(bytes.size()));
+            if (!out) throw std::runtime_error("cannot write " + target.string());
+            written += bytes.size();
+        }
+    });
+    return {pages, written.load()};
+}
+
+} // namespace manual
@@ -0,0 +1,64 @@
+//
+//  render_validator.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace manual {
+
+class ThreadPool;
+
+enum class RenderIssueKind : std::uint8_t {
+    Syntax,               // JSON으로 읽을 수 없다
+    Schema,               // 렌더 스키마(0.3.0)와 맞지 않는 모양
+    Reference,            // `references`에 없는 식별자, 번들에 없는 `url`
+    PreciseIdentifier,    // 이 번들 모듈의 USR인데 그런 심벌 페이지가 없다
+    VariantPath,          // `variants.paths`가 가리키는 페이지가 없거나 자기 경로가 빠졌다
+    Count,
+};
+
+std::string_view renderIssueKindName(RenderIssueKind kind);
+
+struct RenderIssue {
+    RenderIssueKind kind;
+    std::string page;      // `/documentation/swiftuimanual/contentview`
+    std::string pointer;   // JSON Pointer(`/variants/0/paths/0`)
+    std::string message;
+};
+
+struct RenderValidation {
+    std::size_t pages = 0;
+    std::uint64_t bytes = 0;
+    std::size_t counts[std::size_t(RenderIssueKind::Count)] = {};
+    /// 페이지 경로, 문서 안 순서로 정렬한 문제 목록. `maxIssues`를 넘으면 개수만 센다.
+    std::vector<RenderIssue> issues;
+
+    std::size_t issueCount() const;
+};
+
+/// `dataDirectory`(`docs/data`) 아래 렌더 JSON을 모두 검사한다.
+///
+/// 페이지마다 스키마 모양, `references` 안에서 풀리는지를 작업 스레드에서 나눠 보고,
+/// 페이지 사이를 잇는 것(`variants.paths`, 토픽 참조의 `url`, 이 모듈의 `preciseIdentifier`)은
+/// 모든 페이지를 읽은 뒤 경로와 USR 집합으로 한 번에 확인한다.
+RenderValidation validateRenderPages(const std::string& dataDirectory, ThreadPool& pool,
+                                     std::size_t maxIssues = 1000);
+
+struct RenderCorpusStats {
+    std::size_t pages = 0;
+    std::uint64_t bytes = 0;
+};
+
+/// `dataDirectory`의 페이지를 모듈 이름만 바꿔 복제해 `pages`개 이상의 벤치마크 묶음을 `outDirectory`에 만든다.
+/// 복제본 `k`는 `swiftUIManual` → `swiftUIManual<k>`(USR 길이 접두사 포함)로 바꾸므로 자기 복제본 안에서만 서로를
+/// 가리킨다. 복제본이 중간에 끊기지 않도록 페이지 수를 원본 수의 배수로 올리므로, 원본이 검사를 통과하면 묶음도 통과한다.
+RenderCorpusStats writeRenderCorpus(const std::string& dataDirectory, const std::string& outDirectory,
+                                    std::size_t pages, ThreadPool& pool);
+
+} // namespace manual
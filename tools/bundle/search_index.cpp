@@ -0,0 +1,338 @@
+//
+//  search_index.cpp
+//  swiftUIManual tools
+//
+
+#include "bundle/search_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <unordered_map>
+
+#include "common/arena.h"
+#include "common/json.h"
+#include "common/mapped_file.h"
+
+namespace fs = std::filesystem;
+
+namespace manual {
+
+namespace {
+
+// MARK: - 색인어
+
+constexpr char32_t kHangulFirst = 0xAC00;
+constexpr char32_t kHangulLast = 0xD7A3;
+constexpr char32_t kJamoFirst = 0x3131;   // 호환 자모 ㄱ
+constexpr char32_t kJamoLast = 0x314E;    // ㅎ
+
+/// 초성 번호 → 호환 자모
+constexpr char32_t kInitials[19] = {
+    0x3131, 0x3132, 0x3134, 0x3137, 0x3138, 0x3139, 0x3141, 0x3142, 0x3143, 0x3145,
+    0x3146, 0x3147, 0x3148, 0x3149, 0x314A, 0x314B, 0x314C, 0x314D, 0x314E,
+};
+
+bool isHangul(char32_t c) { return c >= kHangulFirst && c <= kHangulLast; }
+bool isJamo(char32_t c) { return c >= kJamoFirst && c <= kJamoLast; }
+bool isWordByte(unsigned char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+bool isUpper(char c) { return c >= 'A' && c <= 'Z'; }
+bool isLower(char c) { return c >= 'a' && c <= 'z'; }
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+char32_t initialOf(char32_t syllable) { return kInitials[(syllable - kHangulFirst) / 588]; }
+
+void appendUtf8(std::string& out, char32_t c) {
+    if (c < 0x80) {
+        out += char(c);
+    } else if (c < 0x800) {
+        out += char(0xC0 | (c >> 6));
+        out += char(0x80 | (c & 0x3F));
+    } else {
+        out += char(0xE0 | (c >> 12));
+        out += char(0x80 | ((c >> 6) & 0x3F));
+        out += char(0x80 | (c & 0x3F));
+    }
+}
+
+/// UTF-8 한 글자를 읽는다. 잘못된 바이트는 U+FFFD로 읽고 한 바이트만 넘긴다.
+char32_t decodeUtf8(std::string_view text, std::size_t& at) {
+    auto byte = [&](std::size_t i) { return static_cast<unsigned char>(text[i]); };
+    unsigned char lead = byte(at);
+    std::size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+    if (length == 0 || at + length > text.size()) {
+        ++at;
+        return 0xFFFD;
+    }
+    char32_t c = length == 1 ? lead : lead & (0x7F >> length);
+    for (std::size_t i = 1; i < length; ++i) {
+        if ((byte(at + i) & 0xC0) != 0x80) {
+            ++at;
+            return 0xFFFD;
+        }
+        c = (c << 6) | (byte(at + i) & 0x3F);
+    }
+    at += length;
+    return c;
+}
+
+std::string lowercase(std::string_view word) {
+    std::string lower(word);
+    for (char& c : lower) {
+        if (isUpper(c)) c = char(c - 'A' + 'a');
+    }
+    return lower;
+}
+
+void addWord(std::string_view word, SearchTermMode mode, std::vector<std::string>& terms) {
+    std::string whole = lowercase(word);
+    std::size_t trimmed = whole.find_first_not_of('_');
+    if (trimmed == std::string::npos) return;
+    terms.push_back(whole);
+    if (mode == SearchTermMode::Query) return;
+
+    // 카멜 표기, 숫자, 밑줄 경계에서 나눈다. `URLSession`은 `url`, `session`이 된다.
+    std::vector<std::string_view> parts;
+    std::size_t start = 0;
+    auto cut = [&](std::size_t end) {
+        if (end > start) parts.push_back(word.substr(start, end - start));
+        start = end;
+    };
+    for (std::size_t i = 1; i < word.size(); ++i) {
+        char previous = word[i - 1], c = word[i];
+        if (c == '_') {
+            cut(i);
+            start = i + 1;
+        } else if (previous == '_') {
+            start = i;
+        } else if ((isLower(previous) && isUpper(c)) || (isDigit(previous) != isDigit(c)) ||
+                   (isUpper(previous) && isUpper(c) && i + 1 < word.size() && isLower(word[i + 1]))) {
+            cut(i);
+        }
+    }
+    if (start < word.size() && word[start] != '_') cut(word.size());
+    if (parts.size() < 2) return;
+    for (std::string_view part : parts) {
+        if (part.size() >= 2) terms.push_back(lowercase(part));
+    }
+}
+
+/// 음절(또는 초성) 구간을 2-gram으로 자른다. 한 글자 구간은 그대로 낸다.
+/// `unigrams`면 여러 글자 구간의 글자도 하나씩 낸다. 한 음절 질의(`뷰`)가 `뷰를`, `뷰는`에도 맞도록 색인에 쓴다.
+void addGrams(const std::vector<char32_t>& run, std::vector<std::string>& terms, bool unigrams = false) {
+    if (run.size() == 1 || unigrams) {
+        for (char32_t c : run) {
+            terms.emplace_back();
+            appendUtf8(terms.back(), c);
+        }
+    }
+    if (run.size() == 1) return;
+    for (std::size_t i = 0; i + 1 < run.size(); ++i) {
+        terms.emplace_back();
+        appendUtf8(terms.back(), run[i]);
+        appendUtf8(terms.back(), run[i + 1]);
+    }
+}
+
+// MARK: - 렌더 JSON에서 글 모으기
+
+constexpr std::uint16_t kTitleWeight = 4;
+constexpr std::uint16_t kAbstractWeight = 2;
+constexpr std::uint16_t kBodyWeight = 1;
+
+struct DocumentTerms {
+    std::vector<std::string> scratch;
+    std::unordered_map<std::string, std::uint32_t> frequencies;
+    float length = 0;
+
+    void add(std::string_view text, std::uint16_t weight) {
+        scratch.clear();
+        searchTerms(text, SearchTermMode::Index, scratch);
+        for (auto& term : scratch) frequencies[std::move(term)] += weight;
+        length += float(scratch.size()) * weight;
+    }
+
+    /// 인라인 내용과 본문 블록에서 `text`와 `code` 문자열만 골라 색인한다(참조 식별자는 빼고).
+    void addInline(const JsonValue& value, std::uint16_t weight) {
+        if (value.isArray()) {
+            for (const auto& element : value.elements) addInline(element, weight);
+        } else if (value.isObject()) {
+            for (const auto& member : value.members) {
+                if ((member.key == "text" || member.key == "code") && member.value.isString()) {
+                    add(member.value.text, weight);
+                } else {
+                    addInline(member.value, weight);
+                }
+            }
+        }
+    }
+};
+
+} // namespace
+
+void searchTerms(std::string_view text, SearchTermMode mode, std::vector<std::string>& terms) {
+    std::vector<char32_t> syllables, initials, jamo;
+    auto flushHangul = [&] {
+        if (!syllables.empty()) {
+            addGrams(syllables, terms, mode == SearchTermMode::Index);
+            if (mode == SearchTermMode::Index) addGrams(initials, terms);
+        }
+        if (!jamo.empty()) addGrams(jamo, terms);
+        syllables.clear();
+        initials.clear();
+        jamo.clear();
+    };
+
+    std::size_t at = 0;
+    while (at < text.size()) {
+        auto lead = static_cast<unsigned char>(text[at]);
+        if (isWordByte(lead)) {
+            flushHangul();
+            std::size_t end = at;
+            while (end < text.size() && isWordByte(static_cast<unsigned char>(text[end]))) ++end;
+            addWord(text.substr(at, end - at), mode, terms);
+            at = end;
+            continue;
+        }
+        char32_t c = decodeUtf8(text, at);
+        if (isHangul(c)) {
+            if (!jamo.empty()) flushHangul();
+            syllables.push_back(c);
+            initials.push_back(initialOf(c));
+        } else if (isJamo(c)) {
+            if (!syllables.empty()) flushHangul();
+            jamo.push_back(c);
+        } else {
+            flushHangul();
+        }
+    }
+    flushHangul();
+}
+
+// MARK: - 색인
+
+SearchIndex SearchIndex::build(const std::string& dataDirectory) {
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::recursive_directory_iterator(dataDirectory)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    SearchIndex index;
+    std::unordered_map<std::string, std::vector<std::pair<std::uint32_t, std::uint16_t>>> postings;
+    DocumentTerms document;
+    double totalLength = 0;
+    for (const auto& path : files) {
+        Arena arena(1 << 16);
+        MappedFile file(path.string());
+        JsonValue root = parseJson(file.bytes(), arena);
+
+        std::string webPath;
+        if (const JsonValue* variants = root.get("variants"); variants && variants->isArray() && variants->elements.size() > 0) {
+            const JsonValue* paths = variants->elements[0].get("paths");
+            if (paths && paths->isArray() && paths->elements.size() > 0 && paths->elements[0].isString()) {
+                webPath = std::string(paths->elements[0].text);
+            }
+        }
+        if (webPath.empty()) continue;   // 페이지가 아닌 JSON
+        const JsonValue* metadata = root.get("metadata");
+        const JsonValue* title = metadata ? metadata->get("title") : nullptr;
+
+        document.frequencies.clear();
+        document.length = 0;
+        if (title && title->isString()) document.add(title->text, kTitleWeight);
+        if (const JsonValue* abstract = root.get("abstract")) document.addInline(*abstract, kAbstractWeight);
+        if (const JsonValue* summary = root.get("deprecationSummary")) document.addInline(*summary, kBodyWeight);
+        if (const JsonValue* sections = root.get("primaryContentSections"); sections && sections->isArray()) {
+            for (const auto& section : sections->elements) {
+                const JsonValue* declarations = section.get("declarations");
+                if (declarations == nullptr) {
+                    document.addInline(section, kBodyWeight);
+                    continue;
+                }
+                if (!declarations->isArray()) continue;
+                for (const auto& declaration : declarations->elements) {
+                    const JsonValue* tokens = declaration.get("tokens");
+                    if (tokens == nullptr || !tokens->isArray()) continue;
+                    std::string source;
+                    for (const auto& token : tokens->elements) {
+                        if (const JsonValue* text = token.get("text"); text && text->isString()) source += text->text;
+                    }
+                    document.add(source, kBodyWeight);
+                }
+            }
+        }
+
+        auto id = std::uint32_t(index.paths_.size());
+        index.paths_.push_back(std::move(webPath));
+        index.titles_.emplace_back(title && title->isString() ? title->text : std::string_view());
+        index.lengths_.push_back(document.length);
+        totalLength += document.length;
+        for (auto& [term, frequency] : document.frequencies) {
+            postings[term].emplace_back(id, std::uint16_t(std::min<std::uint32_t>(frequency, 0xFFFF)));
+        }
+    }
+    index.averageLength_ = index.paths_.empty() ? 0 : float(totalLength / double(index.paths_.size()));
+
+    index.terms_.reserve(postings.size());
+    for (const auto& entry : postings) index.terms_.push_back(entry.first);
+    std::sort(index.terms_.begin(), index.terms_.end());
+    for (const auto& term : index.terms_) {
+        index.postingBegin_.push_back(std::uint32_t(index.postingDocuments_.size()));
+        for (const auto& [document, frequency] : postings[term]) {
+            index.postingDocuments_.push_back(document);
+            index.postingFrequencies_.push_back(frequency);
+        }
+    }
+    index.postingBegin_.push_back(std::uint32_t(index.postingDocuments_.size()));
+    return index;
+}
+
+void SearchIndex::addScores(std::size_t term, float weight, std::vector<float>& scores) const {
+    constexpr float k1 = 1.2f, b = 0.75f;
+    std::uint32_t begin = postingBegin_[term], end = postingBegin_[term + 1];
+    float documents = float(paths_.size());
+    float frequency = float(end - begin);
+    float idf = std::log(1.0f + (documents - frequency + 0.5f) / (frequency + 0.5f));
+    for (std::uint32_t i = begin; i < end; ++i) {
+        std::uint32_t document = postingDocuments_[i];
+        float tf = postingFrequencies_[i];
+        float norm = k1 * (1.0f - b + b * lengths_[document] / averageLength_);
+        scores[document] += weight * idf * tf * (k1 + 1.0f) / (tf + norm);
+    }
+}
+
+void SearchIndex::search(std::string_view query, std::size_t limit, std::vector<SearchHit>& hits) const {
+    hits.clear();
+    std::vector<std::string> terms;
+    searchTerms(query, SearchTermMode::Query, terms);
+    if (terms.empty() || paths_.empty()) return;
+
+    std::vector<float> scores(paths_.size(), 0.0f);
+    for (const auto& term : terms) {
+        auto found = std::lower_bound(terms_.begin(), terms_.end(), term);
+        if (found != terms_.end() && *found == term) addScores(std::size_t(found - terms_.begin()), 1.0f, scores);
+    }
+    // 입력 중인 마지막 영문 단어는 접두어로도 찾되 점수를 반만 준다.
+    bool typing = isWordByte(static_cast<unsigned char>(query.back()));
+    const std::string& last = terms.back();
+    if (typing && isWordByte(static_cast<unsigned char>(last[0]))) {
+        constexpr std::size_t kMaxExpansions = 64;
+        auto it = std::upper_bound(terms_.begin(), terms_.end(), last);
+        for (std::size_t expanded = 0;
+             it != terms_.end() && expanded < kMaxExpansions && it->compare(0, last.size(), last) == 0; ++it, ++expanded) {
+            addScores(std::size_t(it - terms_.begin()), 0.5f, scores);
+        }
+    }
+
+    for (std::uint32_t document = 0; document < scores.size(); ++document) {
+        if (scores[document] > 0) hits.push_back({document, scores[document]});
+    }
+    std::size_t count = std::min(limit, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + std::ptrdiff_t(count), hits.end(), [](const SearchHit& a, const SearchHit& b) {
+        return a.score != b.score ? a.score > b.score : a.document < b.document;
+    });
+    hits.resize(count);
+}
+
+} // namespace manual
@@ -0,0 +1,63 @@
+//
+//  search_index.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace manual {
+
+enum class SearchTermMode : std::uint8_t { Index, Query };
+
+/// 글을 색인어로 나눠 `terms` 뒤에 붙인다.
+///
+/// - 영문과 숫자는 소문자로 한 단어를 만든다. 색인할 때는 `navigationTitle`, `URLSession`, `foo_bar`의
+///   카멜 표기와 밑줄 경계도 나눠 부분 단어를 함께 내므로, `title`로 `navigationTitle`을 찾는다.
+/// - 한글 음절은 이어진 구간마다 2음절씩 겹쳐 자른다(한 음절짜리는 그대로). 색인할 때는 음절 하나하나와
+///   같은 구간의 초성 2-gram도 내므로, 한 음절 질의 `뷰`가 `뷰를`에 맞는다. `ㅅㅇ`처럼 자모만 친 질의는 초성 2-gram이 된다.
+void searchTerms(std::string_view text, SearchTermMode mode, std::vector<std::string>& terms);
+
+struct SearchHit {
+    std::uint32_t document;
+    float score;
+};
+
+/// `docs/data`의 렌더 JSON으로 만드는 메모리 내 역색인. 순위는 BM25로 매긴다.
+///
+/// 제목, 요약, 본문(`primaryContentSections`의 문단과 제목), 폐기 안내, 선언 토큰을 색인하며,
+/// 필드마다 단어 빈도에 가중치를 곱한다. 만든 뒤에는 읽기만 하므로 여러 스레드가 함께 질의해도 된다.
+class SearchIndex {
+public:
+    /// `dataDirectory` 아래 렌더 JSON을 모두 읽는다. 형식이 맞지 않으면 `std::runtime_error`를 던진다.
+    static SearchIndex build(const std::string& dataDirectory);
+
+    /// 점수가 높은 순으로 최대 `limit`개를 `hits`에 채운다. 마지막 영문 색인어는 접두어로도 찾는다.
+    void search(std::string_view query, std::size_t limit, std::vector<SearchHit>& hits) const;
+
+    std::size_t documentCount() const { return paths_.size(); }
+    std::size_t termCount() const { return terms_.size(); }
+    std::size_t postingCount() const { return postingDocuments_.size(); }
+    /// `/documentation/swiftuimanual/contentview/searchable(text:placement:prompt:)` 같은 웹 경로.
+    const std::string& path(std::uint32_t document) const { return paths_[document]; }
+    const std::string& title(std::uint32_t document) const { return titles_[document]; }
+
+private:
+    void addScores(std::size_t term, float weight, std::vector<float>& scores) const;
+
+    std::vector<std::string> paths_;
+    std::vector<std::string> titles_;
+    std::vector<float> lengths_;   // 가중한 색인어 수
+    float averageLength_ = 0;
+
+    std::vector<std::string> terms_;            // 정렬됨
+    std::vector<std::uint32_t> postingBegin_;   // 색인어마다 게시 목록 시작, 끝에 하나 더
+    std::vector<std::uint32_t> postingDocuments_;
+    std::vector<std::uint16_t> postingFrequencies_;   // 가중한 빈도
+};
+
+} // namespace manual
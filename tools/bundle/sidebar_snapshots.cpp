@@ -0,0 +1,183 @@
+//
+//  sidebar_snapshots.cpp
+//  swiftUIManual tools
+//
+
+#include "bundle/sidebar_snapshots.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "bundle/documentation_lookup.h"
+#include "common/bplist.h"
+#include "common/hash.h"
+#include "common/json_writer.h"
+#include "interface/availability_index.h"
+
+namespace manual {
+
+namespace {
+
+constexpr const char* kAvailabilityDatabase = "availability";
+constexpr int kMaxDepth = 64;   // bplist와 같은 상한. 실제 사이드바는 열 단계를 넘지 않는다
+
+std::uint64_t loadU64(const char* bytes) {
+    std::uint64_t value;
+    std::memcpy(&value, bytes, sizeof value);
+    return value;
+}
+
+void setBit(std::vector<std::uint64_t>& bits, std::uint32_t index) {
+    bits[index / 64] |= std::uint64_t(1) << (index % 64);
+}
+
+bool testBit(const std::uint64_t* bits, std::size_t index) {
+    return (bits[index / 64] >> (index % 64) & 1) != 0;
+}
+
+/// 노드마다 `availability.index`의 행 번호 목록(CSR). 목록이 비면 가용성 정보가 없는 노드다.
+struct NodeRows {
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> rows;
+};
+
+NodeRows readNodeRows(const DocumentationLookup& lookup, const AvailabilityIndex& index) {
+    std::unordered_map<std::uint64_t, std::uint32_t> rowOfId;
+    for (std::size_t row = 0; row < index.rowCount(); ++row) {
+        std::string_view name = index.name(row);
+        std::uint64_t id = 0;
+        auto [end, error] = std::from_chars(name.data(), name.data() + name.size(), id);
+        if (error != std::errc() || end != name.data() + name.size()) {
+            throw std::runtime_error("availability index has a row name that is not a number");
+        }
+        rowOfId.emplace(id, std::uint32_t(row));
+    }
+
+    const NavigatorIndex& navigator = lookup.navigator();
+    LmdbTransaction transaction = lookup.environment().begin();
+    LmdbDatabase database;
+    if (!transaction.open(kAvailabilityDatabase, database)) {
+        throw std::runtime_error("data.mdb has no availability database");
+    }
+
+    NodeRows result;
+    result.offsets.reserve(navigator.size() + 1);
+    result.offsets.push_back(0);
+    for (std::uint32_t node = 0; node < navigator.size(); ++node) {
+        // 키와 값은 DocC가 쓴 그대로 리틀 엔디언 UInt64다. 0번은 빈 목록이다.
+        std::uint64_t id = navigator[node].availabilityId;
+        std::string_view value;
+        if (id != 0 && transaction.get(database, std::string_view(reinterpret_cast<const char*>(&id), sizeof id), value)) {
+            for (std::size_t at = 0; at + 8 <= value.size(); at += 8) {
+                auto found = rowOfId.find(loadU64(value.data() + at));
+                if (found != rowOfId.end()) result.rows.push_back(found->second);
+            }
+        }
+        result.offsets.push_back(std::uint32_t(result.rows.size()));
+    }
+    return result;
+}
+
+/// `available`(행 비트 집합)로 보이는 노드를 `visible`에 켠다. `available`이 없으면 모든 노드가 보인다.
+void markVisible(const NavigatorIndex& navigator, const NodeRows& nodeRows, const std::uint64_t* available,
+                 std::uint32_t node, int depth, std::vector<std::uint64_t>& visible) {
+    if (depth > kMaxDepth) throw std::runtime_error("navigator index is nested too deeply");
+    setBit(visible, node);
+    std::uint32_t pendingMarker = kNoNode;
+    for (std::uint32_t child : navigator.children(node)) {
+        // 묶음 표식은 다음 표식 전까지 보이는 형제가 있을 때만 남긴다.
+        if (navigator[child].pageType == NavigatorPageType::GroupMarker) {
+            pendingMarker = child;
+            continue;
+        }
+        bool shown = available == nullptr || nodeRows.offsets[child] == nodeRows.offsets[child + 1];
+        for (std::uint32_t at = nodeRows.offsets[child]; !shown && at < nodeRows.offsets[child + 1]; ++at) {
+            shown = testBit(available, nodeRows.rows[at]);
+        }
+        if (!shown) continue;
+        if (pendingMarker != kNoNode) {
+            setBit(visible, pendingMarker);
+            pendingMarker = kNoNode;
+        }
+        markVisible(navigator, nodeRows, available, child, depth + 1, visible);
+    }
+}
+
+} // namespace
+
+SidebarSnapshots SidebarSnapshots::build(const std::string& indexDirectory) {
+    DocumentationLookup lookup(indexDirectory);
+    MappedFile plist(indexDirectory + "/availability.index");
+    AvailabilityIndexBuilder builder;
+    builder.importBundleIndex(parseBinaryPlist(plist.bytes()));
+    std::string serialized = builder.serialize();
+    AvailabilityIndex index(serialized);
+    NodeRows nodeRows = readNodeRows(lookup, index);
+    const NavigatorIndex& navigator = lookup.navigator();
+
+    SidebarSnapshots result;
+    result.nodeCount_ = navigator.size();
+    std::map<std::vector<std::uint64_t>, std::uint32_t> byVisible;
+    std::vector<std::uint64_t> visible;
+    std::string bytes;
+    auto snapshotFor = [&](const std::uint64_t* available) {
+        visible.assign((navigator.size() + 63) / 64, 0);
+        markVisible(navigator, nodeRows, available, 0, 0, visible);
+        auto [found, inserted] = byVisible.emplace(visible, std::uint32_t(result.snapshots_.size()));
+        if (inserted) {
+            navigator.renderIndexJson(bytes, visible.data());
+            char name[32];
+            std::snprintf(name, sizeof name, "sidebar.%08x.json", unsigned(fnv1a(bytes) & 0xFFFFFFFFu));
+            std::size_t nodes = 0;
+            for (std::uint64_t word : visible) nodes += std::size_t(__builtin_popcountll(word));
+            result.snapshots_.push_back({name, bytes, nodes});
+        }
+        return found->second;
+    };
+
+    // 0번은 거르지 않은 트리다.
+    snapshotFor(nullptr);
+    for (std::size_t p = 0; p < kPlatformCount; ++p) {
+        auto platform = Platform(p);
+        Span<const std::uint64_t> versions = index.versions(platform);
+        if (versions.size() <= 1) continue;   // 이 플랫폼 정보가 없다
+        // 앞 경계와 결과가 같은 경계는 적지 않는다. 클라이언트는 고른 버전 이하의 마지막 항목을 쓴다.
+        std::uint32_t previous = kNoNode;
+        for (std::size_t v = 0; v < versions.size(); ++v) {
+            Version version = index.version(platform, std::uint8_t(v));
+            std::uint32_t snapshot = snapshotFor(index.availableAt(platform, version));
+            if (snapshot != previous) result.filters_.push_back({platform, version, snapshot});
+            previous = snapshot;
+        }
+    }
+    return result;
+}
+
+std::string SidebarSnapshots::manifest() const {
+    std::string out;
+    JsonWriter writer(out);
+    writer.beginObject();
+    writer.field("all", snapshots_[0].name);
+    writer.key("platforms");
+    writer.beginObject();
+    for (std::size_t i = 0; i < filters_.size(); ++i) {
+        const SidebarFilter& filter = filters_[i];
+        if (i == 0 || filters_[i - 1].platform != filter.platform) {
+            if (i != 0) writer.endObject();
+            writer.key(platformName(filter.platform));
+            writer.beginObject();
+        }
+        writer.key(filter.version.string());
+        writer.string(snapshots_[filter.snapshot].name);
+    }
+    if (!filters_.empty()) writer.endObject();
+    writer.endObject();
+    writer.endObject();
+    return out;
+}
+
+} // namespace manual
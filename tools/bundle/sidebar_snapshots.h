@@ -0,0 +1,55 @@
+//
+//  sidebar_snapshots.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "interface/availability.h"
+
+namespace manual {
+
+/// 플랫폼 필터 하나로 거른 사이드바 트리. 바이트는 `index.json`과 같은 형식이다.
+struct SidebarSnapshot {
+    std::string name;    // `sidebar.1a2b3c4d.json`. 이름의 해시는 내용 해시라 영구 캐시해도 된다.
+    std::string bytes;
+    std::size_t nodes = 0;   // 남은 노드 수
+};
+
+/// 플랫폼·버전 필터와 그 결과 스냅숏.
+struct SidebarFilter {
+    Platform platform;
+    Version version;
+    std::uint32_t snapshot;
+};
+
+/// `availability.index`에 나오는 플랫폼·버전 조합마다 사이드바 트리를 미리 걸러 둔다.
+///
+/// 노드마다 `data.mdb`의 `availability` 표에서 가용성 번호 목록을 읽고, `AvailabilityIndex`의 버전 경계별
+/// 비트 집합으로 보이는 노드를 고른다. 남는 노드 집합이 같은 필터는 같은 스냅숏을 가리키므로,
+/// 필터를 바꾸는 클라이언트는 트리를 다시 훑지 않고 캐시된 파일 하나를 받는다.
+class SidebarSnapshots {
+public:
+    /// `indexDirectory`(`docs/index`)의 `navigator.index`, `data.mdb`, `availability.index`로 만든다.
+    /// 파일이 없거나 형식이 다르면 예외를 던진다.
+    static SidebarSnapshots build(const std::string& indexDirectory);
+
+    const std::vector<SidebarSnapshot>& snapshots() const { return snapshots_; }
+    const std::vector<SidebarFilter>& filters() const { return filters_; }
+    std::size_t nodeCount() const { return nodeCount_; }
+
+    /// `{"all":"sidebar.….json","platforms":{"iOS":{"0.0":…,"13.0":"sidebar.1a2b3c4d.json"},…}}`.
+    /// 클라이언트는 고른 플랫폼에서 고른 버전 이하의 마지막 항목을 받는다.
+    std::string manifest() const;
+
+private:
+    std::vector<SidebarSnapshot> snapshots_;
+    std::vector<SidebarFilter> filters_;
+    std::size_t nodeCount_ = 0;
+};
+
+} // namespace manual
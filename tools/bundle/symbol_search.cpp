@@ -0,0 +1,375 @@
+//
+//  symbol_search.cpp
+//  swiftUIManual tools
+//
+
+#include "bundle/symbol_search.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+
+#include "bundle/search_index.h"
+#include "common/arena.h"
+#include "common/json.h"
+#include "common/mapped_file.h"
+
+namespace fs = std::filesystem;
+
+namespace manual {
+
+// MARK: - 편집 거리
+
+EditDistance::EditDistance(std::string_view pattern) {
+    length_ = std::min<std::size_t>(pattern.size(), 64);
+    for (std::size_t i = 0; i < length_; ++i) masks_[static_cast<unsigned char>(pattern[i])] |= std::uint64_t(1) << i;
+}
+
+/// Myers(1999)의 비트 병렬 알고리즘을 전역 편집 거리로 쓴 것(Hyyrö). 열마다 단어 연산 몇 번이다.
+std::size_t EditDistance::operator()(std::string_view text) const {
+    if (length_ == 0) return text.size();
+    std::uint64_t positive = ~std::uint64_t(0), negative = 0;
+    const std::uint64_t last = std::uint64_t(1) << (length_ - 1);
+    std::size_t score = length_;
+    for (unsigned char c : text) {
+        std::uint64_t equal = masks_[c];
+        std::uint64_t xv = equal | negative;
+        std::uint64_t xh = (((equal & positive) + positive) ^ positive) | equal;
+        std::uint64_t ph = negative | ~(xh | positive);
+        std::uint64_t mh = positive & xh;
+        if (ph & last) ++score;
+        else if (mh & last) --score;
+        ph = (ph << 1) | 1;   // 첫 행은 D[0][j] = j
+        mh <<= 1;
+        positive = mh | ~(xv | ph);
+        negative = ph & xv;
+    }
+    return score;
+}
+
+namespace {
+
+std::string lowercase(std::string_view text) {
+    std::string lower(text);
+    for (char& c : lower) {
+        if (c >= 'A' && c <= 'Z') c = char(c - 'A' + 'a');
+    }
+    return lower;
+}
+
+/// 질의 낱말 하나와 색인 낱말의 닮은 정도(0~1).
+float wordScore(std::string_view query, const EditDistance& distance, std::string_view word) {
+    if (word == query) return 1.0f;
+    if (query.size() >= 3 && word.size() > query.size() && word.compare(0, query.size(), query) == 0) return 0.85f;
+    std::size_t allowed = query.size() <= 3 ? 0 : query.size() <= 6 ? 1 : 2;
+    if (allowed == 0 || word.size() + allowed < query.size() || word.size() > query.size() + allowed) return 0.0f;
+    std::size_t edits = distance(word);
+    return edits <= allowed ? 1.0f - 0.15f * float(edits) : 0.0f;
+}
+
+constexpr float kLabelWeight = 1.0f;
+constexpr float kInternalWeight = 0.8f;
+constexpr float kTypeWeight = 0.7f;
+constexpr float kPartFactor = 0.9f;   // 카멜 표기로 나눈 부분 낱말
+constexpr float kPartName = 0.7f;    // 이름의 일부만 맞은 경우(`rotor` → `accessibilityRotor`)
+constexpr float kNameFactor = 2.0f;
+constexpr float kUncoveredPenalty = 0.2f;
+constexpr float kDeprecatedPenalty = 0.3f;
+
+/// 선언 토큰에서 매개변수와 제네릭 제약을 읽는다.
+void readDeclaration(const JsonValue& tokens, SymbolEntry& entry) {
+    std::map<std::string, std::string> constraints;   // 제네릭 매개변수 → 제약
+    std::vector<std::string> generics;
+    int depth = 0;
+    bool inParameters = false, parametersDone = false, inWhere = false;
+    std::string pendingConstrained;
+    for (const auto& token : tokens.elements) {
+        const JsonValue* kindValue = token.get("kind");
+        const JsonValue* textValue = token.get("text");
+        if (!kindValue || !textValue || !kindValue->isString() || !textValue->isString()) continue;
+        std::string_view kind = kindValue->text, text = textValue->text;
+        entry.declaration += text;
+
+        if (kind == "text") {
+            for (char c : text) {
+                if (c == '(') {
+                    if (depth == 0 && !parametersDone) inParameters = true;
+                    ++depth;
+                } else if (c == ')') {
+                    if (--depth == 0 && inParameters) {
+                        inParameters = false;
+                        parametersDone = true;
+                    }
+                }
+            }
+            continue;
+        }
+        if (kind == "genericParameter") {
+            generics.emplace_back(text);
+        } else if (kind == "keyword" && text == "where") {
+            inWhere = true;
+        } else if (kind == "externalParam" && inParameters && depth == 1) {
+            entry.parameters.emplace_back();
+            if (text != "_") entry.parameters.back().label = std::string(text);
+        } else if (kind == "internalParam" && inParameters && depth == 1) {
+            if (entry.parameters.empty() || !entry.parameters.back().internal.empty()) entry.parameters.emplace_back();
+            entry.parameters.back().internal = std::string(text);
+        } else if (kind == "typeIdentifier") {
+            if (inParameters && !entry.parameters.empty()) {
+                entry.parameters.back().types.emplace_back(text);
+            } else if (inWhere) {
+                // `where S : StringProtocol`은 형식 두 개가 번갈아 나온다.
+                if (pendingConstrained.empty()) {
+                    pendingConstrained = std::string(text);
+                } else {
+                    constraints.emplace(pendingConstrained, std::string(text));
+                    pendingConstrained.clear();
+                }
+            }
+        }
+    }
+    for (auto& parameter : entry.parameters) {
+        for (auto& type : parameter.types) {
+            auto found = constraints.find(type);
+            if (found != constraints.end() && std::find(generics.begin(), generics.end(), type) != generics.end()) {
+                type = found->second;
+            }
+        }
+    }
+}
+
+void readPlatforms(const JsonValue& platforms, SymbolEntry& entry) {
+    for (const auto& item : platforms.elements) {
+        const JsonValue* name = item.get("name");
+        if (!name || !name->isString()) continue;
+        auto platform = platformNamed(name->text);
+        if (!platform) continue;
+        PlatformAvailability& info = entry.availability.entry(*platform);
+        if (const JsonValue* introduced = item.get("introducedAt"); introduced && introduced->isString()) {
+            info.introduced = Version::parse(introduced->text);
+        }
+        if (const JsonValue* deprecatedAt = item.get("deprecatedAt"); deprecatedAt && deprecatedAt->isString()) {
+            info.deprecated = Version::parse(deprecatedAt->text);
+        }
+        const JsonValue* unavailable = item.get("unavailable");
+        info.unavailable = unavailable && unavailable->boolean;
+        const JsonValue* deprecated = item.get("deprecated");
+        if (deprecated && deprecated->boolean) {
+            info.deprecatedUnversioned = info.deprecated.empty();
+            entry.deprecated = true;
+        }
+    }
+}
+
+/// 질의에서 읽은 플랫폼 조건.
+struct PlatformTerm {
+    Platform platform;
+    Version version;
+};
+
+bool isVersion(std::string_view word) {
+    return !word.empty() && word.find_first_not_of("0123456789.") == std::string_view::npos && word[0] != '.';
+}
+
+/// `ios`, `ios15`, `ios 15.0`을 플랫폼 조건으로 읽는다. 읽었으면 소비한 낱말 수, 아니면 0.
+std::size_t readPlatformTerm(const std::vector<std::string>& words, std::size_t at, PlatformTerm& term) {
+    static const std::pair<std::string_view, Platform> kNames[] = {
+        {"ios", Platform::iOS}, {"ipados", Platform::iOS}, {"macos", Platform::macOS},
+        {"tvos", Platform::tvOS}, {"watchos", Platform::watchOS}, {"maccatalyst", Platform::macCatalyst},
+    };
+    const std::string& word = words[at];
+    for (const auto& [name, platform] : kNames) {
+        if (word.compare(0, name.size(), name) != 0) continue;
+        std::string_view rest = std::string_view(word).substr(name.size());
+        if (!rest.empty() && !isVersion(rest)) continue;
+        term.platform = platform;
+        if (!rest.empty()) {
+            term.version = Version::parse(rest);
+            return 1;
+        }
+        if (at + 1 < words.size() && isVersion(words[at + 1])) {
+            term.version = Version::parse(words[at + 1]);
+            return 2;
+        }
+        term.version = Version{100000, 0, 0};   // 버전 없이 플랫폼만: 그 플랫폼에서 쓸 수 있는 것
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+// MARK: - 색인
+
+SymbolSearch SymbolSearch::build(const std::string& dataDirectory) {
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::recursive_directory_iterator(dataDirectory)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    SymbolSearch search;
+    std::map<std::string, std::vector<std::uint32_t>> byName;
+    for (const auto& path : files) {
+        Arena arena(1 << 16);
+        MappedFile file(path.string());
+        JsonValue root = parseJson(file.bytes(), arena);
+        const JsonValue* metadata = root.get("metadata");
+        const JsonValue* title = metadata ? metadata->get("title") : nullptr;
+        const JsonValue* sections = root.get("primaryContentSections");
+        const JsonValue* variants = root.get("variants");
+        if (!title || !title->isString() || !sections || !sections->isArray() || !variants || !variants->isArray() ||
+            variants->elements.size() == 0) {
+            continue;
+        }
+        const JsonValue* tokens = nullptr;
+        for (const auto& section : sections->elements) {
+            const JsonValue* declarations = section.get("declarations");
+            if (declarations && declarations->isArray() && declarations->elements.size() > 0) {
+                tokens = declarations->elements[0].get("tokens");
+                break;
+            }
+        }
+        const JsonValue* paths = variants->elements[0].get("paths");
+        if (!tokens || !tokens->isArray() || !paths || !paths->isArray() || paths->elements.size() == 0) continue;
+
+        SymbolEntry entry;
+        entry.title = std::string(title->text);
+        entry.name = lowercase(entry.title.substr(0, entry.title.find('(')));
+        entry.path = std::string(paths->elements[0].text);
+        readDeclaration(*tokens, entry);
+        if (const JsonValue* platforms = metadata->get("platforms"); platforms && platforms->isArray()) {
+            readPlatforms(*platforms, entry);
+        }
+
+        std::vector<Key> keys;
+        std::vector<std::string> parts;
+        auto addKeys = [&](std::string_view text, float weight, std::size_t parameter) {
+            parts.clear();
+            searchTerms(text, SearchTermMode::Index, parts);
+            for (std::size_t k = 0; k < parts.size(); ++k) {
+                keys.push_back({std::move(parts[k]), k == 0 ? weight : weight * kPartFactor, std::uint8_t(parameter)});
+            }
+        };
+        for (std::size_t p = 0; p < entry.parameters.size() && p < 64; ++p) {
+            const SymbolParameter& parameter = entry.parameters[p];
+            if (!parameter.label.empty()) keys.push_back({lowercase(parameter.label), kLabelWeight, std::uint8_t(p)});
+            addKeys(parameter.internal, kInternalWeight, p);
+            for (const auto& type : parameter.types) addKeys(type, kTypeWeight, p);
+        }
+        byName[entry.name].push_back(std::uint32_t(search.symbols_.size()));
+        search.symbols_.push_back(std::move(entry));
+        search.keys_.push_back(std::move(keys));
+    }
+    for (auto& [name, symbols] : byName) {
+        Name entry{name, {}, std::move(symbols)};
+        // 카멜 표기는 소문자로 바꾸기 전의 제목에서 나눈다.
+        const std::string& title = search.symbols_[entry.symbols[0]].title;
+        searchTerms(std::string_view(title).substr(0, title.find('(')), SearchTermMode::Index, entry.parts);
+        if (!entry.parts.empty()) entry.parts.erase(entry.parts.begin());   // 첫 항목은 이름 전체
+        search.names_.push_back(std::move(entry));
+    }
+    return search;
+}
+
+// MARK: - 질의
+
+void SymbolSearch::search(std::string_view query, std::size_t limit, std::vector<SymbolMatch>& matches) const {
+    matches.clear();
+    std::vector<std::string> words;
+    std::string word;
+    for (char c : query) {
+        bool part = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '.';
+        if (part) {
+            word += c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c;
+        } else if (!word.empty()) {
+            words.push_back(std::move(word));
+            word.clear();
+        }
+    }
+    if (!word.empty()) words.push_back(std::move(word));
+
+    std::vector<PlatformTerm> platforms;
+    std::vector<std::string> terms;
+    for (std::size_t i = 0; i < words.size();) {
+        PlatformTerm term;
+        if (std::size_t used = readPlatformTerm(words, i, term)) {
+            platforms.push_back(term);
+            i += used;
+        } else {
+            if (words[i] != "_") terms.push_back(words[i]);
+            ++i;
+        }
+    }
+    std::vector<EditDistance> distances;
+    distances.reserve(terms.size());
+    for (const auto& term : terms) distances.emplace_back(term);
+
+    // 기본 이름을 먼저 고른다. 맞는 이름이 없으면 모든 심벌을 시그니처만으로 비교한다.
+    struct Candidate {
+        const Name* name;
+        float score;
+        std::size_t term;
+    };
+    std::vector<Candidate> candidates;
+    for (const auto& name : names_) {
+        float best = 0;
+        std::size_t bestTerm = terms.size();
+        for (std::size_t t = 0; t < terms.size(); ++t) {
+            float score = wordScore(terms[t], distances[t], name.text);
+            for (const auto& part : name.parts) {
+                score = std::max(score, kPartName * wordScore(terms[t], distances[t], part));
+            }
+            if (score > best) {
+                best = score;
+                bestTerm = t;
+            }
+        }
+        if (best > 0) candidates.push_back({&name, best, bestTerm});
+    }
+    if (candidates.empty()) {
+        for (const auto& name : names_) candidates.push_back({&name, 0.0f, terms.size()});
+    }
+
+    for (const auto& candidate : candidates) {
+        for (std::uint32_t symbol : candidate.name->symbols) {
+            const SymbolEntry& entry = symbols_[symbol];
+            bool available = std::all_of(platforms.begin(), platforms.end(), [&entry](const PlatformTerm& term) {
+                return entry.availability.mentions(term.platform) &&
+                       entry.availability.isAvailable(term.platform, term.version);
+            });
+            if (!available) continue;
+
+            // 질의 낱말마다 가장 닮은 매개변수 낱말을 고르고, 어느 매개변수를 덮었는지 적어 둔다.
+            float signature = 0;
+            std::uint64_t covered = 0;
+            for (std::size_t t = 0; t < terms.size(); ++t) {
+                if (t == candidate.term) continue;
+                float best = 0;
+                std::size_t bestParameter = 64;
+                for (const Key& key : keys_[symbol]) {
+                    float score = key.weight * wordScore(terms[t], distances[t], key.word);
+                    if (score > best) {
+                        best = score;
+                        bestParameter = key.parameter;
+                    }
+                }
+                signature += best;
+                if (bestParameter < 64) covered |= std::uint64_t(1) << bestParameter;
+            }
+            std::size_t uncovered = entry.parameters.size() - std::size_t(__builtin_popcountll(covered));
+            float score = kNameFactor * candidate.score + signature - kUncoveredPenalty * float(uncovered) -
+                          (entry.deprecated ? kDeprecatedPenalty : 0.0f);
+            matches.push_back({symbol, score});
+        }
+    }
+
+    std::size_t count = std::min(limit, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + std::ptrdiff_t(count), matches.end(),
+                      [](const SymbolMatch& a, const SymbolMatch& b) {
+                          return a.score != b.score ? a.score > b.score : a.symbol < b.symbol;
+                      });
+    matches.resize(count);
+}
+
+} // namespace manual
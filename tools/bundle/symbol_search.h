@@ -0,0 +1,89 @@
+//
+//  symbol_search.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "interface/availability.h"
+
+namespace manual {
+
+/// 두 낱말의 편집 거리. `pattern`은 64바이트까지 비트 병렬(Myers)로 한 번에 훑는다.
+///
+/// 같은 패턴을 여러 낱말과 비교할 때는 `EditDistance`를 만들어 두고 재사용한다.
+class EditDistance {
+public:
+    explicit EditDistance(std::string_view pattern);
+    std::size_t operator()(std::string_view text) const;
+    std::size_t size() const { return length_; }
+
+private:
+    std::uint64_t masks_[256] = {};
+    std::size_t length_ = 0;
+};
+
+/// 선언부에서 읽은 매개변수 하나.
+struct SymbolParameter {
+    std::string label;      // 외부 레이블. `_`이면 비어 있다.
+    std::string internal;   // 내부 이름
+    std::vector<std::string> types;   // 형식 이름들. 제네릭 매개변수는 제약(`S: StringProtocol`)으로 바꾼다.
+};
+
+/// 심벌 페이지 하나.
+struct SymbolEntry {
+    std::string name;          // 소문자 기본 이름(`alert`)
+    std::string title;         // `alert(_:isPresented:actions:message:)`
+    std::string path;          // `/documentation/…/alert(_:ispresented:actions:message:)-1b37a`
+    std::string declaration;   // 선언부 원문
+    std::vector<SymbolParameter> parameters;
+    Availability availability;
+    bool deprecated = false;
+};
+
+struct SymbolMatch {
+    std::uint32_t symbol;
+    float score;
+};
+
+/// 오버로드를 시그니처로 구분하는 심벌 검색.
+///
+/// 질의의 낱말 하나는 기본 이름에, 나머지는 각 오버로드의 레이블·내부 이름·형식 이름에 맞춰 본다.
+/// 낱말은 편집 거리로 비교하므로 오타를 견디고, 질의가 덮지 못한 매개변수가 많을수록 점수를 깎아
+/// `alert title isPresented message`가 네 매개변수짜리 `alert(_:isPresented:actions:message:)`를 먼저 고르게 한다.
+/// `iOS 15`, `macos12`처럼 플랫폼과 버전을 적으면 그 버전에서 쓸 수 있는 심벌만 남긴다.
+class SymbolSearch {
+public:
+    /// `dataDirectory`의 선언이 있는 렌더 JSON을 읽는다. 형식이 맞지 않으면 `std::runtime_error`를 던진다.
+    static SymbolSearch build(const std::string& dataDirectory);
+
+    void search(std::string_view query, std::size_t limit, std::vector<SymbolMatch>& matches) const;
+
+    std::size_t size() const { return symbols_.size(); }
+    std::size_t nameCount() const { return names_.size(); }
+    const SymbolEntry& operator[](std::uint32_t symbol) const { return symbols_[symbol]; }
+
+private:
+    struct Name {
+        std::string text;
+        std::vector<std::string> parts;   // 카멜 표기로 나눈 부분(`accessibilityrotor` → `accessibility`, `rotor`)
+        std::vector<std::uint32_t> symbols;
+    };
+    /// 매개변수 쪽 비교 대상 낱말. 소문자이고 종류별 가중치가 붙어 있다.
+    struct Key {
+        std::string word;
+        float weight;
+        std::uint8_t parameter;
+    };
+
+    std::vector<SymbolEntry> symbols_;
+    std::vector<std::vector<Key>> keys_;   // 심벌마다
+    std::vector<Name> names_;   // 기본 이름별 오버로드 묶음
+};
+
+} // namespace manual
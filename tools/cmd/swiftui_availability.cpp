@@ -0,0 +1,128 @@
+//
+//  swiftui_availability.cpp
+//  swiftUIManual tools
+//
+//  가용성 비트 집합 인덱스를 만들고 "macOS 12에서는 되고 watchOS 8에서는 안 되는 API" 같은 질의에 답한다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "common/bitset.h"
+#include "common/bplist.h"
+#include "common/mapped_file.h"
+#include "common/thread_pool.h"
+#include "interface/availability_index.h"
+#include "interface/parser.h"
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: swiftui-availability build <swiftui.h> <out>\n"
+                 "       swiftui-availability import <availability.index> <out>\n"
+                 "       swiftui-availability query <index> [--on P:V]... [--not-on P:V]... [--list] [--repeat N]\n");
+}
+
+void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), std::streamsize(bytes.size()));
+    if (!out) throw std::runtime_error("cannot write " + path);
+}
+
+/// `macOS:12`, `watchOS:8.0` 꼴의 조건을 읽는다.
+manual::AvailabilityIndex::Term parseTerm(const char* text, bool negate) {
+    const char* colon = std::strchr(text, ':');
+    if (colon == nullptr) throw std::runtime_error(std::string("expected PLATFORM:VERSION, got ") + text);
+    std::optional<manual::Platform> platform = manual::platformNamed(std::string_view(text, std::size_t(colon - text)));
+    if (!platform) throw std::runtime_error(std::string("unknown platform in ") + text);
+    return {*platform, manual::Version::parse(colon + 1), negate};
+}
+
+int query(const std::string& path, const std::vector<manual::AvailabilityIndex::Term>& terms, bool list,
+          int repeat) {
+    manual::MappedFile file(path);
+    manual::AvailabilityIndex index(file.bytes());
+    std::vector<std::uint64_t> result;
+    double best = 0;
+    for (int i = 0; i < repeat; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        index.query(terms, result);
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        if (i == 0 || elapsed.count() < best) best = elapsed.count();
+    }
+    if (list) {
+        manual::forEachBit(result.data(), result.size(), [&index](std::size_t row) {
+            std::string_view name = index.name(row);
+            std::printf("%.*s\n", int(name.size()), name.data());
+        });
+    }
+    std::printf("%zu of %zu rows (%.2f us)\n", manual::bitsCount(result.data(), result.size()), index.rowCount(),
+                best);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 2;
+    }
+    std::string command = argv[1];
+    try {
+        if (command == "build" && argc == 4) {
+            manual::MappedFile file(argv[2]);
+            manual::ThreadPool pool;
+            manual::SymbolTable table = manual::parseInterface(file.bytes(), &pool);
+            manual::AvailabilityIndexBuilder builder;
+            builder.addInterface(table);
+            std::string bytes = builder.serialize();
+            writeFile(argv[3], bytes);
+            std::printf("%zu rows, %zu bytes\n", builder.size(), bytes.size());
+            return 0;
+        }
+        if (command == "import" && argc == 4) {
+            manual::MappedFile file(argv[2]);
+            manual::AvailabilityIndexBuilder builder;
+            builder.importBundleIndex(manual::parseBinaryPlist(file.bytes()));
+            std::string bytes = builder.serialize();
+            writeFile(argv[3], bytes);
+            std::printf("%zu rows, %zu bytes (bplist %zu bytes)\n", builder.size(), bytes.size(), file.size());
+            return 0;
+        }
+        if (command == "query") {
+            std::vector<manual::AvailabilityIndex::Term> terms;
+            bool list = false;
+            int repeat = 1;
+            for (int i = 3; i < argc; ++i) {
+                if (std::strcmp(argv[i], "--on") == 0 && i + 1 < argc) {
+                    terms.push_back(parseTerm(argv[++i], false));
+                } else if (std::strcmp(argv[i], "--not-on") == 0 && i + 1 < argc) {
+                    terms.push_back(parseTerm(argv[++i], true));
+                } else if (std::strcmp(argv[i], "--list") == 0) {
+                    list = true;
+                } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+                    repeat = std::max(1, std::atoi(argv[++i]));
+                } else {
+                    usage();
+                    return 2;
+                }
+            }
+            return query(argv[2], terms, list, repeat);
+        }
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-availability: %s\n", error.what());
+        return 1;
+    }
+    usage();
+    return 2;
+}
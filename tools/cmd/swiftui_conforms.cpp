@@ -0,0 +1,181 @@
+//
+//  swiftui_conforms.cpp
+//  swiftUIManual tools
+//
+//  인터페이스의 순응 그래프를 만들고 "ShapeStyle에 순응하는 타입", "`.periodic`으로 쓸 수 있는 멤버" 같은 질의에 답한다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "common/bitset.h"
+#include "common/mapped_file.h"
+#include "common/thread_pool.h"
+#include "interface/conformance_graph.h"
+#include "interface/parser.h"
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr, "usage: swiftui-conforms [--bench N] [--conformers NAME]... [--conformances NAME]...\n"
+                         "                        [--members PROTOCOL]... [--member NAME]... <swiftui.h>\n");
+}
+
+enum class QueryKind { Conformers, Conformances, Members, Member };
+
+struct Query {
+    QueryKind kind;
+    std::string name;
+};
+
+std::string_view kindMark(manual::ConformanceGraph::NodeKind kind) {
+    switch (kind) {
+    case manual::ConformanceGraph::NodeKind::Protocol:
+        return "protocol ";
+    case manual::ConformanceGraph::NodeKind::Type:
+        return "";
+    case manual::ConformanceGraph::NodeKind::External:
+        return "external ";
+    }
+    return "";
+}
+
+void printNodes(const manual::ConformanceGraph& graph, const std::uint64_t* bits) {
+    manual::forEachBit(bits, graph.wordCount(), [&](std::size_t node) {
+        std::string_view mark = kindMark(graph.kind(std::uint32_t(node)));
+        std::string_view name = graph.name(std::uint32_t(node));
+        std::printf("  %.*s%.*s\n", int(mark.size()), mark.data(), int(name.size()), name.data());
+    });
+}
+
+void printMembers(const manual::ConformanceGraph& graph, const manual::SymbolTable& table,
+                  manual::Span<const manual::ConformanceGraph::StaticMember> members) {
+    for (const auto& member : members) {
+        std::string_view protocol = graph.name(member.protocol);
+        std::printf("  %s\n      in %.*s where Self == %.*s\n", table.signature(member.decl).c_str(),
+                    int(protocol.size()), protocol.data(), int(graph.name(member.self).size()),
+                    graph.name(member.self).data());
+    }
+}
+
+/// 질의 하나의 결과 개수. 벤치마크에서 결과를 버리지 않게 한다.
+std::size_t run(const manual::ConformanceGraph& graph, const Query& query) {
+    if (query.kind == QueryKind::Member) return graph.staticMembersNamed(query.name).size();
+    std::uint32_t node = graph.find(query.name);
+    if (node == manual::ConformanceGraph::kNoNode) return 0;
+    switch (query.kind) {
+    case QueryKind::Conformers:
+        return manual::bitsCount(graph.conformers(node), graph.wordCount());
+    case QueryKind::Conformances:
+        return manual::bitsCount(graph.conformances(node), graph.wordCount());
+    case QueryKind::Members:
+        return graph.staticMembers(node).size();
+    case QueryKind::Member:
+        break;
+    }
+    return 0;
+}
+
+void print(const manual::ConformanceGraph& graph, const manual::SymbolTable& table, const Query& query) {
+    if (query.kind == QueryKind::Member) {
+        std::printf(".%s:\n", query.name.c_str());
+        printMembers(graph, table, graph.staticMembersNamed(query.name));
+        return;
+    }
+    std::uint32_t node = graph.find(query.name);
+    if (node == manual::ConformanceGraph::kNoNode) {
+        std::printf("%s: not found\n", query.name.c_str());
+        return;
+    }
+    switch (query.kind) {
+    case QueryKind::Conformers:
+        std::printf("conforming to %s:\n", query.name.c_str());
+        printNodes(graph, graph.conformers(node));
+        break;
+    case QueryKind::Conformances:
+        std::printf("%s conforms to:\n", query.name.c_str());
+        printNodes(graph, graph.conformances(node));
+        break;
+    case QueryKind::Members:
+        std::printf("usable as .member where %s is expected:\n", query.name.c_str());
+        printMembers(graph, table, graph.staticMembers(node));
+        break;
+    case QueryKind::Member:
+        break;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int bench = 0;
+    std::vector<Query> queries;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            bench = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--conformers") == 0 && i + 1 < argc) {
+            queries.push_back({QueryKind::Conformers, argv[++i]});
+        } else if (std::strcmp(argv[i], "--conformances") == 0 && i + 1 < argc) {
+            queries.push_back({QueryKind::Conformances, argv[++i]});
+        } else if (std::strcmp(argv[i], "--members") == 0 && i + 1 < argc) {
+            queries.push_back({QueryKind::Members, argv[++i]});
+        } else if (std::strcmp(argv[i], "--member") == 0 && i + 1 < argc) {
+            std::string name = argv[++i];
+            if (!name.empty() && name[0] == '.') name.erase(0, 1);
+            queries.push_back({QueryKind::Member, name});
+        } else if (argv[i][0] != '-' && path.empty()) {
+            path = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (path.empty()) {
+        usage();
+        return 2;
+    }
+
+    try {
+        manual::MappedFile file(path);
+        manual::ThreadPool pool(0);
+        manual::SymbolTable table = manual::parseInterface(file.bytes(), &pool);
+
+        auto start = std::chrono::steady_clock::now();
+        manual::ConformanceGraph graph = manual::ConformanceGraph::build(table);
+        std::chrono::duration<double, std::milli> built = std::chrono::steady_clock::now() - start;
+
+        if (bench > 0) {
+            std::size_t results = 0;
+            start = std::chrono::steady_clock::now();
+            for (int round = 0; round < bench; ++round) {
+                for (const auto& query : queries) results += run(graph, query);
+            }
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            std::size_t count = std::max<std::size_t>(1, std::size_t(bench) * queries.size());
+            std::printf("%zu queries, %.0f ns/query (%zu results)\n", count, elapsed.count() / double(count), results);
+        } else if (queries.empty()) {
+            std::size_t protocols = 0;
+            std::size_t edges = 0;
+            for (std::uint32_t node = 0; node < graph.size(); ++node) {
+                protocols += graph.kind(node) == manual::ConformanceGraph::NodeKind::Protocol ? 1 : 0;
+                edges += graph.directConformances(node).size();
+            }
+            std::printf("  nodes       %zu (%zu protocols)\n", graph.size(), protocols);
+            std::printf("  edges       %zu\n", edges);
+        } else {
+            for (const auto& query : queries) print(graph, table, query);
+        }
+        std::printf("built in %.3f ms, %.1f KiB\n", built.count(), double(graph.memoryUsage()) / 1024);
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-conforms: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+//
+//  swiftui_diff.cpp
+//  swiftUIManual tools
+//
+//  두 SDK의 swiftui.h를 심벌 표로 파싱해 선언 단위로 비교한다. 들여쓰기나 확장 순서가 바뀐 것은 차이로 보지 않고,
+//  추가·삭제된 선언, 선언부가 바뀐 선언, 가용성이 바뀐 선언만 출력한다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/mapped_file.h"
+#include "common/thread_pool.h"
+#include "interface/api_diff.h"
+#include "interface/parser.h"
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr, "usage: swiftui-diff [--threads N] [--bench N] [--keys] <old swiftui.h> <new swiftui.h>\n");
+}
+
+void printDecl(char mark, const manual::SymbolTable& table, std::int32_t index) {
+    std::printf("%c %s\n", mark, table.signature(std::size_t(index)).c_str());
+}
+
+void printChanges(const manual::ApiDiff& diff, const manual::SymbolTable& before, const manual::SymbolTable& after,
+                  bool keys) {
+    std::vector<manual::Availability> oldAvailability = manual::effectiveAvailabilities(before);
+    std::vector<manual::Availability> newAvailability = manual::effectiveAvailabilities(after);
+    for (const auto& change : diff.changes) {
+        if (change.flags & manual::kApiAdded) {
+            printDecl('+', after, change.newDecl);
+        } else if (change.flags & manual::kApiRemoved) {
+            printDecl('-', before, change.oldDecl);
+        } else if (change.flags & manual::kApiSignature) {
+            printDecl('-', before, change.oldDecl);
+            printDecl('+', after, change.newDecl);
+        } else {
+            printDecl('~', after, change.newDecl);
+        }
+        if (keys) {
+            bool added = change.newDecl != manual::kNoDecl;
+            std::printf("    key: %s\n", added ? manual::apiKey(after, std::size_t(change.newDecl)).c_str()
+                                              : manual::apiKey(before, std::size_t(change.oldDecl)).c_str());
+        }
+        if (change.flags & manual::kApiAvailability) {
+            std::printf("    available: %s\n",
+                        manual::describeAvailabilityChange(oldAvailability[std::size_t(change.oldDecl)],
+                                                           newAvailability[std::size_t(change.newDecl)])
+                            .c_str());
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    int bench = 0;
+    bool keys = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = unsigned(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            bench = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--keys") == 0) {
+            keys = true;
+        } else if (argv[i][0] != '-') {
+            paths.emplace_back(argv[i]);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (paths.size() != 2) {
+        usage();
+        return 2;
+    }
+
+    try {
+        manual::MappedFile oldFile(paths[0]);
+        manual::MappedFile newFile(paths[1]);
+        manual::ThreadPool pool(threads);
+
+        manual::SymbolTable before;
+        manual::SymbolTable after;
+        manual::ApiDiff diff;
+        double best = 0;
+        for (int round = 0; round < std::max(1, bench); ++round) {
+            auto start = std::chrono::steady_clock::now();
+            before = manual::parseInterface(oldFile.bytes(), &pool);
+            after = manual::parseInterface(newFile.bytes(), &pool);
+            diff = manual::diffInterfaces(before, after);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (round == 0 || elapsed.count() < best) best = elapsed.count();
+        }
+
+        if (bench == 0) printChanges(diff, before, after, keys);
+        std::printf("%zu added, %zu removed, %zu signature, %zu availability, %zu unchanged in %.2f ms\n",
+                    diff.count(manual::kApiAdded), diff.count(manual::kApiRemoved),
+                    diff.count(manual::kApiSignature), diff.count(manual::kApiAvailability), diff.unchanged, best);
+        return diff.changes.empty() ? 0 : 1;
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-diff: %s\n", error.what());
+        return 2;
+    }
+}
@@ -0,0 +1,264 @@
+//
+//  swiftui_grid.cpp
+//  swiftUIManual tools
+//
+//  가상화한 `LazyVGrid`/`LazyHGrid`를 끝까지 스크롤하며 프레임마다 만들 칸을 구하고 시간과 메모리를 잰다.
+//  `--table`은 표 모양의 `Grid`를 전용 풀이기로 배치한다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "layout/grid_layout.h"
+#include "layout/lazy_grid.h"
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr, "usage: swiftui-grid [--items N] [--sections N] [--columns SPEC] [--width W] [--viewport H]\n"
+                         "                    [--prefetch P] [--frames N] [--pinned] [--horizontal] [--dump OFFSET]\n"
+                         "       swiftui-grid --table ROWS [--width W] [--repeat N] [--dump]\n"
+                         "       SPEC: comma-separated fixed:L | flexible[:MIN[:MAX]] | adaptive:MIN[:MAX],\n"
+                         "             each optionally followed by @top, @bottom, @leading or @trailing\n");
+}
+
+/// `@top` 같은 정렬 이름을 `alignment`의 해당 성분에 넣는다.
+void parseAlignment(const std::string& name, manual::Alignment& alignment) {
+    if (name == "top") {
+        alignment.vertical = manual::VerticalAlignment::Top;
+    } else if (name == "bottom") {
+        alignment.vertical = manual::VerticalAlignment::Bottom;
+    } else if (name == "leading") {
+        alignment.horizontal = manual::HorizontalAlignment::Leading;
+    } else if (name == "trailing") {
+        alignment.horizontal = manual::HorizontalAlignment::Trailing;
+    } else if (name != "center") {
+        throw std::runtime_error("bad grid item alignment '" + name + "'");
+    }
+}
+
+/// `adaptive:80,fixed:40@top` 같은 열 지정을 `GridItem` 목록으로 옮긴다.
+std::vector<manual::GridItem> parseColumns(const std::string& spec) {
+    std::vector<manual::GridItem> items;
+    std::size_t start = 0;
+    while (start <= spec.size()) {
+        std::size_t end = spec.find(',', start);
+        if (end == std::string::npos) end = spec.size();
+        std::string part = spec.substr(start, end - start);
+        std::optional<manual::Alignment> alignment;
+        std::size_t at = part.find('@');
+        if (at != std::string::npos) {
+            alignment.emplace();
+            parseAlignment(part.substr(at + 1), *alignment);
+            part.resize(at);
+        }
+        std::vector<double> values;
+        std::size_t colon = part.find(':');
+        std::string kind = part.substr(0, colon);
+        while (colon != std::string::npos) {
+            std::size_t next = part.find(':', colon + 1);
+            values.push_back(std::atof(part.substr(colon + 1, next - colon - 1).c_str()));
+            colon = next;
+        }
+        if (kind == "fixed" && values.size() == 1) {
+            items.push_back(manual::GridItem::fixed(values[0]));
+        } else if (kind == "flexible" && values.size() <= 2) {
+            items.push_back(values.empty() ? manual::GridItem::flexible()
+                            : values.size() == 1 ? manual::GridItem::flexible(values[0])
+                                                 : manual::GridItem::flexible(values[0], values[1]));
+        } else if (kind == "adaptive" && (values.size() == 1 || values.size() == 2)) {
+            items.push_back(values.size() == 1 ? manual::GridItem::adaptive(values[0])
+                                               : manual::GridItem::adaptive(values[0], values[1]));
+        } else {
+            throw std::runtime_error("bad grid item '" + part + "'");
+        }
+        items.back().alignment = alignment;
+        start = end + 1;
+    }
+    return items;
+}
+
+void dump(const manual::LazyGridWindow& window) {
+    for (const auto& supplement : window.supplements) {
+        std::printf("section %u %s%s (%g, %g, %g × %g)\n", supplement.section, supplement.footer ? "footer" : "header",
+                    supplement.pinned ? " pinned" : "", supplement.frame.minX(), supplement.frame.minY(),
+                    supplement.frame.size.width, supplement.frame.size.height);
+    }
+    for (const auto& cell : window.cells) {
+        std::printf("item %llu section %u%s (%g, %g, %g × %g)\n", static_cast<unsigned long long>(cell.item),
+                    cell.section, cell.prefetch ? " prefetch" : "", cell.frame.minX(), cell.frame.minY(),
+                    cell.frame.size.width, cell.frame.size.height);
+    }
+}
+
+/// 대시보드 표 모양의 `Grid`. 머리글 행 다음에 `GridRow { Image; 이름; 설명; 값; 막대 }`를 `rows`개 두고,
+/// 25행마다 다섯 열을 모두 차지하는(`gridCellColumns(5)`) 구역 제목을 끼운다. 값 열은 뒤쪽 정렬이다.
+void buildTable(manual::GridSolver& grid, std::size_t rows) {
+    grid.addRow();
+    for (std::uint32_t characters : {4u, 4u, 11u, 5u, 5u}) grid.addText(characters, 13);
+    grid.setColumnAlignment(0, manual::HorizontalAlignment::Leading);
+    grid.setColumnAlignment(1, manual::HorizontalAlignment::Leading);
+    grid.setColumnAlignment(2, manual::HorizontalAlignment::Leading);
+    grid.setColumnAlignment(3, manual::HorizontalAlignment::Trailing);
+    std::uint64_t state = 7;
+    auto next = [&](std::uint32_t bound) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return std::uint32_t((state >> 33) % bound);
+    };
+    for (std::size_t row = 0; row < rows; ++row) {
+        if (row % 25 == 0) {
+            grid.addRow();
+            grid.addText(10 + next(30), 15, 5);
+        }
+        grid.addRow(manual::VerticalAlignment::FirstTextBaseline);
+        grid.addImage({16, 16});
+        grid.addText(5 + next(26));
+        grid.addText(10 + next(111), 13);
+        grid.addText(1 + next(8));
+        grid.addShape();
+    }
+}
+
+void benchmarkTable(std::size_t rows, double width, int repeat, bool dumpFrames) {
+    manual::GridSolver grid({manual::HorizontalAlignment::Leading, manual::VerticalAlignment::Center});
+    auto start = std::chrono::steady_clock::now();
+    buildTable(grid, rows);
+    std::chrono::duration<double, std::milli> built = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    manual::Size size = grid.place({width, manual::ProposedViewSize::kUnspecified});
+    std::chrono::duration<double, std::milli> first = std::chrono::steady_clock::now() - start;
+    if (dumpFrames) {
+        for (std::uint32_t cell = 0; cell < grid.cells(); ++cell) {
+            manual::Rect frame = grid.frame(cell);
+            std::printf("cell %u (%g, %g, %g × %g)\n", cell, frame.minX(), frame.minY(), frame.size.width,
+                        frame.size.height);
+        }
+        return;
+    }
+
+    // 폭을 번갈아 바꿔 열 폭 결정과 두 번째 패스를 매번 다시 돌린다.
+    double best = 0;
+    for (int round = 0; round < repeat; ++round) {
+        start = std::chrono::steady_clock::now();
+        grid.place({width - double(round % 2), manual::ProposedViewSize::kUnspecified});
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (round == 0 || elapsed.count() < best) best = elapsed.count();
+    }
+    std::printf("%u rows × %u columns (%u cells) built in %.2f ms, laid out to %g × %g\n", grid.rows(), grid.columns(),
+                grid.cells(), built.count(), size.width, size.height);
+    std::printf("  first layout %.2f ms (both passes), relayout at a new width %.3f ms (%.1f ns per cell)\n",
+                first.count(), best, best * 1e6 / grid.cells());
+    std::printf("  column widths:");
+    for (double length : grid.columnWidths()) std::printf(" %g", length);
+    std::printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::uint64_t items = 1000000;
+    std::uint64_t sectionCount = 1000;
+    std::string columns = "adaptive:80";
+    double width = 800;
+    double viewport = 600;
+    double prefetch = -1;
+    int frames = 10000;
+    bool pinned = false;
+    bool horizontal = false;
+    double dumpOffset = -1;
+    std::size_t table = 0;
+    int repeat = 10;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--items") == 0 && i + 1 < argc) {
+            items = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--sections") == 0 && i + 1 < argc) {
+            sectionCount = std::max<std::uint64_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--columns") == 0 && i + 1 < argc) {
+            columns = argv[++i];
+        } else if (std::strcmp(argv[i], "--width") == 0 && i + 1 < argc) {
+            width = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--viewport") == 0 && i + 1 < argc) {
+            viewport = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--prefetch") == 0 && i + 1 < argc) {
+            prefetch = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--pinned") == 0) {
+            pinned = true;
+        } else if (std::strcmp(argv[i], "--horizontal") == 0) {
+            horizontal = true;
+        } else if (std::strcmp(argv[i], "--table") == 0 && i + 1 < argc) {
+            table = std::size_t(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--dump") == 0) {
+            dumpOffset = i + 1 < argc && argv[i + 1][0] != '-' ? std::atof(argv[++i]) : 0;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (prefetch < 0) prefetch = viewport / 2;
+
+    try {
+        if (table > 0) {
+            benchmarkTable(table, width, repeat, dumpOffset >= 0);
+            return 0;
+        }
+        manual::LazyGrid grid(horizontal ? manual::Axis::Horizontal : manual::Axis::Vertical, parseColumns(columns),
+                              manual::ProposedViewSize::kUnspecified, manual::Alignment{},
+                              pinned ? manual::kPinSectionHeaders | manual::kPinSectionFooters : manual::kPinNone);
+        std::vector<manual::LazyGridSection> sections(static_cast<std::size_t>(sectionCount));
+        for (std::uint64_t s = 0; s < sectionCount; ++s) {
+            auto& section = sections[std::size_t(s)];
+            section.items = items / sectionCount + (s < items % sectionCount ? 1 : 0);
+            section.headerLength = 32;
+            section.footerLength = s % 4 == 3 ? 20 : 0;
+        }
+        grid.setSections(std::move(sections));
+        grid.resolve(width);
+
+        manual::LazyGridWindow window;
+        if (dumpOffset >= 0) {
+            grid.visibleWindow(dumpOffset, viewport, prefetch, window);
+            dump(window);
+            return 0;
+        }
+
+        double last = std::max(0.0, grid.contentLength() - viewport);
+        std::size_t mostCells = 0;
+        std::uint64_t cells = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            grid.resolve(width);   // 프레임마다 배치가 부르지만 폭이 그대로면 다시 풀지 않는다
+            double offset = frames > 1 ? last * double(frame) / double(frames - 1) : 0;
+            grid.visibleWindow(offset, viewport, prefetch, window);
+            cells += window.cells.size();
+            mostCells = std::max(mostCells, window.cells.size());
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::printf("%llu items in %llu sections, %zu tracks at width %g, content length %.0f\n",
+                    static_cast<unsigned long long>(grid.itemCount()), static_cast<unsigned long long>(sectionCount),
+                    grid.tracks().size(), width, grid.contentLength());
+        std::printf("  %d frames: %.2f µs per frame, %.1f cells per frame (at most %zu), %llu track resolutions\n",
+                    frames, elapsed.count() / frames, double(cells) / frames, mostCells,
+                    static_cast<unsigned long long>(grid.resolutions()));
+        std::printf("  memory: %zu bytes of section geometry, %zu bytes of window buffers\n", grid.memoryUsage(),
+                    window.cells.capacity() * sizeof(manual::LazyGridCell) +
+                        window.supplements.capacity() * sizeof(manual::LazyGridSupplement));
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-grid: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
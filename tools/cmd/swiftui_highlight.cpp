@@ -0,0 +1,82 @@
+//
+//  swiftui_highlight.cpp
+//  swiftUIManual tools
+//
+//  Swift 코드(swiftui.h 전체 등)를 highlight.js와 같은 범주로 칠한다. 범주별 구간 수와 처리 속도를 출력하거나,
+//  `--html`이면 `hljs-*` 클래스의 HTML을 출력한다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "bundle/html_prerender.h"
+#include "common/mapped_file.h"
+#include "interface/highlighter.h"
+
+namespace {
+
+void usage() { std::fprintf(stderr, "usage: swiftui-highlight [--html] [--repeat N] <file.swift>\n"); }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool html = false;
+    int repeat = 1;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--html") == 0) {
+            html = true;
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (argv[i][0] != '-' && path.empty()) {
+            path = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (path.empty()) {
+        usage();
+        return 2;
+    }
+
+    try {
+        manual::MappedFile file(path);
+        std::vector<manual::HighlightSpan> spans;
+        if (html) {
+            std::string out = "<pre><code class=\"hljs language-swift\">";
+            manual::appendHighlightedSwift(out, file.bytes(), spans);
+            out += "</code></pre>\n";
+            std::fwrite(out.data(), 1, out.size(), stdout);
+            return 0;
+        }
+
+        double best = 0;
+        for (int round = 0; round < repeat; ++round) {
+            auto start = std::chrono::steady_clock::now();
+            manual::highlightSwift(file.bytes(), spans);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (round == 0 || elapsed.count() < best) best = elapsed.count();
+        }
+        std::size_t counts[manual::kHighlightClassCount] = {};
+        for (const auto& span : spans) ++counts[std::size_t(span.kind)];
+        std::printf("%s\n", path.c_str());
+        for (std::size_t kind = 0; kind < manual::kHighlightClassCount; ++kind) {
+            if (counts[kind] == 0) continue;
+            std::string_view name = manual::highlightClassName(manual::HighlightClass(kind));
+            std::printf("  %-22.*s %zu\n", int(name.size()), name.data(), counts[kind]);
+        }
+        std::printf("  %zu spans, %.1f MB in %.3f ms: %.0f MB/s\n", spans.size(), double(file.size()) / 1e6,
+                    best * 1000, double(file.size()) / 1e6 / best);
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-highlight: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
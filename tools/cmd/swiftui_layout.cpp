@@ -0,0 +1,223 @@
+//
+//  swiftui_layout.cpp
+//  swiftUIManual tools
+//
+//  문서 페이지(또는 합성 카탈로그 트리)를 SwiftUI `Layout` 규약대로 화면 없이 배치하고 처리량을 잰다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/thread_pool.h"
+#include "layout/page_layout.h"
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr, "usage: swiftui-layout [--threads N] [--repeat N] [--width W] [--no-memo] [--dump PATH] <docs/data>\n"
+                         "       swiftui-layout (--synthetic NODES | --nested DEPTH) [--repeat N] [--width W] [--no-memo] [--edit N] [--dump]\n");
+}
+
+std::string_view kindName(manual::LayoutTree::NodeKind kind) {
+    switch (kind) {
+    case manual::LayoutTree::NodeKind::Container:
+        return "Layout";
+    case manual::LayoutTree::NodeKind::Text:
+        return "Text";
+    case manual::LayoutTree::NodeKind::Image:
+        return "Image";
+    case manual::LayoutTree::NodeKind::Shape:
+        return "Shape";
+    case manual::LayoutTree::NodeKind::Spacer:
+        return "Spacer";
+    }
+    return "";
+}
+
+void dump(const manual::LayoutEngine& engine, std::uint32_t node, int depth) {
+    const manual::LayoutTree& tree = engine.tree();
+    manual::Rect frame = engine.frame(node);
+    std::string_view kind = kindName(tree.kind(node));
+    std::printf("%*s%.*s (%g, %g, %g × %g)", depth * 2, "", int(kind.size()), kind.data(), frame.minX(), frame.minY(),
+                frame.size.width, frame.size.height);
+    if (tree.kind(node) == manual::LayoutTree::NodeKind::Text) {
+        std::printf(" %g chars @%g", tree.content(node).width, tree.content(node).height);
+    }
+    std::printf("\n");
+    for (std::uint32_t child = tree.firstChild(node); child != manual::LayoutTree::kNoNode;
+         child = tree.nextSibling(child)) {
+        dump(engine, child, depth + 1);
+    }
+}
+
+void printStats(const manual::MeasureStats& stats, std::uint64_t measurements, double passes, double nodes) {
+    std::printf("  %.1f measurements per node", double(measurements) / passes / nodes);
+    if (stats.hits + stats.misses > 0) {
+        std::printf(", memo %.1f%% hit (%llu hits, %llu misses)", stats.hitRate() * 100,
+                    static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses));
+    }
+    std::printf("\n");
+}
+
+/// 글 잎을 하나씩 바꿔 가며 증분 배치를 `edits`번 돌리고, 처음부터 배치한 결과와 프레임을 비교한다.
+void benchmarkEdits(manual::LayoutTree& tree, manual::LayoutEngine& engine, std::uint32_t root,
+                    manual::ProposedViewSize proposal, int edits) {
+    std::vector<std::uint32_t> texts;
+    for (std::uint32_t node = 0; node < tree.size(); ++node) {
+        if (tree.kind(node) == manual::LayoutTree::NodeKind::Text) texts.push_back(node);
+    }
+    if (texts.empty()) return;
+    engine.layout(root, proposal);
+    engine.resetStats();
+    std::uint64_t state = 42;
+    auto start = std::chrono::steady_clock::now();
+    for (int edit = 0; edit < edits; ++edit) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        std::uint32_t node = texts[(state >> 33) % texts.size()];
+        tree.setText(node, std::uint32_t(1 + (state >> 20) % 120));
+        engine.layout(root, proposal);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    const manual::MeasureStats& stats = engine.measureStats();
+    std::printf("%d edits: %.2f µs per edit, %.1f measurements, %.1f nodes re-measured, %.1f nodes re-placed\n", edits,
+                elapsed.count() / edits, double(engine.measurements()) / edits, double(stats.invalidated) / edits,
+                double(stats.placed) / edits);
+
+    manual::LayoutEngine fresh(tree);
+    fresh.layout(root, proposal);
+    double worst = 0;
+    for (std::uint32_t node = 0; node < tree.size(); ++node) {
+        manual::Rect a = engine.frame(node);
+        manual::Rect b = fresh.frame(node);
+        worst = std::max({worst, std::abs(a.minX() - b.minX()), std::abs(a.minY() - b.minY()),
+                          std::abs(a.size.width - b.size.width), std::abs(a.size.height - b.size.height)});
+    }
+    std::printf("  max frame difference from a full layout: %g\n", worst);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    int repeat = 10;
+    double width = 800;
+    std::size_t synthetic = 0;
+    std::size_t nested = 0;
+    bool memoize = true;
+    int edits = 0;
+    bool dumpTree = false;
+    std::string dumpPath;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = unsigned(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--width") == 0 && i + 1 < argc) {
+            width = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--synthetic") == 0 && i + 1 < argc) {
+            synthetic = std::size_t(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--nested") == 0 && i + 1 < argc) {
+            nested = std::size_t(std::max(1, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--edit") == 0 && i + 1 < argc) {
+            edits = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--no-memo") == 0) {
+            memoize = false;
+        } else if (std::strcmp(argv[i], "--dump") == 0) {
+            dumpTree = true;
+            if (synthetic == 0 && nested == 0 && i + 1 < argc && argv[i + 1][0] != '-') dumpPath = argv[++i];
+        } else if (argv[i][0] != '-' && path.empty()) {
+            path = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (path.empty() == (synthetic == 0 && nested == 0)) {
+        usage();
+        return 2;
+    }
+
+    try {
+        manual::ProposedViewSize proposal(width, manual::ProposedViewSize::kUnspecified);
+        if (synthetic > 0 || nested > 0) {
+            manual::LayoutTree tree;
+            auto start = std::chrono::steady_clock::now();
+            std::uint32_t root = synthetic > 0 ? manual::buildSyntheticLayout(synthetic, tree)
+                                               : manual::buildNestedLayout(nested, tree);
+            std::chrono::duration<double, std::milli> built = std::chrono::steady_clock::now() - start;
+            manual::LayoutEngine engine(tree);
+            engine.setMemoization(memoize);
+            double best = 0;
+            manual::Size size;
+            for (int round = 0; round < repeat; ++round) {
+                start = std::chrono::steady_clock::now();
+                engine.reset();
+                size = engine.layout(root, proposal);
+                std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                if (round == 0 || elapsed.count() < best) best = elapsed.count();
+            }
+            if (dumpTree) dump(engine, root, 0);
+            std::printf("%zu nodes built in %.2f ms, laid out to %g × %g in %.2f ms (%.1f M nodes/s)\n", tree.size(),
+                        built.count(), size.width, size.height, best, double(tree.size()) / best / 1000);
+            printStats(engine.measureStats(), engine.measurements(), repeat, double(tree.size()));
+            if (edits > 0) benchmarkEdits(tree, engine, root, proposal, edits);
+            return 0;
+        }
+
+        manual::ThreadPool pool(threads);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<manual::PageLayout> pages = manual::loadPageLayouts(path, pool);
+        std::chrono::duration<double, std::milli> built = std::chrono::steady_clock::now() - start;
+        std::size_t nodes = 0;
+        std::vector<std::unique_ptr<manual::LayoutEngine>> engines;
+        for (const auto& page : pages) {
+            nodes += page.tree.size();
+            engines.push_back(std::make_unique<manual::LayoutEngine>(page.tree));
+            engines.back()->setMemoization(memoize);
+        }
+
+        if (!dumpPath.empty()) {
+            auto found = std::find_if(pages.begin(), pages.end(),
+                                      [&](const manual::PageLayout& page) { return page.path == dumpPath; });
+            if (found == pages.end()) throw std::runtime_error("no page " + dumpPath);
+            manual::LayoutEngine& engine = *engines[std::size_t(found - pages.begin())];
+            engine.layout(found->root, proposal);
+            dump(engine, found->root, 0);
+            return 0;
+        }
+
+        double best = 0;
+        for (int round = 0; round < repeat; ++round) {
+            start = std::chrono::steady_clock::now();
+            pool.parallelFor(pages.size(), [&](std::size_t i) {
+                engines[i]->reset();
+                engines[i]->layout(pages[i].root, proposal);
+            });
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (round == 0 || elapsed.count() < best) best = elapsed.count();
+        }
+        std::uint64_t measurements = 0;
+        manual::MeasureStats stats;
+        for (const auto& engine : engines) {
+            measurements += engine->measurements();
+            stats += engine->measureStats();
+        }
+        std::printf("%zu pages, %zu nodes built in %.1f ms\n", pages.size(), nodes, built.count());
+        std::printf("  layout pass %.2f ms with %u threads: %.0f pages/s, %.1f M nodes/s\n", best, pool.size(),
+                    double(pages.size()) / best * 1000, double(nodes) / best / 1000);
+        printStats(stats, measurements, repeat, double(nodes));
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-layout: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
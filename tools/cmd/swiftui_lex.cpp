@@ -0,0 +1,89 @@
+//
+//  swiftui_lex.cpp
+//  swiftUIManual tools
+//
+//  swiftui.h를 토큰으로 나누고 속성 통계와 소요 시간을 출력한다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+
+#include "common/mapped_file.h"
+#include "interface/lexer.h"
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr, "usage: swiftui-lex [--repeat N] [--dump] <swiftui.h>\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int repeat = 1;
+    bool dump = false;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--dump") == 0) {
+            dump = true;
+        } else if (argv[i][0] != '-' && path == nullptr) {
+            path = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (path == nullptr) {
+        usage();
+        return 2;
+    }
+
+    try {
+        manual::MappedFile file(path);
+        manual::TokenStream stream;
+        double best = 0;
+        for (int run = 0; run < repeat; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            manual::lex(file.bytes(), stream);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (run == 0 || elapsed.count() < best) best = elapsed.count();
+        }
+
+        if (dump) {
+            for (const auto& token : stream.tokens) {
+                std::string_view kind = manual::tokenKindName(token.kind);
+                std::string_view text = stream.text(token);
+                std::printf("%u\t%u\t%.*s\t%.*s\n", token.offset, unsigned(token.depth), int(kind.size()),
+                            kind.data(), int(text.size()), text.data());
+            }
+            return 0;
+        }
+
+        std::size_t topLevelBodies = 0;
+        for (const auto& token : stream.tokens) {
+            if (token.kind == manual::TokenKind::LBrace && token.depth == 0) ++topLevelBodies;
+        }
+        std::printf("bytes            %zu\n", file.size());
+        std::printf("tokens           %zu\n", stream.tokens.size());
+        std::printf("top-level bodies %zu\n", topLevelBodies);
+        std::printf("max depth        %u\n", unsigned(stream.maxDepth));
+        std::printf("balanced         %s\n", stream.balanced ? "yes" : "no");
+        for (std::size_t i = 1; i < manual::kAttributeKindCount; ++i) {
+            std::string_view name = manual::attributeSpelling(manual::AttributeKind(i));
+            std::printf("@%-15.*s %u\n", int(name.size()), name.data(), stream.attributeCounts[i]);
+        }
+        std::printf("@%-15s %u\n", "(other)", stream.count(manual::AttributeKind::Other));
+        std::printf("time             %.3f ms\n", best);
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-lex: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+//
+//  swiftui_lookup.cpp
+//  swiftUIManual tools
+//
+//  docs/index/data.mdb를 직접 읽어 USR을 경로로, 경로를 제목으로 바꾼다. `--bench`는 리더 스레드별 처리량을 잰다.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "bundle/documentation_lookup.h"
+#include "common/thread_pool.h"
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: swiftui-lookup [--usr USR]... [--path PATH]... [--bench N] [--threads N] <docs/index>\n");
+}
+
+void printNode(const manual::DocumentationLookup& lookup, const std::string& query, std::uint32_t node) {
+    if (node == manual::kNoNode) {
+        std::printf("%s: not found\n", query.c_str());
+        return;
+    }
+    std::string_view path = lookup.pathOf(node);
+    std::string_view title = lookup.titleOf(node);
+    std::printf("%s: node %u %.*s \"%.*s\"\n", query.c_str(), node, int(path.size()), path.data(), int(title.size()),
+                title.data());
+}
+
+/// 모든 문서 경로를 `rounds`번씩 경로 → 노드 → 경로·제목으로 조회한다.
+void bench(const manual::DocumentationLookup& lookup, int rounds, unsigned threads) {
+    std::vector<std::string_view> paths;
+    const manual::NavigatorIndex& navigator = lookup.navigator();
+    for (std::uint32_t node = 0; node < navigator.size(); ++node) {
+        manual::NavigatorNode item = navigator[node];
+        if (item.pageType != manual::NavigatorPageType::GroupMarker && !item.path.empty()) paths.push_back(item.path);
+    }
+    if (paths.empty()) return;
+
+    manual::ThreadPool pool(threads);
+    std::atomic<std::size_t> misses{0};
+    auto start = std::chrono::steady_clock::now();
+    pool.parallelFor(std::size_t(rounds), [&](std::size_t) {
+        std::size_t missed = 0;
+        for (std::string_view path : paths) {
+            std::uint32_t node = lookup.nodeForPath(path);
+            if (node == manual::kNoNode || lookup.pathOf(node).empty() || lookup.titleOf(node).empty()) ++missed;
+        }
+        misses += missed;
+    });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::size_t total = paths.size() * std::size_t(rounds);
+    std::printf("%zu lookups on %u threads in %.3f ms (%.0f per second, %zu missed)\n", total, pool.size(),
+                elapsed.count() * 1000, double(total) / elapsed.count(), misses.load());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> usrs;
+    std::vector<std::string> paths;
+    int rounds = 0;
+    unsigned threads = 0;
+    std::string directory;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--usr") == 0 && i + 1 < argc) {
+            usrs.emplace_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--path") == 0 && i + 1 < argc) {
+            paths.emplace_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            rounds = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = unsigned(std::atoi(argv[++i]));
+        } else if (argv[i][0] != '-' && directory.empty()) {
+            directory = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (directory.empty()) {
+        usage();
+        return 2;
+    }
+
+    try {
+        manual::DocumentationLookup lookup(directory);
+        if (usrs.empty() && paths.empty() && rounds == 0) {
+            manual::LmdbTransaction transaction = lookup.environment().begin();
+            std::printf("%s\n", directory.c_str());
+            std::printf("  bundle      %.*s\n", int(lookup.bundleIdentifier().size()), lookup.bundleIdentifier().data());
+            std::printf("  txn         %llu\n", static_cast<unsigned long long>(transaction.id()));
+            std::printf("  pages       %zu x %zu bytes\n", lookup.environment().pageCount(),
+                        lookup.environment().pageSize());
+            transaction.forEach(transaction.main(), [&transaction](std::string_view name, std::string_view) {
+                manual::LmdbDatabase database;
+                transaction.open(name, database);
+                std::printf("  %-11.*s %llu entries\n", int(name.size()), name.data(),
+                            static_cast<unsigned long long>(database.entries));
+            });
+        }
+        for (const auto& usr : usrs) printNode(lookup, usr, lookup.nodeForUsr(usr));
+        for (const auto& path : paths) printNode(lookup, path, lookup.nodeForPath(path));
+        if (rounds > 0) bench(lookup, rounds, threads);
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-lookup: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+//
+//  swiftui_navigator.cpp
+//  swiftUIManual tools
+//
+//  DocC navigator.index를 매핑한 채로 읽어 사이드바 트리를 출력하거나 index.json을 다시 만든다.
+//  `--sidebars`는 플랫폼·버전 필터마다 미리 거른 사이드바 스냅숏을 디렉터리에 쓴다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "bundle/navigator_index.h"
+#include "bundle/sidebar_snapshots.h"
+#include "common/mapped_file.h"
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr, "usage: swiftui-navigator [--tree] [--json] [--find PATH] [--repeat N] <navigator.index>\n"
+                         "       swiftui-navigator --sidebars OUT <docs/index>\n");
+}
+
+void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), std::streamsize(bytes.size()));
+    if (!out) throw std::runtime_error("cannot write " + path);
+}
+
+int writeSidebars(const std::string& indexDirectory, const std::string& out) {
+    auto start = std::chrono::steady_clock::now();
+    manual::SidebarSnapshots sidebars = manual::SidebarSnapshots::build(indexDirectory);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::size_t bytes = 0;
+    for (const auto& snapshot : sidebars.snapshots()) {
+        writeFile(out + "/" + snapshot.name, snapshot.bytes);
+        bytes += snapshot.bytes.size();
+    }
+    writeFile(out + "/sidebar.json", sidebars.manifest());
+    std::printf("%zu filters -> %zu snapshots (%zu bytes) in %.2f ms\n", sidebars.filters().size(),
+                sidebars.snapshots().size(), bytes, elapsed.count());
+    for (const auto& filter : sidebars.filters()) {
+        const manual::SidebarSnapshot& snapshot = sidebars.snapshots()[filter.snapshot];
+        std::string_view platform = manual::platformName(filter.platform);
+        std::printf("  %-12.*s %-8s %s  %zu/%zu nodes\n", int(platform.size()), platform.data(),
+                    filter.version.string().c_str(), snapshot.name.c_str(), snapshot.nodes, sidebars.nodeCount());
+    }
+    return 0;
+}
+
+void printTree(const manual::NavigatorIndex& index, std::uint32_t node, int depth) {
+    if (depth > 64) throw std::runtime_error("navigator.index is nested too deeply");   // `appendNodeJson`과 같은 상한
+    manual::NavigatorNode item = index[node];
+    std::string_view type = manual::navigatorTypeName(item.pageType);
+    std::printf("%*s%.*s [%.*s] %.*s\n", depth * 2, "", int(item.title.size()), item.title.data(), int(type.size()),
+                type.data(), int(item.path.size()), item.path.data());
+    for (std::uint32_t child : index.children(node)) printTree(index, child, depth + 1);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool tree = false;
+    bool json = false;
+    std::string find;
+    std::string sidebars;
+    int repeat = 1;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--tree") == 0) {
+            tree = true;
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (std::strcmp(argv[i], "--find") == 0 && i + 1 < argc) {
+            find = argv[++i];
+        } else if (std::strcmp(argv[i], "--sidebars") == 0 && i + 1 < argc) {
+            sidebars = argv[++i];
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (argv[i][0] != '-' && path.empty()) {
+            path = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (path.empty()) {
+        usage();
+        return 2;
+    }
+
+    try {
+        if (!sidebars.empty()) return writeSidebars(path, sidebars);
+
+        manual::MappedFile file(path);
+        auto start = std::chrono::steady_clock::now();
+        manual::NavigatorIndex index(file.bytes());
+        std::chrono::duration<double, std::micro> opened = std::chrono::steady_clock::now() - start;
+
+        if (!find.empty()) {
+            std::uint32_t node = index.find(find);
+            if (node == manual::kNoNode) {
+                std::fprintf(stderr, "swiftui-navigator: no node at %s\n", find.c_str());
+                return 1;
+            }
+            printTree(index, node, 0);
+            return 0;
+        }
+        if (tree) {
+            printTree(index, 0, 0);
+            return 0;
+        }
+
+        std::string out;
+        double best = 0;
+        for (int i = 0; i < repeat; ++i) {
+            auto begin = std::chrono::steady_clock::now();
+            index.renderIndexJson(out);
+            std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - begin;
+            if (i == 0 || elapsed.count() < best) best = elapsed.count();
+        }
+        if (json) {
+            std::fwrite(out.data(), 1, out.size(), stdout);
+            return 0;
+        }
+        std::printf("%s\n", path.c_str());
+        std::printf("  nodes       %zu\n", index.size());
+        std::printf("  open        %.2f us (%.1f KiB side tables)\n", opened.count(),
+                    double(index.memoryUsage()) / 1024);
+        std::printf("  index.json  %zu bytes in %.2f us\n", out.size(), best);
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-navigator: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+//
+//  swiftui_prerender.cpp
+//  swiftUIManual tools
+//
+//  docs/data의 렌더 JSON을 정적 HTML로 미리 렌더링해 페이지 껍데기에 넣는다.
+//  JS를 돌리지 않아도 선언부, 요약, 토픽이 바로 보인다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "bundle/html_prerender.h"
+#include "common/thread_pool.h"
+
+namespace {
+
+void usage() { std::fprintf(stderr, "usage: swiftui-prerender [--threads N] [--repeat N] <docs> <out>\n"); }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    int repeat = 1;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = unsigned(std::max(1, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (argv[i][0] != '-') {
+            paths.emplace_back(argv[i]);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (paths.size() != 2) {
+        usage();
+        return 2;
+    }
+
+    try {
+        manual::ThreadPool pool(threads);
+        manual::PrerenderStats stats;
+        double best = 0;
+        for (int round = 0; round < repeat; ++round) {
+            auto start = std::chrono::steady_clock::now();
+            stats = manual::prerenderSite(paths[0], paths[1], pool);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (round == 0 || elapsed.count() < best) best = elapsed.count();
+        }
+        std::printf("%zu pages, %.1f MB in %.1f ms with %u threads", stats.pages, double(stats.bytes) / 1e6,
+                    best * 1000, pool.size());
+        if (stats.missingShells > 0) std::printf(" (%zu without index.html skipped)", stats.missingShells);
+        std::printf("\n");
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-prerender: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+//
+//  swiftui_rebuild.cpp
+//  swiftUIManual tools
+//
+//  최상위 선언 해시와 선언 → 페이지 의존 그래프를 저장해 두고, 새 SDK의 swiftui.h에서 다시 만들 페이지만 골라낸다.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "bundle/rebuild_manifest.h"
+#include "common/mapped_file.h"
+#include "common/thread_pool.h"
+#include "interface/parser.h"
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: swiftui-rebuild manifest <swiftui.h> <docs/data> <out>\n"
+                 "       swiftui-rebuild plan [--list] <manifest> <swiftui.h>\n");
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int manifest(const std::string& interface, const std::string& data, const std::string& output) {
+    auto start = std::chrono::steady_clock::now();
+    manual::MappedFile file(interface);
+    manual::ThreadPool pool;
+    manual::SymbolTable table = manual::parseInterface(file.bytes(), &pool);
+    manual::RebuildManifest manifest;
+    manifest.decls = manual::hashDeclarations(table);
+    manifest.unmatchedPages = manual::attachPages(manifest.decls, table, data);
+    manifest.write(output);
+
+    std::size_t pages = 0, producers = 0;
+    for (const auto& record : manifest.decls) {
+        pages += record.pages.size();
+        if (!record.pages.empty()) ++producers;
+    }
+    std::printf("%zu declarations, %zu produce %zu page links, %zu pages unmatched (%.1f ms)\n",
+                manifest.decls.size(), producers, pages, manifest.unmatchedPages, millisecondsSince(start));
+    return 0;
+}
+
+int plan(const std::string& manifestPath, const std::string& interface, bool list) {
+    auto start = std::chrono::steady_clock::now();
+    manual::RebuildManifest previous = manual::RebuildManifest::read(manifestPath);
+    manual::MappedFile file(interface);
+    manual::ThreadPool pool;
+    manual::SymbolTable table = manual::parseInterface(file.bytes(), &pool);
+    manual::RebuildPlan plan = manual::planRebuild(previous, manual::hashDeclarations(table));
+    double elapsed = millisecondsSince(start);
+
+    if (list) {
+        for (const auto& page : plan.pages) std::printf("%s\n", page.c_str());
+        return 0;
+    }
+    std::printf("%zu unchanged, %zu changed or removed, %zu new declarations\n", plan.unchanged, plan.removed,
+                plan.added.size());
+    for (const auto& label : plan.added) std::printf("  new: %s\n", label.c_str());
+    std::printf("%zu pages to re-emit (%.1f ms)\n", plan.pages.size(), elapsed);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+    std::string command = argv[1];
+    try {
+        if (command == "manifest" && argc == 5) return manifest(argv[2], argv[3], argv[4]);
+        if (command == "plan") {
+            bool list = argc == 5 && std::strcmp(argv[2], "--list") == 0;
+            if (argc == 4 || list) return plan(argv[argc - 2], argv[argc - 1], list);
+        }
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-rebuild: %s\n", error.what());
+        return 1;
+    }
+    usage();
+    return 2;
+}
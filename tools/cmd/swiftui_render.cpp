@@ -0,0 +1,241 @@
+//
+//  swiftui_render.cpp
+//  swiftUIManual tools
+//
+//  docs/data의 렌더 JSON을 문자열 표를 공유하는 바이너리 아카이브로 묶고, 원래 JSON으로 되살려 확인한다.
+//  `emit`은 스키마 전용 쓰기 경로로 페이지를 다시 써서 원본과 비교한다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bundle/render_archive.h"
+#include "bundle/render_page.h"
+#include "common/arena.h"
+#include "common/json.h"
+#include "common/mapped_file.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: swiftui-render pack <docs/data> <out>\n"
+                 "       swiftui-render verify <archive> <docs/data>\n"
+                 "       swiftui-render cat <archive> <name>\n"
+                 "       swiftui-render emit [--repeat N] <docs/data>\n");
+}
+
+/// `root` 아래 `.json` 파일을 이름순으로 모은다. 문서 이름은 확장자를 뺀 상대 경로다.
+std::vector<std::pair<std::string, fs::path>> renderFiles(const fs::path& root) {
+    std::vector<std::pair<std::string, fs::path>> files;
+    for (const auto& entry : fs::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json") continue;
+        fs::path relative = fs::relative(entry.path(), root);
+        relative.replace_extension();
+        files.emplace_back(relative.generic_string(), entry.path());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+/// 문서들이 조각을 몇 번 가리키는지 센다.
+std::size_t countFragmentReferences(const manual::RenderValue& value) {
+    switch (value.type()) {
+    case manual::RenderValue::Type::Tokens: return 1;
+    case manual::RenderValue::Type::Array: {
+        std::size_t count = 0;
+        value.forEachElement([&count](const manual::RenderValue& element) { count += countFragmentReferences(element); });
+        return count;
+    }
+    case manual::RenderValue::Type::Object: {
+        std::size_t count = 0;
+        value.forEachMember(
+            [&count](std::string_view, const manual::RenderValue& member) { count += countFragmentReferences(member); });
+        return count;
+    }
+    default: return 0;
+    }
+}
+
+int pack(const std::string& directory, const std::string& output) {
+    manual::RenderArchiveBuilder builder;
+    std::size_t jsonBytes = 0;
+    for (const auto& [name, path] : renderFiles(directory)) {
+        manual::MappedFile file(path.string());
+        builder.add(name, file.bytes());
+        jsonBytes += file.size();
+    }
+    std::string bytes = builder.serialize();
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), std::streamsize(bytes.size()));
+    if (!out) throw std::runtime_error("cannot write " + output);
+    std::printf("%zu documents, %zu JSON bytes -> %zu bytes (%.1fx)\n", builder.size(), jsonBytes, bytes.size(),
+                double(jsonBytes) / double(bytes.size()));
+    manual::RenderArchive archive(bytes);
+    std::size_t references = 0;
+    for (std::size_t document = 0; document < archive.size(); ++document) {
+        references += countFragmentReferences(archive.root(document));
+    }
+    std::printf("%zu token arrays stored as %zu distinct fragments\n", references, archive.fragmentCount());
+    return 0;
+}
+
+int verify(const std::string& archivePath, const std::string& directory) {
+    manual::MappedFile file(archivePath);
+    manual::RenderArchive archive(file.bytes());
+    std::string out;
+    std::size_t checked = 0, mismatched = 0, bytes = 0;
+    double seconds = 0;
+    for (const auto& [name, path] : renderFiles(directory)) {
+        std::size_t document = archive.find(name);
+        manual::MappedFile json(path.string());
+        auto start = std::chrono::steady_clock::now();
+        out.clear();
+        if (document < archive.size()) archive.root(document).appendJson(out);
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        ++checked;
+        bytes += out.size();
+        if (document == archive.size() || out != json.bytes()) {
+            ++mismatched;
+            std::fprintf(stderr, "mismatch: %s\n", name.c_str());
+        }
+    }
+    std::printf("%zu documents, %zu mismatched, %zu strings shared; %.1f MB/s to JSON\n", checked, mismatched,
+                archive.stringCount(), double(bytes) / seconds / 1e6);
+    return mismatched == 0 ? 0 : 1;
+}
+
+int cat(const std::string& archivePath, const std::string& name) {
+    manual::MappedFile file(archivePath);
+    manual::RenderArchive archive(file.bytes());
+    std::size_t document = archive.find(name);
+    if (document == archive.size()) throw std::runtime_error("no document named " + name);
+    std::string out;
+    archive.root(document).appendJson(out);
+    std::fwrite(out.data(), 1, out.size(), stdout);
+    return 0;
+}
+
+/// 모든 페이지를 파싱해 두고, 스키마 쓰기 경로와 범용 `appendJson`으로 각각 다시 써서 비교한다.
+int emit(const std::string& directory, int repeat) {
+    struct Page {
+        std::string name;
+        manual::MappedFile file;
+        manual::JsonValue root;
+    };
+    manual::Arena arena(1 << 20);
+    std::vector<Page> pages;
+    for (const auto& [name, path] : renderFiles(directory)) {
+        pages.push_back({name, manual::MappedFile(path.string()), {}});
+        pages.back().root = manual::parseJson(pages.back().file.bytes(), arena);
+    }
+
+    manual::RenderPage page;
+    std::string out;
+    std::size_t mismatched = 0, typed = 0, members = 0, bytes = 0;
+    for (const auto& each : pages) {
+        page.read(each.root);
+        typed += page.typedMemberCount();
+        members += page.memberCount();
+        out.clear();
+        page.write(out);
+        bytes += out.size();
+        if (out != each.file.bytes()) {
+            ++mismatched;
+            std::fprintf(stderr, "mismatch: %s\n", each.name.c_str());
+        }
+    }
+
+    // 페이지마다 한 번 읽어 둔 모델로 쓰기만 재는 경우도 함께 본다.
+    std::vector<manual::RenderPage> models(pages.size());
+    for (std::size_t i = 0; i < pages.size(); ++i) models[i].read(pages[i].root);
+
+    // 경로들을 번갈아 돌려 가장 빠른 회차끼리 비교한다.
+    double readWriteSeconds = 1e9, writeSeconds = 1e9, genericSeconds = 1e9;
+    auto elapsed = [](auto start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    for (int round = 0; round < repeat; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& each : pages) {
+            page.read(each.root);
+            out.clear();
+            page.write(out);
+        }
+        readWriteSeconds = std::min(readWriteSeconds, elapsed(start));
+        start = std::chrono::steady_clock::now();
+        for (const auto& model : models) {
+            out.clear();
+            model.write(out);
+        }
+        writeSeconds = std::min(writeSeconds, elapsed(start));
+        start = std::chrono::steady_clock::now();
+        for (const auto& each : pages) {
+            out.clear();
+            manual::appendJson(out, each.root);
+        }
+        genericSeconds = std::min(genericSeconds, elapsed(start));
+    }
+
+    double total = double(bytes) / 1e6;
+    std::printf("%zu pages, %zu mismatched, %zu/%zu top-level members typed\n", pages.size(), mismatched, typed,
+                members);
+    std::printf("schema writer %.1f MB/s (%.1f MB/s with read), generic appendJson %.1f MB/s\n",
+                total / writeSeconds, total / readWriteSeconds, total / genericSeconds);
+    return mismatched == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && std::string(argv[1]) == "emit") {
+        int repeat = 20;
+        std::string directory;
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--repeat" && i + 1 < argc) {
+                repeat = std::max(1, std::atoi(argv[++i]));
+            } else if (directory.empty() && arg[0] != '-') {
+                directory = arg;
+            } else {
+                usage();
+                return 2;
+            }
+        }
+        if (directory.empty()) {
+            usage();
+            return 2;
+        }
+        try {
+            return emit(directory, repeat);
+        } catch (const std::exception& error) {
+            std::fprintf(stderr, "swiftui-render: %s\n", error.what());
+            return 1;
+        }
+    }
+    if (argc != 4) {
+        usage();
+        return 2;
+    }
+    std::string command = argv[1];
+    try {
+        if (command == "pack") return pack(argv[2], argv[3]);
+        if (command == "verify") return verify(argv[2], argv[3]);
+        if (command == "cat") return cat(argv[2], argv[3]);
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-render: %s\n", error.what());
+        return 1;
+    }
+    usage();
+    return 2;
+}
@@ -0,0 +1,76 @@
+//
+//  swiftui_search.cpp
+//  swiftUIManual tools
+//
+//  docs/data로 한글·영문 역색인을 만들고 BM25 순위로 검색한다. `--bench`는 질의 하나의 평균 시간을 잰다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "bundle/search_index.h"
+
+namespace {
+
+void usage() { std::fprintf(stderr, "usage: swiftui-search [--limit N] [--bench N] <docs/data> [query]...\n"); }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t limit = 10;
+    int rounds = 0;
+    std::string directory;
+    std::vector<std::string> queries;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--limit") == 0 && i + 1 < argc) {
+            limit = std::size_t(std::max(1, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            rounds = std::max(1, std::atoi(argv[++i]));
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            usage();
+            return 2;
+        } else if (directory.empty()) {
+            directory = argv[i];
+        } else {
+            queries.emplace_back(argv[i]);
+        }
+    }
+    if (directory.empty()) {
+        usage();
+        return 2;
+    }
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        manual::SearchIndex index = manual::SearchIndex::build(directory);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::printf("%zu documents, %zu terms, %zu postings built in %.1f ms\n", index.documentCount(),
+                    index.termCount(), index.postingCount(), elapsed.count() * 1000);
+
+        std::vector<manual::SearchHit> hits;
+        for (const auto& query : queries) {
+            index.search(query, limit, hits);
+            std::printf("\n%s: %zu hits\n", query.c_str(), hits.size());
+            for (const auto& hit : hits) {
+                std::printf("  %7.3f  %-40s %s\n", double(hit.score), index.title(hit.document).c_str(),
+                            index.path(hit.document).c_str());
+            }
+            if (rounds > 0) {
+                start = std::chrono::steady_clock::now();
+                for (int round = 0; round < rounds; ++round) index.search(query, limit, hits);
+                elapsed = std::chrono::steady_clock::now() - start;
+                std::printf("  %.2f us per query\n", elapsed.count() * 1e6 / rounds);
+            }
+        }
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-search: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
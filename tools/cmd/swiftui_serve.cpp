@@ -0,0 +1,223 @@
+//
+//  swiftui_serve.cpp
+//  swiftUIManual tools
+//
+//  docs/ 번들을 내보내는 정적 서버. 시작할 때 gzip/brotli 본문을 만들어 두고, 요청마다 sendfile로 보낸다.
+//  `--search`를 주면 `/search?q=…`로 한글·영문 전문 검색에 답한다. `--sidebars`를 주면 플랫폼 필터별 사이드바 스냅숏을 `/index/` 아래에 함께 내보낸다. `--cache`를 주면 자주 요청되는 렌더 JSON을 메모리에 두고, SIGUSR1을 받을 때마다 캐시 통계를 JSON 한 줄로 출력한다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+
+#include <pthread.h>
+
+#include "bundle/search_index.h"
+#include "bundle/sidebar_snapshots.h"
+#include "common/json_writer.h"
+#include "common/thread_pool.h"
+#include "serve/http_server.h"
+#include "serve/static_site.h"
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr,
+                 "usage: swiftui-serve [--host ADDR] [--port N] [--threads N] [--gzip-level N] [--brotli-quality N]\n"
+                 "                     [--cache BYTES[K|M|G]] [--cache-prefix PATH] [--idle-timeout SECONDS] [--search]\n"
+                 "                     [--sidebars] <docs>\n");
+}
+
+/// 질의 문자열 값 하나를 푼다(`+`는 공백, `%XX`는 바이트).
+std::string decodeComponent(std::string_view text) {
+    auto hex = [](char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+    std::string decoded;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '+') {
+            decoded += ' ';
+        } else if (text[i] == '%' && i + 2 < text.size() && hex(text[i + 1]) >= 0 && hex(text[i + 2]) >= 0) {
+            decoded += char(hex(text[i + 1]) * 16 + hex(text[i + 2]));
+            i += 2;
+        } else {
+            decoded += text[i];
+        }
+    }
+    return decoded;
+}
+
+/// `/search?q=…&limit=N`에 `{"query":…,"results":[{"path":…,"title":…,"score":…}]}`로 답한다.
+std::string_view answerSearch(const manual::SearchIndex& index, std::string_view query, std::string& body) {
+    std::string text;
+    std::size_t limit = 20;
+    while (!query.empty()) {
+        std::size_t amp = query.find('&');
+        std::string_view pair = query.substr(0, amp);
+        query = amp == std::string_view::npos ? std::string_view() : query.substr(amp + 1);
+        std::size_t equals = pair.find('=');
+        std::string_view name = pair.substr(0, equals);
+        std::string value = equals == std::string_view::npos ? std::string() : decodeComponent(pair.substr(equals + 1));
+        if (name == "q") text = value;
+        if (name == "limit") limit = std::size_t(std::clamp(std::atoi(value.c_str()), 1, 100));
+    }
+
+    std::vector<manual::SearchHit> hits;
+    index.search(text, limit, hits);
+    manual::JsonWriter writer(body);
+    writer.beginObject();
+    writer.field("query", text);
+    writer.key("results");
+    writer.beginArray();
+    for (const auto& hit : hits) {
+        writer.beginObject();
+        writer.field("path", index.path(hit.document));
+        writer.field("title", index.title(hit.document));
+        char score[32];
+        std::snprintf(score, sizeof score, "%.4f", double(hit.score));
+        writer.key("score");
+        writer.number(score);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+    return "application/json; charset=utf-8";
+}
+
+/// `64M`처럼 단위를 붙인 바이트 수. 형식이 맞지 않으면 0.
+std::size_t parseBytes(const char* text) {
+    char* end = nullptr;
+    unsigned long long value = std::strtoull(text, &end, 10);
+    switch (*end) {
+    case 'K': case 'k': value <<= 10; ++end; break;
+    case 'M': case 'm': value <<= 20; ++end; break;
+    case 'G': case 'g': value <<= 30; ++end; break;
+    default: break;
+    }
+    return *end == '\0' ? std::size_t(value) : 0;
+}
+
+void printCacheStats(const manual::HttpServer& http) {
+    manual::TinyLfuCache::Stats stats = http.cacheStats();
+    std::uint64_t requests = stats.hits + stats.misses;
+    std::printf("{\"hits\":%llu,\"misses\":%llu,\"hitRatio\":%.4f,\"admitted\":%llu,\"rejected\":%llu,"
+                "\"evicted\":%llu,\"entries\":%llu,\"bytes\":%llu}\n",
+                static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses),
+                requests == 0 ? 0.0 : double(stats.hits) / double(requests),
+                static_cast<unsigned long long>(stats.admitted), static_cast<unsigned long long>(stats.rejected),
+                static_cast<unsigned long long>(stats.evicted), static_cast<unsigned long long>(stats.entries),
+                static_cast<unsigned long long>(stats.bytes));
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    manual::HttpServer::Options server;
+    manual::StaticSite::Options site;
+    std::string root;
+    bool search = false;
+    bool sidebars = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--host") == 0 && i + 1 < argc) {
+            server.host = argv[++i];
+        } else if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            server.port = std::uint16_t(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            server.threads = unsigned(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--gzip-level") == 0 && i + 1 < argc) {
+            site.gzipLevel = std::clamp(std::atoi(argv[++i]), 1, 9);
+        } else if (std::strcmp(argv[i], "--brotli-quality") == 0 && i + 1 < argc) {
+            site.brotliQuality = std::clamp(std::atoi(argv[++i]), 0, 11);
+        } else if (std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            server.cacheBytes = parseBytes(argv[++i]);
+            if (server.cacheBytes == 0) {
+                usage();
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--cache-prefix") == 0 && i + 1 < argc) {
+            server.cachePrefix = argv[++i];
+        } else if (std::strcmp(argv[i], "--idle-timeout") == 0 && i + 1 < argc) {
+            server.idleSeconds = unsigned(std::max(0, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--search") == 0) {
+            search = true;
+        } else if (std::strcmp(argv[i], "--sidebars") == 0) {
+            sidebars = true;
+        } else if (argv[i][0] != '-' && root.empty()) {
+            root = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (root.empty()) {
+        usage();
+        return 2;
+    }
+
+    // 작업 스레드가 신호를 받지 않도록 먼저 막고, 주 스레드가 sigwait로 기다린다.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        // 스냅숏은 이름에 내용 해시가 있어 영구 캐시되고, 목록(`sidebar.json`)만 ETag로 재검증한다.
+        std::vector<manual::GeneratedFile> generated;
+        if (sidebars) {
+            manual::SidebarSnapshots snapshots = manual::SidebarSnapshots::build(root + "/index");
+            for (const auto& snapshot : snapshots.snapshots()) {
+                generated.push_back({"/index/" + snapshot.name, snapshot.bytes});
+            }
+            generated.push_back({"/index/sidebar.json", snapshots.manifest()});
+            std::printf("sidebars: %zu filters, %zu snapshots\n", snapshots.filters().size(),
+                        snapshots.snapshots().size());
+        }
+        manual::ThreadPool pool(server.threads);
+        manual::StaticSite assets(root, site, pool, std::move(generated));
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        auto megabytes = [&assets](manual::ContentEncoding encoding) { return double(assets.bytes(encoding)) / 1e6; };
+        std::printf("%zu files, %.1f MB (gzip %.1f MB, br %.1f MB) prepared in %.2f s\n", assets.size(),
+                    megabytes(manual::ContentEncoding::Identity), megabytes(manual::ContentEncoding::Gzip),
+                    megabytes(manual::ContentEncoding::Brotli), elapsed.count());
+
+        manual::SearchIndex index;
+        if (search) {
+            start = std::chrono::steady_clock::now();
+            index = manual::SearchIndex::build(root + "/data");
+            elapsed = std::chrono::steady_clock::now() - start;
+            std::printf("search index: %zu documents, %zu terms in %.1f ms\n", index.documentCount(),
+                        index.termCount(), elapsed.count() * 1000);
+        }
+
+        manual::HttpServer http(assets, server);
+        if (search) {
+            http.route("/search", [&index](std::string_view query, std::string& body) {
+                return answerSearch(index, query, body);
+            });
+        }
+        http.start();
+        std::printf("serving %s on http://%s:%u with %u threads\n", root.c_str(), server.host.c_str(),
+                    unsigned(http.port()), http.threads());
+        std::fflush(stdout);
+        int received = 0;
+        while (sigwait(&signals, &received) == 0 && received == SIGUSR1) printCacheStats(http);
+        http.stop();
+        if (server.cacheBytes > 0) printCacheStats(http);
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-serve: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
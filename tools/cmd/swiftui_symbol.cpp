@@ -0,0 +1,78 @@
+//
+//  swiftui_symbol.cpp
+//  swiftUIManual tools
+//
+//  오버로드가 여럿인 심벌을 레이블, 매개변수 형식, 가용성으로 찾는다. 오타를 견디며 시그니처가 가까운 순으로 보여 준다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "bundle/symbol_search.h"
+
+namespace {
+
+void usage() { std::fprintf(stderr, "usage: swiftui-symbol [--limit N] [--bench N] <docs/data> <query>...\n"); }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t limit = 5;
+    int rounds = 0;
+    std::string directory;
+    std::vector<std::string> queries;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--limit") == 0 && i + 1 < argc) {
+            limit = std::size_t(std::max(1, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            rounds = std::max(1, std::atoi(argv[++i]));
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            usage();
+            return 2;
+        } else if (directory.empty()) {
+            directory = argv[i];
+        } else {
+            queries.emplace_back(argv[i]);
+        }
+    }
+    if (directory.empty() || queries.empty()) {
+        usage();
+        return 2;
+    }
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        manual::SymbolSearch search = manual::SymbolSearch::build(directory);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::printf("%zu symbols under %zu names in %.1f ms\n", search.size(), search.nameCount(),
+                    elapsed.count() * 1000);
+
+        std::vector<manual::SymbolMatch> matches;
+        for (const auto& query : queries) {
+            search.search(query, limit, matches);
+            std::printf("\n%s\n", query.c_str());
+            for (const auto& match : matches) {
+                const manual::SymbolEntry& entry = search[match.symbol];
+                std::string declaration = entry.declaration.substr(0, entry.declaration.find_last_not_of('\n') + 1);
+                std::printf("  %6.3f  %s\n          %s\n          %s\n", double(match.score), entry.path.c_str(),
+                            declaration.c_str(), entry.availability.summary().c_str());
+            }
+            if (rounds > 0) {
+                start = std::chrono::steady_clock::now();
+                for (int round = 0; round < rounds; ++round) search.search(query, limit, matches);
+                elapsed = std::chrono::steady_clock::now() - start;
+                std::printf("  %.2f us per query\n", elapsed.count() * 1e6 / rounds);
+            }
+        }
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-symbol: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
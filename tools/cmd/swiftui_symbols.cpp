@@ -0,0 +1,117 @@
+//
+//  swiftui_symbols.cpp
+//  swiftUIManual tools
+//
+//  인터페이스 파일을 병렬로 파싱해 선언 통계를 출력하거나 이름으로 선언을 찾는다.
+//  파일을 여러 개 주면 같은 스레드 풀에서 나란히 파싱한다.
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/mapped_file.h"
+#include "common/thread_pool.h"
+#include "interface/parser.h"
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr, "usage: swiftui-symbols [--threads N] [--serial] [--find NAME] <swiftui.h>...\n");
+}
+
+struct Job {
+    std::unique_ptr<manual::MappedFile> file;
+    manual::SymbolTable table;
+    std::size_t shards = 0;
+    double milliseconds = 0;
+};
+
+void printStatistics(const Job& job) {
+    std::size_t counts[manual::kDeclKindCount] = {};
+    for (const auto& decl : job.table.decls()) ++counts[std::size_t(decl.kind)];
+    std::printf("%s\n", job.file->path().c_str());
+    std::printf("  shards      %zu\n", job.shards);
+    std::printf("  top-level   %zu\n", job.table.topLevel().size());
+    std::printf("  decls       %zu\n", job.table.size());
+    for (std::size_t kind = 0; kind < manual::kDeclKindCount; ++kind) {
+        if (counts[kind] == 0) continue;
+        std::string_view name = manual::declKindName(manual::DeclKind(kind));
+        std::printf("  %-11.*s %zu\n", int(name.size()), name.data(), counts[kind]);
+    }
+    std::printf("  symbols     %zu\n", job.table.symbols().size());
+    std::printf("  availability %zu distinct\n", job.table.availabilities().size());
+    std::printf("  model       %.1f KiB (+ %.1f KiB tokens)\n", double(job.table.modelMemoryUsage()) / 1024,
+                double(job.table.tokens().tokens.capacity() * sizeof(manual::Token)) / 1024);
+    std::printf("  time        %.3f ms\n", job.milliseconds);
+}
+
+void printMatches(const Job& job, const std::string& name) {
+    for (std::uint32_t index : job.table.find(name)) {
+        const manual::Decl& decl = job.table[index];
+        std::printf("%s\n", job.table.signature(index).c_str());
+        const manual::Availability& availability = job.table.availability(decl);
+        if (!availability.empty()) std::printf("    available: %s\n", availability.summary().c_str());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = 0;
+    bool serial = false;
+    std::string find;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = unsigned(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--serial") == 0) {
+            serial = true;
+        } else if (std::strcmp(argv[i], "--find") == 0 && i + 1 < argc) {
+            find = argv[++i];
+        } else if (argv[i][0] != '-') {
+            paths.emplace_back(argv[i]);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (paths.empty()) {
+        usage();
+        return 2;
+    }
+
+    try {
+        std::vector<Job> jobs(paths.size());
+        for (std::size_t i = 0; i < paths.size(); ++i) jobs[i].file = std::make_unique<manual::MappedFile>(paths[i]);
+
+        manual::ThreadPool pool(threads);
+        manual::ThreadPool* parser = serial ? nullptr : &pool;
+        // 파일마다 하나의 작업을 두고, 각 작업 안에서 다시 구간별로 나눈다.
+        pool.parallelFor(jobs.size(), [&](std::size_t index) {
+            Job& job = jobs[index];
+            auto start = std::chrono::steady_clock::now();
+            job.table = manual::parseInterface(job.file->bytes(), parser);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            job.milliseconds = elapsed.count();
+            job.shards = manual::findShards(job.table.tokens()).size();
+        });
+
+        for (const auto& job : jobs) {
+            if (find.empty()) {
+                printStatistics(job);
+            } else {
+                printMatches(job, find);
+            }
+        }
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-symbols: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
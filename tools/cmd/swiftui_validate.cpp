@@ -0,0 +1,100 @@
+//
+//  swiftui_validate.cpp
+//  swiftUIManual tools
+//
+//  배포 전에 docs/data의 렌더 JSON을 병렬로 검사한다. 스키마 모양, 풀리지 않는 참조, 이 모듈의 USR, variants 경로를 본다.
+//  `corpus`는 같은 페이지를 복제해 처리량 측정용 묶음을 만든다.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+
+#include "bundle/render_validator.h"
+#include "common/thread_pool.h"
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr, "usage: swiftui-validate [--threads N] [--repeat N] [--show N] <docs/data>\n"
+                         "       swiftui-validate corpus [--threads N] [--pages N] <docs/data> <out>\n");
+}
+
+int validate(const std::string& directory, unsigned threads, int repeat, std::size_t show) {
+    manual::ThreadPool pool(threads);
+    manual::RenderValidation result;
+    double best = 0;
+    for (int round = 0; round < repeat; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        result = manual::validateRenderPages(directory, pool, show);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (round == 0 || elapsed.count() < best) best = elapsed.count();
+    }
+
+    std::printf("%zu pages, %.1f MB in %.1f ms with %u threads: %.0f MB/s, %.0f pages/s\n", result.pages,
+                double(result.bytes) / 1e6, best * 1000, pool.size(), double(result.bytes) / 1e6 / best,
+                double(result.pages) / best);
+    for (std::size_t kind = 0; kind < std::size_t(manual::RenderIssueKind::Count); ++kind) {
+        if (result.counts[kind] == 0) continue;
+        std::string_view name = manual::renderIssueKindName(manual::RenderIssueKind(kind));
+        std::printf("  %-20.*s %zu\n", int(name.size()), name.data(), result.counts[kind]);
+    }
+    for (const auto& issue : result.issues) {
+        std::string_view kind = manual::renderIssueKindName(issue.kind);
+        std::printf("%s#%s: %.*s: %s\n", issue.page.c_str(), issue.pointer.c_str(), int(kind.size()), kind.data(),
+                    issue.message.c_str());
+    }
+    if (result.issueCount() > result.issues.size()) {
+        std::printf("... %zu more\n", result.issueCount() - result.issues.size());
+    }
+    return result.issueCount() == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool corpus = argc > 1 && std::strcmp(argv[1], "corpus") == 0;
+    unsigned threads = 0;
+    int repeat = 1;
+    std::size_t show = 50;
+    std::size_t pages = 100000;
+    std::vector<std::string> paths;
+    for (int i = corpus ? 2 : 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = unsigned(std::max(1, std::atoi(argv[++i])));
+        } else if (!corpus && std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (!corpus && std::strcmp(argv[i], "--show") == 0 && i + 1 < argc) {
+            show = std::size_t(std::max(0, std::atoi(argv[++i])));
+        } else if (corpus && std::strcmp(argv[i], "--pages") == 0 && i + 1 < argc) {
+            pages = std::size_t(std::max(1, std::atoi(argv[++i])));
+        } else if (argv[i][0] != '-') {
+            paths.emplace_back(argv[i]);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (paths.size() != (corpus ? 2u : 1u)) {
+        usage();
+        return 2;
+    }
+
+    try {
+        if (!corpus) return validate(paths[0], threads, repeat, show);
+        manual::ThreadPool pool(threads);
+        auto start = std::chrono::steady_clock::now();
+        manual::RenderCorpusStats stats = manual::writeRenderCorpus(paths[0], paths[1], pages, pool);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::printf("%zu pages, %.1f MB written to %s in %.1f s\n", stats.pages, double(stats.bytes) / 1e6,
+                    paths[1].c_str(), elapsed.count());
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "swiftui-validate: %s\n", error.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+//
+//  arena.cpp
+//  swiftUIManual tools
+//
+
+#include "common/arena.h"
+
+namespace manual {
+
+Arena& Arena::operator=(Arena&& other) noexcept {
+    if (this != &other) {
+        release();
+        head_ = std::exchange(other.head_, nullptr);
+        cursor_ = std::exchange(other.cursor_, nullptr);
+        limit_ = std::exchange(other.limit_, nullptr);
+        blockSize_ = other.blockSize_;
+        used_ = std::exchange(other.used_, 0);
+        reserved_ = std::exchange(other.reserved_, 0);
+    }
+    return *this;
+}
+
+void Arena::release() {
+    Block* block = head_;
+    while (block != nullptr) {
+        Block* next = block->next;
+        ::operator delete(block);
+        block = next;
+    }
+    head_ = nullptr;
+    cursor_ = nullptr;
+    limit_ = nullptr;
+    used_ = 0;
+    reserved_ = 0;
+}
+
+void* Arena::allocateSlow(std::size_t size, std::size_t alignment) {
+    std::size_t needed = size + alignment;
+    if (needed > blockSize_ / 4) {
+        // 큰 요청은 전용 블록을 주고, 지금 채우고 있는 블록은 그대로 이어 쓴다.
+        auto* block = static_cast<Block*>(::operator new(sizeof(Block) + needed));
+        block->size = needed;
+        if (head_ != nullptr) {
+            block->next = head_->next;
+            head_->next = block;
+        } else {
+            block->next = nullptr;
+            head_ = block;
+        }
+        reserved_ += needed;
+        used_ += size;
+        auto address = reinterpret_cast<std::uintptr_t>(block + 1);
+        return reinterpret_cast<void*>((address + alignment - 1) & ~std::uintptr_t(alignment - 1));
+    }
+
+    auto* block = static_cast<Block*>(::operator new(sizeof(Block) + blockSize_));
+    block->size = blockSize_;
+    block->next = head_;
+    head_ = block;
+    reserved_ += blockSize_;
+    cursor_ = reinterpret_cast<char*>(block + 1);
+    limit_ = cursor_ + blockSize_;
+    return allocate(size, alignment);
+}
+
+} // namespace manual
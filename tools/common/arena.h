@@ -0,0 +1,106 @@
+//
+//  arena.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace manual {
+
+/// 연속된 `T` 배열을 가리키는 가벼운 뷰. 아레나에 만든 배열을 넘길 때 쓴다.
+template <class T>
+class Span {
+public:
+    Span() = default;
+    Span(T* data, std::size_t size) : data_(data), size_(size) {}
+
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+    T* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T& operator[](std::size_t index) const { return data_[index]; }
+
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/// 범프 할당기. 작은 객체를 블록 단위로 이어 붙이고, 해제는 블록째로 한 번에 한다.
+///
+/// 소멸자가 호출되지 않으므로 아레나에는 소멸자가 필요 없는 타입만 둔다.
+class Arena {
+public:
+    explicit Arena(std::size_t blockSize = 64 * 1024) : blockSize_(blockSize) {}
+    ~Arena() { release(); }
+
+    Arena(Arena&& other) noexcept { *this = std::move(other); }
+    Arena& operator=(Arena&& other) noexcept;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+        auto address = reinterpret_cast<std::uintptr_t>(cursor_);
+        std::size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+        if (cursor_ == nullptr || std::size_t(limit_ - cursor_) < size + padding) {
+            return allocateSlow(size, alignment);
+        }
+        char* result = cursor_ + padding;
+        cursor_ = result + size;
+        used_ += size + padding;
+        return result;
+    }
+
+    template <class T, class... Args>
+    T* make(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "아레나 객체의 소멸자는 호출되지 않는다");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template <class T>
+    Span<T> makeArray(std::size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "아레나 객체의 소멸자는 호출되지 않는다");
+        if (count == 0) return {};
+        T* data = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        for (std::size_t i = 0; i < count; ++i) new (data + i) T();
+        return {data, count};
+    }
+
+    std::string_view copy(std::string_view text) {
+        if (text.empty()) return {};
+        char* data = static_cast<char*>(allocate(text.size(), 1));
+        std::memcpy(data, text.data(), text.size());
+        return {data, text.size()};
+    }
+
+    /// 모든 블록을 돌려준다. 블록 수에만 비례하며 객체 수와는 상관없다.
+    void release();
+
+    std::size_t bytesUsed() const { return used_; }
+    std::size_t bytesReserved() const { return reserved_; }
+
+private:
+    struct Block {
+        Block* next;
+        std::size_t size;
+    };
+
+    void* allocateSlow(std::size_t size, std::size_t alignment);
+
+    Block* head_ = nullptr;
+    char* cursor_ = nullptr;
+    char* limit_ = nullptr;
+    std::size_t blockSize_ = 64 * 1024;
+    std::size_t used_ = 0;
+    std::size_t reserved_ = 0;
+};
+
+} // namespace manual
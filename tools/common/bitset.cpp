@@ -0,0 +1,54 @@
+//
+//  bitset.cpp
+//  swiftUIManual tools
+//
+
+#include "common/bitset.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace manual {
+
+namespace {
+
+#if defined(__SSE2__)
+inline __m128i load(const std::uint64_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline void store(std::uint64_t* p, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+#endif
+
+} // namespace
+
+void bitsAnd(std::uint64_t* dst, const std::uint64_t* src, std::size_t words) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 2 <= words; i += 2) store(dst + i, _mm_and_si128(load(dst + i), load(src + i)));
+#endif
+    for (; i < words; ++i) dst[i] &= src[i];
+}
+
+void bitsAndNot(std::uint64_t* dst, const std::uint64_t* src, std::size_t words) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    // _mm_andnot_si128(a, b)는 ~a & b다.
+    for (; i + 2 <= words; i += 2) store(dst + i, _mm_andnot_si128(load(src + i), load(dst + i)));
+#endif
+    for (; i < words; ++i) dst[i] &= ~src[i];
+}
+
+void bitsOr(std::uint64_t* dst, const std::uint64_t* src, std::size_t words) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 2 <= words; i += 2) store(dst + i, _mm_or_si128(load(dst + i), load(src + i)));
+#endif
+    for (; i < words; ++i) dst[i] |= src[i];
+}
+
+std::size_t bitsCount(const std::uint64_t* words, std::size_t count) {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count; ++i) total += std::size_t(__builtin_popcountll(words[i]));
+    return total;
+}
+
+} // namespace manual
@@ -0,0 +1,34 @@
+//
+//  bitset.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace manual {
+
+/// `dst &= src`. 두 배열은 `words`개의 64비트 단어로 이뤄진다.
+void bitsAnd(std::uint64_t* dst, const std::uint64_t* src, std::size_t words);
+/// `dst &= ~src`
+void bitsAndNot(std::uint64_t* dst, const std::uint64_t* src, std::size_t words);
+/// `dst |= src`
+void bitsOr(std::uint64_t* dst, const std::uint64_t* src, std::size_t words);
+/// 켜진 비트 수
+std::size_t bitsCount(const std::uint64_t* words, std::size_t count);
+
+/// 켜진 비트의 위치를 오름차순으로 `body`에 넘긴다.
+template <class Body>
+void forEachBit(const std::uint64_t* words, std::size_t count, Body&& body) {
+    for (std::size_t word = 0; word < count; ++word) {
+        std::uint64_t bits = words[word];
+        while (bits != 0) {
+            body(word * 64 + std::size_t(__builtin_ctzll(bits)));
+            bits &= bits - 1;
+        }
+    }
+}
+
+} // namespace manual
@@ -0,0 +1,205 @@
+//
+//  bplist.cpp
+//  swiftUIManual tools
+//
+
+#include "common/bplist.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace manual {
+
+namespace {
+
+constexpr std::size_t kTrailerSize = 32;
+constexpr int kMaxDepth = 64;
+/// 공유 참조를 따라가면 같은 객체를 여러 번 펼친다. 나무 모양이면 방문 수가 참조 칸 수(≤ 파일 크기)를 넘지 않으므로,
+/// 그 몇 배를 넘기면 서로를 두 번씩 가리키는 배열처럼 지수적으로 불어나는 파일로 본다.
+constexpr std::uint64_t kMaxVisitsPerByte = 4;
+
+[[noreturn]] void malformed(const char* what) {
+    throw std::runtime_error(std::string("malformed bplist: ") + what);
+}
+
+void appendUtf8(std::string& out, std::uint32_t code) {
+    if (code < 0x80) {
+        out += char(code);
+    } else if (code < 0x800) {
+        out += char(0xC0 | (code >> 6));
+        out += char(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += char(0xE0 | (code >> 12));
+        out += char(0x80 | ((code >> 6) & 0x3F));
+        out += char(0x80 | (code & 0x3F));
+    } else {
+        out += char(0xF0 | (code >> 18));
+        out += char(0x80 | ((code >> 12) & 0x3F));
+        out += char(0x80 | ((code >> 6) & 0x3F));
+        out += char(0x80 | (code & 0x3F));
+    }
+}
+
+class Reader {
+public:
+    explicit Reader(std::string_view bytes) : bytes_(bytes) {
+        if (bytes.size() < 8 + kTrailerSize || bytes.substr(0, 8) != "bplist00") malformed("header");
+        std::size_t trailer = bytes.size() - kTrailerSize;
+        offsetSize_ = std::uint8_t(bytes[trailer + 6]);
+        refSize_ = std::uint8_t(bytes[trailer + 7]);
+        objectCount_ = readUnsigned(trailer + 8, 8);
+        topObject_ = readUnsigned(trailer + 16, 8);
+        offsetTable_ = readUnsigned(trailer + 24, 8);
+        if (offsetSize_ == 0 || offsetSize_ > 8 || refSize_ == 0 || refSize_ > 8) malformed("trailer");
+        if (offsetTable_ > trailer || objectCount_ > (trailer - offsetTable_) / offsetSize_) malformed("offset table");
+        if (topObject_ >= objectCount_) malformed("top object");
+        visitBudget_ = bytes.size() * kMaxVisitsPerByte;
+    }
+
+    PlistValue top() { return object(topObject_, 0); }
+
+private:
+    std::uint64_t readUnsigned(std::size_t at, std::size_t size) const {
+        if (at + size > bytes_.size()) malformed("truncated");
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < size; ++i) value = (value << 8) | std::uint8_t(bytes_[at + i]);
+        return value;
+    }
+
+    std::size_t offsetOf(std::uint64_t ref) const {
+        if (ref >= objectCount_) malformed("object reference");
+        return std::size_t(readUnsigned(std::size_t(offsetTable_ + ref * offsetSize_), offsetSize_));
+    }
+
+    /// `at`부터 `size`바이트짜리 항목 `count`개가 파일 안에 들어가는지. 곱과 합이 넘치지 않게 나눠 비교한다.
+    bool fits(std::size_t at, std::uint64_t count, std::size_t size) const {
+        return at <= bytes_.size() && count <= (bytes_.size() - at) / size;
+    }
+
+    /// 표식의 하위 4비트가 0xF면 뒤따르는 정수 객체가 길이다.
+    std::uint64_t length(std::size_t& at, std::uint8_t marker) const {
+        std::uint64_t count = marker & 0x0F;
+        if (count != 0x0F) return count;
+        if (at >= bytes_.size()) malformed("length");
+        std::uint8_t next = std::uint8_t(bytes_[at]);
+        if ((next & 0xF0) != 0x10) malformed("length");
+        std::size_t size = std::size_t(1) << (next & 0x0F);
+        count = readUnsigned(at + 1, size > 8 ? 8 : size);
+        at += 1 + size;
+        return count;
+    }
+
+    PlistValue object(std::uint64_t ref, int depth) {
+        if (depth > kMaxDepth) malformed("nesting");
+        if (visitBudget_-- == 0) malformed("too many objects");
+        std::size_t at = offsetOf(ref);
+        if (at >= bytes_.size()) malformed("object offset");
+        auto marker = std::uint8_t(bytes_[at++]);
+        PlistValue value;
+        switch (marker >> 4) {
+        case 0x0:
+            if (marker == 0x08 || marker == 0x09) {
+                value.type = PlistValue::Type::Bool;
+                value.boolean = marker == 0x09;
+            }
+            return value;
+        case 0x1: {
+            // 16바이트 정수는 하위 8바이트만 쓴다.
+            std::size_t size = std::size_t(1) << (marker & 0x0F);
+            value.type = PlistValue::Type::Integer;
+            value.integer = size > 8 ? readUnsigned(at + size - 8, 8) : readUnsigned(at, size);
+            return value;
+        }
+        case 0x2:
+        case 0x3: {
+            std::size_t size = marker >> 4 == 0x3 ? 8 : std::size_t(1) << (marker & 0x0F);
+            std::uint64_t bits = readUnsigned(at, size);
+            value.type = marker >> 4 == 0x3 ? PlistValue::Type::Date : PlistValue::Type::Real;
+            if (size == 4) {
+                float single;
+                auto narrow = std::uint32_t(bits);
+                std::memcpy(&single, &narrow, sizeof single);
+                value.real = single;
+            } else {
+                std::memcpy(&value.real, &bits, sizeof value.real);
+            }
+            return value;
+        }
+        case 0x4:
+        case 0x5: {
+            std::uint64_t count = length(at, marker);
+            if (!fits(at, count, 1)) malformed("string");
+            value.type = marker >> 4 == 0x4 ? PlistValue::Type::Data : PlistValue::Type::String;
+            value.string.assign(bytes_.data() + at, std::size_t(count));
+            return value;
+        }
+        case 0x6: {
+            std::uint64_t count = length(at, marker);
+            if (!fits(at, count, 2)) malformed("utf16 string");
+            value.type = PlistValue::Type::String;
+            for (std::uint64_t i = 0; i < count; ++i) {
+                auto unit = std::uint32_t(readUnsigned(at + i * 2, 2));
+                if (unit >= 0xD800 && unit < 0xDC00 && i + 1 < count) {
+                    auto low = std::uint32_t(readUnsigned(at + (i + 1) * 2, 2));
+                    unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+                    ++i;
+                }
+                appendUtf8(value.string, unit);
+            }
+            return value;
+        }
+        case 0x8:
+            value.type = PlistValue::Type::Uid;
+            value.integer = readUnsigned(at, (marker & 0x0F) + 1u);
+            return value;
+        case 0xA:
+        case 0xC: {
+            std::uint64_t count = length(at, marker);
+            if (!fits(at, count, refSize_)) malformed("array");
+            value.type = PlistValue::Type::Array;
+            value.array.reserve(std::size_t(count));
+            for (std::uint64_t i = 0; i < count; ++i) {
+                value.array.push_back(object(readUnsigned(std::size_t(at + i * refSize_), refSize_), depth + 1));
+            }
+            return value;
+        }
+        case 0xD: {
+            std::uint64_t count = length(at, marker);
+            if (!fits(at, count, 2 * refSize_)) malformed("dict");
+            value.type = PlistValue::Type::Dict;
+            value.dict.reserve(std::size_t(count));
+            for (std::uint64_t i = 0; i < count; ++i) {
+                PlistValue key = object(readUnsigned(std::size_t(at + i * refSize_), refSize_), depth + 1);
+                if (key.type != PlistValue::Type::String) malformed("dict key");
+                PlistValue item = object(readUnsigned(std::size_t(at + (count + i) * refSize_), refSize_), depth + 1);
+                value.dict.emplace_back(std::move(key.string), std::move(item));
+            }
+            return value;
+        }
+        default:
+            malformed("object type");
+        }
+    }
+
+    std::string_view bytes_;
+    std::uint8_t offsetSize_ = 0;
+    std::uint8_t refSize_ = 0;
+    std::uint64_t objectCount_ = 0;
+    std::uint64_t topObject_ = 0;
+    std::uint64_t offsetTable_ = 0;
+    std::uint64_t visitBudget_ = 0;
+};
+
+} // namespace
+
+const PlistValue* PlistValue::get(std::string_view key) const {
+    if (type != Type::Dict) return nullptr;
+    for (const auto& entry : dict) {
+        if (entry.first == key) return &entry.second;
+    }
+    return nullptr;
+}
+
+PlistValue parseBinaryPlist(std::string_view bytes) { return Reader(bytes).top(); }
+
+} // namespace manual
@@ -0,0 +1,37 @@
+//
+//  bplist.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace manual {
+
+/// 바이너리 프로퍼티 리스트(`bplist00`)의 값 하나.
+struct PlistValue {
+    enum class Type : std::uint8_t { Null, Bool, Integer, Real, Date, Data, String, Uid, Array, Dict };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    std::uint64_t integer = 0;   // 부호 있는 값은 2의 보수 그대로 둔다. `-1`과 `UInt64.max`는 같은 비트다.
+    double real = 0;
+    std::string string;          // String은 UTF-8로, Data는 바이트 그대로 담는다.
+    std::vector<PlistValue> array;
+    std::vector<std::pair<std::string, PlistValue>> dict;
+
+    bool isDict() const { return type == Type::Dict; }
+    bool isArray() const { return type == Type::Array; }
+    /// 딕셔너리에서 `key`의 값. 없거나 딕셔너리가 아니면 `nullptr`.
+    const PlistValue* get(std::string_view key) const;
+};
+
+/// `bytes`를 읽는다. 형식이 맞지 않으면 `std::runtime_error`를 던진다.
+PlistValue parseBinaryPlist(std::string_view bytes);
+
+} // namespace manual
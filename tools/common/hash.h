@@ -0,0 +1,29 @@
+//
+//  hash.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace manual {
+
+/// 64비트 FNV-1a. 짧은 식별자를 섞는 데 쓴다.
+inline std::uint64_t fnv1a(std::string_view text, std::uint64_t seed = 0xcbf29ce484222325ull) {
+    std::uint64_t hash = seed;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/// 두 해시 값을 섞는다.
+inline std::uint64_t hashCombine(std::uint64_t hash, std::uint64_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+} // namespace manual
@@ -0,0 +1,66 @@
+//
+//  interner.cpp
+//  swiftUIManual tools
+//
+
+#include "common/interner.h"
+
+#include "common/hash.h"
+
+namespace manual {
+
+StringInterner::StringInterner() : arena_(32 * 1024) {
+    strings_.emplace_back();
+    hashes_.push_back(std::uint32_t(fnv1a({})));
+    slots_.assign(1024, 0);
+    slots_[hashes_[0] & (slots_.size() - 1)] = 1;
+}
+
+Symbol StringInterner::intern(std::string_view text) {
+    auto hash = std::uint32_t(fnv1a(text));
+    std::size_t mask = slots_.size() - 1;
+    for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        std::uint32_t entry = slots_[slot];
+        if (entry == 0) {
+            auto symbol = Symbol(strings_.size());
+            strings_.push_back(arena_.copy(text));
+            hashes_.push_back(hash);
+            slots_[slot] = symbol + 1;
+            // 채움률을 1/2 아래로 유지한다.
+            if (strings_.size() * 2 > slots_.size()) grow();
+            return symbol;
+        }
+        if (hashes_[entry - 1] == hash && strings_[entry - 1] == text) return entry - 1;
+    }
+}
+
+bool StringInterner::find(std::string_view text, Symbol& symbol) const {
+    auto hash = std::uint32_t(fnv1a(text));
+    std::size_t mask = slots_.size() - 1;
+    for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        std::uint32_t entry = slots_[slot];
+        if (entry == 0) return false;
+        if (hashes_[entry - 1] == hash && strings_[entry - 1] == text) {
+            symbol = entry - 1;
+            return true;
+        }
+    }
+}
+
+std::size_t StringInterner::memoryUsage() const {
+    return arena_.bytesReserved() + strings_.capacity() * sizeof(std::string_view) +
+           hashes_.capacity() * sizeof(std::uint32_t) + slots_.capacity() * sizeof(std::uint32_t);
+}
+
+void StringInterner::grow() {
+    std::vector<std::uint32_t> slots(slots_.size() * 2, 0);
+    std::size_t mask = slots.size() - 1;
+    for (std::size_t symbol = 0; symbol < strings_.size(); ++symbol) {
+        std::size_t slot = hashes_[symbol] & mask;
+        while (slots[slot] != 0) slot = (slot + 1) & mask;
+        slots[slot] = std::uint32_t(symbol + 1);
+    }
+    slots_.swap(slots);
+}
+
+} // namespace manual
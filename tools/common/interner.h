@@ -0,0 +1,44 @@
+//
+//  interner.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "common/arena.h"
+
+namespace manual {
+
+/// 인터닝한 문자열의 번호. 0은 항상 빈 문자열이다.
+using Symbol = std::uint32_t;
+constexpr Symbol kEmptySymbol = 0;
+
+/// 같은 문자열을 한 번만 저장하고 번호로 가리키게 한다.
+///
+/// 문자열 바이트는 아레나에 두고, 조회는 번호만 담은 개방 주소법 해시 표로 한다.
+class StringInterner {
+public:
+    StringInterner();
+
+    Symbol intern(std::string_view text);
+    /// 이미 있는 문자열의 번호. 없으면 `false`를 돌려준다.
+    bool find(std::string_view text, Symbol& symbol) const;
+
+    std::string_view operator[](Symbol symbol) const { return strings_[symbol]; }
+    std::size_t size() const { return strings_.size(); }
+    std::size_t memoryUsage() const;
+
+private:
+    void grow();
+
+    Arena arena_;
+    std::vector<std::string_view> strings_;
+    std::vector<std::uint32_t> hashes_;
+    std::vector<std::uint32_t> slots_;   // 번호 + 1. 0은 빈 칸이다.
+};
+
+} // namespace manual
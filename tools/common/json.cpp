@@ -0,0 +1,351 @@
+//
+//  json.cpp
+//  swiftUIManual tools
+//
+
+#include "common/json.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace manual {
+
+namespace {
+
+constexpr int kMaxDepth = 256;
+
+class Parser {
+public:
+    Parser(std::string_view text, Arena& arena) : text_(text), arena_(arena) {}
+
+    JsonValue parseDocument() {
+        JsonValue value = parseValue(0);
+        skipSpaces();
+        if (at_ != text_.size()) fail("trailing characters");
+        return value;
+    }
+
+private:
+    [[noreturn]] void fail(const char* what) const {
+        throw std::runtime_error("malformed JSON at offset " + std::to_string(at_) + ": " + what);
+    }
+
+    void skipSpaces() {
+        while (at_ < text_.size() && (text_[at_] == ' ' || text_[at_] == '\n' || text_[at_] == '\r' || text_[at_] == '\t')) {
+            ++at_;
+        }
+    }
+
+    bool consume(std::string_view literal) {
+        if (text_.substr(at_, literal.size()) != literal) return false;
+        at_ += literal.size();
+        return true;
+    }
+
+    JsonValue parseValue(int depth) {
+        if (depth > kMaxDepth) fail("nesting");
+        skipSpaces();
+        if (at_ >= text_.size()) fail("unexpected end");
+        JsonValue value;
+        char c = text_[at_];
+        if (c == '{') {
+            parseObject(value, depth);
+        } else if (c == '[') {
+            parseArray(value, depth);
+        } else if (c == '"') {
+            value.type = JsonValue::Type::String;
+            value.text = parseString();
+        } else if (consume("true")) {
+            value.type = JsonValue::Type::Bool;
+            value.boolean = true;
+        } else if (consume("false")) {
+            value.type = JsonValue::Type::Bool;
+        } else if (consume("null")) {
+            value.type = JsonValue::Type::Null;
+        } else if (c == '-' || (c >= '0' && c <= '9')) {
+            value.type = JsonValue::Type::Number;
+            value.text = parseNumber();
+        } else {
+            fail("unexpected character");
+        }
+        return value;
+    }
+
+    void parseObject(JsonValue& value, int depth) {
+        value.type = JsonValue::Type::Object;
+        ++at_;
+        std::size_t mark = members_.size();
+        skipSpaces();
+        if (at_ < text_.size() && text_[at_] == '}') {
+            ++at_;
+            return;
+        }
+        for (;;) {
+            skipSpaces();
+            if (at_ >= text_.size() || text_[at_] != '"') fail("expected key");
+            JsonMember member;
+            member.key = parseString();
+            skipSpaces();
+            if (at_ >= text_.size() || text_[at_] != ':') fail("expected ':'");
+            ++at_;
+            member.value = parseValue(depth + 1);
+            members_.push_back(member);
+            skipSpaces();
+            if (at_ < text_.size() && text_[at_] == ',') {
+                ++at_;
+                continue;
+            }
+            if (at_ < text_.size() && text_[at_] == '}') {
+                ++at_;
+                break;
+            }
+            fail("expected ',' or '}'");
+        }
+        // 자식을 다 읽은 뒤에야 개수를 알 수 있으므로, 공용 스택에 모았다가 아레나로 옮긴다.
+        value.members = arena_.makeArray<JsonMember>(members_.size() - mark);
+        std::copy(members_.begin() + std::ptrdiff_t(mark), members_.end(), value.members.begin());
+        members_.resize(mark);
+    }
+
+    void parseArray(JsonValue& value, int depth) {
+        value.type = JsonValue::Type::Array;
+        ++at_;
+        std::size_t mark = elements_.size();
+        skipSpaces();
+        if (at_ < text_.size() && text_[at_] == ']') {
+            ++at_;
+            return;
+        }
+        for (;;) {
+            JsonValue element = parseValue(depth + 1);
+            elements_.push_back(element);
+            skipSpaces();
+            if (at_ < text_.size() && text_[at_] == ',') {
+                ++at_;
+                continue;
+            }
+            if (at_ < text_.size() && text_[at_] == ']') {
+                ++at_;
+                break;
+            }
+            fail("expected ',' or ']'");
+        }
+        value.elements = arena_.makeArray<JsonValue>(elements_.size() - mark);
+        std::copy(elements_.begin() + std::ptrdiff_t(mark), elements_.end(), value.elements.begin());
+        elements_.resize(mark);
+    }
+
+    std::string_view parseNumber() {
+        std::size_t start = at_;
+        if (text_[at_] == '-') ++at_;
+        auto digits = [this] {
+            std::size_t begin = at_;
+            while (at_ < text_.size() && text_[at_] >= '0' && text_[at_] <= '9') ++at_;
+            if (at_ == begin) fail("expected digit");
+        };
+        digits();
+        if (at_ < text_.size() && text_[at_] == '.') {
+            ++at_;
+            digits();
+        }
+        if (at_ < text_.size() && (text_[at_] == 'e' || text_[at_] == 'E')) {
+            ++at_;
+            if (at_ < text_.size() && (text_[at_] == '+' || text_[at_] == '-')) ++at_;
+            digits();
+        }
+        return text_.substr(start, at_ - start);
+    }
+
+    unsigned parseHex4() {
+        if (at_ + 4 > text_.size()) fail("truncated escape");
+        unsigned code = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = text_[at_++];
+            code <<= 4;
+            if (c >= '0' && c <= '9') {
+                code |= unsigned(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                code |= unsigned(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                code |= unsigned(c - 'A' + 10);
+            } else {
+                fail("bad escape");
+            }
+        }
+        return code;
+    }
+
+    std::string_view parseString() {
+        ++at_;
+        std::size_t start = at_;
+        // 대부분의 문자열에는 이스케이프가 없으므로 원문을 그대로 가리킨다.
+        while (at_ < text_.size() && text_[at_] != '"' && text_[at_] != '\\') ++at_;
+        if (at_ >= text_.size()) fail("unterminated string");
+        if (text_[at_] == '"') return text_.substr(start, at_++ - start);
+
+        scratch_.assign(text_.data() + start, at_ - start);
+        while (at_ < text_.size() && text_[at_] != '"') {
+            char c = text_[at_++];
+            if (c != '\\') {
+                scratch_ += c;
+                continue;
+            }
+            if (at_ >= text_.size()) fail("truncated escape");
+            switch (text_[at_++]) {
+            case '"': scratch_ += '"'; break;
+            case '\\': scratch_ += '\\'; break;
+            case '/': scratch_ += '/'; break;
+            case 'b': scratch_ += '\b'; break;
+            case 'f': scratch_ += '\f'; break;
+            case 'n': scratch_ += '\n'; break;
+            case 'r': scratch_ += '\r'; break;
+            case 't': scratch_ += '\t'; break;
+            case 'u': {
+                unsigned code = parseHex4();
+                if (code >= 0xD800 && code < 0xDC00 && consume("\\u")) {
+                    unsigned low = parseHex4();
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(code);
+                break;
+            }
+            default: fail("bad escape");
+            }
+        }
+        if (at_ >= text_.size()) fail("unterminated string");
+        ++at_;
+        return arena_.copy(scratch_);
+    }
+
+    void appendUtf8(unsigned code) {
+        if (code < 0x80) {
+            scratch_ += char(code);
+        } else if (code < 0x800) {
+            scratch_ += char(0xC0 | (code >> 6));
+            scratch_ += char(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            scratch_ += char(0xE0 | (code >> 12));
+            scratch_ += char(0x80 | ((code >> 6) & 0x3F));
+            scratch_ += char(0x80 | (code & 0x3F));
+        } else {
+            scratch_ += char(0xF0 | (code >> 18));
+            scratch_ += char(0x80 | ((code >> 12) & 0x3F));
+            scratch_ += char(0x80 | ((code >> 6) & 0x3F));
+            scratch_ += char(0x80 | (code & 0x3F));
+        }
+    }
+
+    std::string_view text_;
+    Arena& arena_;
+    std::size_t at_ = 0;
+    std::string scratch_;
+    std::vector<JsonValue> elements_;
+    std::vector<JsonMember> members_;
+};
+
+} // namespace
+
+const JsonValue* JsonValue::get(std::string_view key) const {
+    if (type != Type::Object) return nullptr;
+    for (const auto& member : members) {
+        if (member.key == key) return &member.value;
+    }
+    return nullptr;
+}
+
+JsonValue parseJson(std::string_view text, Arena& arena) { return Parser(text, arena).parseDocument(); }
+
+void appendJson(std::string& out, const JsonValue& value) {
+    switch (value.type) {
+    case JsonValue::Type::Null: out += "null"; break;
+    case JsonValue::Type::Bool: out += value.boolean ? "true" : "false"; break;
+    case JsonValue::Type::Number: out += value.text; break;
+    case JsonValue::Type::String: appendJsonString(out, value.text); break;
+    case JsonValue::Type::Array: {
+        out += '[';
+        bool first = true;
+        for (const auto& element : value.elements) {
+            if (!first) out += ',';
+            first = false;
+            appendJson(out, element);
+        }
+        out += ']';
+        break;
+    }
+    case JsonValue::Type::Object: {
+        out += '{';
+        bool first = true;
+        for (const auto& member : value.members) {
+            if (!first) out += ',';
+            first = false;
+            appendJsonString(out, member.key, false);
+            out += ':';
+            appendJson(out, member.value);
+        }
+        out += '}';
+        break;
+    }
+    }
+}
+
+namespace {
+
+constexpr std::uint64_t kOnes = 0x0101010101010101ull;
+constexpr std::uint64_t kHighs = 0x8080808080808080ull;
+
+/// 단어의 어느 바이트가 `byte`와 같으면 참(거짓 양성 없음).
+inline bool hasByte(std::uint64_t word, unsigned char byte) {
+    std::uint64_t x = word ^ (kOnes * byte);
+    return ((x - kOnes) & ~x & kHighs) != 0;
+}
+
+/// 8바이트 안에 이스케이프할 문자가 있을 수 있는지. 제어 문자, `"`, `\`, (`/`)를 한 번에 본다.
+inline bool mayNeedEscape(std::uint64_t word, bool escapeSlash) {
+    bool control = ((word - kOnes * 0x20) & ~word & kHighs) != 0;
+    return control || hasByte(word, '"') || hasByte(word, '\\') || (escapeSlash && hasByte(word, '/'));
+}
+
+} // namespace
+
+void appendJsonString(std::string& out, std::string_view text, bool escapeSlash) {
+    static const char hex[] = "0123456789abcdef";
+    out += '"';
+    std::size_t run = 0;   // 이스케이프가 필요 없는 구간은 한 번에 붙인다.
+    std::size_t i = 0;
+    while (i < text.size()) {
+        // 한글처럼 이스케이프가 없는 긴 구간은 8바이트씩 건너뛴다.
+        if (i + 8 <= text.size()) {
+            std::uint64_t word;
+            std::memcpy(&word, text.data() + i, 8);
+            if (!mayNeedEscape(word, escapeSlash)) {
+                i += 8;
+                continue;
+            }
+        }
+        auto c = static_cast<unsigned char>(text[i++]);
+        if (c >= 0x20 && c != '"' && c != '\\' && (c != '/' || !escapeSlash)) continue;
+        out.append(text.data() + run, i - 1 - run);
+        run = i;
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '/': out += "\\/"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        default:
+            out += "\\u00";
+            out += hex[c >> 4];
+            out += hex[c & 0xF];
+        }
+    }
+    out.append(text.data() + run, text.size() - run);
+    out += '"';
+}
+
+} // namespace manual
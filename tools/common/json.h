@@ -0,0 +1,53 @@
+//
+//  json.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "common/arena.h"
+
+namespace manual {
+
+struct JsonMember;
+
+/// 파싱한 JSON 값. 객체 멤버 순서를 보존하고 숫자는 원문 그대로 두므로, 다시 쓰면 DocC 출력과 같은 바이트가 된다.
+///
+/// 배열과 문자열은 파싱할 때 넘긴 아레나에 있다. 이스케이프가 없는 문자열은 원문을 그대로 가리킨다.
+struct JsonValue {
+    enum class Type : std::uint8_t { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    std::string_view text;   // String은 풀어 쓴 UTF-8, Number는 원문
+    Span<JsonValue> elements;
+    Span<JsonMember> members;
+
+    bool isString() const { return type == Type::String; }
+    bool isArray() const { return type == Type::Array; }
+    bool isObject() const { return type == Type::Object; }
+    /// 객체에서 `key`의 값. 없거나 객체가 아니면 `nullptr`.
+    const JsonValue* get(std::string_view key) const;
+};
+
+struct JsonMember {
+    std::string_view key;
+    JsonValue value;
+};
+
+/// `text`를 파싱한다. 결과는 `arena`와 `text`보다 오래 살 수 없다. 형식이 맞지 않으면 `std::runtime_error`를 던진다.
+JsonValue parseJson(std::string_view text, Arena& arena);
+
+/// `value`를 공백 없이 `out` 뒤에 붙인다.
+void appendJson(std::string& out, const JsonValue& value);
+
+/// `text`를 따옴표로 감싼 JSON 문자열로 `out` 뒤에 붙인다.
+/// DocC(Foundation `JSONEncoder`)처럼 값의 `/`는 `\/`로 쓰고, ASCII가 아닌 문자는 UTF-8 그대로 둔다.
+/// 객체 키는 `/`를 이스케이프하지 않으므로 `escapeSlash`를 끈다.
+void appendJsonString(std::string& out, std::string_view text, bool escapeSlash = true);
+
+} // namespace manual
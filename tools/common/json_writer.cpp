@@ -0,0 +1,24 @@
+//
+//  json_writer.cpp
+//  swiftUIManual tools
+//
+
+#include "common/json_writer.h"
+
+namespace manual {
+
+void JsonWriter::integer(std::int64_t value) {
+    separate();
+    char digits[24];
+    char* end = digits + sizeof digits;
+    char* at = end;
+    std::uint64_t magnitude = value < 0 ? 0 - std::uint64_t(value) : std::uint64_t(value);
+    do {
+        *--at = char('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) *--at = '-';
+    out_.append(at, std::size_t(end - at));
+}
+
+} // namespace manual
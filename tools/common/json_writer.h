@@ -0,0 +1,103 @@
+//
+//  json_writer.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/json.h"
+
+namespace manual {
+
+/// DOM을 만들지 않고 출력 버퍼에 JSON을 바로 쓴다. 쉼표를 넣을지는 중첩 단계마다 하나씩 기억한다.
+///
+/// 이스케이프 규칙은 `appendJsonString`과 같다. 버퍼는 호출자가 가지므로, 페이지마다 비우고 다시 쓰면 할당이 없다.
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : out_(out) {}
+
+    void beginObject() { open('{'); }
+    void endObject() { close('}'); }
+    void beginArray() { open('['); }
+    void endArray() { close(']'); }
+
+    /// 객체 키. 렌더 JSON은 키의 `/`를 이스케이프하지 않는다.
+    void key(std::string_view name) {
+        separate();
+        appendJsonString(out_, name, false);
+        out_ += ':';
+        afterKey_ = true;
+    }
+    /// 이스케이프할 문자가 없는 상수 키는 훑지 않고 바로 붙인다.
+    template <std::size_t N>
+    void key(const char (&name)[N]) {
+        separate();
+        out_ += '"';
+        out_.append(name, N - 1);
+        out_ += "\":";
+        afterKey_ = true;
+    }
+
+    void string(std::string_view text) {
+        separate();
+        appendJsonString(out_, text);
+    }
+    /// 숫자 원문을 그대로 쓴다.
+    void number(std::string_view literal) {
+        separate();
+        out_ += literal;
+    }
+    void integer(std::int64_t value);
+    void boolean(bool value) {
+        separate();
+        out_ += value ? "true" : "false";
+    }
+    void null() {
+        separate();
+        out_ += "null";
+    }
+    /// 파싱한 값을 키 순서 그대로 쓴다.
+    void value(const JsonValue& value) { appendJson(valueBuffer(), value); }
+
+    /// 호출자가 완성된 JSON 값 하나를 직접 붙일 수 있도록 구분자만 쓰고 버퍼를 돌려준다.
+    std::string& valueBuffer() {
+        separate();
+        return out_;
+    }
+
+    template <std::size_t N>
+    void field(const char (&name)[N], std::string_view text) {
+        key(name);
+        string(text);
+    }
+
+private:
+    void separate() {
+        if (afterKey_) {
+            afterKey_ = false;
+        } else if (!empty_.empty()) {
+            if (!empty_.back()) out_ += ',';
+            empty_.back() = 0;
+        }
+    }
+    void open(char bracket) {
+        separate();
+        out_ += bracket;
+        empty_.push_back(1);
+    }
+    void close(char bracket) {
+        empty_.pop_back();
+        out_ += bracket;
+    }
+
+    std::string& out_;
+    std::vector<std::uint8_t> empty_;   // 단계마다 아직 항목을 쓰지 않았는지
+    bool afterKey_ = false;
+};
+
+} // namespace manual
@@ -0,0 +1,70 @@
+//
+//  mapped_file.cpp
+//  swiftUIManual tools
+//
+
+#include "common/mapped_file.h"
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace manual {
+
+MappedFile::MappedFile(const std::string& path, Access access) : path_(path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "fstat " + path);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    // 빈 파일은 mmap 할 수 없으므로 빈 뷰로 둔다.
+    if (size_ > 0) {
+        void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "mmap " + path);
+        }
+        ::madvise(mapped, size_, access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+        data_ = static_cast<const char*>(mapped);
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() { release(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : path_(std::move(other.path_)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        path_ = std::move(other.path_);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+void MappedFile::release() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+} // namespace manual
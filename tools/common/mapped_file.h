@@ -0,0 +1,44 @@
+//
+//  mapped_file.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace manual {
+
+/// 파일을 읽기 전용으로 메모리에 매핑한다.
+///
+/// 매핑은 객체가 살아 있는 동안 유지되며, `bytes()`가 돌려주는 뷰는 복사 없이 파일 내용을 가리킨다.
+class MappedFile {
+public:
+    /// 커널에 알려 줄 접근 방식. 한 번 훑는 파일은 미리 읽기를, B 트리처럼 건너뛰는 파일은 그 반대를 원한다.
+    enum class Access { Sequential, Random };
+
+    /// `path`를 연다. 실패하면 `std::system_error`를 던진다.
+    explicit MappedFile(const std::string& path, Access access = Access::Sequential);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    std::string_view bytes() const { return {data_, size_}; }
+    const std::string& path() const { return path_; }
+
+private:
+    void release();
+
+    std::string path_;
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace manual
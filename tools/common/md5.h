@@ -0,0 +1,21 @@
+//
+//  md5.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace manual {
+
+/// MD5 요약. DocC 번들이 경로 키를 만들 때 쓰므로 그대로 맞춰야 한다(보안 용도가 아니다).
+std::array<std::uint8_t, 16> md5(std::string_view data);
+
+/// 요약 앞 `bytes`바이트를 소문자 16진수로 쓴다.
+std::string md5Hex(std::string_view data, std::size_t bytes = 16);
+
+} // namespace manual
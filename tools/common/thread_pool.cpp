@@ -0,0 +1,139 @@
+//
+//  thread_pool.cpp
+//  swiftUIManual tools
+//
+
+#include "common/thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace manual {
+
+namespace {
+
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local unsigned currentIndex = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned threads) {
+    unsigned count = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    workers_.reserve(count);
+    for (unsigned i = 0; i < count; ++i) workers_.push_back(std::make_unique<Worker>());
+    threads_.reserve(count);
+    for (unsigned i = 0; i < count; ++i) threads_.emplace_back([this, i] { run(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) thread.join();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    // 작업자 스레드가 넣는 작업은 자기 큐에, 바깥에서 넣는 작업은 큐를 돌아가며 넣는다.
+    unsigned index = currentPool == this ? currentIndex : nextQueue_.fetch_add(1) % size();
+    {
+        std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+        workers_[index]->tasks.push_back(std::move(task));
+    }
+    pending_.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_one();
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body) {
+    if (count == 0) return;
+
+    struct State {
+        std::atomic<std::size_t> next{0};
+        std::atomic<unsigned> active{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+
+    // 인덱스를 하나씩 원자적으로 가져가므로 크기가 들쭉날쭉한 항목도 고르게 나뉜다.
+    auto drain = [state, &body, count] {
+        while (true) {
+            std::size_t index = state->next.fetch_add(1);
+            if (index >= count) break;
+            try {
+                body(index);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->errorMutex);
+                if (!state->error) state->error = std::current_exception();
+                state->next.store(count);
+            }
+        }
+    };
+
+    unsigned helpers = unsigned(std::min<std::size_t>(size(), count - 1));
+    state->active.store(helpers);
+    for (unsigned i = 0; i < helpers; ++i) {
+        submit([state, drain] {
+            drain();
+            state->active.fetch_sub(1);
+        });
+    }
+
+    drain();
+    unsigned self = currentPool == this ? currentIndex : size();
+    while (state->active.load() != 0) {
+        if (!runOne(self)) std::this_thread::yield();
+    }
+    if (state->error) std::rethrow_exception(state->error);
+}
+
+void ThreadPool::run(unsigned index) {
+    currentPool = this;
+    currentIndex = index;
+    while (true) {
+        if (runOne(index)) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this] { return stopping_ || pending_.load() != 0; });
+        if (stopping_ && pending_.load() == 0) return;
+    }
+}
+
+bool ThreadPool::runOne(unsigned self) {
+    std::function<void()> task;
+    if ((self < size() && popLocal(self, task)) || steal(self, task)) {
+        pending_.fetch_sub(1);
+        task();
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::popLocal(unsigned index, std::function<void()>& task) {
+    Worker& worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) return false;
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(unsigned thief, std::function<void()>& task) {
+    unsigned count = size();
+    for (unsigned offset = 1; offset <= count; ++offset) {
+        unsigned victim = (thief + offset) % count;
+        if (victim == thief) continue;
+        Worker& worker = *workers_[victim];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.tasks.empty()) continue;
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+} // namespace manual
@@ -0,0 +1,62 @@
+//
+//  thread_pool.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace manual {
+
+/// 작업 훔치기(work-stealing) 방식의 스레드 풀.
+///
+/// 작업자마다 자기 큐를 가지고, 자기 큐가 비면 다른 작업자의 큐 앞쪽에서 작업을 가져온다.
+/// `parallelFor`를 기다리는 스레드도 대기하는 동안 남은 작업을 처리하므로, 작업 안에서
+/// 다시 `parallelFor`를 불러도 교착되지 않는다. 여러 인터페이스를 동시에 파싱할 때 이 성질을 쓴다.
+class ThreadPool {
+public:
+    /// `threads`가 0이면 하드웨어 스레드 수만큼 만든다.
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const { return unsigned(workers_.size()); }
+
+    void submit(std::function<void()> task);
+
+    /// `body(0)`부터 `body(count - 1)`까지 나눠 실행하고 모두 끝날 때까지 기다린다.
+    /// 실행 중 던져진 첫 번째 예외는 호출한 스레드에서 다시 던진다.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void run(unsigned index);
+    bool runOne(unsigned self);
+    bool popLocal(unsigned index, std::function<void()>& task);
+    bool steal(unsigned thief, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<unsigned> nextQueue_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+};
+
+} // namespace manual
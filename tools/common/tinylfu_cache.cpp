@@ -0,0 +1,203 @@
+//
+//  tinylfu_cache.cpp
+//  swiftUIManual tools
+//
+
+#include "common/tinylfu_cache.h"
+
+#include <algorithm>
+
+namespace manual {
+
+namespace {
+
+std::uint64_t mix(std::uint64_t value) {
+    value += 0x9e3779b97f4a7c15ull;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+    return value ^ (value >> 31);
+}
+
+constexpr std::uint64_t kRowSeeds[4] = {
+    0xc3a5c85c97cb3127ull, 0xb492b66fbe98f273ull, 0x9ae16a3b2f90404full, 0xcbf29ce484222325ull,
+};
+
+} // namespace
+
+// MARK: - 빈도 스케치
+
+FrequencySketch::FrequencySketch(std::size_t capacity) {
+    std::size_t counters = 64;
+    while (counters < capacity * 4) counters <<= 1;
+    words_.assign(counters / 16, 0);
+    counterMask_ = counters - 1;
+    resetAt_ = std::max<std::size_t>(capacity, 16) * 10;
+}
+
+std::size_t FrequencySketch::counterIndex(std::uint64_t hash, unsigned row) const {
+    return std::size_t(mix(hash ^ kRowSeeds[row])) & counterMask_;
+}
+
+void FrequencySketch::increment(std::uint64_t key) {
+    std::uint64_t hash = mix(key);
+    bool added = false;
+    for (unsigned row = 0; row < 4; ++row) {
+        std::size_t index = counterIndex(hash, row);
+        std::uint64_t& word = words_[index / 16];
+        unsigned shift = unsigned(index % 16) * 4;
+        if (((word >> shift) & 0xF) != 0xF) {
+            word += std::uint64_t(1) << shift;
+            added = true;
+        }
+    }
+    if (added && ++additions_ >= resetAt_) halve();
+}
+
+unsigned FrequencySketch::estimate(std::uint64_t key) const {
+    std::uint64_t hash = mix(key);
+    unsigned frequency = 0xF;
+    for (unsigned row = 0; row < 4; ++row) {
+        std::size_t index = counterIndex(hash, row);
+        unsigned shift = unsigned(index % 16) * 4;
+        frequency = std::min(frequency, unsigned((words_[index / 16] >> shift) & 0xF));
+    }
+    return frequency;
+}
+
+void FrequencySketch::halve() {
+    for (auto& word : words_) word = (word >> 1) & 0x7777777777777777ull;
+    additions_ /= 2;
+}
+
+// MARK: - 캐시
+
+TinyLfuCache::Stats& TinyLfuCache::Stats::operator+=(const Stats& other) {
+    hits += other.hits;
+    misses += other.misses;
+    admitted += other.admitted;
+    rejected += other.rejected;
+    evicted += other.evicted;
+    entries += other.entries;
+    bytes += other.bytes;
+    return *this;
+}
+
+TinyLfuCache::TinyLfuCache(std::size_t budget, std::size_t expectedEntries) : sketch_(expectedEntries) {
+    windowBudget_ = std::max<std::size_t>(budget / 100, 1);
+    mainBudget_ = budget > windowBudget_ ? budget - windowBudget_ : 0;
+    protectedBudget_ = mainBudget_ / 5 * 4;
+}
+
+TinyLfuCache::List& TinyLfuCache::list(Segment segment) {
+    switch (segment) {
+    case Segment::Window: return window_;
+    case Segment::Probation: return probation_;
+    case Segment::Protected: break;
+    }
+    return protected_;
+}
+
+std::size_t& TinyLfuCache::bytes(Segment segment) {
+    switch (segment) {
+    case Segment::Window: return windowBytes_;
+    case Segment::Probation: return probationBytes_;
+    case Segment::Protected: break;
+    }
+    return protectedBytes_;
+}
+
+void TinyLfuCache::move(List::iterator entry, Segment segment) {
+    bytes(entry->segment) -= entry->value.size();
+    list(segment).splice(list(segment).begin(), list(entry->segment), entry);
+    entry->segment = segment;
+    bytes(segment) += entry->value.size();
+}
+
+void TinyLfuCache::erase(List::iterator entry) {
+    bytes(entry->segment) -= entry->value.size();
+    index_.erase(entry->key);
+    list(entry->segment).erase(entry);
+}
+
+const std::string* TinyLfuCache::get(std::uint64_t key) {
+    sketch_.increment(key);
+    auto found = index_.find(key);
+    if (found == index_.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    List::iterator entry = found->second;
+    if (entry->segment == Segment::Probation) {
+        // 수습 구역에서 다시 쓰이면 보호 구역으로 올리고, 넘친 만큼 보호 구역의 가장 오래된 항목을 내린다.
+        move(entry, Segment::Protected);
+        while (protectedBytes_ > protectedBudget_ && protected_.size() > 1) {
+            move(std::prev(protected_.end()), Segment::Probation);
+        }
+    } else {
+        move(entry, entry->segment);
+    }
+    return &entry->value;
+}
+
+void TinyLfuCache::put(std::uint64_t key, std::string value) {
+    if (value.size() > mainBudget_) return;
+    auto found = index_.find(key);
+    if (found != index_.end()) erase(found->second);
+    window_.push_front({key, std::move(value), Segment::Window});
+    windowBytes_ += window_.front().value.size();
+    index_[key] = window_.begin();
+    evictWindow();
+    entries_.store(index_.size(), std::memory_order_relaxed);
+    bytes_.store(windowBytes_ + probationBytes_ + protectedBytes_, std::memory_order_relaxed);
+}
+
+/// 창이 넘치면 가장 오래된 항목을 후보로, 주 영역의 첫 희생자와 빈도를 비교해 들일지 정한다.
+/// 들일지는 아무것도 지우기 전에 정하므로, 거절된 후보가 주 영역 항목을 먼저 쫓아내는 일이 없다.
+void TinyLfuCache::evictWindow() {
+    while (windowBytes_ > windowBudget_ && !window_.empty()) {
+        List::iterator candidate = std::prev(window_.end());
+        std::size_t excess = probationBytes_ + protectedBytes_ + candidate->value.size();
+        excess = excess > mainBudget_ ? excess - mainBudget_ : 0;
+
+        // 수습 구역 끝부터, 모자라면 보호 구역 끝부터 후보가 밀어낼 희생자를 센다.
+        std::size_t victims = 0;
+        std::size_t freed = 0;
+        const Entry* first = nullptr;
+        for (List* segment : {&probation_, &protected_}) {
+            for (auto victim = segment->rbegin(); victim != segment->rend() && freed < excess; ++victim) {
+                if (first == nullptr) first = &*victim;
+                freed += victim->value.size();
+                ++victims;
+            }
+        }
+        bool admit = freed >= excess &&
+                     (first == nullptr || sketch_.estimate(candidate->key) > sketch_.estimate(first->key));
+        if (!admit) {
+            erase(candidate);
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        for (; victims > 0; --victims) {
+            List& segment = !probation_.empty() ? probation_ : protected_;
+            erase(std::prev(segment.end()));
+            evicted_.fetch_add(1, std::memory_order_relaxed);
+        }
+        move(candidate, Segment::Probation);
+        admitted_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+TinyLfuCache::Stats TinyLfuCache::stats() const {
+    Stats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.admitted = admitted_.load(std::memory_order_relaxed);
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    stats.evicted = evicted_.load(std::memory_order_relaxed);
+    stats.entries = entries_.load(std::memory_order_relaxed);
+    stats.bytes = bytes_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace manual
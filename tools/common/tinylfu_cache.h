@@ -0,0 +1,98 @@
+//
+//  tinylfu_cache.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace manual {
+
+/// 최근 요청 빈도를 4비트 카운터 4줄로 어림하는 count-min 스케치.
+///
+/// 더한 횟수가 카운터 수의 10배가 되면 모든 카운터를 반으로 줄여, 오래전 인기는 점점 잊는다.
+class FrequencySketch {
+public:
+    /// `capacity`는 기억하려는 서로 다른 키의 수다.
+    explicit FrequencySketch(std::size_t capacity);
+
+    void increment(std::uint64_t key);
+    /// 0~15
+    unsigned estimate(std::uint64_t key) const;
+
+private:
+    std::size_t counterIndex(std::uint64_t hash, unsigned row) const;
+    void halve();
+
+    std::vector<std::uint64_t> words_;   // 단어마다 4비트 카운터 16개
+    std::size_t counterMask_ = 0;
+    std::size_t additions_ = 0;
+    std::size_t resetAt_ = 0;
+};
+
+/// 바이트 예산 안에서 자주 요청되는 값을 메모리에 두는 W-TinyLFU 캐시.
+///
+/// 새 항목은 작은 LRU 창(예산의 1%)에 먼저 들어가고, 창에서 밀려날 때 빈도 스케치로 본 인기가
+/// 주 영역(구획 LRU: 수습 20%, 보호 80%)에서 쫓겨날 항목보다 높을 때만 들어간다.
+/// 한 번 보고 마는 요청이 자주 쓰는 페이지를 밀어내지 못한다. 스레드 하나가 쓰는 것을 전제로 하며,
+/// 통계만 다른 스레드에서 읽어도 된다.
+class TinyLfuCache {
+public:
+    struct Stats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t admitted = 0;   // 창에서 주 영역으로 올라간 항목
+        std::uint64_t rejected = 0;   // 빈도가 낮아 창에서 버린 항목
+        std::uint64_t evicted = 0;    // 주 영역에서 쫓겨난 항목
+        std::uint64_t entries = 0;
+        std::uint64_t bytes = 0;
+
+        Stats& operator+=(const Stats& other);
+    };
+
+    /// `budget`은 값 바이트의 상한이다. `expectedEntries`로 스케치 크기를 정한다.
+    TinyLfuCache(std::size_t budget, std::size_t expectedEntries);
+
+    /// 있으면 값을 돌려주고 없으면 `nullptr`. 어느 쪽이든 빈도를 센다. 포인터는 다음 `put`까지 유효하다.
+    const std::string* get(std::uint64_t key);
+    /// 스케치가 어림한 최근 요청 수(0~15). 값을 만드는 비용이 있으면 이것으로 넣을지 먼저 고른다.
+    unsigned frequency(std::uint64_t key) const { return sketch_.estimate(key); }
+    /// `get`이 놓친 값을 넣는다. 예산보다 큰 값은 넣지 않는다.
+    void put(std::uint64_t key, std::string value);
+
+    Stats stats() const;
+    std::size_t budget() const { return windowBudget_ + mainBudget_; }
+
+private:
+    enum class Segment : std::uint8_t { Window, Probation, Protected };
+
+    struct Entry {
+        std::uint64_t key;
+        std::string value;
+        Segment segment;
+    };
+    using List = std::list<Entry>;
+
+    List& list(Segment segment);
+    std::size_t& bytes(Segment segment);
+    void move(List::iterator entry, Segment segment);
+    void erase(List::iterator entry);
+    void evictWindow();
+
+    FrequencySketch sketch_;
+    std::unordered_map<std::uint64_t, List::iterator> index_;
+    List window_, probation_, protected_;   // 앞이 가장 최근
+    std::size_t windowBytes_ = 0, probationBytes_ = 0, protectedBytes_ = 0;
+    std::size_t windowBudget_ = 0, mainBudget_ = 0, protectedBudget_ = 0;
+
+    std::atomic<std::uint64_t> hits_{0}, misses_{0}, admitted_{0}, rejected_{0}, evicted_{0};
+    std::atomic<std::uint64_t> entries_{0}, bytes_{0};
+};
+
+} // namespace manual
@@ -0,0 +1,389 @@
+//
+//  api_diff.cpp
+//  swiftUIManual tools
+//
+
+#include "interface/api_diff.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+#include "common/interner.h"
+
+namespace manual {
+
+namespace {
+
+bool isPunct(const TokenStream& stream, std::size_t index, std::string_view text) {
+    const Token& token = stream.tokens[index];
+    return token.kind == TokenKind::Punct && stream.text(token) == text;
+}
+
+/// 토큰 `[begin, end)`를 붙여 쓴다. 원문에서 떨어져 있던 토큰 사이에만 공백 한 칸을 넣고 주석은 뺀다.
+void appendTokens(const TokenStream& stream, std::size_t begin, std::size_t end, std::string& out) {
+    const Token* previous = nullptr;
+    for (std::size_t i = begin; i < end; ++i) {
+        const Token& token = stream.tokens[i];
+        if (token.kind == TokenKind::Comment) continue;
+        if (previous != nullptr && previous->offset + previous->length != token.offset) out += ' ';
+        out += stream.text(token);
+        previous = &token;
+    }
+}
+
+/// 선언부에서 괄호 밖의 첫 `where`. 없으면 `bodyToken`.
+std::size_t findWhere(const TokenStream& stream, const Decl& decl) {
+    int nesting = 0;
+    for (std::size_t i = decl.headerToken; i < decl.bodyToken; ++i) {
+        const Token& token = stream.tokens[i];
+        if (token.kind == TokenKind::LParen || token.kind == TokenKind::LBracket) {
+            ++nesting;
+        } else if (token.kind == TokenKind::RParen || token.kind == TokenKind::RBracket) {
+            --nesting;
+        } else if (nesting == 0 && token.keyword() == Keyword::Where) {
+            return i;
+        }
+    }
+    return decl.bodyToken;
+}
+
+/// 확장이 더하는 순응 목록(`extension Text : Equatable`의 `Equatable`)의 시작. 없으면 `where` 위치.
+std::size_t findConformances(const TokenStream& stream, const Decl& decl, std::size_t where) {
+    for (std::size_t i = decl.headerToken; i < where; ++i) {
+        if (isPunct(stream, i, ":")) return i + 1;
+    }
+    return where;
+}
+
+bool takesParameters(DeclKind kind) {
+    return kind == DeclKind::Func || kind == DeclKind::Init || kind == DeclKind::Subscript;
+}
+
+/// 매개변수 목록의 형식만 쉼표로 잇는다. 레이블과 내부 이름은 이미 선언 이름에 있고, 기본값은 오버로드를 가르지 않는다.
+void appendParameterTypes(const TokenStream& stream, const Decl& decl, std::string& out) {
+    std::size_t i = decl.headerToken;
+    while (i < decl.bodyToken && stream.tokens[i].keyword() != Keyword::Func &&
+           stream.tokens[i].keyword() != Keyword::Init && stream.tokens[i].keyword() != Keyword::Subscript) {
+        ++i;
+    }
+    while (i < decl.bodyToken && stream.tokens[i].kind != TokenKind::LParen) ++i;
+    if (i == decl.bodyToken) return;
+
+    out += '(';
+    int nesting = 0;   // `()`, `[]`, `<>` 깊이
+    bool inType = false;
+    bool inDefault = false;
+    std::size_t typeBegin = 0;
+    auto flush = [&](std::size_t end) {
+        if (inType) appendTokens(stream, typeBegin, end, out);
+        inType = false;
+        inDefault = false;
+    };
+    for (++i; i < decl.bodyToken; ++i) {
+        const Token& token = stream.tokens[i];
+        if (nesting == 0) {
+            if (token.kind == TokenKind::RParen) {
+                flush(i);
+                break;
+            }
+            if (isPunct(stream, i, ",")) {
+                flush(i);
+                out += ',';
+                continue;
+            }
+            if (!inType && !inDefault && isPunct(stream, i, ":")) {
+                inType = true;
+                typeBegin = i + 1;
+                continue;
+            }
+            if (inType && isPunct(stream, i, "=")) {
+                flush(i);
+                inDefault = true;
+                continue;
+            }
+        }
+        if (token.kind == TokenKind::LParen || token.kind == TokenKind::LBracket) {
+            ++nesting;
+        } else if (token.kind == TokenKind::RParen || token.kind == TokenKind::RBracket) {
+            --nesting;
+        } else if (token.kind == TokenKind::Punct && stream.text(token) != "->") {
+            for (char c : stream.text(token)) nesting += c == '<' ? 1 : c == '>' ? -1 : 0;
+        }
+    }
+    out += ')';
+}
+
+/// 한 심벌 표의 키를 만든다. 부모가 항상 자식보다 앞에 있으므로 둘러싼 경로를 한 번씩만 만든다.
+class KeyBuilder {
+public:
+    explicit KeyBuilder(const SymbolTable& table) : table_(table), stream_(table.tokens()) {}
+
+    /// 멤버의 키 앞에 붙는 경로. 확장은 확장한 타입 이름과 `where` 제약이다.
+    std::string context(std::size_t index) const {
+        const Decl& decl = table_[index];
+        std::string path;
+        if (decl.parent != kNoDecl) {
+            path = context(std::size_t(decl.parent));
+            path += '.';
+        }
+        appendContext(decl, path);
+        return path;
+    }
+
+    void appendContext(const Decl& decl, std::string& out) const {
+        out += table_.name(decl);
+        if (decl.kind == DeclKind::Extension) {
+            std::size_t where = findWhere(stream_, decl);
+            if (where < decl.bodyToken) {
+                out += " where ";
+                appendTokens(stream_, where + 1, decl.bodyToken, out);
+            }
+        }
+    }
+
+    /// `parentContext`는 부모의 `context()`. 비교하지 않는 선언이면 `false`.
+    bool key(std::size_t index, std::string_view parentContext, std::string& out) const {
+        const Decl& decl = table_[index];
+        out.clear();
+        if (decl.kind == DeclKind::Extension) {
+            std::size_t where = findWhere(stream_, decl);
+            std::size_t conformances = findConformances(stream_, decl, where);
+            if (conformances == where) return false;
+            out += "extension ";
+            out += table_.name(decl);
+            out += " : ";
+            appendTokens(stream_, conformances, where, out);
+            if (where < decl.bodyToken) {
+                out += " where ";
+                appendTokens(stream_, where + 1, decl.bodyToken, out);
+            }
+            return true;
+        }
+        if (decl.kind == DeclKind::Import) {
+            out += "import ";
+            out += table_.name(decl);
+            return true;
+        }
+        if (!parentContext.empty()) {
+            out += parentContext;
+            out += '.';
+        }
+        out += table_.name(decl);
+        if (takesParameters(decl.kind)) appendParameterTypes(stream_, decl, out);
+        if ((decl.flags & kDeclStatic) != 0) out += " static";
+        return true;
+    }
+
+private:
+    const SymbolTable& table_;
+    const TokenStream& stream_;
+};
+
+struct KeyedDecl {
+    Symbol key;
+    std::uint32_t decl;
+
+    friend bool operator<(const KeyedDecl& lhs, const KeyedDecl& rhs) {
+        return lhs.key != rhs.key ? lhs.key < rhs.key : lhs.decl < rhs.decl;
+    }
+};
+
+std::vector<KeyedDecl> keyDecls(const SymbolTable& table, StringInterner& keys) {
+    KeyBuilder builder(table);
+    std::vector<KeyedDecl> keyed;
+    keyed.reserve(table.size());
+    std::vector<Symbol> contexts(table.size(), kEmptySymbol);
+    std::string context;
+    std::string key;
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        const Decl& decl = table[i];
+        std::string_view parent = decl.parent == kNoDecl ? std::string_view() : keys[contexts[std::size_t(decl.parent)]];
+        if (isContainer(decl.kind)) {
+            context.assign(parent);
+            if (!context.empty()) context += '.';
+            builder.appendContext(decl, context);
+            contexts[i] = keys.intern(context);
+        }
+        if (builder.key(i, parent, key)) keyed.push_back({keys.intern(key), std::uint32_t(i)});
+    }
+    std::sort(keyed.begin(), keyed.end());
+    return keyed;
+}
+
+bool sameHeader(const SymbolTable& before, const Decl& lhs, const SymbolTable& after, const Decl& rhs) {
+    const TokenStream& left = before.tokens();
+    const TokenStream& right = after.tokens();
+    std::size_t i = lhs.headerToken;
+    std::size_t j = rhs.headerToken;
+    while (true) {
+        while (i < lhs.bodyToken && left.tokens[i].kind == TokenKind::Comment) ++i;
+        while (j < rhs.bodyToken && right.tokens[j].kind == TokenKind::Comment) ++j;
+        if (i == lhs.bodyToken || j == rhs.bodyToken) return i == lhs.bodyToken && j == rhs.bodyToken;
+        if (left.text(left.tokens[i]) != right.text(right.tokens[j])) return false;
+        ++i;
+        ++j;
+    }
+}
+
+std::size_t flagIndex(ApiChangeFlags flag) {
+    std::size_t index = 0;
+    while ((1u << index) != unsigned(flag)) ++index;
+    return index;
+}
+
+} // namespace
+
+std::size_t ApiDiff::count(ApiChangeFlags flag) const { return counts[flagIndex(flag)]; }
+
+std::string apiKey(const SymbolTable& table, std::size_t index) {
+    KeyBuilder builder(table);
+    const Decl& decl = table[index];
+    std::string parent = decl.parent == kNoDecl ? std::string() : builder.context(std::size_t(decl.parent));
+    std::string key;
+    builder.key(index, parent, key);
+    return key;
+}
+
+std::vector<Availability> effectiveAvailabilities(const SymbolTable& table) {
+    std::vector<Availability> result(table.size());
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        const Decl& decl = table[i];
+        result[i] = table.availability(decl);
+        if (decl.parent != kNoDecl) result[i].inherit(result[std::size_t(decl.parent)]);
+    }
+    return result;
+}
+
+ApiDiff diffInterfaces(const SymbolTable& before, const SymbolTable& after) {
+    StringInterner keys;
+    std::vector<KeyedDecl> left = keyDecls(before, keys);
+    std::vector<KeyedDecl> right = keyDecls(after, keys);
+
+    // 정렬한 두 목록을 나란히 훑어 같은 키끼리 선언 순서대로 짝짓는다.
+    std::vector<std::int32_t> partner(after.size(), kNoDecl);
+    std::vector<std::uint32_t> removed;
+    std::vector<std::uint32_t> added;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < left.size() || j < right.size()) {
+        if (j == right.size() || (i < left.size() && left[i].key < right[j].key)) {
+            removed.push_back(left[i++].decl);
+        } else if (i == left.size() || right[j].key < left[i].key) {
+            added.push_back(right[j++].decl);
+        } else {
+            partner[right[j].decl] = std::int32_t(left[i].decl);
+            ++i;
+            ++j;
+        }
+    }
+
+    // 키가 어긋난 선언 중 한정 이름이 같은 것이 양쪽에 하나씩뿐이면 같은 선언의 선언부가 바뀐 것으로 본다.
+    struct Unmatched {
+        std::size_t removed = 0;
+        std::size_t added = 0;
+        std::uint32_t lastRemoved = 0;
+        std::uint32_t lastAdded = 0;
+    };
+    std::unordered_map<std::string_view, Unmatched> byName;
+    for (std::uint32_t index : removed) {
+        Unmatched& entry = byName[before.qualifiedName(before[index])];
+        ++entry.removed;
+        entry.lastRemoved = index;
+    }
+    for (std::uint32_t index : added) {
+        auto it = byName.find(after.qualifiedName(after[index]));
+        if (it == byName.end()) continue;
+        ++it->second.added;
+        it->second.lastAdded = index;
+    }
+    std::vector<bool> paired(before.size(), false);
+    for (const auto& [name, entry] : byName) {
+        if (entry.removed != 1 || entry.added != 1) continue;
+        partner[entry.lastAdded] = std::int32_t(entry.lastRemoved);
+        paired[entry.lastRemoved] = true;
+    }
+
+    std::vector<Availability> oldAvailability = effectiveAvailabilities(before);
+    std::vector<Availability> newAvailability = effectiveAvailabilities(after);
+
+    ApiDiff diff;
+    std::vector<bool> keyed(after.size(), false);
+    for (const auto& entry : right) keyed[entry.decl] = true;
+    for (std::size_t index = 0; index < after.size(); ++index) {
+        if (!keyed[index]) continue;
+        ApiChange change;
+        change.newDecl = std::int32_t(index);
+        change.oldDecl = partner[index];
+        if (change.oldDecl == kNoDecl) {
+            change.flags = kApiAdded;
+        } else {
+            auto old = std::size_t(change.oldDecl);
+            // 이름으로 짝지은 선언은 키(둘러싼 제약이나 매개변수 형식)가 이미 다르다.
+            if (paired[old] || !sameHeader(before, before[old], after, after[index])) change.flags |= kApiSignature;
+            if (oldAvailability[old] != newAvailability[index]) change.flags |= kApiAvailability;
+        }
+        if (change.flags == 0) {
+            ++diff.unchanged;
+        } else {
+            diff.changes.push_back(change);
+        }
+    }
+    std::sort(removed.begin(), removed.end());
+    for (std::uint32_t index : removed) {
+        if (paired[index]) continue;
+        ApiChange change;
+        change.flags = kApiRemoved;
+        change.oldDecl = std::int32_t(index);
+        diff.changes.push_back(change);
+    }
+    for (const auto& change : diff.changes) {
+        for (std::size_t bit = 0; bit < 4; ++bit) diff.counts[bit] += (change.flags >> bit) & 1u;
+    }
+    return diff;
+}
+
+std::string describeAvailabilityChange(const Availability& before, const Availability& after) {
+    std::string text;
+    auto append = [&text](std::string_view part) {
+        if (!text.empty()) text += ", ";
+        text += part;
+    };
+    if (before.unavailableEverywhere != after.unavailableEverywhere) {
+        append(after.unavailableEverywhere ? "* unavailable" : "* available");
+    }
+    if (before.deprecatedEverywhere != after.deprecatedEverywhere) {
+        append(after.deprecatedEverywhere ? "* deprecated" : "* undeprecated");
+    }
+    auto version = [](Version value) { return value.empty() ? std::string("-") : value.string(); };
+    for (std::size_t i = 0; i < kPlatformCount; ++i) {
+        auto platform = Platform(i);
+        const PlatformAvailability& lhs = before[platform];
+        const PlatformAvailability& rhs = after[platform];
+        if (before.mentions(platform) != after.mentions(platform)) {
+            std::string part(platformName(platform));
+            part += after.mentions(platform) ? " added" : " dropped";
+            append(part);
+            continue;
+        }
+        if (lhs == rhs) continue;
+        std::string part(platformName(platform));
+        if (lhs.unavailable != rhs.unavailable) part += rhs.unavailable ? " unavailable" : " available";
+        if (lhs.introduced != rhs.introduced) {
+            part += " " + version(lhs.introduced) + " → " + version(rhs.introduced);
+        }
+        if (lhs.deprecated != rhs.deprecated || lhs.isDeprecated() != rhs.isDeprecated()) {
+            if (!rhs.isDeprecated()) {
+                part += " undeprecated";
+            } else {
+                part += " deprecated";
+                if (!rhs.deprecated.empty()) part += " " + rhs.deprecated.string();
+            }
+        }
+        if (lhs.obsoleted != rhs.obsoleted) part += " obsoleted " + version(rhs.obsoleted);
+        append(part);
+    }
+    return text;
+}
+
+} // namespace manual
@@ -0,0 +1,56 @@
+//
+//  api_diff.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "interface/availability.h"
+#include "interface/symbol_table.h"
+
+namespace manual {
+
+enum ApiChangeFlags : std::uint8_t {
+    kApiAdded = 1 << 0,
+    kApiRemoved = 1 << 1,
+    kApiSignature = 1 << 2,      // 선언부(속성과 본문 제외)가 바뀌었다
+    kApiAvailability = 1 << 3,   // 둘러싼 선언에서 물려받은 것까지 합친 가용성이 바뀌었다
+};
+
+/// 두 인터페이스 사이에서 바뀐 선언 하나. 추가는 `oldDecl`이, 삭제는 `newDecl`이 `kNoDecl`이다.
+struct ApiChange {
+    std::uint8_t flags = 0;
+    std::int32_t oldDecl = kNoDecl;
+    std::int32_t newDecl = kNoDecl;
+};
+
+struct ApiDiff {
+    /// 새 인터페이스의 선언 순서, 이어서 삭제된 선언을 이전 인터페이스의 순서로 둔다.
+    std::vector<ApiChange> changes;
+    std::size_t unchanged = 0;
+    std::size_t counts[4] = {};   // 추가, 삭제, 선언부, 가용성
+
+    std::size_t count(ApiChangeFlags flag) const;
+};
+
+/// 선언마다 USR처럼 쓰는 키를 만든다: 둘러싼 타입 경로(확장이면 `where` 제약 포함), 이름과 인자 레이블,
+/// 함수류는 매개변수 형식, `static` 여부. 확장 블록의 위치나 순서, 들여쓰기는 키에 들어가지 않는다.
+/// 순응을 더하지 않는 확장(`extension View { ... }`)은 멤버를 담는 그릇일 뿐이므로 비교하지 않는다.
+std::string apiKey(const SymbolTable& table, std::size_t index);
+
+/// 키가 같은 선언끼리 짝지어 선언부와 가용성을 비교한다.
+/// 키로 짝을 못 찾은 선언 중 한정 이름이 같은 것이 양쪽에 하나씩이면 삭제+추가 대신 선언부 변경으로 본다.
+ApiDiff diffInterfaces(const SymbolTable& before, const SymbolTable& after);
+
+/// `iOS 15.0 → 16.0, macOS deprecated 13.0`처럼 가용성 차이를 플랫폼별로 요약한다.
+std::string describeAvailabilityChange(const Availability& before, const Availability& after);
+
+/// 둘러싼 선언의 가용성을 물려받은 선언별 가용성.
+std::vector<Availability> effectiveAvailabilities(const SymbolTable& table);
+
+} // namespace manual
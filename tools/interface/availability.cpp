@@ -0,0 +1,210 @@
+//
+//  availability.cpp
+//  swiftUIManual tools
+//
+
+#include "interface/availability.h"
+
+#include "common/hash.h"
+
+namespace manual {
+
+namespace {
+
+constexpr std::string_view kPlatformNames[kPlatformCount] = {"iOS", "macOS", "tvOS", "watchOS", "macCatalyst"};
+
+bool isComma(const TokenStream& stream, const Token& token) {
+    return token.kind == TokenKind::Punct && stream.text(token) == ",";
+}
+
+bool isColon(const TokenStream& stream, const Token& token) {
+    return token.kind == TokenKind::Punct && stream.text(token) == ":";
+}
+
+std::uint64_t hashAvailability(const Availability& availability) {
+    std::uint64_t hash = hashCombine(availability.mentioned, (availability.unavailableEverywhere ? 1u : 0u) |
+                                                                 (availability.deprecatedEverywhere ? 2u : 0u));
+    for (const auto& info : availability.platforms) {
+        hash = hashCombine(hash, info.introduced.key());
+        hash = hashCombine(hash, info.deprecated.key());
+        hash = hashCombine(hash, info.obsoleted.key());
+        hash = hashCombine(hash, (info.unavailable ? 1u : 0u) | (info.deprecatedUnversioned ? 2u : 0u));
+    }
+    return hash;
+}
+
+} // namespace
+
+std::string_view platformName(Platform platform) { return kPlatformNames[std::size_t(platform)]; }
+
+std::optional<Platform> platformNamed(std::string_view name) {
+    for (std::size_t i = 0; i < kPlatformCount; ++i) {
+        if (kPlatformNames[i] == name) return Platform(i);
+    }
+    if (name == "Mac Catalyst") return Platform::macCatalyst;
+    if (name == "OSX") return Platform::macOS;
+    return std::nullopt;
+}
+
+std::string Version::string() const {
+    std::string text = std::to_string(major) + "." + std::to_string(minor);
+    if (patch != 0) text += "." + std::to_string(patch);
+    return text;
+}
+
+Version Version::parse(std::string_view text) {
+    std::uint32_t parts[3] = {0, 0, 0};
+    std::size_t part = 0;
+    for (char c : text) {
+        if (c == '.') {
+            if (++part == 3) break;
+        } else if (c >= '0' && c <= '9') {
+            parts[part] = parts[part] * 10 + std::uint32_t(c - '0');
+        } else {
+            break;
+        }
+    }
+    return Version{parts[0], std::uint16_t(parts[1]), std::uint16_t(parts[2])};
+}
+
+PlatformAvailability& Availability::entry(Platform platform) {
+    mentioned |= std::uint8_t(1u << unsigned(platform));
+    return platforms[std::size_t(platform)];
+}
+
+bool Availability::isAvailable(Platform platform, Version version) const {
+    if (unavailableEverywhere) return false;
+    // Mac Catalyst는 따로 적혀 있지 않으면 iOS 정보를 따른다.
+    if (platform == Platform::macCatalyst && !mentions(platform) && mentions(Platform::iOS)) {
+        platform = Platform::iOS;
+    }
+    if (!mentions(platform)) return true;
+    const PlatformAvailability& info = (*this)[platform];
+    if (info.unavailable) return false;
+    if (!info.introduced.empty() && version < info.introduced) return false;
+    if (!info.obsoleted.empty() && info.obsoleted <= version) return false;
+    return true;
+}
+
+void Availability::inherit(const Availability& outer) {
+    for (std::size_t i = 0; i < kPlatformCount; ++i) {
+        auto platform = Platform(i);
+        if (!mentions(platform) && outer.mentions(platform)) entry(platform) = outer[platform];
+    }
+    unavailableEverywhere = unavailableEverywhere || outer.unavailableEverywhere;
+}
+
+std::string Availability::summary() const {
+    std::string text;
+    auto append = [&text](std::string_view part) {
+        if (!text.empty()) text += ", ";
+        text += part;
+    };
+    if (unavailableEverywhere) append("* unavailable");
+    if (deprecatedEverywhere) append("* deprecated");
+    for (std::size_t i = 0; i < kPlatformCount; ++i) {
+        auto platform = Platform(i);
+        if (!mentions(platform)) continue;
+        const PlatformAvailability& info = (*this)[platform];
+        std::string part(platformName(platform));
+        if (info.unavailable) {
+            part += " unavailable";
+        } else {
+            if (!info.introduced.empty()) part += " " + info.introduced.string();
+            if (!info.deprecated.empty()) {
+                part += " deprecated " + info.deprecated.string();
+            } else if (info.deprecatedUnversioned) {
+                part += " deprecated";
+            }
+            if (!info.obsoleted.empty()) part += " obsoleted " + info.obsoleted.string();
+        }
+        append(part);
+    }
+    return text;
+}
+
+AvailabilityTable::AvailabilityTable() { intern(Availability{}); }
+
+AvailabilityId AvailabilityTable::intern(const Availability& availability) {
+    std::uint64_t hash = hashAvailability(availability);
+    auto range = byHash_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (values_[it->second] == availability) return it->second;
+    }
+    auto id = AvailabilityId(values_.size());
+    values_.push_back(availability);
+    byHash_.emplace(hash, id);
+    return id;
+}
+
+std::size_t AvailabilityTable::memoryUsage() const {
+    return values_.capacity() * sizeof(Availability) +
+           byHash_.size() * (sizeof(std::uint64_t) + sizeof(AvailabilityId) + 2 * sizeof(void*)) +
+           byHash_.bucket_count() * sizeof(void*);
+}
+
+void parseAvailabilityArguments(const TokenStream& stream, std::size_t open, std::size_t close, Availability& into) {
+    // 쉼표로 나눈 인자 구간 [begin, end)의 목록을 차례로 본다.
+    std::size_t begin = open + 1;
+    std::optional<Platform> longhandPlatform;
+    bool wildcard = false;
+    bool first = true;
+    while (begin < close) {
+        std::size_t end = begin;
+        while (end < close && !isComma(stream, stream.tokens[end])) ++end;
+        const Token& head = stream.tokens[begin];
+        std::string_view word = stream.text(head);
+
+        if (first) {
+            first = false;
+            if (word == "*") {
+                wildcard = true;
+            } else if (end - begin >= 2 && stream.tokens[begin + 1].kind == TokenKind::Number) {
+                // 줄임꼴: `@available(iOS 13.0, macOS 10.15, *)`
+                for (std::size_t i = begin; i < close;) {
+                    std::size_t next = i;
+                    while (next < close && !isComma(stream, stream.tokens[next])) ++next;
+                    if (next - i >= 2 && stream.tokens[i + 1].kind == TokenKind::Number) {
+                        if (auto platform = platformNamed(stream.text(stream.tokens[i]))) {
+                            into.entry(*platform).introduced = Version::parse(stream.text(stream.tokens[i + 1]));
+                        }
+                    }
+                    i = next + 1;
+                }
+                return;
+            } else {
+                longhandPlatform = platformNamed(word);
+                // 모르는 플랫폼(`iOSApplicationExtension` 등)은 통째로 건너뛴다.
+                if (!longhandPlatform) return;
+                into.entry(*longhandPlatform);
+            }
+            begin = end + 1;
+            continue;
+        }
+
+        bool hasValue = end - begin >= 3 && isColon(stream, stream.tokens[begin + 1]);
+        Version value = hasValue ? Version::parse(stream.text(stream.tokens[begin + 2])) : Version{};
+        if (wildcard) {
+            if (word == "unavailable") into.unavailableEverywhere = true;
+            if (word == "deprecated") into.deprecatedEverywhere = true;
+        } else {
+            PlatformAvailability& info = into.entry(*longhandPlatform);
+            if (word == "unavailable") {
+                info.unavailable = true;
+            } else if (word == "introduced" && hasValue) {
+                info.introduced = value;
+            } else if (word == "deprecated") {
+                if (hasValue) {
+                    info.deprecated = value;
+                } else {
+                    info.deprecatedUnversioned = true;
+                }
+            } else if (word == "obsoleted" && hasValue) {
+                info.obsoleted = value;
+            }
+        }
+        begin = end + 1;
+    }
+}
+
+} // namespace manual
@@ -0,0 +1,119 @@
+//
+//  availability.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "interface/lexer.h"
+
+namespace manual {
+
+/// DocC 번들이 구분하는 플랫폼. 값은 비트 위치로도 쓴다.
+enum class Platform : std::uint8_t {
+    iOS,
+    macOS,
+    tvOS,
+    watchOS,
+    macCatalyst,
+};
+constexpr std::size_t kPlatformCount = 5;
+
+std::string_view platformName(Platform platform);
+/// `@available`에 쓰는 이름(`iOS`, `macCatalyst`)과 DocC 이름(`Mac Catalyst`)을 모두 받는다.
+std::optional<Platform> platformNamed(std::string_view name);
+
+/// `13.0`, `10.15`, `100000.0` 같은 버전. 값이 모두 0이면 비어 있는 것으로 본다.
+struct Version {
+    std::uint32_t major = 0;
+    std::uint16_t minor = 0;
+    std::uint16_t patch = 0;
+
+    bool empty() const { return major == 0 && minor == 0 && patch == 0; }
+    std::uint64_t key() const { return (std::uint64_t(major) << 32) | (std::uint32_t(minor) << 16) | patch; }
+    std::string string() const;
+
+    static Version parse(std::string_view text);
+
+    friend bool operator==(Version lhs, Version rhs) { return lhs.key() == rhs.key(); }
+    friend bool operator!=(Version lhs, Version rhs) { return lhs.key() != rhs.key(); }
+    friend bool operator<(Version lhs, Version rhs) { return lhs.key() < rhs.key(); }
+    friend bool operator<=(Version lhs, Version rhs) { return lhs.key() <= rhs.key(); }
+};
+
+/// 한 플랫폼에 대한 `@available` 정보.
+struct PlatformAvailability {
+    Version introduced;
+    Version deprecated;
+    Version obsoleted;
+    bool unavailable = false;
+    bool deprecatedUnversioned = false;   // `@available(iOS, deprecated)`처럼 버전 없이 폐기된 경우
+
+    bool isDeprecated() const { return deprecatedUnversioned || !deprecated.empty(); }
+
+    friend bool operator==(const PlatformAvailability& lhs, const PlatformAvailability& rhs) {
+        return lhs.introduced == rhs.introduced && lhs.deprecated == rhs.deprecated &&
+               lhs.obsoleted == rhs.obsoleted && lhs.unavailable == rhs.unavailable &&
+               lhs.deprecatedUnversioned == rhs.deprecatedUnversioned;
+    }
+};
+
+/// 선언 하나에 붙은 `@available` 속성들을 플랫폼별로 모은 것.
+struct Availability {
+    std::uint8_t mentioned = 0;   // 명시된 플랫폼의 비트 집합
+    bool unavailableEverywhere = false;
+    bool deprecatedEverywhere = false;
+    std::array<PlatformAvailability, kPlatformCount> platforms{};
+
+    bool empty() const { return mentioned == 0 && !unavailableEverywhere && !deprecatedEverywhere; }
+    bool mentions(Platform platform) const { return (mentioned & (1u << unsigned(platform))) != 0; }
+    const PlatformAvailability& operator[](Platform platform) const { return platforms[std::size_t(platform)]; }
+    PlatformAvailability& entry(Platform platform);
+
+    /// `version`의 `platform`에서 쓸 수 있는지 판단한다. 명시되지 않은 플랫폼은 쓸 수 있는 것으로 본다.
+    bool isAvailable(Platform platform, Version version) const;
+
+    /// 명시되지 않은 플랫폼 정보를 `outer`(둘러싼 선언)에서 물려받는다.
+    void inherit(const Availability& outer);
+
+    /// `iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0` 꼴로 요약한다.
+    std::string summary() const;
+
+    friend bool operator==(const Availability& lhs, const Availability& rhs) {
+        return lhs.mentioned == rhs.mentioned && lhs.unavailableEverywhere == rhs.unavailableEverywhere &&
+               lhs.deprecatedEverywhere == rhs.deprecatedEverywhere && lhs.platforms == rhs.platforms;
+    }
+    friend bool operator!=(const Availability& lhs, const Availability& rhs) { return !(lhs == rhs); }
+};
+
+/// 인터닝한 가용성의 번호. 0은 아무 속성도 없는 가용성이다.
+using AvailabilityId = std::uint32_t;
+
+/// 선언마다 반복되는 가용성 묶음(`iOS 13.0, macOS 10.15, tvOS 13.0, watchOS 6.0` 등)을 한 번만 저장한다.
+class AvailabilityTable {
+public:
+    AvailabilityTable();
+
+    AvailabilityId intern(const Availability& availability);
+    const Availability& operator[](AvailabilityId id) const { return values_[id]; }
+    std::size_t size() const { return values_.size(); }
+    std::size_t memoryUsage() const;
+
+private:
+    std::vector<Availability> values_;
+    std::unordered_multimap<std::uint64_t, AvailabilityId> byHash_;
+};
+
+/// `@available(...)`의 괄호 안 토큰 `[open + 1, close)`을 읽어 `into`에 더한다.
+void parseAvailabilityArguments(const TokenStream& stream, std::size_t open, std::size_t close, Availability& into);
+
+} // namespace manual
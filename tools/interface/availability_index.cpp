@@ -0,0 +1,300 @@
+//
+//  availability_index.cpp
+//  swiftUIManual tools
+//
+
+#include "interface/availability_index.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "common/bitset.h"
+#include "common/bplist.h"
+#include "interface/symbol_table.h"
+
+namespace manual {
+
+namespace {
+
+/// 파일 맨 앞의 고정 길이 머리. 값은 만든 기계의 바이트 순서(리틀 엔디언)로 쓴다.
+struct Header {
+    char magic[4];
+    std::uint32_t formatVersion;
+    std::uint32_t rowCount;
+    std::uint32_t wordCount;
+    std::uint32_t versionCount;
+    std::uint32_t nameBytes;
+    std::uint32_t versionBegin[kPlatformCount];
+    std::uint32_t versionCount_[kPlatformCount];
+};
+static_assert(sizeof(Header) == 64, "머리는 64바이트");
+
+constexpr char kMagic[4] = {'A', 'V', 'I', 'X'};
+constexpr std::uint32_t kFormatVersion = 1;
+
+std::size_t align8(std::size_t size) { return (size + 7) & ~std::size_t(7); }
+
+Version versionFromKey(std::uint64_t key) {
+    return Version{std::uint32_t(key >> 32), std::uint16_t(key >> 16), std::uint16_t(key)};
+}
+
+/// 질의에 실제로 쓰이는 플랫폼 정보. Mac Catalyst는 따로 없으면 iOS를 따른다.
+const PlatformAvailability& resolved(const Availability& availability, Platform platform) {
+    static const PlatformAvailability unrestricted;
+    if (platform == Platform::macCatalyst && !availability.mentions(platform) &&
+        availability.mentions(Platform::iOS)) {
+        platform = Platform::iOS;
+    }
+    return availability.mentions(platform) ? availability[platform] : unrestricted;
+}
+
+Version versionValue(const PlistValue* value) {
+    if (value == nullptr || !value->isDict()) return {};
+    auto field = [value](std::string_view key) -> std::uint64_t {
+        const PlistValue* item = value->get(key);
+        return item != nullptr && item->type == PlistValue::Type::Integer ? item->integer : 0;
+    };
+    return Version{std::uint32_t(field("majorVersion")), std::uint16_t(field("minorVersion")),
+                   std::uint16_t(field("patchVersion"))};
+}
+
+std::uint64_t parseId(const std::string& text) {
+    std::uint64_t id = 0;
+    for (char c : text) id = id * 10 + std::uint64_t(c >= '0' && c <= '9' ? c - '0' : 0);
+    return id;
+}
+
+} // namespace
+
+// MARK: - AvailabilityIndexBuilder
+
+void AvailabilityIndexBuilder::add(std::string_view name, const Availability& availability) {
+    names_.emplace_back(name);
+    rows_.push_back(availability);
+}
+
+void AvailabilityIndexBuilder::addInterface(const SymbolTable& table) {
+    std::vector<Availability> effective(table.size());
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        const Decl& decl = table[i];
+        Availability availability = table.availability(decl);
+        if (decl.parent != kNoDecl) availability.inherit(effective[std::size_t(decl.parent)]);
+        effective[i] = availability;
+        if (decl.kind != DeclKind::Import && !availability.empty()) add(table.qualifiedName(decl), availability);
+    }
+}
+
+void AvailabilityIndexBuilder::importBundleIndex(const PlistValue& root) {
+    const PlistValue* data = root.get("data");
+    if (data == nullptr || !data->isDict()) throw std::runtime_error("availability.index has no data dictionary");
+
+    std::vector<const std::pair<std::string, PlistValue>*> entries;
+    for (const auto& entry : data->dict) entries.push_back(&entry);
+    std::sort(entries.begin(), entries.end(),
+              [](const auto* lhs, const auto* rhs) { return parseId(lhs->first) < parseId(rhs->first); });
+
+    for (const auto* entry : entries) {
+        const PlistValue& info = entry->second;
+        const PlistValue* platformName = info.get("platformName");
+        const PlistValue* name = platformName != nullptr ? platformName->get("name") : nullptr;
+        if (name == nullptr) continue;
+
+        Availability availability;
+        // `all`은 모든 플랫폼에서 쓸 수 있는 항목이다.
+        if (name->string != "all") {
+            std::optional<Platform> platform = platformNamed(name->string);
+            if (!platform) continue;
+            for (std::size_t i = 0; i < kPlatformCount; ++i) availability.entry(Platform(i)).unavailable = true;
+            PlatformAvailability& target = availability.entry(*platform);
+            target = PlatformAvailability{};
+            target.introduced = versionValue(info.get("introduced"));
+            target.deprecated = versionValue(info.get("deprecated"));
+            target.obsoleted = versionValue(info.get("obsoleted"));
+        }
+        add(entry->first, availability);
+    }
+}
+
+std::string AvailabilityIndexBuilder::serialize() const {
+    const std::size_t rows = rows_.size();
+    const std::size_t words = (rows + 63) / 64;
+
+    // 플랫폼마다 가용성이 바뀔 수 있는 버전 경계를 모은다.
+    std::vector<std::uint64_t> versions[kPlatformCount];
+    for (std::size_t p = 0; p < kPlatformCount; ++p) {
+        auto platform = Platform(p);
+        std::vector<std::uint64_t>& list = versions[p];
+        list.push_back(0);
+        for (const Availability& row : rows_) {
+            const PlatformAvailability& info = resolved(row, platform);
+            for (Version version : {info.introduced, info.deprecated, info.obsoleted}) {
+                if (!version.empty()) list.push_back(version.key());
+            }
+        }
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        if (list.size() >= AvailabilityTuple::kUnavailable) throw std::runtime_error("too many versions for one platform");
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof kMagic);
+    header.formatVersion = kFormatVersion;
+    header.rowCount = std::uint32_t(rows);
+    header.wordCount = std::uint32_t(words);
+    std::uint32_t versionTotal = 0;
+    for (std::size_t p = 0; p < kPlatformCount; ++p) {
+        header.versionBegin[p] = versionTotal;
+        header.versionCount_[p] = std::uint32_t(versions[p].size());
+        versionTotal += std::uint32_t(versions[p].size());
+    }
+    header.versionCount = versionTotal;
+    std::size_t nameBytes = 0;
+    for (const auto& name : names_) nameBytes += name.size();
+    header.nameBytes = std::uint32_t(nameBytes);
+
+    std::vector<std::uint64_t> versionKeys;
+    std::vector<std::uint64_t> bits(std::size_t(versionTotal) * words, 0);
+    for (std::size_t p = 0; p < kPlatformCount; ++p) {
+        for (std::size_t k = 0; k < versions[p].size(); ++k) {
+            versionKeys.push_back(versions[p][k]);
+            std::uint64_t* set = bits.data() + (header.versionBegin[p] + k) * words;
+            Version at = versionFromKey(versions[p][k]);
+            for (std::size_t row = 0; row < rows; ++row) {
+                if (rows_[row].isAvailable(Platform(p), at)) set[row / 64] |= std::uint64_t(1) << (row % 64);
+            }
+        }
+    }
+
+    std::vector<AvailabilityTuple> tuples(rows);
+    for (std::size_t row = 0; row < rows; ++row) {
+        AvailabilityTuple& tuple = tuples[row];
+        std::memset(&tuple, 0, sizeof tuple);
+        for (std::size_t p = 0; p < kPlatformCount; ++p) {
+            const PlatformAvailability& info = resolved(rows_[row], Platform(p));
+            auto indexOf = [&](Version version) -> std::uint8_t {
+                if (version.empty()) return 0;
+                auto it = std::lower_bound(versions[p].begin(), versions[p].end(), version.key());
+                return std::uint8_t(it - versions[p].begin());
+            };
+            bool unavailable = info.unavailable || rows_[row].unavailableEverywhere;
+            tuple.introduced[p] = unavailable ? AvailabilityTuple::kUnavailable : indexOf(info.introduced);
+            tuple.deprecated[p] = indexOf(info.deprecated);
+            tuple.obsoleted[p] = indexOf(info.obsoleted);
+            if (info.deprecatedUnversioned || rows_[row].deprecatedEverywhere) {
+                tuple.deprecatedAlways |= std::uint8_t(1u << p);
+            }
+        }
+    }
+
+    std::string out;
+    auto append = [&out](const void* data, std::size_t size) {
+        out.append(static_cast<const char*>(data), size);
+        out.resize(align8(out.size()), '\0');
+    };
+    append(&header, sizeof header);
+    append(versionKeys.data(), versionKeys.size() * sizeof(std::uint64_t));
+    append(bits.data(), bits.size() * sizeof(std::uint64_t));
+    append(tuples.data(), tuples.size() * sizeof(AvailabilityTuple));
+    std::vector<std::uint32_t> offsets;
+    offsets.reserve(rows + 1);
+    std::string names;
+    names.reserve(nameBytes);
+    for (const auto& name : names_) {
+        offsets.push_back(std::uint32_t(names.size()));
+        names += name;
+    }
+    offsets.push_back(std::uint32_t(names.size()));
+    append(offsets.data(), offsets.size() * sizeof(std::uint32_t));
+    append(names.data(), names.size());
+    return out;
+}
+
+// MARK: - AvailabilityIndex
+
+AvailabilityIndex::AvailabilityIndex(std::string_view bytes) {
+    if (bytes.size() < sizeof(Header)) throw std::runtime_error("availability index is truncated");
+    Header header;
+    std::memcpy(&header, bytes.data(), sizeof header);
+    if (std::memcmp(header.magic, kMagic, sizeof kMagic) != 0 || header.formatVersion != kFormatVersion) {
+        throw std::runtime_error("not an availability index (or written with another byte order)");
+    }
+    rowCount_ = header.rowCount;
+    wordCount_ = header.wordCount;
+    std::size_t versionTotal = 0;
+    for (std::size_t p = 0; p < kPlatformCount; ++p) {
+        versionBegin_[p] = header.versionBegin[p];
+        versionCount_[p] = header.versionCount_[p];
+        // 튜플은 번호를 한 바이트에 담으므로 만들 때와 같은 상한을 둔다.
+        if (versionCount_[p] == 0 || versionCount_[p] >= AvailabilityTuple::kUnavailable ||
+            std::uint64_t(versionBegin_[p]) + versionCount_[p] > header.versionCount) {
+            throw std::runtime_error("availability index has a bad version table");
+        }
+        versionTotal += versionCount_[p];
+    }
+    if (versionTotal != header.versionCount || wordCount_ != (rowCount_ + 63) / 64) {
+        throw std::runtime_error("availability index has inconsistent counts");
+    }
+
+    std::size_t at = sizeof(Header);
+    auto section = [&](std::size_t size) {
+        std::size_t start = at;
+        if (size > align8(bytes.size()) - at) throw std::runtime_error("availability index is truncated");
+        at = align8(at + size);
+        return bytes.data() + start;
+    };
+    // 버전 수 × 단어 수는 머리의 32비트 값 둘을 곱한 것이라 넘칠 수 있다. 파일 크기로 먼저 막는다.
+    if (wordCount_ != 0 && versionTotal > bytes.size() / sizeof(std::uint64_t) / wordCount_) {
+        throw std::runtime_error("availability index is truncated");
+    }
+    versions_ = reinterpret_cast<const std::uint64_t*>(section(versionTotal * sizeof(std::uint64_t)));
+    bits_ = reinterpret_cast<const std::uint64_t*>(section(versionTotal * wordCount_ * sizeof(std::uint64_t)));
+    tuples_ = reinterpret_cast<const AvailabilityTuple*>(section(rowCount_ * sizeof(AvailabilityTuple)));
+    nameOffsets_ = reinterpret_cast<const std::uint32_t*>(section((rowCount_ + 1) * sizeof(std::uint32_t)));
+    names_ = section(header.nameBytes);
+    if (nameOffsets_[rowCount_] != header.nameBytes) throw std::runtime_error("availability index has a bad name table");
+    for (std::size_t row = 0; row < rowCount_; ++row) {
+        if (nameOffsets_[row] > nameOffsets_[row + 1]) throw std::runtime_error("availability index has a bad name table");
+    }
+    // `availableAt`은 첫 경계가 0.0이라는 데 기댄다.
+    for (std::size_t p = 0; p < kPlatformCount; ++p) {
+        if (versions_[versionBegin_[p]] != 0) throw std::runtime_error("availability index has a bad version table");
+    }
+}
+
+std::string_view AvailabilityIndex::name(std::size_t row) const {
+    return {names_ + nameOffsets_[row], nameOffsets_[row + 1] - nameOffsets_[row]};
+}
+
+Span<const std::uint64_t> AvailabilityIndex::versions(Platform platform) const {
+    auto p = std::size_t(platform);
+    return {versions_ + versionBegin_[p], versionCount_[p]};
+}
+
+Version AvailabilityIndex::version(Platform platform, std::uint8_t index) const {
+    if (index >= versionCount_[std::size_t(platform)]) throw std::runtime_error("availability index has no such version");
+    return versionFromKey(versions(platform)[index]);
+}
+
+const std::uint64_t* AvailabilityIndex::availableAt(Platform platform, Version version) const {
+    // 질의 버전 이하인 마지막 경계의 집합을 쓴다. 첫 경계가 0.0이므로 항상 하나는 있다.
+    Span<const std::uint64_t> list = versions(platform);
+    auto it = std::upper_bound(list.begin(), list.end(), version.key());
+    std::size_t index = std::size_t(it - list.begin()) - 1;
+    return bits_ + (versionBegin_[std::size_t(platform)] + index) * wordCount_;
+}
+
+void AvailabilityIndex::query(const std::vector<Term>& terms, std::vector<std::uint64_t>& result) const {
+    result.assign(wordCount_, ~std::uint64_t(0));
+    if (rowCount_ % 64 != 0) result.back() = (std::uint64_t(1) << (rowCount_ % 64)) - 1;
+    for (const Term& term : terms) {
+        const std::uint64_t* set = availableAt(term.platform, term.version);
+        if (term.negate) {
+            bitsAndNot(result.data(), set, wordCount_);
+        } else {
+            bitsAnd(result.data(), set, wordCount_);
+        }
+    }
+}
+
+} // namespace manual
@@ -0,0 +1,95 @@
+//
+//  availability_index.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/arena.h"
+#include "interface/availability.h"
+
+namespace manual {
+
+struct PlistValue;
+class SymbolTable;
+
+/// 행 하나의 가용성을 플랫폼별 버전 번호로 줄인 것. 번호는 그 플랫폼 버전 목록의 위치다.
+struct AvailabilityTuple {
+    static constexpr std::uint8_t kUnavailable = 0xFF;
+
+    std::uint8_t introduced[kPlatformCount];   // 0이면 처음부터, kUnavailable이면 쓸 수 없음
+    std::uint8_t deprecated[kPlatformCount];   // 0이면 폐기되지 않음
+    std::uint8_t obsoleted[kPlatformCount];    // 0이면 제거되지 않음
+    std::uint8_t deprecatedAlways;             // 버전 없이 폐기된 플랫폼의 비트 집합
+};
+static_assert(sizeof(AvailabilityTuple) == 16, "행마다 16바이트");
+
+/// 가용성 인덱스를 만든다. `serialize()` 결과를 파일로 저장하면 `AvailabilityIndex`가 그대로 읽는다.
+class AvailabilityIndexBuilder {
+public:
+    void add(std::string_view name, const Availability& availability);
+
+    /// 가용성이 붙었거나 둘러싼 선언에서 물려받은 선언을 모두 더한다. 행 이름은 한정 이름이다.
+    void addInterface(const SymbolTable& table);
+
+    /// DocC 번들의 `availability.index`(bplist)를 가져온다. 행 이름은 번들의 가용성 번호다.
+    /// 번들 정보는 적힌 플랫폼에서만 유효하므로, 나머지 플랫폼은 쓸 수 없는 것으로 둔다.
+    void importBundleIndex(const PlistValue& root);
+
+    std::size_t size() const { return names_.size(); }
+    std::string serialize() const;
+
+private:
+    std::vector<std::string> names_;
+    std::vector<Availability> rows_;
+};
+
+/// 직렬화한 가용성 인덱스를 복사 없이 읽는다.
+///
+/// 플랫폼마다 가용성이 바뀌는 버전 경계 목록이 있고, 경계마다 "이 버전에서 쓸 수 있는 행"의 비트 집합이 있다.
+/// 질의는 비트 집합끼리 AND/ANDN 하는 것으로 끝난다.
+class AvailabilityIndex {
+public:
+    struct Term {
+        Platform platform;
+        Version version;
+        bool negate;   // "쓸 수 없는" 조건
+    };
+
+    /// `bytes`는 인덱스보다 오래 살아 있어야 한다. 형식이 맞지 않으면 `std::runtime_error`를 던진다.
+    explicit AvailabilityIndex(std::string_view bytes);
+
+    std::size_t rowCount() const { return rowCount_; }
+    std::size_t wordCount() const { return wordCount_; }
+    std::string_view name(std::size_t row) const;
+    const AvailabilityTuple& tuple(std::size_t row) const { return tuples_[row]; }
+
+    /// 가용성이 바뀌는 버전 경계. 첫 항목은 항상 0.0이다.
+    Span<const std::uint64_t> versions(Platform platform) const;
+    /// 튜플의 버전 번호를 버전으로 되돌린다. 번호가 목록 밖이면 `std::runtime_error`를 던진다.
+    Version version(Platform platform, std::uint8_t index) const;
+
+    /// `platform`의 `version`에서 쓸 수 있는 행의 비트 집합(`wordCount()` 단어).
+    const std::uint64_t* availableAt(Platform platform, Version version) const;
+
+    /// 모든 조건을 만족하는 행의 비트 집합을 `result`에 채운다. 호출자가 버퍼를 재사용할 수 있다.
+    void query(const std::vector<Term>& terms, std::vector<std::uint64_t>& result) const;
+
+private:
+    std::size_t rowCount_ = 0;
+    std::size_t wordCount_ = 0;
+    std::uint32_t versionBegin_[kPlatformCount] = {};
+    std::uint32_t versionCount_[kPlatformCount] = {};
+    const std::uint64_t* versions_ = nullptr;
+    const std::uint64_t* bits_ = nullptr;
+    const AvailabilityTuple* tuples_ = nullptr;
+    const std::uint32_t* nameOffsets_ = nullptr;
+    const char* names_ = nullptr;
+};
+
+} // namespace manual
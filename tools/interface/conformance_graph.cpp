@@ -0,0 +1,253 @@
+//
+//  conformance_graph.cpp
+//  swiftUIManual tools
+//
+
+#include "interface/conformance_graph.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "common/bitset.h"
+#include "interface/symbol_table.h"
+
+namespace manual {
+
+namespace {
+
+bool isPunct(const TokenStream& stream, std::size_t index, std::string_view text) {
+    const Token& token = stream.tokens[index];
+    return token.kind == TokenKind::Punct && stream.text(token) == text;
+}
+
+/// `()`, `[]`, `<>` 깊이를 토큰 하나만큼 갱신한다. `->`의 `>`는 세지 않는다.
+void track(const TokenStream& stream, std::size_t index, int& nesting) {
+    const Token& token = stream.tokens[index];
+    if (token.kind == TokenKind::LParen || token.kind == TokenKind::LBracket) {
+        ++nesting;
+    } else if (token.kind == TokenKind::RParen || token.kind == TokenKind::RBracket) {
+        --nesting;
+    } else if (token.kind == TokenKind::Punct && stream.text(token) != "->") {
+        for (char c : stream.text(token)) nesting += c == '<' ? 1 : c == '>' ? -1 : 0;
+    }
+}
+
+/// 선언부에서 괄호 밖의 첫 `where`. 없으면 `bodyToken`.
+std::size_t findWhere(const TokenStream& stream, const Decl& decl) {
+    int nesting = 0;
+    for (std::size_t i = decl.headerToken; i < decl.bodyToken; ++i) {
+        if (nesting == 0 && stream.tokens[i].keyword() == Keyword::Where) return i;
+        track(stream, i, nesting);
+    }
+    return decl.bodyToken;
+}
+
+/// 상속 절(`: Animatable, ViewModifier`)의 시작. 없으면 `where` 위치.
+std::size_t findInheritance(const TokenStream& stream, const Decl& decl, std::size_t where) {
+    int nesting = 0;
+    for (std::size_t i = decl.headerToken; i < where; ++i) {
+        if (nesting == 0 && isPunct(stream, i, ":")) return i + 1;
+        track(stream, i, nesting);
+    }
+    return where;
+}
+
+/// `Foo.Bar<T>`의 `Foo.Bar`. 속성(`@unchecked`)과 `any`는 건너뛴다. 다음에 읽을 위치를 돌려준다.
+std::size_t readTypeName(const TokenStream& stream, std::size_t i, std::size_t end, std::string& name) {
+    name.clear();
+    while (i < end && (stream.tokens[i].kind == TokenKind::Attribute || stream.tokens[i].keyword() == Keyword::Any)) {
+        ++i;
+    }
+    while (i < end) {
+        const Token& token = stream.tokens[i];
+        if (token.kind == TokenKind::Identifier) {
+            name += stream.text(token);
+        } else if (isPunct(stream, i, ".") && !name.empty()) {
+            name += '.';
+        } else {
+            break;
+        }
+        ++i;
+    }
+    return i;
+}
+
+/// `[where + 1, end)`에서 `Self == X`의 `X`를 찾는다.
+bool findSelfConstraint(const TokenStream& stream, std::size_t begin, std::size_t end, std::string& name) {
+    for (std::size_t i = begin; i + 2 < end; ++i) {
+        if (stream.tokens[i].keyword() == Keyword::SelfType && isPunct(stream, i + 1, "==")) {
+            readTypeName(stream, i + 2, end, name);
+            return !name.empty();
+        }
+    }
+    return false;
+}
+
+bool declaresType(DeclKind kind) {
+    return kind == DeclKind::Struct || kind == DeclKind::Class || kind == DeclKind::Enum ||
+           kind == DeclKind::Protocol;
+}
+
+/// 같은 키끼리 모은 값을 오프셋 배열과 평평한 배열로 펼친다.
+template <class Value>
+void flatten(std::vector<std::pair<std::uint32_t, Value>>& pairs, std::size_t keys,
+             std::vector<std::uint32_t>& offsets, std::vector<Value>& values) {
+    std::stable_sort(pairs.begin(), pairs.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    offsets.assign(keys + 1, 0);
+    for (const auto& pair : pairs) ++offsets[pair.first + 1];
+    for (std::size_t key = 0; key < keys; ++key) offsets[key + 1] += offsets[key];
+    values.clear();
+    values.reserve(pairs.size());
+    for (const auto& pair : pairs) values.push_back(pair.second);
+}
+
+} // namespace
+
+ConformanceGraph ConformanceGraph::build(const SymbolTable& table) {
+    ConformanceGraph graph;
+    const TokenStream& stream = table.tokens();
+
+    auto node = [&graph](std::string_view name) {
+        Symbol symbol = graph.symbols_.intern(name);
+        if (symbol >= graph.nodeOfSymbol_.size()) graph.nodeOfSymbol_.resize(symbol + 1, kNoNode);
+        if (graph.nodeOfSymbol_[symbol] == kNoNode) {
+            graph.nodeOfSymbol_[symbol] = std::uint32_t(graph.names_.size());
+            graph.names_.push_back(symbol);
+            graph.kinds_.push_back(NodeKind::External);
+        }
+        return graph.nodeOfSymbol_[symbol];
+    };
+
+    // 1. 타입 노드와 직접 순응 간선
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+    std::vector<std::uint32_t> extensionNodes(table.size(), kNoNode);
+    std::string name;
+    for (std::size_t index = 0; index < table.size(); ++index) {
+        const Decl& decl = table[index];
+        std::uint32_t from;
+        if (declaresType(decl.kind)) {
+            from = node(table.qualifiedName(decl));
+            graph.kinds_[from] = decl.kind == DeclKind::Protocol ? NodeKind::Protocol : NodeKind::Type;
+        } else if (decl.kind == DeclKind::Extension) {
+            from = node(table.name(decl));
+            extensionNodes[index] = from;
+        } else {
+            continue;
+        }
+        std::size_t where = findWhere(stream, decl);
+        std::size_t i = findInheritance(stream, decl, where);
+        while (i < where) {
+            // `A, B & C`처럼 쉼표와 `&`로 나뉜 이름을 차례로 읽고, 제네릭 인자는 건너뛴다.
+            i = readTypeName(stream, i, where, name);
+            if (!name.empty()) edges.emplace_back(from, node(name));
+            int nesting = 0;
+            for (; i < where; ++i) {
+                if (nesting == 0 && (isPunct(stream, i, ",") || isPunct(stream, i, "&"))) break;
+                track(stream, i, nesting);
+            }
+            ++i;
+        }
+    }
+
+    // 2. `where Self == X`로 `.name`이 되는 정적 멤버. 모든 프로토콜 노드의 종류가 정해진 뒤에 본다.
+    std::vector<StaticMember> members;
+    std::vector<Symbol> memberNames;
+    for (std::size_t index = 0; index < table.size(); ++index) {
+        const Decl& decl = table[index];
+        if ((decl.flags & kDeclStatic) == 0 || decl.parent == kNoDecl) continue;
+        std::uint32_t protocol = extensionNodes[std::size_t(decl.parent)];
+        if (protocol == kNoNode || graph.kinds_[protocol] != NodeKind::Protocol) continue;
+        // 멤버 자신의 `where`(`explicit<S>(_:) where Self == ExplicitTimelineSchedule<S>`)가 확장의 것보다 앞선다.
+        const Decl& extension = table[std::size_t(decl.parent)];
+        std::size_t where = findWhere(stream, decl);
+        if (!findSelfConstraint(stream, where + 1, decl.bodyToken, name)) {
+            where = findWhere(stream, extension);
+            if (!findSelfConstraint(stream, where + 1, extension.bodyToken, name)) continue;
+        }
+        members.push_back({std::uint32_t(index), protocol, node(name)});
+        std::string_view base = table.name(decl);
+        memberNames.push_back(graph.symbols_.intern(base.substr(0, base.find('('))));
+    }
+
+    std::size_t nodes = graph.names_.size();
+    graph.words_ = (nodes + 63) / 64;
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    flatten(edges, nodes, graph.edgeOffsets_, graph.edges_);
+
+    // 3. 추이 폐포. 깊이 우선으로 상위부터 채우고, 잘못된 순환은 방문 중 표시로 끊는다.
+    std::size_t words = graph.words_;
+    graph.conformances_.assign(nodes * words, 0);
+    std::vector<std::uint8_t> state(nodes, 0);   // 0: 아직, 1: 방문 중, 2: 끝
+    auto close = [&](auto&& self, std::uint32_t at) -> void {
+        state[at] = 1;
+        std::uint64_t* bits = graph.conformances_.data() + at * words;
+        for (std::uint32_t target : graph.directConformances(at)) {
+            if (state[target] == 0) self(self, target);
+            bits[target / 64] |= std::uint64_t(1) << (target % 64);
+            if (state[target] == 2) bitsOr(bits, graph.conformances_.data() + target * words, words);
+        }
+        bits[at / 64] &= ~(std::uint64_t(1) << (at % 64));
+        state[at] = 2;
+    };
+    for (std::uint32_t at = 0; at < nodes; ++at) {
+        if (state[at] == 0) close(close, at);
+    }
+    graph.conformers_.assign(nodes * words, 0);
+    for (std::uint32_t at = 0; at < nodes; ++at) {
+        forEachBit(graph.conformances(at), words, [&](std::size_t protocol) {
+            graph.conformers_[protocol * words + at / 64] |= std::uint64_t(1) << (at % 64);
+        });
+    }
+
+    // 4. 프로토콜별, 이름별 정적 멤버. 하위 프로토콜 자리에서는 `Self ==` 타입이 그 프로토콜에 순응해야 쓸 수 있다.
+    std::vector<std::pair<std::uint32_t, StaticMember>> byProtocol;
+    std::vector<std::pair<std::uint32_t, StaticMember>> byName;
+    for (std::size_t i = 0; i < members.size(); ++i) {
+        const StaticMember& member = members[i];
+        byProtocol.emplace_back(member.protocol, member);
+        byName.emplace_back(memberNames[i], member);
+        forEachBit(graph.conformers(member.protocol), words, [&](std::size_t refined) {
+            if (graph.kinds_[refined] != NodeKind::Protocol) return;
+            if (member.self == refined || graph.conformsTo(member.self, std::uint32_t(refined))) {
+                byProtocol.emplace_back(std::uint32_t(refined), member);
+            }
+        });
+    }
+    flatten(byProtocol, nodes, graph.memberOffsets_, graph.members_);
+    flatten(byName, graph.symbols_.size(), graph.nameOffsets_, graph.membersByName_);
+    return graph;
+}
+
+std::uint32_t ConformanceGraph::find(std::string_view name) const {
+    Symbol symbol;
+    if (!symbols_.find(name, symbol) || symbol >= nodeOfSymbol_.size()) return kNoNode;
+    return nodeOfSymbol_[symbol];
+}
+
+Span<const std::uint32_t> ConformanceGraph::directConformances(std::uint32_t node) const {
+    return {edges_.data() + edgeOffsets_[node], edgeOffsets_[node + 1] - edgeOffsets_[node]};
+}
+
+Span<const ConformanceGraph::StaticMember> ConformanceGraph::staticMembers(std::uint32_t protocol) const {
+    return {members_.data() + memberOffsets_[protocol], memberOffsets_[protocol + 1] - memberOffsets_[protocol]};
+}
+
+Span<const ConformanceGraph::StaticMember> ConformanceGraph::staticMembersNamed(std::string_view baseName) const {
+    Symbol symbol;
+    if (!symbols_.find(baseName, symbol) || symbol + 1 >= nameOffsets_.size()) return {};
+    return {membersByName_.data() + nameOffsets_[symbol], nameOffsets_[symbol + 1] - nameOffsets_[symbol]};
+}
+
+std::size_t ConformanceGraph::memoryUsage() const {
+    return symbols_.memoryUsage() + names_.capacity() * sizeof(Symbol) + kinds_.capacity() * sizeof(NodeKind) +
+           nodeOfSymbol_.capacity() * sizeof(std::uint32_t) +
+           (edgeOffsets_.capacity() + edges_.capacity() + memberOffsets_.capacity() + nameOffsets_.capacity()) *
+               sizeof(std::uint32_t) +
+           (conformances_.capacity() + conformers_.capacity()) * sizeof(std::uint64_t) +
+           (members_.capacity() + membersByName_.capacity()) * sizeof(StaticMember);
+}
+
+} // namespace manual
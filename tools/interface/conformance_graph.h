@@ -0,0 +1,85 @@
+//
+//  conformance_graph.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "common/arena.h"
+#include "common/interner.h"
+
+namespace manual {
+
+class SymbolTable;
+
+/// 인터페이스의 순응 관계를 타입 이름 노드의 그래프로 모으고, 추이 폐포를 노드마다 비트 집합으로 미리 구해 둔다.
+///
+/// 간선은 `struct Text : Equatable`, `extension Optional : View where Wrapped : View`(조건부 순응 포함),
+/// `protocol AnimatableModifier : Animatable, ViewModifier`에서 온다. 질의는 비트 집합 하나를 읽거나
+/// 미리 펼쳐 둔 배열 구간을 돌려줄 뿐이라, 호버마다 물어도 선언을 다시 훑지 않는다.
+class ConformanceGraph {
+public:
+    enum class NodeKind : std::uint8_t {
+        Protocol,   // 이 인터페이스가 선언한 프로토콜
+        Type,       // 이 인터페이스가 선언한 구조체, 클래스, 열거형
+        External,   // `Equatable`, `Sendable`처럼 다른 모듈의 이름. 순응 대상이면 프로토콜로 다룬다.
+    };
+
+    static constexpr std::uint32_t kNoNode = 0xFFFFFFFF;
+
+    /// `where Self == X` 제약 덕분에 `.name`으로 쓸 수 있는 정적 멤버.
+    struct StaticMember {
+        std::uint32_t decl;       // 심벌 표의 선언 번호
+        std::uint32_t protocol;   // 멤버를 선언한 확장의 프로토콜
+        std::uint32_t self;       // `Self ==`의 타입
+    };
+
+    /// `table`은 그래프보다 오래 살 필요가 없다. 멤버는 선언 번호로만 가리킨다.
+    static ConformanceGraph build(const SymbolTable& table);
+
+    std::size_t size() const { return names_.size(); }
+    std::size_t wordCount() const { return words_; }
+    std::string_view name(std::uint32_t node) const { return symbols_[names_[node]]; }
+    NodeKind kind(std::uint32_t node) const { return kinds_[node]; }
+    /// 이름(`Text.Storage`)의 노드. 없으면 `kNoNode`.
+    std::uint32_t find(std::string_view name) const;
+
+    /// 선언과 확장에 직접 적힌 순응 대상.
+    Span<const std::uint32_t> directConformances(std::uint32_t node) const;
+    /// `node`가 추이적으로 순응하는 프로토콜의 비트 집합(`wordCount()` 단어). 자기 자신은 없다.
+    const std::uint64_t* conformances(std::uint32_t node) const { return conformances_.data() + node * words_; }
+    /// `node`에 추이적으로 순응하는 타입과 하위 프로토콜의 비트 집합.
+    const std::uint64_t* conformers(std::uint32_t node) const { return conformers_.data() + node * words_; }
+    bool conformsTo(std::uint32_t node, std::uint32_t protocol) const {
+        return (conformances(node)[protocol / 64] >> (protocol % 64)) & 1u;
+    }
+
+    /// `protocol`을 기대하는 자리에서 `.name`으로 쓸 수 있는 정적 멤버. 상위 프로토콜의 확장에 있더라도
+    /// `Self ==` 타입이 `protocol`에 순응하면 넣는다.
+    Span<const StaticMember> staticMembers(std::uint32_t protocol) const;
+    /// 기본 이름(`periodic`)이 같은 정적 멤버. `periodic(from:by:)`도 `periodic`으로 찾는다.
+    Span<const StaticMember> staticMembersNamed(std::string_view baseName) const;
+
+    std::size_t memoryUsage() const;
+
+private:
+    StringInterner symbols_;
+    std::vector<Symbol> names_;
+    std::vector<NodeKind> kinds_;
+    std::vector<std::uint32_t> nodeOfSymbol_;   // 인터닝 번호 → 노드. 멤버 이름처럼 노드가 아닌 것은 `kNoNode`.
+    std::size_t words_ = 0;
+    std::vector<std::uint32_t> edgeOffsets_;
+    std::vector<std::uint32_t> edges_;
+    std::vector<std::uint64_t> conformances_;
+    std::vector<std::uint64_t> conformers_;
+    std::vector<std::uint32_t> memberOffsets_;   // 노드별 `members_`의 시작
+    std::vector<StaticMember> members_;
+    std::vector<std::uint32_t> nameOffsets_;     // 인터닝 번호별 `membersByName_`의 시작
+    std::vector<StaticMember> membersByName_;
+};
+
+} // namespace manual
@@ -0,0 +1,539 @@
+//
+//  highlighter.cpp
+//  swiftUIManual tools
+//
+
+#include "interface/highlighter.h"
+
+#include <algorithm>
+#include <array>
+
+namespace manual {
+
+namespace {
+
+constexpr std::string_view kClassNames[kHighlightClassCount] = {
+    "hljs-keyword", "hljs-literal", "hljs-built_in", "hljs-number",         "hljs-string",
+    "hljs-subst",   "hljs-comment", "hljs-meta",     "hljs-type",           "hljs-title function_",
+    "hljs-title class_", "hljs-operator", "hljs-variable",
+};
+
+// MARK: - 문자 범주
+
+enum CharClass : std::uint8_t {
+    kSpace,
+    kNewline,
+    kLower,       // a-z, `_`
+    kUpper,       // A-Z
+    kDigit,
+    kHigh,        // UTF-8 바이트. 이름의 일부로 본다.
+    kQuote,
+    kSlash,
+    kBackslash,
+    kAt,
+    kHash,
+    kDollar,
+    kBacktick,
+    kLParen,
+    kRParen,
+    kOperator,    // `=-+!*%<>&|^~?`
+    kDot,
+    kOther,
+};
+
+constexpr std::array<std::uint8_t, 256> makeCharClasses() {
+    std::array<std::uint8_t, 256> table{};
+    for (auto& entry : table) entry = kOther;
+    for (int c = 0x80; c < 0x100; ++c) table[c] = kHigh;
+    for (int c = 'a'; c <= 'z'; ++c) table[c] = kLower;
+    for (int c = 'A'; c <= 'Z'; ++c) table[c] = kUpper;
+    for (int c = '0'; c <= '9'; ++c) table[c] = kDigit;
+    table['_'] = kLower;
+    table[' '] = table['\t'] = table['\r'] = table['\f'] = table['\v'] = kSpace;
+    table['\n'] = kNewline;
+    table['"'] = kQuote;
+    table['/'] = kSlash;
+    table['\\'] = kBackslash;
+    table['@'] = kAt;
+    table['#'] = kHash;
+    table['$'] = kDollar;
+    table['`'] = kBacktick;
+    table['('] = kLParen;
+    table[')'] = kRParen;
+    for (char c : std::string_view("=-+!*%<>&|^~?")) table[std::uint8_t(c)] = kOperator;
+    table['.'] = kDot;
+    return table;
+}
+constexpr std::array<std::uint8_t, 256> kCharClasses = makeCharClasses();
+
+/// 이름 글자 범주는 `kLower`부터 `kHigh`까지 이어져 있어 비교 한 번으로 가른다.
+constexpr bool isIdentifierClass(std::uint8_t cls) { return std::uint8_t(cls - kLower) <= kHigh - kLower; }
+
+// MARK: - 이름 표
+
+enum WordFlags : std::uint16_t {
+    kWordKeyword = 1 << 0,
+    kWordLiteral = 1 << 1,
+    kWordBuiltIn = 1 << 2,      // 바로 뒤에 `(`가 올 때만
+    kWordAttribute = 1 << 3,    // `@` 뒤에서 예약어로 칠하는 속성
+    kWordDirective = 1 << 4,    // `#` 뒤에서 예약어로 칠하는 것
+    kWordPlatform = 1 << 5,     // `@available(…)` 안에서 예약어
+    kWordFunction = 1 << 6,     // 다음 이름이 함수 이름
+    kWordType = 1 << 7,         // 다음 이름이 타입 이름
+    kWordBang = 1 << 8,         // `as?`, `try!`, `init?`
+    kWordSetter = 1 << 9,       // `private(set)`
+    kWordMember = 1 << 10,      // `.init`, `.self`, `.Type`, `.Protocol`
+};
+
+struct WordList {
+    std::string_view words;   // 공백으로 나눈 목록
+    std::uint16_t flags;
+};
+
+constexpr WordList kWordLists[] = {
+    {"actor associatedtype async await as break case catch class continue convenience default defer deinit didSet "
+     "do dynamic else enum extension fallthrough fileprivate final for func get guard if import indirect infix "
+     "init inout internal in is isolated nonisolated lazy let mutating nonmutating open operator optional override "
+     "postfix precedencegroup prefix private protocol public repeat required rethrows return set some static "
+     "struct subscript super switch throws throw try typealias unowned var weak where while willSet distributed "
+     "Any Self self",
+     kWordKeyword},
+    {"false nil true", kWordLiteral},
+    {"abs all any assert assertionFailure debugPrint dump fatalError getVaList isKnownUniquelyReferenced max min "
+     "numericCast pointwiseMax pointwiseMin precondition preconditionFailure print readLine repeatElement sequence "
+     "stride swap swift_unboxFromSwiftValueWithType transcode type unsafeBitCast unsafeDowncast "
+     "withExtendedLifetime withUnsafeMutablePointer withUnsafePointer withVaList withoutActuallyEscaping zip",
+     kWordBuiltIn},
+    {"available autoclosure convention discardableResult dynamicCallable dynamicMemberLookup escaping frozen "
+     "GKInspectable IBAction IBDesignable IBInspectable IBOutlet IBSegueAction inlinable main nonobjc "
+     "NSApplicationMain NSCopying NSManaged objc objcMembers propertyWrapper requires_stored_property_inits "
+     "resultBuilder testable UIApplicationMain unknown usableFromInline",
+     kWordAttribute},
+    {"available colorLiteral column dsohandle else elseif endif error file fileID fileLiteral filePath function if "
+     "imageLiteral keyPath line selector sourceLocation warn_unqualified_access warning",
+     kWordDirective},
+    {"iOS iOSApplicationExtension macOS macOSApplicationExtension macCatalyst macCatalystApplicationExtension "
+     "watchOS watchOSApplicationExtension tvOS tvOSApplicationExtension swift",
+     kWordPlatform},
+    {"func", kWordFunction},
+    {"struct protocol class extension enum actor", kWordType},
+    {"as try init", kWordBang},
+    {"fileprivate internal open private public", kWordSetter},
+    {"init self Type Protocol", kWordMember},
+};
+
+/// 이름 → 플래그. 표가 작아서 길이와 첫·끝 글자만 섞은 해시로도 충돌이 거의 없다.
+class WordTable {
+public:
+    WordTable() {
+        for (const auto& list : kWordLists) {
+            std::string_view words = list.words;
+            while (!words.empty()) {
+                std::size_t space = words.find(' ');
+                add(words.substr(0, space), list.flags);
+                words = space == std::string_view::npos ? std::string_view() : words.substr(space + 1);
+            }
+        }
+    }
+
+    std::uint16_t find(std::string_view word) const {
+        for (std::size_t slot = hash(word);; slot = (slot + 1) & kMask) {
+            const Entry& entry = slots_[slot];
+            if (entry.flags == 0) return 0;
+            if (entry.word == word) return entry.flags;
+        }
+    }
+
+private:
+    static constexpr std::size_t kSlots = 512;
+    static constexpr std::size_t kMask = kSlots - 1;
+
+    struct Entry {
+        std::string_view word;
+        std::uint16_t flags = 0;
+    };
+
+    static std::size_t hash(std::string_view word) {
+        std::size_t h = word.size() * 0x9E37u;
+        h ^= std::uint8_t(word[0]) * 0x85EBu;
+        h ^= std::uint8_t(word[word.size() - 1]) * 0xC2B3u;
+        h ^= std::uint8_t(word[word.size() / 2]) * 0x27D5u;
+        return (h ^ (h >> 7)) & kMask;
+    }
+
+    void add(std::string_view word, std::uint16_t flags) {
+        for (std::size_t slot = hash(word);; slot = (slot + 1) & kMask) {
+            Entry& entry = slots_[slot];
+            if (entry.flags == 0 || entry.word == word) {
+                entry.word = word;
+                entry.flags |= flags;
+                return;
+            }
+        }
+    }
+
+    std::array<Entry, kSlots> slots_{};
+};
+
+const WordTable& wordTable() {
+    static const WordTable table;
+    return table;
+}
+
+// MARK: - 훑기
+
+class Scanner {
+public:
+    Scanner(std::string_view code, std::vector<HighlightSpan>& spans)
+        : code_(code), size_(code.size()), spans_(spans), words_(wordTable()) {}
+
+    void run() {
+        while (i_ < size_) {
+            if (!frames_.empty() && frames_.back().kind == Frame::String) {
+                scanString();
+                continue;
+            }
+            scanCode();
+        }
+        if (!frames_.empty() && frames_.back().kind == Frame::String) emit(segmentStart_, size_, HighlightClass::String);
+    }
+
+private:
+    /// 문자열과 보간의 중첩. 보간이 닫히면 아래의 문자열로 돌아간다.
+    struct Frame {
+        enum Kind : std::uint8_t { String, Interpolation } kind;
+        bool multiline = false;
+        std::uint8_t hashes = 0;   // `#"…"#`의 `#` 수
+        std::uint32_t parens = 0;  // 보간 안에서 연 괄호
+    };
+
+    std::uint8_t at(std::size_t index) const { return index < size_ ? std::uint8_t(code_[index]) : 0; }
+    std::uint8_t classAt(std::size_t index) const { return index < size_ ? kCharClasses[at(index)] : std::uint8_t(kOther); }
+
+    void emit(std::size_t begin, std::size_t end, HighlightClass kind) {
+        if (begin >= end) return;
+        // 같은 범주가 붙어 있으면 하나로 잇는다(`///` 주석 줄들 사이 등은 이어지지 않는다).
+        if (!spans_.empty() && spans_.back().end == begin && spans_.back().kind == kind &&
+            kind != HighlightClass::Subst) {
+            spans_.back().end = std::uint32_t(end);
+            return;
+        }
+        spans_.push_back({std::uint32_t(begin), std::uint32_t(end), kind});
+    }
+
+    std::size_t identifierEnd(std::size_t j) const {
+        while (j < size_ && isIdentifierClass(kCharClasses[at(j)])) ++j;
+        return j;
+    }
+
+    /// 바로 앞의 공백이 아닌 글자.
+    std::uint8_t previousSignificant(std::size_t index) const {
+        while (index > 0) {
+            std::uint8_t c = at(--index);
+            std::uint8_t cls = kCharClasses[c];
+            if (cls != kSpace && cls != kNewline) return c;
+        }
+        return 0;
+    }
+
+    void scanCode() {
+        std::size_t start = i_;
+        std::uint8_t cls = kCharClasses[at(i_)];
+        switch (cls) {
+        case kSpace:
+        case kNewline:
+            // 공백 범주 둘은 표의 맨 앞이다.
+            while (++i_ < size_ && kCharClasses[at(i_)] <= kNewline) {
+            }
+            return;
+        case kLower:
+        case kUpper:
+        case kHigh:
+            scanWord(start);
+            return;
+        case kDigit:
+            scanNumber(start);
+            break;
+        case kQuote:
+            openString(start, 0);
+            return;
+        case kSlash:
+            if (at(i_ + 1) == '/') {
+                while (i_ < size_ && at(i_) != '\n') ++i_;
+                emit(start, i_, HighlightClass::Comment);
+            } else if (at(i_ + 1) == '*') {
+                scanBlockComment(start);
+            } else {
+                scanOperator(start);
+            }
+            break;
+        case kAt: {
+            std::size_t end = identifierEnd(i_ + 1);
+            std::uint16_t flags = end > i_ + 1 ? words_.find(code_.substr(i_ + 1, end - i_ - 1)) : 0;
+            if (end == i_ + 1) {
+                ++i_;
+                break;
+            }
+            i_ = end;
+            emit(start, end, (flags & kWordAttribute) != 0 ? HighlightClass::Keyword : HighlightClass::Meta);
+            if (code_.substr(start + 1, end - start - 1) == "available") available_ = kAvailableNext;
+            break;
+        }
+        case kHash: {
+            std::size_t hashes = 0;
+            while (at(i_ + hashes) == '#') ++hashes;
+            if (at(i_ + hashes) == '"') {
+                openString(start, hashes);
+                return;
+            }
+            std::size_t end = identifierEnd(i_ + 1);
+            std::uint16_t flags = end > i_ + 1 ? words_.find(code_.substr(i_ + 1, end - i_ - 1)) : 0;
+            i_ = std::max(end, i_ + 1);
+            if ((flags & kWordDirective) != 0) {
+                emit(start, end, HighlightClass::Keyword);
+                if (code_.substr(start + 1, end - start - 1) == "available") available_ = kAvailableNext;
+            }
+            break;
+        }
+        case kDollar: {
+            std::size_t end = identifierEnd(i_ + 1);
+            i_ = std::max(end, i_ + 1);
+            if (end > start + 1) emit(start, end, HighlightClass::Variable);
+            break;
+        }
+        case kBacktick: {
+            std::size_t end = i_ + 1;
+            while (end < size_ && at(end) != '`' && at(end) != '\n') ++end;
+            i_ = at(end) == '`' ? end + 1 : end;
+            if (pending_ == Pending::Function) emit(start, i_, HighlightClass::Function);
+            break;
+        }
+        case kLParen:
+            ++i_;
+            ++parens_;
+            if (!frames_.empty()) ++frames_.back().parens;
+            if (available_ == kAvailableNext) available_ = parens_;
+            break;
+        case kRParen:
+            if (!frames_.empty() && frames_.back().kind == Frame::Interpolation && frames_.back().parens == 0) {
+                ++i_;
+                emit(start, i_, HighlightClass::Subst);
+                frames_.pop_back();
+                segmentStart_ = i_;
+                return;
+            }
+            ++i_;
+            if (!frames_.empty()) --frames_.back().parens;
+            if (available_ == parens_) available_ = kAvailableNone;
+            if (parens_ > 0) --parens_;
+            break;
+        case kOperator:
+            scanOperator(start);
+            break;
+        case kDot:
+            if (at(i_ + 1) == '.') {
+                scanOperator(start);
+            } else {
+                ++i_;
+            }
+            break;
+        default:
+            ++i_;
+            break;
+        }
+        pending_ = Pending::None;
+    }
+
+    void scanWord(std::size_t start) {
+        std::size_t end = identifierEnd(i_);
+        i_ = end;
+        std::string_view word = code_.substr(start, end - start);
+        Pending pending = pending_;
+        pending_ = Pending::None;
+        std::uint8_t before = previousSignificant(start);
+        std::uint16_t flags = words_.find(word);
+
+        if (before == '.') {
+            // `.init`, `.self`만 예약어다. `.default`, `.padding`은 멤버 이름이다.
+            if ((flags & kWordMember) != 0) {
+                emit(start, end, HighlightClass::Keyword);
+            } else if (classAt(start) == kUpper) {
+                emit(start, end, HighlightClass::Type);
+            }
+            return;
+        }
+        if (pending == Pending::Function && (flags & kWordKeyword) == 0) {
+            emit(start, end, HighlightClass::Function);
+            return;
+        }
+        if (pending == Pending::Type && (flags & kWordKeyword) == 0) {
+            emit(start, end, HighlightClass::Class);
+            return;
+        }
+        if ((flags & kWordKeyword) != 0) {
+            if ((flags & kWordBang) != 0 && (at(i_) == '?' || at(i_) == '!')) {
+                ++i_;
+            } else if ((flags & kWordSetter) != 0 && code_.substr(i_, 5) == "(set)") {
+                i_ += 5;
+            }
+            emit(start, i_, HighlightClass::Keyword);
+            if ((flags & kWordFunction) != 0) pending_ = Pending::Function;
+            if ((flags & kWordType) != 0) pending_ = Pending::Type;
+            return;
+        }
+        if ((flags & kWordLiteral) != 0) {
+            emit(start, end, HighlightClass::Literal);
+        } else if ((flags & kWordBuiltIn) != 0 && at(end) == '(') {
+            emit(start, end, HighlightClass::BuiltIn);
+        } else if ((flags & kWordPlatform) != 0 && available_ != kAvailableNone && available_ != kAvailableNext) {
+            emit(start, end, HighlightClass::Keyword);
+        } else if (classAt(start) == kUpper) {
+            emit(start, end, HighlightClass::Type);
+        }
+    }
+
+    void scanNumber(std::size_t start) {
+        if (at(i_) == '0' && (at(i_ + 1) == 'x' || at(i_ + 1) == 'o' || at(i_ + 1) == 'b')) i_ += 2;
+        while (i_ < size_) {
+            std::uint8_t c = at(i_);
+            std::uint8_t cls = kCharClasses[c];
+            if (cls == kDigit || cls == kLower || cls == kUpper) {
+                // 지수의 부호: `1e-5`, `0x1p+3`
+                bool exponent = c == 'e' || c == 'E' || c == 'p' || c == 'P';
+                ++i_;
+                if (exponent && (at(i_) == '+' || at(i_) == '-')) ++i_;
+            } else if (c == '.' && classAt(i_ + 1) == kDigit) {
+                ++i_;
+            } else {
+                break;
+            }
+        }
+        emit(start, i_, HighlightClass::Number);
+    }
+
+    void scanBlockComment(std::size_t start) {
+        int depth = 0;
+        while (i_ < size_) {
+            if (at(i_) == '/' && at(i_ + 1) == '*') {
+                ++depth;
+                i_ += 2;
+            } else if (at(i_) == '*' && at(i_ + 1) == '/') {
+                i_ += 2;
+                if (--depth == 0) break;
+            } else {
+                ++i_;
+            }
+        }
+        emit(start, i_, HighlightClass::Comment);
+    }
+
+    void scanOperator(std::size_t start) {
+        while (i_ < size_ && (classAt(i_) == kOperator || classAt(i_) == kSlash || classAt(i_) == kDot)) {
+            // 연산자 뒤에 붙은 주석은 연산자가 아니다.
+            if (at(i_) == '/' && (at(i_ + 1) == '/' || at(i_ + 1) == '*')) break;
+            ++i_;
+        }
+        if (i_ == start) ++i_;
+        std::string_view op = code_.substr(start, i_ - start);
+        if (pending_ == Pending::Function) {
+            emit(start, i_, HighlightClass::Function);
+        } else if (op != "->" && op != "." && op != "?" && op != "!") {
+            emit(start, i_, HighlightClass::Operator);
+        }
+    }
+
+    void openString(std::size_t start, std::size_t hashes) {
+        Frame frame;
+        frame.kind = Frame::String;
+        frame.hashes = std::uint8_t(hashes);
+        i_ = start + hashes;
+        frame.multiline = code_.substr(i_, 3) == "\"\"\"";
+        i_ += frame.multiline ? 3 : 1;
+        frames_.push_back(frame);
+        segmentStart_ = start;
+        pending_ = Pending::None;
+    }
+
+    bool closesString(const Frame& frame, std::size_t index) const {
+        if (frame.multiline ? code_.substr(index, 3) != "\"\"\"" : at(index) != '"') return false;
+        std::size_t after = index + (frame.multiline ? 3 : 1);
+        for (std::size_t k = 0; k < frame.hashes; ++k) {
+            if (at(after + k) != '#') return false;
+        }
+        return true;
+    }
+
+    /// 맨 위 문자열 프레임을 이어서 훑는다. 닫히면 프레임을 빼고, 보간을 만나면 보간 프레임을 쌓는다.
+    void scanString() {
+        Frame frame = frames_.back();
+        std::size_t segment = segmentStart_;
+        while (i_ < size_) {
+            std::uint8_t c = at(i_);
+            if (c == '\n' && !frame.multiline) break;
+            if (c == '"' && closesString(frame, i_)) {
+                i_ += (frame.multiline ? 3 : 1) + frame.hashes;
+                emit(segment, i_, HighlightClass::String);
+                frames_.pop_back();
+                return;
+            }
+            if (c == '\\') {
+                std::size_t k = 1;
+                while (k <= frame.hashes && at(i_ + k) == '#') ++k;
+                if (k != std::size_t(frame.hashes) + 1) {
+                    ++i_;
+                    continue;
+                }
+                emit(segment, i_, HighlightClass::String);
+                std::size_t escape = i_;
+                i_ += k;
+                if (at(i_) == '(') {
+                    ++i_;
+                    emit(escape, i_, HighlightClass::Subst);
+                    Frame interpolation;
+                    interpolation.kind = Frame::Interpolation;
+                    frames_.push_back(interpolation);
+                    return;
+                }
+                if (at(i_) == 'u' && at(i_ + 1) == '{') {
+                    while (i_ < size_ && at(i_) != '}' && at(i_) != '\n') ++i_;
+                    if (at(i_) == '}') ++i_;
+                } else if (i_ < size_) {
+                    ++i_;
+                }
+                emit(escape, i_, HighlightClass::Subst);
+                segment = i_;
+                continue;
+            }
+            ++i_;
+        }
+        // 닫히지 않은 문자열은 줄 끝에서 끝낸다.
+        emit(segment, i_, HighlightClass::String);
+        frames_.pop_back();
+    }
+
+    enum class Pending : std::uint8_t { None, Function, Type };
+    static constexpr std::uint32_t kAvailableNone = 0xFFFFFFFF;
+    static constexpr std::uint32_t kAvailableNext = 0xFFFFFFFE;
+
+    std::string_view code_;
+    std::size_t size_;
+    std::size_t i_ = 0;
+    std::vector<HighlightSpan>& spans_;
+    const WordTable& words_;
+    std::vector<Frame> frames_;
+    std::size_t segmentStart_ = 0;   // 맨 위 문자열에서 아직 내보내지 않은 구간의 시작(처음엔 `#`과 따옴표 포함)
+    Pending pending_ = Pending::None;
+    std::uint32_t parens_ = 0;
+    std::uint32_t available_ = kAvailableNone;   // `@available(`의 괄호 깊이
+};
+
+} // namespace
+
+std::string_view highlightClassName(HighlightClass kind) { return kClassNames[std::size_t(kind)]; }
+
+void highlightSwift(std::string_view code, std::vector<HighlightSpan>& spans) {
+    spans.clear();
+    Scanner(code, spans).run();
+}
+
+} // namespace manual
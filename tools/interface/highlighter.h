@@ -0,0 +1,51 @@
+//
+//  highlighter.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace manual {
+
+/// highlight.js Swift 문법(`highlight-js-custom-swift`)이 쓰는 범주.
+enum class HighlightClass : std::uint8_t {
+    Keyword,      // 예약어, `@available`·`@ViewBuilder`가 아닌 내장 속성, `#if`, `.init`
+    Literal,      // `true`, `false`, `nil`
+    BuiltIn,      // `print(`처럼 호출하는 표준 함수
+    Number,
+    String,
+    Subst,        // 문자열 안의 `\(`…`)`, `\n`
+    Comment,
+    Meta,         // `@ViewBuilder`, `@State`처럼 사용자 정의 속성
+    Type,         // 대문자로 시작하는 이름
+    Function,     // `func` 뒤의 이름
+    Class,        // `struct`, `class`, `enum`, `protocol`, `extension`, `actor` 뒤의 이름
+    Operator,
+    Variable,     // `$0`, `$text`
+    Count,
+};
+constexpr std::size_t kHighlightClassCount = std::size_t(HighlightClass::Count);
+
+/// `hljs-keyword`, `hljs-title function_` 같은 CSS 클래스.
+std::string_view highlightClassName(HighlightClass kind);
+
+/// 칠할 구간 `[begin, end)`. 칠하지 않는 글자(공백, 보통 이름, 괄호)는 구간이 없다.
+struct HighlightSpan {
+    std::uint32_t begin;
+    std::uint32_t end;
+    HighlightClass kind;
+};
+
+/// Swift 코드를 한 번 훑어 칠할 구간을 `spans`에 채운다. 구간은 겹치지 않고 위치 순이다.
+///
+/// 바이트마다 문자 범주 표를 한 번 찾아 상태(코드, 문자열, 보간, 주석)를 옮겨 가고, 이름은 작은 개방 주소법 표
+/// 하나로 예약어·리터럴·내장 함수·속성·플랫폼 여부를 함께 찾는다. 정규식 없이 highlight.js와 같은 범주를 낸다.
+/// 보간은 hljs처럼 `subst` 하나로 감싸지 않고 `\(`와 `)`만 칠한 뒤 안쪽을 코드로 칠한다.
+/// `spans`는 비우기만 하므로 같은 버퍼로 반복 호출하면 할당이 없다.
+void highlightSwift(std::string_view code, std::vector<HighlightSpan>& spans);
+
+} // namespace manual
@@ -0,0 +1,355 @@
+//
+//  lexer.cpp
+//  swiftUIManual tools
+//
+
+#include "interface/lexer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace manual {
+
+namespace {
+
+// MARK: - 바이트 분류
+
+enum : std::uint8_t {
+    kSpace = 1 << 0,
+    kIdentHead = 1 << 1,
+    kIdentBody = 1 << 2,
+    kDigit = 1 << 3,
+};
+
+struct ByteClassTable {
+    std::uint8_t bits[256] = {};
+
+    constexpr ByteClassTable() {
+        bits[std::uint8_t(' ')] = kSpace;
+        bits[std::uint8_t('\t')] = kSpace;
+        bits[std::uint8_t('\n')] = kSpace;
+        bits[std::uint8_t('\r')] = kSpace;
+        for (int c = 'a'; c <= 'z'; ++c) bits[c] = kIdentHead | kIdentBody;
+        for (int c = 'A'; c <= 'Z'; ++c) bits[c] = kIdentHead | kIdentBody;
+        for (int c = '0'; c <= '9'; ++c) bits[c] = kIdentBody | kDigit;
+        bits[std::uint8_t('_')] = kIdentHead | kIdentBody;
+        // UTF-8 멀티바이트 문자는 식별자의 일부로 본다.
+        for (int c = 0x80; c <= 0xFF; ++c) bits[c] = kIdentHead | kIdentBody;
+    }
+};
+constexpr ByteClassTable kByteClass;
+
+inline bool is(char c, std::uint8_t cls) { return (kByteClass.bits[std::uint8_t(c)] & cls) != 0; }
+
+inline unsigned countTrailingZeros(unsigned mask) { return unsigned(__builtin_ctz(mask)); }
+
+// 16바이트 단위로 공백이 아닌 첫 바이트를 찾는다. 인터페이스 파일은 긴 들여쓰기 구간이 많다.
+inline const char* skipSpaces(const char* p, const char* end) {
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)));
+        unsigned other = ~unsigned(_mm_movemask_epi8(ws)) & 0xFFFFu;
+        if (other != 0) return p + countTrailingZeros(other);
+        p += 16;
+    }
+#endif
+    while (p < end && is(*p, kSpace)) ++p;
+    return p;
+}
+
+// 식별자를 이루는 바이트([A-Za-z0-9_], 0x80 이상)가 끝나는 위치를 찾는다.
+inline const char* scanIdentifier(const char* p, const char* end) {
+#if defined(__SSE2__)
+    const __m128i bias = _mm_set1_epi8(char(0x80));
+    const __m128i lowerBit = _mm_set1_epi8(0x20);
+    const __m128i a = _mm_set1_epi8('a');
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i alphaLimit = _mm_set1_epi8(char(26 ^ 0x80));
+    const __m128i digitLimit = _mm_set1_epi8(char(10 ^ 0x80));
+    const __m128i underscore = _mm_set1_epi8('_');
+    const __m128i nul = _mm_setzero_si128();
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        // 부호 없는 범위 비교는 0x80을 더해 부호 있는 비교로 바꿔 처리한다.
+        __m128i alpha = _mm_cmplt_epi8(_mm_xor_si128(_mm_sub_epi8(_mm_or_si128(v, lowerBit), a), bias), alphaLimit);
+        __m128i digit = _mm_cmplt_epi8(_mm_xor_si128(_mm_sub_epi8(v, zero), bias), digitLimit);
+        __m128i ident = _mm_or_si128(_mm_or_si128(alpha, digit),
+                                     _mm_or_si128(_mm_cmpeq_epi8(v, underscore), _mm_cmplt_epi8(v, nul)));
+        unsigned other = ~unsigned(_mm_movemask_epi8(ident)) & 0xFFFFu;
+        if (other != 0) return p + countTrailingZeros(other);
+        p += 16;
+    }
+#endif
+    while (p < end && is(*p, kIdentBody)) ++p;
+    return p;
+}
+
+// MARK: - 키워드와 속성
+
+constexpr std::string_view kKeywordSpellings[] = {
+    "",
+    "Any", "as", "associatedtype", "async", "await", "case", "class", "convenience", "deinit", "dynamic",
+    "enum", "extension", "false", "fileprivate", "final", "func", "get", "import", "in", "indirect", "infix",
+    "init", "inout", "internal", "is", "lazy", "let", "mutating", "nil", "nonisolated", "nonmutating", "open",
+    "operator", "optional", "override", "postfix", "prefix", "private", "protocol", "public", "required",
+    "rethrows", "Self", "self", "set", "some", "static", "struct", "subscript", "throws", "true", "try",
+    "typealias", "unowned", "var", "weak", "where",
+};
+constexpr std::size_t kKeywordCount = sizeof(kKeywordSpellings) / sizeof(kKeywordSpellings[0]);
+static_assert(kKeywordCount == std::size_t(Keyword::Where) + 1, "철자 표는 Keyword 순서를 따라야 한다");
+
+struct KeywordEntry {
+    std::string_view spelling;
+    Keyword keyword;
+};
+
+// 철자 순으로 정렬한 조회 표. 처음 쓸 때 한 번만 만든다.
+const std::array<KeywordEntry, kKeywordCount - 1>& sortedKeywords() {
+    static const auto table = [] {
+        std::array<KeywordEntry, kKeywordCount - 1> entries{};
+        for (std::size_t i = 1; i < kKeywordCount; ++i) entries[i - 1] = {kKeywordSpellings[i], Keyword(i)};
+        std::sort(entries.begin(), entries.end(),
+                  [](const KeywordEntry& lhs, const KeywordEntry& rhs) { return lhs.spelling < rhs.spelling; });
+        return entries;
+    }();
+    return table;
+}
+
+Keyword lookupKeyword(std::string_view text) {
+    // 키워드는 모두 2~14자이고, 대문자로 시작하는 것은 `Any`, `Self`뿐이다.
+    if (text.size() < 2 || text.size() > 14) return Keyword::None;
+    char head = text[0];
+    if ((head < 'a' || head > 'z') && head != 'A' && head != 'S') return Keyword::None;
+    const auto& table = sortedKeywords();
+    auto it = std::lower_bound(table.begin(), table.end(), text,
+                               [](const KeywordEntry& entry, std::string_view key) { return entry.spelling < key; });
+    return it != table.end() && it->spelling == text ? it->keyword : Keyword::None;
+}
+
+constexpr std::string_view kAttributeSpellings[kAttributeKindCount] = {
+    "", "available", "inlinable", "frozen", "resultBuilder", "propertyWrapper", "usableFromInline",
+};
+
+AttributeKind lookupAttribute(std::string_view name) {
+    for (std::size_t i = 1; i < kAttributeKindCount; ++i) {
+        if (kAttributeSpellings[i] == name) return AttributeKind(i);
+    }
+    return AttributeKind::Other;
+}
+
+// MARK: - 스캐너
+
+const char* scanString(const char* p, const char* end) {
+    // 여는 따옴표 바로 다음에서 시작한다. 멀티라인 리터럴(`"""`)도 같은 방식으로 닫는다.
+    bool multiline = end - p >= 2 && p[0] == '"' && p[1] == '"';
+    if (multiline) p += 2;
+    while (p < end) {
+        const void* hit = std::memchr(p, '"', std::size_t(end - p));
+        const char* quote = hit ? static_cast<const char*>(hit) : end;
+        // 역슬래시 이스케이프를 건너뛴다.
+        const char* escape = static_cast<const char*>(std::memchr(p, '\\', std::size_t(quote - p)));
+        if (escape != nullptr) {
+            p = escape + 2;
+            continue;
+        }
+        if (quote == end) return end;
+        if (!multiline) return quote + 1;
+        if (end - quote >= 3 && quote[1] == '"' && quote[2] == '"') return quote + 3;
+        p = quote + 1;
+    }
+    return end;
+}
+
+const char* scanBlockComment(const char* p, const char* end) {
+    // `/*` 다음에서 시작한다. Swift 블록 주석은 중첩될 수 있다.
+    int nesting = 1;
+    while (p < end && nesting > 0) {
+        if (p[0] == '/' && p + 1 < end && p[1] == '*') {
+            ++nesting;
+            p += 2;
+        } else if (p[0] == '*' && p + 1 < end && p[1] == '/') {
+            --nesting;
+            p += 2;
+        } else {
+            ++p;
+        }
+    }
+    return p;
+}
+
+const char* scanNumber(const char* p, const char* end) {
+    while (p < end) {
+        if (is(*p, kIdentBody)) {
+            ++p;
+        } else if (*p == '.' && p + 1 < end && is(p[1], kDigit)) {
+            p += 2;
+        } else {
+            break;
+        }
+    }
+    return p;
+}
+
+const char* scanPunct(const char* p, const char* end) {
+    // 여러 글자로 된 기호 중 선언부에 나오는 것만 하나로 묶는다. `>>`는 제네릭 닫기이므로 나눈다.
+    if (end - p >= 3 && p[0] == '.' && p[1] == '.' && (p[2] == '.' || p[2] == '<')) return p + 3;
+    if (end - p >= 2) {
+        if ((p[0] == '-' && p[1] == '>') || (p[0] == '=' && p[1] == '=') || (p[0] == '!' && p[1] == '=') ||
+            (p[0] == '&' && p[1] == '&') || (p[0] == '|' && p[1] == '|')) {
+            return p + 2;
+        }
+    }
+    return p + 1;
+}
+
+} // namespace
+
+void lex(std::string_view source, TokenStream& out) {
+    out.source = source;
+    out.tokens.clear();
+    out.attributeCounts.fill(0);
+    out.maxDepth = 0;
+    out.balanced = true;
+    // 인터페이스 파일은 대략 4~5바이트마다 토큰이 하나 나온다. 한 번에 잡아 두어 재할당을 피한다.
+    out.tokens.reserve(std::max(out.tokens.capacity(), source.size() / 4 + 16));
+
+    const char* const begin = source.data();
+    const char* const end = begin + source.size();
+    const char* p = begin;
+    std::uint16_t depth = 0;
+
+    auto emit = [&](const char* start, const char* stop, TokenKind kind, std::uint8_t detail, std::uint16_t at) {
+        out.tokens.push_back(Token{std::uint32_t(start - begin), std::uint32_t(stop - start), kind, detail, at});
+    };
+
+    while (true) {
+        p = skipSpaces(p, end);
+        if (p >= end) break;
+        const char* start = p;
+        char c = *p;
+
+        if (is(c, kIdentHead)) {
+            p = scanIdentifier(p + 1, end);
+            Keyword keyword = lookupKeyword(std::string_view(start, std::size_t(p - start)));
+            emit(start, p, keyword == Keyword::None ? TokenKind::Identifier : TokenKind::Keyword,
+                 std::uint8_t(keyword), depth);
+            continue;
+        }
+
+        switch (c) {
+        case '{':
+            emit(start, ++p, TokenKind::LBrace, 0, depth);
+            if (depth < UINT16_MAX) ++depth;
+            out.maxDepth = std::max(out.maxDepth, depth);
+            break;
+        case '}':
+            if (depth == 0) {
+                out.balanced = false;
+            } else {
+                --depth;
+            }
+            emit(start, ++p, TokenKind::RBrace, 0, depth);
+            break;
+        case '(': emit(start, ++p, TokenKind::LParen, 0, depth); break;
+        case ')': emit(start, ++p, TokenKind::RParen, 0, depth); break;
+        case '[': emit(start, ++p, TokenKind::LBracket, 0, depth); break;
+        case ']': emit(start, ++p, TokenKind::RBracket, 0, depth); break;
+        case '`': {
+            // 역따옴표로 감싼 식별자(`default`)는 따옴표를 포함해 하나의 식별자로 둔다.
+            const char* close = scanIdentifier(p + 1, end);
+            p = (close < end && *close == '`') ? close + 1 : p + 1;
+            emit(start, p, p - start > 1 ? TokenKind::Identifier : TokenKind::Unknown, 0, depth);
+            break;
+        }
+        case '@': {
+            p = scanIdentifier(p + 1, end);
+            AttributeKind kind = lookupAttribute(std::string_view(start + 1, std::size_t(p - start - 1)));
+            ++out.attributeCounts[std::size_t(kind)];
+            emit(start, p, TokenKind::Attribute, std::uint8_t(kind), depth);
+            break;
+        }
+        case '#':
+            p = scanIdentifier(p + 1, end);
+            emit(start, p, TokenKind::Directive, 0, depth);
+            break;
+        case '"':
+            p = scanString(p + 1, end);
+            emit(start, p, TokenKind::String, 0, depth);
+            break;
+        case '/':
+            if (p + 1 < end && p[1] == '/') {
+                const void* newline = std::memchr(p, '\n', std::size_t(end - p));
+                p = newline ? static_cast<const char*>(newline) : end;
+                emit(start, p, TokenKind::Comment, 0, depth);
+            } else if (p + 1 < end && p[1] == '*') {
+                p = scanBlockComment(p + 2, end);
+                emit(start, p, TokenKind::Comment, 0, depth);
+            } else {
+                p = scanPunct(p, end);
+                emit(start, p, TokenKind::Punct, 0, depth);
+            }
+            break;
+        default:
+            if (is(c, kDigit)) {
+                p = scanNumber(p + 1, end);
+                emit(start, p, TokenKind::Number, 0, depth);
+            } else if (std::uint8_t(c) < 0x20 || c == 0x7F) {
+                emit(start, ++p, TokenKind::Unknown, 0, depth);
+            } else {
+                p = scanPunct(p, end);
+                emit(start, p, TokenKind::Punct, 0, depth);
+            }
+            break;
+        }
+    }
+    if (depth != 0) out.balanced = false;
+}
+
+TokenStream lex(std::string_view source) {
+    TokenStream stream;
+    lex(source, stream);
+    return stream;
+}
+
+std::string_view tokenKindName(TokenKind kind) {
+    switch (kind) {
+    case TokenKind::Identifier: return "identifier";
+    case TokenKind::Keyword: return "keyword";
+    case TokenKind::Attribute: return "attribute";
+    case TokenKind::Directive: return "directive";
+    case TokenKind::Number: return "number";
+    case TokenKind::String: return "string";
+    case TokenKind::Comment: return "comment";
+    case TokenKind::Punct: return "punct";
+    case TokenKind::LBrace: return "lbrace";
+    case TokenKind::RBrace: return "rbrace";
+    case TokenKind::LParen: return "lparen";
+    case TokenKind::RParen: return "rparen";
+    case TokenKind::LBracket: return "lbracket";
+    case TokenKind::RBracket: return "rbracket";
+    case TokenKind::Unknown: return "unknown";
+    }
+    return "unknown";
+}
+
+std::string_view keywordSpelling(Keyword keyword) {
+    auto index = std::size_t(keyword);
+    return index < kKeywordCount ? kKeywordSpellings[index] : std::string_view();
+}
+
+std::string_view attributeSpelling(AttributeKind kind) {
+    auto index = std::size_t(kind);
+    return index < kAttributeKindCount ? kAttributeSpellings[index] : std::string_view();
+}
+
+} // namespace manual
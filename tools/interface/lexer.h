@@ -0,0 +1,91 @@
+//
+//  lexer.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace manual {
+
+enum class TokenKind : std::uint8_t {
+    Identifier,
+    Keyword,
+    Attribute,   // `@available`, `@ViewBuilder` 등. `detail`에 AttributeKind가 들어간다.
+    Directive,   // `#if` 등
+    Number,
+    String,
+    Comment,
+    Punct,       // `:`, `,`, `->`, `...` 등 괄호를 제외한 기호
+    LBrace,
+    RBrace,
+    LParen,
+    RParen,
+    LBracket,
+    RBracket,
+    Unknown,
+};
+
+/// 인터페이스에 나오는 예약어와 문맥 키워드.
+enum class Keyword : std::uint8_t {
+    None,
+    Any, As, Associatedtype, Async, Await, Case, Class, Convenience, Deinit, Dynamic,
+    Enum, Extension, False, Fileprivate, Final, Func, Get, Import, In, Indirect, Infix,
+    Init, Inout, Internal, Is, Lazy, Let, Mutating, Nil, Nonisolated, Nonmutating, Open,
+    Operator, Optional, Override, Postfix, Prefix, Private, Protocol, Public, Required,
+    Rethrows, SelfType, SelfValue, Set, Some, Static, Struct, Subscript, Throws, True, Try,
+    Typealias, Unowned, Var, Weak, Where,
+};
+
+/// 따로 집계하는 속성. 나머지는 모두 `Other`로 분류한다.
+enum class AttributeKind : std::uint8_t {
+    Other,
+    Available,
+    Inlinable,
+    Frozen,
+    ResultBuilder,
+    PropertyWrapper,
+    UsableFromInline,
+};
+constexpr std::size_t kAttributeKindCount = 7;
+
+/// 토큰 하나. 원문을 복사하지 않고 오프셋과 길이만 가진다.
+struct Token {
+    std::uint32_t offset;
+    std::uint32_t length;
+    TokenKind kind;
+    std::uint8_t detail;   // Keyword 또는 AttributeKind 값
+    std::uint16_t depth;   // 토큰 위치의 중괄호 깊이. 짝이 되는 `{`와 `}`는 같은 값을 가진다.
+
+    Keyword keyword() const { return kind == TokenKind::Keyword ? Keyword(detail) : Keyword::None; }
+    AttributeKind attribute() const { return AttributeKind(detail); }
+};
+static_assert(sizeof(Token) == 12, "Token은 평평한 배열에 촘촘히 들어가야 한다");
+
+/// `lex()`의 결과. 토큰은 하나의 배열에 모이며, 원문은 호출자가 소유한다.
+struct TokenStream {
+    std::string_view source;
+    std::vector<Token> tokens;
+    std::array<std::uint32_t, kAttributeKindCount> attributeCounts{};
+    std::uint16_t maxDepth = 0;
+    bool balanced = true;
+
+    std::string_view text(const Token& token) const { return source.substr(token.offset, token.length); }
+    std::uint32_t count(AttributeKind kind) const { return attributeCounts[std::size_t(kind)]; }
+};
+
+/// `source`를 한 번 훑어 토큰, 속성, 중괄호 깊이를 함께 구한다.
+///
+/// `out`의 토큰 배열은 비우기만 하고 용량은 재사용하므로, 같은 버퍼로 반복 호출하면 힙 할당이 생기지 않는다.
+void lex(std::string_view source, TokenStream& out);
+TokenStream lex(std::string_view source);
+
+std::string_view tokenKindName(TokenKind kind);
+std::string_view keywordSpelling(Keyword keyword);
+std::string_view attributeSpelling(AttributeKind kind);
+
+} // namespace manual
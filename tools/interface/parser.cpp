@@ -0,0 +1,478 @@
+//
+//  parser.cpp
+//  swiftUIManual tools
+//
+
+#include "interface/parser.h"
+
+#include <cstring>
+
+#include "common/thread_pool.h"
+
+namespace manual {
+
+namespace {
+
+bool isModifier(Keyword keyword) {
+    switch (keyword) {
+    case Keyword::Public: case Keyword::Open: case Keyword::Internal: case Keyword::Private:
+    case Keyword::Fileprivate: case Keyword::Static: case Keyword::Final: case Keyword::Mutating:
+    case Keyword::Nonmutating: case Keyword::Override: case Keyword::Convenience: case Keyword::Required:
+    case Keyword::Indirect: case Keyword::Nonisolated: case Keyword::Dynamic: case Keyword::Lazy:
+    case Keyword::Optional: case Keyword::Weak: case Keyword::Unowned: case Keyword::Prefix:
+    case Keyword::Postfix: case Keyword::Infix:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool declKindFor(Keyword keyword, DeclKind& kind) {
+    switch (keyword) {
+    case Keyword::Import: kind = DeclKind::Import; return true;
+    case Keyword::Struct: kind = DeclKind::Struct; return true;
+    case Keyword::Class: kind = DeclKind::Class; return true;
+    case Keyword::Enum: kind = DeclKind::Enum; return true;
+    case Keyword::Protocol: kind = DeclKind::Protocol; return true;
+    case Keyword::Extension: kind = DeclKind::Extension; return true;
+    case Keyword::Typealias: kind = DeclKind::Typealias; return true;
+    case Keyword::Associatedtype: kind = DeclKind::Associatedtype; return true;
+    case Keyword::Func: kind = DeclKind::Func; return true;
+    case Keyword::Init: kind = DeclKind::Init; return true;
+    case Keyword::Deinit: kind = DeclKind::Deinit; return true;
+    case Keyword::Subscript: kind = DeclKind::Subscript; return true;
+    case Keyword::Var: kind = DeclKind::Var; return true;
+    case Keyword::Let: kind = DeclKind::Let; return true;
+    case Keyword::Case: kind = DeclKind::Case; return true;
+    case Keyword::Operator: kind = DeclKind::Operator; return true;
+    default: return false;
+    }
+}
+
+bool takesParameters(DeclKind kind) {
+    return kind == DeclKind::Func || kind == DeclKind::Init || kind == DeclKind::Subscript || kind == DeclKind::Case;
+}
+
+bool isIdentifierStart(char c) {
+    return c == '_' || c == '`' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c & 0x80) != 0;
+}
+
+std::string_view stripBackticks(std::string_view text) {
+    if (text.size() >= 2 && text.front() == '`' && text.back() == '`') return text.substr(1, text.size() - 2);
+    return text;
+}
+
+/// 구간 하나를 파싱한 중간 결과. 이름과 가용성은 합칠 때 인터닝한다.
+struct ParsedDecl {
+    Decl decl;
+    std::string_view name;
+    Availability availability;
+};
+
+struct ShardResult {
+    Arena names{8 * 1024};   // 인자 레이블을 붙여 만든 이름. 원문에 그대로 있는 이름은 복사하지 않는다.
+    std::vector<ParsedDecl> decls;
+};
+
+/// 토큰 배열 위에서 선언을 읽는 도우미. 구간 하나를 맡아 결과를 `out`에 덧붙인다.
+class DeclReader {
+public:
+    DeclReader(const TokenStream& stream, ShardResult& out)
+        : stream_(stream), tokens_(stream.tokens), out_(out.decls), names_(out.names) {}
+
+    /// `[begin, end)`의 멤버를 읽고 첫 번째 선언의 인덱스를 돌려준다.
+    std::int32_t readMembers(std::size_t begin, std::size_t end, std::int32_t parent) {
+        std::int32_t first = kNoDecl;
+        std::int32_t last = kNoDecl;
+        std::size_t i = begin;
+        while (i < end) {
+            std::size_t before = out_.size();
+            i = readDecl(i, end, parent);
+            for (std::size_t index = before; index < out_.size(); ++index) {
+                if (out_[index].decl.parent != parent) continue;
+                if (last == kNoDecl) {
+                    first = std::int32_t(index);
+                } else {
+                    out_[std::size_t(last)].decl.nextSibling = std::int32_t(index);
+                }
+                last = std::int32_t(index);
+            }
+        }
+        return first;
+    }
+
+private:
+    std::string_view text(std::size_t i) const { return stream_.text(tokens_[i]); }
+    bool isPunct(std::size_t i, std::string_view spelling) const {
+        return tokens_[i].kind == TokenKind::Punct && text(i) == spelling;
+    }
+
+    bool startsLine(std::size_t i) const {
+        if (i == 0) return true;
+        const Token& previous = tokens_[i - 1];
+        std::size_t gapBegin = previous.offset + previous.length;
+        std::size_t gapLength = tokens_[i].offset - gapBegin;
+        return std::memchr(stream_.source.data() + gapBegin, '\n', gapLength) != nullptr;
+    }
+
+    bool isDeclStart(std::size_t i) const {
+        const Token& token = tokens_[i];
+        if (token.kind == TokenKind::Attribute || token.kind == TokenKind::Directive) return true;
+        DeclKind kind;
+        return token.kind == TokenKind::Keyword && (isModifier(token.keyword()) || declKindFor(token.keyword(), kind));
+    }
+
+    /// `open`의 짝이 되는 닫는 괄호 다음 위치.
+    std::size_t skipGroup(std::size_t open, std::size_t end) const {
+        int nesting = 0;
+        for (std::size_t i = open; i < end; ++i) {
+            TokenKind kind = tokens_[i].kind;
+            if (kind == TokenKind::LParen || kind == TokenKind::LBracket) {
+                ++nesting;
+            } else if (kind == TokenKind::RParen || kind == TokenKind::RBracket) {
+                if (--nesting == 0) return i + 1;
+            }
+        }
+        return end;
+    }
+
+    std::size_t matchingBrace(std::size_t open, std::size_t end) const {
+        std::uint16_t depth = tokens_[open].depth;
+        for (std::size_t i = open + 1; i < end; ++i) {
+            if (tokens_[i].kind == TokenKind::RBrace && tokens_[i].depth == depth) return i;
+        }
+        return end;
+    }
+
+    /// 제네릭 매개변수 `<...>`를 건너뛴다.
+    std::size_t skipGenericParameters(std::size_t i, std::size_t end) const {
+        if (i >= end || !isPunct(i, "<")) return i;
+        int nesting = 0;
+        for (; i < end; ++i) {
+            if (isPunct(i, "<")) {
+                ++nesting;
+            } else if (isPunct(i, ">") && --nesting == 0) {
+                return i + 1;
+            }
+        }
+        return end;
+    }
+
+    /// 매개변수 목록에서 DocC식 레이블 `(a:_:)`를 만들고 닫는 괄호 다음 위치를 돌려준다.
+    std::size_t readLabels(std::size_t open, std::size_t end, std::string& name) const {
+        // 연산자 함수의 인자는 레이블 없이 불리므로 DocC는 모두 `_`로 적는다: `==(_:_:)`
+        bool unlabeled = !name.empty() && tokens_[open].kind == TokenKind::LParen && !isIdentifierStart(name[0]);
+        name += '(';
+        int parens = 1;
+        int angles = 0;
+        bool atParameterStart = true;
+        std::size_t i = open + 1;
+        for (; i < end; ++i) {
+            const Token& token = tokens_[i];
+            // `@ViewBuilder content: () -> V`처럼 인자 앞에 붙은 속성은 레이블이 아니다.
+            if (parens == 1 && atParameterStart && token.kind == TokenKind::Attribute) continue;
+            if (parens == 1 && atParameterStart && token.kind != TokenKind::RParen) {
+                atParameterStart = false;
+                // `label name: T`, `label: T`, `_ name: T`. 레이블이 없는 연관값(`case a(Int)`)은 `_`로 둔다.
+                bool word = token.kind == TokenKind::Identifier || token.kind == TokenKind::Keyword;
+                bool labeled = !unlabeled && word && i + 1 < end &&
+                               (isPunct(i + 1, ":") || tokens_[i + 1].kind == TokenKind::Identifier ||
+                                tokens_[i + 1].kind == TokenKind::Keyword);
+                name += labeled ? stripBackticks(text(i)) : std::string_view("_");
+                name += ':';
+            }
+            if (token.kind == TokenKind::LParen || token.kind == TokenKind::LBracket) {
+                ++parens;
+            } else if (token.kind == TokenKind::RParen || token.kind == TokenKind::RBracket) {
+                if (--parens == 0) {
+                    ++i;
+                    break;
+                }
+            } else if (parens == 1 && token.kind == TokenKind::Punct) {
+                std::string_view spelling = text(i);
+                if (spelling == "<") {
+                    ++angles;
+                } else if (spelling == ">") {
+                    --angles;
+                } else if (spelling == "," && angles == 0) {
+                    atParameterStart = true;
+                }
+            }
+        }
+        name += ')';
+        return i;
+    }
+
+    std::size_t nextDeclStart(std::size_t i, std::size_t end) const {
+        while (i < end && !(tokens_[i].kind == TokenKind::RBrace || (startsLine(i) && isDeclStart(i)))) ++i;
+        return i;
+    }
+
+    std::size_t readDecl(std::size_t i, std::size_t end, std::int32_t parent) {
+        const std::size_t first = i;
+        if (tokens_[i].kind == TokenKind::RBrace || tokens_[i].kind == TokenKind::Directive) return i + 1;
+
+        Availability availability;
+        std::uint8_t flags = 0;
+        std::size_t header = end;
+        // 속성과 수식어는 섞여 나올 수 있다: `@MainActor public static func`.
+        while (i < end) {
+            const Token& token = tokens_[i];
+            if (token.kind == TokenKind::Attribute) {
+                bool hasArguments = i + 1 < end && tokens_[i + 1].kind == TokenKind::LParen &&
+                                    tokens_[i + 1].offset == token.offset + token.length;
+                if (hasArguments) {
+                    std::size_t close = skipGroup(i + 1, end);
+                    if (token.attribute() == AttributeKind::Available) {
+                        parseAvailabilityArguments(stream_, i + 1, close - 1, availability);
+                    }
+                    i = close;
+                } else {
+                    ++i;
+                }
+                continue;
+            }
+            if (header == end) header = i;
+            if (token.kind != TokenKind::Keyword) break;
+            Keyword keyword = token.keyword();
+            bool classModifier = keyword == Keyword::Class && i + 1 < end &&
+                                 tokens_[i + 1].kind == TokenKind::Keyword && !startsLine(i + 1);
+            if (isModifier(keyword) || classModifier) {
+                if (keyword == Keyword::Static || keyword == Keyword::Class) flags |= kDeclStatic;
+                ++i;
+                continue;
+            }
+            break;
+        }
+        if (header == end) header = i;
+
+        DeclKind kind;
+        if (i >= end || tokens_[i].kind != TokenKind::Keyword || !declKindFor(tokens_[i].keyword(), kind)) {
+            // 알 수 없는 줄은 다음 선언까지 건너뛴다.
+            return nextDeclStart(std::max(i, first + 1), end);
+        }
+        ++i;
+
+        while (true) {
+            ParsedDecl parsed;
+            Decl& decl = parsed.decl;
+            decl.kind = kind;
+            decl.flags = flags;
+            decl.parent = parent;
+            decl.firstToken = std::uint32_t(first);
+            decl.headerToken = std::uint32_t(header);
+            parsed.availability = availability;
+            std::size_t nameToken = i;
+            name_.clear();
+            i = readName(kind, i, end, name_);
+
+            std::size_t j = i;
+            bool sawParameters = false;
+            bool nextCase = false;
+            int nesting = 0;
+            for (; j < end; ++j) {
+                const Token& token = tokens_[j];
+                if (nesting == 0) {
+                    if (token.kind == TokenKind::LBrace || token.kind == TokenKind::RBrace) break;
+                    if (startsLine(j) && isDeclStart(j)) break;
+                    if (kind == DeclKind::Case && isPunct(j, ",")) {
+                        nextCase = true;
+                        break;
+                    }
+                    if (token.kind == TokenKind::LParen && takesParameters(kind) && !sawParameters) {
+                        sawParameters = true;
+                        j = readLabels(j, end, name_) - 1;
+                        continue;
+                    }
+                }
+                if (token.kind == TokenKind::LParen || token.kind == TokenKind::LBracket) {
+                    ++nesting;
+                } else if (token.kind == TokenKind::RParen || token.kind == TokenKind::RBracket) {
+                    --nesting;
+                }
+            }
+            if (!sawParameters && (kind == DeclKind::Func || kind == DeclKind::Init || kind == DeclKind::Subscript)) {
+                name_ += "()";
+            }
+            std::string_view original = nameToken < end ? text(nameToken) : std::string_view();
+            parsed.name = name_ == original ? original : names_.copy(name_);
+
+            auto index = std::int32_t(out_.size());
+            decl.bodyToken = std::uint32_t(j);
+            decl.endToken = std::uint32_t(j);
+            out_.push_back(parsed);
+
+            if (j < end && tokens_[j].kind == TokenKind::LBrace) {
+                std::size_t close = matchingBrace(j, end);
+                if (isContainer(kind)) {
+                    std::int32_t child = readMembers(j + 1, close, index);
+                    out_[std::size_t(index)].decl.firstChild = child;
+                } else {
+                    for (std::size_t k = j + 1; k < close; ++k) {
+                        if (tokens_[k].keyword() == Keyword::Set) out_[std::size_t(index)].decl.flags |= kDeclSettable;
+                    }
+                }
+                j = close < end ? close + 1 : end;
+                out_[std::size_t(index)].decl.endToken = std::uint32_t(j);
+            }
+            if (!nextCase) return j;
+            i = j + 1;
+        }
+    }
+
+    std::size_t readName(DeclKind kind, std::size_t i, std::size_t end, std::string& name) const {
+        if (i >= end) return i;
+        switch (kind) {
+        case DeclKind::Init:
+        case DeclKind::Deinit:
+        case DeclKind::Subscript:
+            name = keywordSpelling(tokens_[i - 1].keyword());
+            // 실패 가능한 생성자의 `?`, `!`는 이름에 넣지 않는다.
+            if (kind == DeclKind::Init && (isPunct(i, "?") || isPunct(i, "!"))) ++i;
+            return skipGenericParameters(i, end);
+        case DeclKind::Extension:
+        case DeclKind::Import:
+            // 점으로 이어진 경로: `Text.Storage`
+            name = stripBackticks(text(i++));
+            while (i + 1 < end && isPunct(i, ".") && tokens_[i + 1].kind != TokenKind::Punct) {
+                name += '.';
+                name += stripBackticks(text(i + 1));
+                i += 2;
+            }
+            return i;
+        case DeclKind::Func:
+        case DeclKind::Operator:
+            if (tokens_[i].kind == TokenKind::Punct) {
+                // 연산자 이름은 붙어 있는 기호 토큰을 모두 이은 것이다: `==`, `..<`
+                std::size_t start = i;
+                while (i < end && tokens_[i].kind == TokenKind::Punct &&
+                       (i == start || tokens_[i].offset == tokens_[i - 1].offset + tokens_[i - 1].length)) {
+                    name += text(i++);
+                }
+                return skipGenericParameters(i, end);
+            }
+            name = stripBackticks(text(i++));
+            return skipGenericParameters(i, end);
+        default:
+            name = stripBackticks(text(i++));
+            return i;
+        }
+    }
+
+    const TokenStream& stream_;
+    const std::vector<Token>& tokens_;
+    std::vector<ParsedDecl>& out_;
+    Arena& names_;
+    std::string name_;
+};
+
+} // namespace
+
+/// 구간별 결과를 하나의 표로 합치는 쪽. 심벌 표의 내부를 채울 수 있게 friend로 둔다.
+class SymbolTableBuilder {
+public:
+    static SymbolTable build(TokenStream&& stream, std::vector<ShardResult>& shards) {
+        SymbolTable table;
+        table.tokens_ = std::move(stream);
+        std::size_t total = 0;
+        std::size_t roots = 0;
+        for (const auto& shard : shards) {
+            total += shard.decls.size();
+            for (const auto& parsed : shard.decls) roots += parsed.decl.parent == kNoDecl ? 1 : 0;
+        }
+        table.decls_ = table.arena_.makeArray<Decl>(total);
+        table.topLevel_ = table.arena_.makeArray<std::uint32_t>(roots);
+
+        std::size_t next = 0;
+        std::size_t nextRoot = 0;
+        std::string qualified;
+        for (auto& shard : shards) {
+            auto base = std::int32_t(next);
+            auto shift = [base](std::int32_t index) { return index == kNoDecl ? kNoDecl : index + base; };
+            for (auto& parsed : shard.decls) {
+                Decl decl = parsed.decl;
+                decl.parent = shift(decl.parent);
+                decl.firstChild = shift(decl.firstChild);
+                decl.nextSibling = shift(decl.nextSibling);
+                decl.name = table.symbols_.intern(parsed.name);
+                decl.availability = table.availabilities_.intern(parsed.availability);
+                // 부모가 항상 자식보다 앞에 있으므로 부모의 한정 이름은 이미 정해져 있다.
+                if (decl.parent == kNoDecl) {
+                    decl.qualifiedName = decl.name;
+                    if (nextRoot > 0) table.decls_[table.topLevel_[nextRoot - 1]].nextSibling = std::int32_t(next);
+                    table.topLevel_[nextRoot++] = std::uint32_t(next);
+                } else {
+                    qualified = table.qualifiedName(table.decls_[std::size_t(decl.parent)]);
+                    qualified += '.';
+                    qualified += parsed.name;
+                    decl.qualifiedName = table.symbols_.intern(qualified);
+                }
+                table.decls_[next++] = decl;
+            }
+            // 구간의 이름 버퍼는 인터닝이 끝났으니 바로 돌려준다.
+            shard.names.release();
+        }
+
+        // 한정 이름 번호별 선언 목록을 CSR 배열로 만든다.
+        table.nameOffsets_ = table.arena_.makeArray<std::uint32_t>(table.symbols_.size() + 1);
+        for (const Decl& decl : table.decls_) ++table.nameOffsets_[decl.qualifiedName + 1];
+        for (std::size_t i = 1; i < table.nameOffsets_.size(); ++i) table.nameOffsets_[i] += table.nameOffsets_[i - 1];
+        table.byQualifiedName_ = table.arena_.makeArray<std::uint32_t>(total);
+        std::vector<std::uint32_t> fill(table.nameOffsets_.begin(), table.nameOffsets_.end() - 1);
+        for (std::size_t i = 0; i < total; ++i) table.byQualifiedName_[fill[table.decls_[i].qualifiedName]++] = std::uint32_t(i);
+        return table;
+    }
+};
+
+std::vector<Shard> findShards(const TokenStream& stream) {
+    std::vector<Shard> shards;
+    const auto& tokens = stream.tokens;
+    std::uint32_t begin = 0;
+    bool sawDeclKeyword = false;
+    int nesting = 0;
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+        const Token& token = tokens[i];
+        if (token.depth != 0) continue;
+        switch (token.kind) {
+        case TokenKind::LParen: case TokenKind::LBracket: ++nesting; continue;
+        case TokenKind::RParen: case TokenKind::RBracket: --nesting; continue;
+        default: break;
+        }
+        if (nesting != 0) continue;
+
+        bool declStart = token.kind == TokenKind::Attribute || token.kind == TokenKind::Directive;
+        DeclKind kind;
+        bool declKeyword = token.kind == TokenKind::Keyword && declKindFor(token.keyword(), kind);
+        declStart = declStart || declKeyword || (token.kind == TokenKind::Keyword && isModifier(token.keyword()));
+        if (declStart && sawDeclKeyword && i > begin) {
+            std::size_t gap = tokens[i - 1].offset + tokens[i - 1].length;
+            if (std::memchr(stream.source.data() + gap, '\n', token.offset - gap) != nullptr) {
+                shards.push_back(Shard{begin, std::uint32_t(i)});
+                begin = std::uint32_t(i);
+                sawDeclKeyword = false;
+            }
+        }
+        if (declKeyword) sawDeclKeyword = true;
+    }
+    if (begin < tokens.size()) shards.push_back(Shard{begin, std::uint32_t(tokens.size())});
+    return shards;
+}
+
+SymbolTable parseInterface(std::string_view source, ThreadPool* pool) {
+    TokenStream stream = lex(source);
+    std::vector<Shard> shards = findShards(stream);
+    std::vector<ShardResult> results(shards.size());
+
+    auto parseShard = [&](std::size_t index) {
+        DeclReader reader(stream, results[index]);
+        reader.readMembers(shards[index].begin, shards[index].end, kNoDecl);
+    };
+    if (pool != nullptr) {
+        pool->parallelFor(shards.size(), parseShard);
+    } else {
+        for (std::size_t i = 0; i < shards.size(); ++i) parseShard(i);
+    }
+    return SymbolTableBuilder::build(std::move(stream), results);
+}
+
+} // namespace manual
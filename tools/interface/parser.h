@@ -0,0 +1,34 @@
+//
+//  parser.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "interface/lexer.h"
+#include "interface/symbol_table.h"
+
+namespace manual {
+
+class ThreadPool;
+
+/// 최상위 선언 하나가 차지하는 토큰 구간 `[begin, end)`.
+struct Shard {
+    std::uint32_t begin;
+    std::uint32_t end;
+};
+
+/// 최상위 선언의 경계를 찾는다. 각 구간은 다른 구간과 상관없이 파싱할 수 있다.
+std::vector<Shard> findShards(const TokenStream& stream);
+
+/// 인터페이스 전체를 파싱한다.
+///
+/// `pool`이 있으면 최상위 선언 구간을 작업자들이 나눠 파싱하고, 원래 순서대로 하나의 심벌 표로 합친다.
+/// `source`는 반환된 심벌 표보다 오래 살아 있어야 한다.
+SymbolTable parseInterface(std::string_view source, ThreadPool* pool = nullptr);
+
+} // namespace manual
@@ -0,0 +1,71 @@
+//
+//  symbol_table.cpp
+//  swiftUIManual tools
+//
+
+#include "interface/symbol_table.h"
+
+
+namespace manual {
+
+std::string_view declKindName(DeclKind kind) {
+    switch (kind) {
+    case DeclKind::Import: return "import";
+    case DeclKind::Struct: return "struct";
+    case DeclKind::Class: return "class";
+    case DeclKind::Enum: return "enum";
+    case DeclKind::Protocol: return "protocol";
+    case DeclKind::Extension: return "extension";
+    case DeclKind::Typealias: return "typealias";
+    case DeclKind::Associatedtype: return "associatedtype";
+    case DeclKind::Func: return "func";
+    case DeclKind::Init: return "init";
+    case DeclKind::Deinit: return "deinit";
+    case DeclKind::Subscript: return "subscript";
+    case DeclKind::Var: return "var";
+    case DeclKind::Let: return "let";
+    case DeclKind::Case: return "case";
+    case DeclKind::Operator: return "operator";
+    }
+    return "unknown";
+}
+
+bool isContainer(DeclKind kind) {
+    switch (kind) {
+    case DeclKind::Struct:
+    case DeclKind::Class:
+    case DeclKind::Enum:
+    case DeclKind::Protocol:
+    case DeclKind::Extension:
+        return true;
+    default:
+        return false;
+    }
+}
+
+std::string SymbolTable::signature(std::size_t index) const {
+    const Decl& decl = decls_[index];
+    std::string text;
+    for (std::uint32_t i = decl.headerToken; i < decl.bodyToken; ++i) {
+        const Token& token = tokens_.tokens[i];
+        if (i > decl.headerToken) {
+            const Token& previous = tokens_.tokens[i - 1];
+            if (previous.offset + previous.length != token.offset) text += ' ';
+        }
+        text += tokens_.text(token);
+    }
+    return text;
+}
+
+Span<const std::uint32_t> SymbolTable::find(std::string_view qualifiedName) const {
+    Symbol symbol;
+    if (!symbols_.find(qualifiedName, symbol) || symbol + 1 >= nameOffsets_.size()) return {};
+    std::uint32_t begin = nameOffsets_[symbol];
+    return {byQualifiedName_.data() + begin, nameOffsets_[symbol + 1] - begin};
+}
+
+std::size_t SymbolTable::modelMemoryUsage() const {
+    return arena_.bytesReserved() + symbols_.memoryUsage() + availabilities_.memoryUsage();
+}
+
+} // namespace manual
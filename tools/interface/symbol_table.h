@@ -0,0 +1,107 @@
+//
+//  symbol_table.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "common/arena.h"
+#include "common/interner.h"
+#include "interface/availability.h"
+#include "interface/lexer.h"
+
+namespace manual {
+
+enum class DeclKind : std::uint8_t {
+    Import,
+    Struct,
+    Class,
+    Enum,
+    Protocol,
+    Extension,
+    Typealias,
+    Associatedtype,
+    Func,
+    Init,
+    Deinit,
+    Subscript,
+    Var,
+    Let,
+    Case,
+    Operator,
+};
+constexpr std::size_t kDeclKindCount = 16;
+
+std::string_view declKindName(DeclKind kind);
+/// 멤버를 가질 수 있는 선언인지. 이런 선언의 본문만 멤버로 파싱한다.
+bool isContainer(DeclKind kind);
+
+enum DeclFlags : std::uint8_t {
+    kDeclStatic = 1 << 0,      // `static` 또는 `class` 수식어
+    kDeclSettable = 1 << 1,    // 접근자 블록에 `set`이 있다
+};
+
+constexpr std::int32_t kNoDecl = -1;
+
+/// 선언 하나. 문자열과 가용성은 인터닝한 번호로, 나머지는 토큰 배열의 구간으로 가리킨다.
+struct Decl {
+    DeclKind kind = DeclKind::Struct;
+    std::uint8_t flags = 0;
+    Symbol name = kEmptySymbol;            // 함수류는 DocC처럼 인자 레이블을 붙인다: `padding(_:_:)`
+    Symbol qualifiedName = kEmptySymbol;   // 확장은 확장한 타입 이름을 쓴다: `View.padding(_:_:)`
+    AvailabilityId availability = 0;
+    std::int32_t parent = kNoDecl;
+    std::int32_t firstChild = kNoDecl;
+    std::int32_t nextSibling = kNoDecl;
+    std::uint32_t firstToken = 0;    // 속성을 포함한 선언의 시작
+    std::uint32_t headerToken = 0;   // 수식어와 선언 키워드의 시작
+    std::uint32_t bodyToken = 0;     // 본문 `{`. 본문이 없으면 `endToken`과 같다.
+    std::uint32_t endToken = 0;      // 본문까지 포함한 끝(배타적)
+};
+
+/// 파싱한 인터페이스 전체.
+///
+/// 선언 노드와 조회용 배열은 모두 하나의 아레나에 있어서, 표를 버리면 블록 몇 개만 돌려주면 된다.
+/// 토큰 배열도 함께 가지며, 원문은 호출자가 소유한다.
+class SymbolTable {
+public:
+    std::string_view source() const { return tokens_.source; }
+    const TokenStream& tokens() const { return tokens_; }
+    Span<const Decl> decls() const { return {decls_.data(), decls_.size()}; }
+    Span<const std::uint32_t> topLevel() const { return {topLevel_.data(), topLevel_.size()}; }
+    const Decl& operator[](std::size_t index) const { return decls_[index]; }
+    std::size_t size() const { return decls_.size(); }
+
+    const StringInterner& symbols() const { return symbols_; }
+    const AvailabilityTable& availabilities() const { return availabilities_; }
+    std::string_view name(const Decl& decl) const { return symbols_[decl.name]; }
+    std::string_view qualifiedName(const Decl& decl) const { return symbols_[decl.qualifiedName]; }
+    const Availability& availability(const Decl& decl) const { return availabilities_[decl.availability]; }
+
+    /// 정규화한 선언부. 속성과 본문을 빼고, 토큰 사이 공백은 한 칸으로 줄인다.
+    std::string signature(std::size_t index) const;
+
+    /// 한정 이름이 같은 모든 선언(오버로드, 여러 확장)을 선언 순서로 돌려준다.
+    Span<const std::uint32_t> find(std::string_view qualifiedName) const;
+
+    /// 토큰 배열을 뺀 모델(선언, 문자열, 가용성, 조회 배열)이 차지하는 바이트 수.
+    std::size_t modelMemoryUsage() const;
+
+private:
+    friend class SymbolTableBuilder;
+
+    TokenStream tokens_;
+    Arena arena_;
+    StringInterner symbols_;
+    AvailabilityTable availabilities_;
+    Span<Decl> decls_;
+    Span<std::uint32_t> topLevel_;
+    Span<std::uint32_t> nameOffsets_;   // 한정 이름 번호별로 `byQualifiedName_`의 시작 위치
+    Span<std::uint32_t> byQualifiedName_;
+};
+
+} // namespace manual
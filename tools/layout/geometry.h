@@ -0,0 +1,105 @@
+//
+//  geometry.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace manual {
+
+enum class Axis : std::uint8_t { Horizontal, Vertical };
+
+struct Size {
+    double width = 0;
+    double height = 0;
+
+    double operator[](Axis axis) const { return axis == Axis::Horizontal ? width : height; }
+    double& operator[](Axis axis) { return axis == Axis::Horizontal ? width : height; }
+    bool operator==(const Size& other) const { return width == other.width && height == other.height; }
+    bool operator!=(const Size& other) const { return !(*this == other); }
+};
+
+struct Point {
+    double x = 0;
+    double y = 0;
+
+    double operator[](Axis axis) const { return axis == Axis::Horizontal ? x : y; }
+    double& operator[](Axis axis) { return axis == Axis::Horizontal ? x : y; }
+};
+
+struct Rect {
+    Point origin;
+    Size size;
+
+    double minX() const { return origin.x; }
+    double minY() const { return origin.y; }
+    double maxX() const { return origin.x + size.width; }
+    double maxY() const { return origin.y + size.height; }
+};
+
+/// SwiftUI `ProposedViewSize`. 치수마다 `nil`(이상적인 크기를 달라)은 NaN으로 둔다.
+struct ProposedViewSize {
+    static constexpr double kUnspecified = std::numeric_limits<double>::quiet_NaN();
+    static constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+    double width = kUnspecified;
+    double height = kUnspecified;
+
+    ProposedViewSize() = default;
+    ProposedViewSize(double width, double height) : width(width), height(height) {}
+    explicit ProposedViewSize(Size size) : width(size.width), height(size.height) {}
+
+    static ProposedViewSize zero() { return {0, 0}; }
+    static ProposedViewSize unspecified() { return {}; }
+    static ProposedViewSize infinity() { return {kInfinity, kInfinity}; }
+
+    bool hasWidth() const { return width == width; }
+    bool hasHeight() const { return height == height; }
+    bool has(Axis axis) const { return axis == Axis::Horizontal ? hasWidth() : hasHeight(); }
+    double operator[](Axis axis) const { return axis == Axis::Horizontal ? width : height; }
+    double& operator[](Axis axis) { return axis == Axis::Horizontal ? width : height; }
+
+    /// `nil`인 치수를 `size`로 채운다. SwiftUI의 기본값은 10×10이다.
+    Size replacingUnspecifiedDimensions(Size size = {10, 10}) const {
+        return {hasWidth() ? width : size.width, hasHeight() ? height : size.height};
+    }
+
+    /// 두 제안이 같은지. `nil`끼리는 같다.
+    bool operator==(const ProposedViewSize& other) const {
+        return (width == other.width || (!hasWidth() && !other.hasWidth())) &&
+               (height == other.height || (!hasHeight() && !other.hasHeight()));
+    }
+    bool operator!=(const ProposedViewSize& other) const { return !(*this == other); }
+};
+
+/// 가로 정렬 가이드.
+enum class HorizontalAlignment : std::uint8_t { Leading, Center, Trailing };
+
+/// 세로 정렬 가이드. 글자 기준선은 `Text`가 명시적으로 알려 주고, 없으면 아래 가장자리다.
+enum class VerticalAlignment : std::uint8_t { Top, Center, Bottom, FirstTextBaseline, LastTextBaseline };
+
+struct Alignment {
+    HorizontalAlignment horizontal = HorizontalAlignment::Center;
+    VerticalAlignment vertical = VerticalAlignment::Center;
+};
+
+/// 크기에 대한 상대 위치. `(0, 0)`이 왼쪽 위, `(1, 1)`이 오른쪽 아래.
+struct UnitPoint {
+    double x = 0;
+    double y = 0;
+
+    static constexpr UnitPoint topLeading() { return {0, 0}; }
+    static constexpr UnitPoint center() { return {0.5, 0.5}; }
+};
+
+struct EdgeInsets {
+    double top = 0;
+    double leading = 0;
+    double bottom = 0;
+    double trailing = 0;
+};
+
+} // namespace manual
@@ -0,0 +1,378 @@
+//
+//  grid_layout.cpp
+//  swiftUIManual tools
+//
+
+#include "layout/grid_layout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "layout/layout_engine.h"
+
+namespace manual {
+
+namespace {
+
+constexpr double kDefaultSpacing = 8;
+constexpr double kShapeIdealLength = 10;   // `nil` 제안에 도형이 돌려주는 길이
+constexpr std::size_t kLanes = 8;          // 열 최대값을 나눠 모으는 갈래 수
+
+/// 칸 종류. 넣은 칸 배열에는 `std::uint8_t`로, 열 우선 배열에는 `std::int32_t`로 둔다.
+enum Kind : std::uint8_t { kEmpty, kText, kImage, kShape };
+
+double alignmentFactor(HorizontalAlignment alignment) {
+    switch (alignment) {
+    case HorizontalAlignment::Leading:
+        return 0;
+    case HorizontalAlignment::Center:
+        return 0.5;
+    case HorizontalAlignment::Trailing:
+        return 1;
+    }
+    return 0.5;
+}
+
+double alignmentFactor(VerticalAlignment alignment) {
+    switch (alignment) {
+    case VerticalAlignment::Top:
+        return 0;
+    case VerticalAlignment::Center:
+        return 0.5;
+    case VerticalAlignment::Bottom:
+    case VerticalAlignment::FirstTextBaseline:
+    case VerticalAlignment::LastTextBaseline:
+        return 1;
+    }
+    return 0.5;
+}
+
+bool isBaseline(VerticalAlignment alignment) {
+    return alignment == VerticalAlignment::FirstTextBaseline || alignment == VerticalAlignment::LastTextBaseline;
+}
+
+// 칸 치수. 종류마다 갈라지지 않고 종류 비교를 0과 1로 바꿔 곱하거나 선택식으로 고르므로 반복이 벡터로 바뀐다.
+// 비교와 곱이 예외를 낼 수 있다고 보면 GCC가 분기를 남기므로 이 파일은 `-fno-trapping-math`로 빌드한다.
+
+inline double idealWidth(std::int32_t kind, double a, double b) {
+    double text = kind == kText;
+    double image = kind == kImage;
+    double shape = kind == kShape;
+    return text * a * b * kTextCharacterWidth + image * a + shape * kShapeIdealLength;
+}
+
+inline double minimumWidth(std::int32_t kind, double a, double b) {
+    double text = (kind == kText) & (a > 0);
+    double image = kind == kImage;
+    return text * b * kTextCharacterWidth + image * a;
+}
+
+/// 열 하나의 최대값. 여덟 갈래로 나눠 모으면 갈래끼리는 서로 기다리지 않아 벡터 비교 한 번에 여럿을 줄인다.
+double columnMaximum(const double* values, std::size_t count) {
+    double lanes[kLanes] = {};
+    std::size_t r = 0;
+    for (; r + kLanes <= count; r += kLanes) {
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            lanes[lane] = lanes[lane] > values[r + lane] ? lanes[lane] : values[r + lane];
+        }
+    }
+    for (; r < count; ++r) lanes[0] = std::max(lanes[0], values[r]);
+    return *std::max_element(lanes, lanes + kLanes);
+}
+
+struct CellMetrics {
+    double width;
+    double height;
+    double baseline;
+};
+
+/// 폭 `width`를 제안받은 칸의 크기와 기준선. `Text`는 `measureText`와 같은 값이다.
+/// 글자 수는 정수라 `floor`와 `ceil` 대신 정수 변환을 쓴다.
+inline CellMetrics measureCell(std::int32_t kind, double a, double b, double width, std::int32_t guide) {
+    double characterWidth = std::max(b * kTextCharacterWidth, 1e-3);   // 글이 아닌 칸의 0 나눗셈을 피한다
+    double lineHeight = b * kTextLineHeight;
+    double natural = a * characterWidth;
+    bool fits = natural <= width;
+    double columns = std::min(width / characterWidth, 1e9);
+    double perLine = std::max(1.0, double(std::int32_t(columns)));
+    double lines = fits ? 1.0 : double(std::int32_t((a + perLine - 1) / perLine));
+    double wrapped = std::min(a, perLine) * characterWidth;
+    bool text = (kind == kText) & (a > 0);   // `&&`는 분기가 되어 벡터화를 막는다
+    double textHeight = lines * lineHeight;
+    bool last = guide == std::int32_t(VerticalAlignment::LastTextBaseline);
+    double textBaseline = last ? textHeight - lineHeight * (1 - kTextAscent) : lineHeight * kTextAscent;
+
+    double otherWidth = kind == kImage ? a : kind == kShape ? width : 0.0;
+    double otherHeight = kind == kImage ? b : kind == kShape ? kShapeIdealLength : 0.0;
+    return {text ? (fits ? natural : wrapped) : otherWidth, text ? textHeight : otherHeight,
+            text ? textBaseline : otherHeight};
+}
+
+} // namespace
+
+GridSolver::GridSolver(Alignment alignment, double horizontalSpacing, double verticalSpacing)
+    : alignment_(alignment), horizontalSpacing_(horizontalSpacing == horizontalSpacing ? horizontalSpacing : kDefaultSpacing),
+      verticalSpacing_(verticalSpacing == verticalSpacing ? verticalSpacing : kDefaultSpacing) {}
+
+std::uint32_t GridSolver::addRow(std::optional<VerticalAlignment> alignment) {
+    rows_.push_back({alignment.value_or(alignment_.vertical)});
+    nextColumn_ = 0;
+    prepared_ = false;
+    return rows() - 1;
+}
+
+std::uint32_t GridSolver::addCell(std::uint8_t kind, double a, double b, std::uint32_t columns) {
+    if (rows_.empty()) throw std::runtime_error("grid cells need a row");
+    columns = std::max<std::uint32_t>(columns, 1);
+    cellKinds_.push_back(kind);
+    cellA_.push_back(a);
+    cellB_.push_back(b);
+    cellRows_.push_back(rows() - 1);
+    cellColumns_.push_back(nextColumn_);
+    cellSpans_.push_back(columns);
+    nextColumn_ += columns;
+    columns_ = std::max(columns_, nextColumn_);
+    prepared_ = false;
+    return cells() - 1;
+}
+
+std::uint32_t GridSolver::addText(std::uint32_t characters, double fontSize, std::uint32_t columns) {
+    return addCell(kText, double(characters), fontSize, columns);
+}
+
+std::uint32_t GridSolver::addImage(Size size, std::uint32_t columns) {
+    return addCell(kImage, size.width, size.height, columns);
+}
+
+std::uint32_t GridSolver::addShape(std::uint32_t columns) {
+    return addCell(kShape, 0, 0, columns);
+}
+
+std::uint32_t GridSolver::addEmpty(std::uint32_t columns) {
+    return addCell(kEmpty, 0, 0, columns);
+}
+
+void GridSolver::setColumnAlignment(std::uint32_t column, HorizontalAlignment alignment) {
+    if (column >= columnAlignments_.size()) columnAlignments_.resize(column + 1);
+    columnAlignments_[column] = alignment;
+}
+
+void GridSolver::setCellAnchor(std::uint32_t cell, UnitPoint anchor) {
+    anchors_.emplace_back(cell, anchor);
+    prepared_ = false;
+}
+
+// MARK: - 풀이
+
+void GridSolver::prepare() {
+    std::size_t rows = rows_.size();
+    std::size_t slots = std::size_t(columns_) * rows;
+    slotKinds_.assign(slots, kEmpty);
+    slotA_.assign(slots, 0);
+    slotB_.assign(slots, 0);
+    slotGuides_.resize(slots);
+    slotWidths_.resize(slots);
+    slotHeights_.resize(slots);
+    slotBaselines_.resize(slots);
+    for (std::size_t c = 0; c < columns_; ++c) {
+        for (std::size_t r = 0; r < rows; ++r) slotGuides_[c * rows + r] = std::int32_t(rows_[r].alignment);
+    }
+    spans_.clear();
+    for (std::uint32_t cell = 0; cell < cells(); ++cell) {
+        if (cellSpans_[cell] > 1) {
+            spans_.push_back(cell);
+            continue;
+        }
+        std::size_t slot = std::size_t(cellColumns_[cell]) * rows + cellRows_[cell];
+        slotKinds_[slot] = cellKinds_[cell];
+        slotA_[slot] = cellA_[cell];
+        slotB_[slot] = cellB_[cell];
+    }
+    std::stable_sort(spans_.begin(), spans_.end(),
+                     [&](std::uint32_t a, std::uint32_t b) { return cellSpans_[a] < cellSpans_[b]; });
+    std::stable_sort(anchors_.begin(), anchors_.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    columnAlignments_.resize(columns_);
+    measureColumns();
+    prepared_ = true;
+    resolved_ = false;
+}
+
+void GridSolver::measureColumns() {
+    std::size_t rows = rows_.size();
+    idealWidths_.assign(columns_, 0);
+    minimumWidths_.assign(columns_, 0);
+    flexibleColumns_.assign(columns_, 0);
+    std::vector<double> ideal(rows);
+    std::vector<double> minimum(rows);
+    for (std::size_t c = 0; c < columns_; ++c) {
+        const std::int32_t* kinds = slotKinds_.data() + c * rows;
+        const double* a = slotA_.data() + c * rows;
+        const double* b = slotB_.data() + c * rows;
+        double* ideals = ideal.data();
+        double* minimums = minimum.data();
+        std::int32_t flexible = 0;
+        for (std::size_t r = 0; r < rows; ++r) {
+            ideals[r] = idealWidth(kinds[r], a[r], b[r]);
+            minimums[r] = minimumWidth(kinds[r], a[r], b[r]);
+            flexible |= std::int32_t(kinds[r] == kShape);
+        }
+        idealWidths_[c] = columnMaximum(ideals, rows);
+        minimumWidths_[c] = columnMaximum(minimums, rows);
+        flexibleColumns_[c] = std::uint8_t(flexible);
+    }
+
+    // 걸친 열의 합이 모자라면 그 열들에 고르게 더한다. 좁은 칸부터라 넓은 칸은 앞서 넓어진 열을 본다.
+    auto widen = [&](std::vector<double>& widths, std::uint32_t column, std::uint32_t span, double width) {
+        double current = horizontalSpacing_ * double(span - 1);
+        for (std::uint32_t k = 0; k < span; ++k) current += widths[column + k];
+        if (width <= current) return;
+        double extra = (width - current) / double(span);
+        for (std::uint32_t k = 0; k < span; ++k) widths[column + k] += extra;
+    };
+    for (std::uint32_t cell : spans_) {
+        std::uint32_t column = cellColumns_[cell];
+        std::uint32_t span = cellSpans_[cell];
+        widen(idealWidths_, column, span, idealWidth(cellKinds_[cell], cellA_[cell], cellB_[cell]));
+        widen(minimumWidths_, column, span, minimumWidth(cellKinds_[cell], cellA_[cell], cellB_[cell]));
+        if (cellKinds_[cell] == kShape) {
+            for (std::uint32_t k = 0; k < span; ++k) flexibleColumns_[column + k] = 1;
+        }
+    }
+}
+
+void GridSolver::resolveColumns(double width) {
+    columnWidths_ = idealWidths_;
+    if (columns_ == 0 || width != width || std::isinf(width)) return;
+    double available = width - horizontalSpacing_ * double(columns_ - 1);
+    double ideal = 0;
+    double minimum = 0;
+    std::uint32_t flexible = 0;
+    for (std::size_t c = 0; c < columns_; ++c) {
+        ideal += idealWidths_[c];
+        minimum += minimumWidths_[c];
+        flexible += flexibleColumns_[c];
+    }
+    if (available <= minimum) {
+        columnWidths_ = minimumWidths_;
+    } else if (available < ideal) {
+        double t = (available - minimum) / (ideal - minimum);
+        for (std::size_t c = 0; c < columns_; ++c) {
+            columnWidths_[c] = minimumWidths_[c] + t * (idealWidths_[c] - minimumWidths_[c]);
+        }
+    } else if (flexible > 0) {
+        double extra = (available - ideal) / double(flexible);
+        for (std::size_t c = 0; c < columns_; ++c) columnWidths_[c] += flexibleColumns_[c] ? extra : 0.0;
+    }
+}
+
+void GridSolver::measureRows() {
+    std::size_t rows = rows_.size();
+    for (std::size_t c = 0; c < columns_; ++c) {
+        const std::int32_t* kinds = slotKinds_.data() + c * rows;
+        const std::int32_t* guides = slotGuides_.data() + c * rows;
+        const double* a = slotA_.data() + c * rows;
+        const double* b = slotB_.data() + c * rows;
+        double* widths = slotWidths_.data() + c * rows;
+        double* heights = slotHeights_.data() + c * rows;
+        double* baselines = slotBaselines_.data() + c * rows;
+        double width = columnWidths_[c];
+        for (std::size_t r = 0; r < rows; ++r) {
+            CellMetrics metrics = measureCell(kinds[r], a[r], b[r], width, guides[r]);
+            widths[r] = metrics.width;
+            heights[r] = metrics.height;
+            baselines[r] = metrics.baseline;
+        }
+    }
+    for (std::uint32_t cell : spans_) {
+        std::uint32_t column = cellColumns_[cell];
+        double width = horizontalSpacing_ * double(cellSpans_[cell] - 1);
+        for (std::uint32_t k = 0; k < cellSpans_[cell]; ++k) width += columnWidths_[column + k];
+        std::size_t slot = std::size_t(column) * rows + cellRows_[cell];
+        CellMetrics metrics = measureCell(cellKinds_[cell], cellA_[cell], cellB_[cell], width, slotGuides_[slot]);
+        slotWidths_[slot] = metrics.width;
+        slotHeights_[slot] = metrics.height;
+        slotBaselines_[slot] = metrics.baseline;
+    }
+
+    // 열 배열을 차례로 겹쳐 행마다 원소별 최대값을 남긴다.
+    rowHeights_.assign(rows, 0);
+    rowAscents_.assign(rows, 0);
+    rowDescents_.assign(rows, 0);
+    double* heights = rowHeights_.data();
+    double* ascents = rowAscents_.data();
+    double* descents = rowDescents_.data();
+    for (std::size_t c = 0; c < columns_; ++c) {
+        const double* slotHeights = slotHeights_.data() + c * rows;
+        const double* slotBaselines = slotBaselines_.data() + c * rows;
+        for (std::size_t r = 0; r < rows; ++r) {
+            double below = slotHeights[r] - slotBaselines[r];
+            heights[r] = heights[r] > slotHeights[r] ? heights[r] : slotHeights[r];
+            ascents[r] = ascents[r] > slotBaselines[r] ? ascents[r] : slotBaselines[r];
+            descents[r] = descents[r] > below ? descents[r] : below;
+        }
+    }
+    for (std::size_t r = 0; r < rows; ++r) {
+        if (isBaseline(rows_[r].alignment)) heights[r] = std::max(heights[r], ascents[r] + descents[r]);
+    }
+}
+
+Size GridSolver::sizeThatFits(ProposedViewSize proposal) {
+    if (!prepared_) prepare();
+    double width = proposal.width;
+    if (resolved_ && (width == resolvedWidth_ || (width != width && resolvedWidth_ != resolvedWidth_))) return size_;
+    resolveColumns(width);
+    measureRows();
+    resolvedWidth_ = width;
+    resolved_ = true;
+
+    size_ = {};
+    for (double length : columnWidths_) size_.width += length;
+    for (double length : rowHeights_) size_.height += length;
+    if (columns_ > 0) size_.width += horizontalSpacing_ * double(columns_ - 1);
+    if (!rows_.empty()) size_.height += verticalSpacing_ * double(rows_.size() - 1);
+    return size_;
+}
+
+Size GridSolver::place(ProposedViewSize proposal) {
+    Size size = sizeThatFits(proposal);
+    std::size_t rows = rows_.size();
+    std::vector<double> columnOffsets(columns_ + 1);
+    for (std::size_t c = 0; c < columns_; ++c) columnOffsets[c + 1] = columnOffsets[c] + columnWidths_[c] + horizontalSpacing_;
+    std::vector<double> rowOffsets(rows + 1);
+    for (std::size_t r = 0; r < rows; ++r) rowOffsets[r + 1] = rowOffsets[r] + rowHeights_[r] + verticalSpacing_;
+
+    frames_.resize(cells());
+    auto anchor = anchors_.begin();
+    for (std::uint32_t cell = 0; cell < cells(); ++cell) {
+        std::uint32_t row = cellRows_[cell];
+        std::uint32_t column = cellColumns_[cell];
+        std::size_t slot = std::size_t(column) * rows + row;
+        double x = columnOffsets[column];
+        double width = columnOffsets[column + cellSpans_[cell]] - horizontalSpacing_ - x;
+        double y = rowOffsets[row];
+        double height = rowHeights_[row];
+        bool fills = cellKinds_[cell] == kShape;   // 도형은 행 높이를 채운다
+        Size cellSize{slotWidths_[slot], fills ? height : slotHeights_[slot]};
+
+        while (anchor != anchors_.end() && anchor->first < cell) ++anchor;
+        if (anchor != anchors_.end() && anchor->first == cell) {
+            x += (width - cellSize.width) * anchor->second.x;
+            y += (height - cellSize.height) * anchor->second.y;
+        } else {
+            HorizontalAlignment horizontal = columnAlignments_[column].value_or(alignment_.horizontal);
+            VerticalAlignment vertical = rows_[row].alignment;
+            x += (width - cellSize.width) * alignmentFactor(horizontal);
+            if (isBaseline(vertical) && !fills) {
+                y += rowAscents_[row] - slotBaselines_[slot];
+            } else {
+                y += (height - cellSize.height) * alignmentFactor(vertical);
+            }
+        }
+        frames_[cell] = {{x, y}, cellSize};
+    }
+    return size;
+}
+
+} // namespace manual
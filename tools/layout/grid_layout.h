@@ -0,0 +1,115 @@
+//
+//  grid_layout.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "layout/geometry.h"
+
+namespace manual {
+
+/// `Grid { GridRow { … } }`의 전용 풀이기.
+///
+/// 일반 `Layout` 경로는 칸마다 가상 호출로 `sizeThatFits`를 묻고 스택이 자식을 거듭 재지만, 표 모양의 격자는 열 폭이
+/// 모든 행의 같은 열 칸 가운데 최대값이라는 것만 알면 된다. 그래서 칸 내용(`Text`, `Image`, `Shape`)을 종류와 두 수로
+/// 줄여 열 우선 배열에 두고 두 번에 푼다.
+///
+/// 1. 열마다 칸의 이상적인 폭과 최소 폭을 한 배열에서 연속으로 구해 최대값으로 줄인다. `gridCellColumns`로 여러 열을
+///    차지하는 칸은 그다음에 좁은 것부터, 걸친 열의 합이 모자라는 만큼 그 열들에 고르게 나눠 준다.
+///    제안 폭이 모자라면 열마다 최소 폭과 이상적인 폭 사이를 같은 비율로 줄이고, 남으면 `Shape`가 있는 열이 나눠 갖는다.
+/// 2. 정한 열 폭으로 칸 높이를 구하고, 열 배열을 차례로 훑으며 행마다 높이와 기준선 위·아래의 최대값을 원소별로 줄인다.
+///
+/// 두 번 모두 종류에 따른 분기 대신 선택식만 쓰는 연속 배열 반복이라 컴파일러가 벡터로 바꾼다. 열 최대값은 여덟 갈래로
+/// 나눠 모은 뒤 합친다.
+class GridSolver {
+public:
+    /// `Grid(alignment:horizontalSpacing:verticalSpacing:)`. 간격이 `nil`이면 8이다.
+    explicit GridSolver(Alignment alignment = {}, double horizontalSpacing = ProposedViewSize::kUnspecified,
+                        double verticalSpacing = ProposedViewSize::kUnspecified);
+
+    /// `GridRow(alignment:)`를 열고 행 번호를 돌려준다. 이후 칸은 이 행에 들어간다.
+    std::uint32_t addRow(std::optional<VerticalAlignment> alignment = std::nullopt);
+    /// 칸을 더하고 칸 번호를 돌려준다. `columns`는 `gridCellColumns(_:)`.
+    std::uint32_t addText(std::uint32_t characters, double fontSize = 17, std::uint32_t columns = 1);
+    std::uint32_t addImage(Size size, std::uint32_t columns = 1);
+    std::uint32_t addShape(std::uint32_t columns = 1);
+    /// 아무것도 그리지 않고 자리만 차지하는 칸(`Color.clear.gridCellUnsizedAxes([.horizontal, .vertical])`).
+    std::uint32_t addEmpty(std::uint32_t columns = 1);
+
+    /// `gridColumnAlignment(_:)`. 열의 모든 칸에 적용한다.
+    void setColumnAlignment(std::uint32_t column, HorizontalAlignment alignment);
+    /// `gridCellAnchor(_:)`. 칸을 행·열 정렬 대신 자기 영역의 `anchor`에 맞춘다.
+    void setCellAnchor(std::uint32_t cell, UnitPoint anchor);
+
+    /// 격자의 크기. 같은 제안 폭이면 다시 풀지 않는다.
+    Size sizeThatFits(ProposedViewSize proposal);
+    /// 풀고 칸마다 격자 원점 기준 프레임을 정한다.
+    Size place(ProposedViewSize proposal);
+
+    std::uint32_t rows() const { return std::uint32_t(rows_.size()); }
+    std::uint32_t columns() const { return columns_; }
+    std::uint32_t cells() const { return std::uint32_t(cellKinds_.size()); }
+    const std::vector<double>& columnWidths() const { return columnWidths_; }
+    const std::vector<double>& rowHeights() const { return rowHeights_; }
+    Rect frame(std::uint32_t cell) const { return frames_[cell]; }
+
+private:
+    std::uint32_t addCell(std::uint8_t kind, double a, double b, std::uint32_t columns);
+    void prepare();
+    void measureColumns();
+    void resolveColumns(double width);
+    void measureRows();
+
+    struct Row {
+        VerticalAlignment alignment;
+    };
+
+    Alignment alignment_;
+    double horizontalSpacing_;
+    double verticalSpacing_;
+
+    // 넣은 순서(행 우선)의 칸. 문자·폭은 `a`, 글자 크기·높이는 `b`다.
+    std::vector<Row> rows_;
+    std::vector<std::uint8_t> cellKinds_;
+    std::vector<double> cellA_;
+    std::vector<double> cellB_;
+    std::vector<std::uint32_t> cellRows_;
+    std::vector<std::uint32_t> cellColumns_;
+    std::vector<std::uint32_t> cellSpans_;
+    std::vector<std::optional<HorizontalAlignment>> columnAlignments_;
+    std::vector<std::pair<std::uint32_t, UnitPoint>> anchors_;
+    std::uint32_t columns_ = 0;
+    std::uint32_t nextColumn_ = 0;
+    bool prepared_ = false;
+
+    // 열 우선 칸 배열(`column * rows + row`). 여러 열에 걸친 칸은 첫 칸 자리에 두되 열 폭 최대값에서는 뺀다.
+    // 종류와 가이드는 실수와 한 벡터에 섞이도록 32비트로 둔다.
+    std::vector<std::int32_t> slotKinds_;
+    std::vector<double> slotA_;
+    std::vector<double> slotB_;
+    std::vector<std::int32_t> slotGuides_;
+    std::vector<double> slotWidths_;
+    std::vector<double> slotHeights_;
+    std::vector<double> slotBaselines_;
+    std::vector<std::uint32_t> spans_;   // 여러 열에 걸친 칸, 좁은 것부터
+
+    std::vector<double> idealWidths_;
+    std::vector<double> minimumWidths_;
+    std::vector<std::uint8_t> flexibleColumns_;
+    std::vector<double> columnWidths_;
+    std::vector<double> rowHeights_;
+    std::vector<double> rowAscents_;
+    std::vector<double> rowDescents_;
+    std::vector<Rect> frames_;
+    double resolvedWidth_ = 0;
+    bool resolved_ = false;
+    Size size_;
+};
+
+} // namespace manual
@@ -0,0 +1,417 @@
+//
+//  layout.cpp
+//  swiftUIManual tools
+//
+
+#include "layout/layout.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "layout/layout_engine.h"
+
+namespace manual {
+
+namespace {
+
+double defaultGuide(HorizontalAlignment guide, double width) {
+    switch (guide) {
+    case HorizontalAlignment::Leading:
+        return 0;
+    case HorizontalAlignment::Center:
+        return width / 2;
+    case HorizontalAlignment::Trailing:
+        return width;
+    }
+    return 0;
+}
+
+double defaultGuide(VerticalAlignment guide, double height) {
+    switch (guide) {
+    case VerticalAlignment::Top:
+        return 0;
+    case VerticalAlignment::Center:
+        return height / 2;
+    case VerticalAlignment::Bottom:
+    case VerticalAlignment::FirstTextBaseline:
+    case VerticalAlignment::LastTextBaseline:
+        return height;
+    }
+    return 0;
+}
+
+bool isBaseline(VerticalAlignment guide) {
+    return guide == VerticalAlignment::FirstTextBaseline || guide == VerticalAlignment::LastTextBaseline;
+}
+
+Axis crossAxis(Axis axis) { return axis == Axis::Horizontal ? Axis::Vertical : Axis::Horizontal; }
+
+} // namespace
+
+// MARK: - ViewDimensions, LayoutSubview
+
+double ViewDimensions::operator[](HorizontalAlignment guide) const {
+    return explicitValue(guide).value_or(defaultGuide(guide, width));
+}
+
+double ViewDimensions::operator[](VerticalAlignment guide) const {
+    return explicitValue(guide).value_or(defaultGuide(guide, height));
+}
+
+std::optional<double> ViewDimensions::explicitValue(HorizontalAlignment guide) const {
+    return engine_->explicitGuide(node_, guide, {width, height}, proposal_);
+}
+
+std::optional<double> ViewDimensions::explicitValue(VerticalAlignment guide) const {
+    return engine_->explicitGuide(node_, guide, {width, height}, proposal_);
+}
+
+Size LayoutSubview::sizeThatFits(ProposedViewSize proposal) const { return engine_->measure(node_, proposal); }
+
+ViewDimensions LayoutSubview::dimensions(ProposedViewSize proposal) const {
+    return {*engine_, node_, engine_->measure(node_, proposal), proposal};
+}
+
+ViewDimensions LayoutSubview::dimensions(ProposedViewSize proposal, Size size) const {
+    return {*engine_, node_, size, proposal};
+}
+
+double LayoutSubview::priority() const { return engine_->tree().priority(node_); }
+
+void LayoutSubview::place(Point position, UnitPoint anchor, ProposedViewSize proposal) const {
+    engine_->recordPlacement(node_, position, anchor, proposal);
+}
+
+// MARK: - Layout
+
+void Layout::makeCache(const LayoutSubviews&, LayoutCache&) const {}
+
+void Layout::updateCache(const LayoutSubviews& subviews, LayoutCache& cache) const {
+    cache.values.clear();
+    cache.indices.clear();
+    makeCache(subviews, cache);
+}
+
+std::optional<double> Layout::explicitAlignment(HorizontalAlignment, Rect, ProposedViewSize, const LayoutSubviews&,
+                                                LayoutCache&) const {
+    return std::nullopt;
+}
+
+std::optional<double> Layout::explicitAlignment(VerticalAlignment, Rect, ProposedViewSize, const LayoutSubviews&,
+                                                LayoutCache&) const {
+    return std::nullopt;
+}
+
+// MARK: - StackLayout
+
+namespace {
+
+// 스택 캐시 `values`의 배치. 머리 뒤에 자식마다 `kChildSlots`칸을 둔다.
+enum StackSlot : std::size_t {
+    kProposalWidth,
+    kProposalHeight,
+    kValid,
+    kMainSize,
+    kCrossSize,
+    kCrossLine,   // 교차축 정렬 가이드의 위치
+    kHeader,
+};
+
+enum ChildSlot : std::size_t {
+    kChildProposal,   // 주축으로 제안한 길이
+    kChildMain,
+    kChildCross,
+    kChildGuide,
+    kChildSlots,
+};
+
+} // namespace
+
+void StackLayout::makeCache(const LayoutSubviews& subviews, LayoutCache& cache) const {
+    cache.values.assign(kHeader + kChildSlots * subviews.size(), 0);
+    cache.indices.resize(subviews.size());
+}
+
+double StackLayout::crossGuide(const ViewDimensions& dimensions) const {
+    return axis_ == Axis::Horizontal ? dimensions[VerticalAlignment(alignment_)]
+                                     : dimensions[HorizontalAlignment(alignment_)];
+}
+
+Size StackLayout::allocate(ProposedViewSize proposal, const LayoutSubviews& subviews, LayoutCache& cache) const {
+    std::vector<double>& values = cache.values;
+    const Axis main = axis_;
+    const Axis cross = crossAxis(axis_);
+    auto result = [&] {
+        Size size;
+        size[main] = values[kMainSize];
+        size[cross] = values[kCrossSize];
+        return size;
+    };
+    std::size_t count = subviews.size();
+    if (values.size() != kHeader + kChildSlots * count) makeCache(subviews, cache);
+    if (values[kValid] != 0 && ProposedViewSize(values[kProposalWidth], values[kProposalHeight]) == proposal) {
+        return result();
+    }
+    if (count == 0) {
+        values[kMainSize] = values[kCrossSize] = values[kCrossLine] = 0;
+    } else {
+        auto child = [&](std::size_t index) { return values.data() + kHeader + kChildSlots * index; };
+        auto childProposal = [&](double length) {
+            ProposedViewSize childProposal;
+            childProposal[main] = length;
+            childProposal[cross] = proposal[cross];
+            return childProposal;
+        };
+        double spacing = spacing_ * double(count - 1);
+
+        if (!proposal.has(main) || count == 1) {
+            // 이상적인 크기를 묻거나 자식이 하나면 나눌 것이 없다.
+            double length = proposal.has(main) ? std::max(0.0, proposal[main] - spacing) : proposal[main];
+            for (std::size_t i = 0; i < count; ++i) {
+                double* slots = child(i);
+                Size size = subviews[i].sizeThatFits(childProposal(length));
+                slots[kChildProposal] = length;
+                slots[kChildMain] = size[main];
+                slots[kChildCross] = size[cross];
+            }
+        } else {
+            // 최소 길이와 유연성을 재 둔다. 교차축 슬롯을 잠시 빌려 쓴다.
+            double totalMinimum = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                double* slots = child(i);
+                double minimum = subviews[i].sizeThatFits(childProposal(0))[main];
+                double maximum = subviews[i].sizeThatFits(childProposal(ProposedViewSize::kInfinity))[main];
+                slots[kChildCross] = minimum;
+                slots[kChildGuide] = maximum - minimum;
+                totalMinimum += minimum;
+            }
+            std::vector<std::uint32_t>& order = cache.indices;
+            order.resize(count);
+            std::iota(order.begin(), order.end(), 0u);
+            std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+                double priorityA = subviews[a].priority();
+                double priorityB = subviews[b].priority();
+                if (priorityA != priorityB) return priorityA > priorityB;
+                return child(a)[kChildGuide] < child(b)[kChildGuide];
+            });
+
+            double remaining = proposal[main] - spacing;
+            double lowerMinimum = totalMinimum;
+            for (std::size_t group = 0; group < count;) {
+                double priority = subviews[order[group]].priority();
+                std::size_t groupEnd = group;
+                while (groupEnd < count && subviews[order[groupEnd]].priority() == priority) {
+                    lowerMinimum -= child(order[groupEnd])[kChildCross];
+                    ++groupEnd;
+                }
+                double available = remaining - lowerMinimum;
+                for (std::size_t k = group; k < groupEnd; ++k) {
+                    double* slots = child(order[k]);
+                    double share = std::max(0.0, available) / double(groupEnd - k);
+                    Size size = subviews[order[k]].sizeThatFits(childProposal(share));
+                    slots[kChildProposal] = share;
+                    slots[kChildMain] = size[main];
+                    slots[kChildCross] = size[cross];
+                    available -= size[main];
+                    remaining -= size[main];
+                }
+                group = groupEnd;
+            }
+        }
+
+        double length = spacing;
+        double above = 0;
+        double below = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            double* slots = child(i);
+            Size size;
+            size[main] = slots[kChildMain];
+            size[cross] = slots[kChildCross];
+            double guide = crossGuide(subviews[i].dimensions(childProposal(slots[kChildProposal]), size));
+            slots[kChildGuide] = guide;
+            length += slots[kChildMain];
+            above = std::max(above, guide);
+            below = std::max(below, slots[kChildCross] - guide);
+        }
+        values[kMainSize] = length;
+        values[kCrossSize] = above + below;
+        values[kCrossLine] = above;
+    }
+    values[kProposalWidth] = proposal.width;
+    values[kProposalHeight] = proposal.height;
+    values[kValid] = 1;
+    return result();
+}
+
+Size StackLayout::sizeThatFits(ProposedViewSize proposal, const LayoutSubviews& subviews, LayoutCache& cache) const {
+    return allocate(proposal, subviews, cache);
+}
+
+void StackLayout::placeSubviews(Rect bounds, ProposedViewSize proposal, const LayoutSubviews& subviews,
+                                LayoutCache& cache) const {
+    allocate(proposal, subviews, cache);
+    const std::vector<double>& values = cache.values;
+    const Axis main = axis_;
+    const Axis cross = crossAxis(axis_);
+    double position = bounds.origin[main];
+    for (std::size_t i = 0; i < subviews.size(); ++i) {
+        const double* slots = values.data() + kHeader + kChildSlots * i;
+        Point point;
+        point[main] = position;
+        point[cross] = bounds.origin[cross] + values[kCrossLine] - slots[kChildGuide];
+        ProposedViewSize childProposal;
+        childProposal[main] = slots[kChildProposal];
+        childProposal[cross] = proposal[cross];
+        subviews[i].place(point, UnitPoint::topLeading(), childProposal);
+        position += slots[kChildMain] + spacing_;
+    }
+}
+
+std::optional<double> StackLayout::explicitAlignment(VerticalAlignment guide, Rect bounds, ProposedViewSize proposal,
+                                                     const LayoutSubviews& subviews, LayoutCache& cache) const {
+    if (!isBaseline(guide) || subviews.empty()) return std::nullopt;
+    allocate(proposal, subviews, cache);
+    const std::vector<double>& values = cache.values;
+    auto childDimensions = [&](std::size_t index) {
+        const double* slots = values.data() + kHeader + kChildSlots * index;
+        ProposedViewSize childProposal;
+        childProposal[axis_] = slots[kChildProposal];
+        childProposal[crossAxis(axis_)] = proposal[crossAxis(axis_)];
+        Size size;
+        size[axis_] = slots[kChildMain];
+        size[crossAxis(axis_)] = slots[kChildCross];
+        return subviews[index].dimensions(childProposal, size);
+    };
+    bool first = guide == VerticalAlignment::FirstTextBaseline;
+    if (axis_ == Axis::Vertical) {
+        // 첫 기준선은 첫 자식의 것, 마지막 기준선은 마지막 자식의 것이다.
+        std::size_t index = first ? 0 : subviews.size() - 1;
+        double top = 0;
+        for (std::size_t i = 0; i < index; ++i) top += values[kHeader + kChildSlots * i + kChildMain] + spacing_;
+        return bounds.minY() + top + childDimensions(index)[guide];
+    }
+    if (VerticalAlignment(alignment_) == guide) return bounds.minY() + values[kCrossLine];
+    double result = first ? ProposedViewSize::kInfinity : -ProposedViewSize::kInfinity;
+    for (std::size_t i = 0; i < subviews.size(); ++i) {
+        double top = values[kCrossLine] - values[kHeader + kChildSlots * i + kChildGuide];
+        double baseline = top + childDimensions(i)[guide];
+        result = first ? std::min(result, baseline) : std::max(result, baseline);
+    }
+    return bounds.minY() + result;
+}
+
+// MARK: - ZStackLayout
+
+namespace {
+
+/// 정렬 가이드에 맞춰 겹친 자식들의 크기와 가이드 위치.
+struct Overlay {
+    Size size;
+    Point line;
+};
+
+Overlay overlay(Alignment alignment, ProposedViewSize proposal, const LayoutSubviews& subviews) {
+    double left = 0, right = 0, above = 0, below = 0;
+    for (LayoutSubview subview : subviews) {
+        ViewDimensions dimensions = subview.dimensions(proposal);
+        double x = dimensions[alignment.horizontal];
+        double y = dimensions[alignment.vertical];
+        left = std::max(left, x);
+        right = std::max(right, dimensions.width - x);
+        above = std::max(above, y);
+        below = std::max(below, dimensions.height - y);
+    }
+    return {{left + right, above + below}, {left, above}};
+}
+
+} // namespace
+
+Size ZStackLayout::sizeThatFits(ProposedViewSize proposal, const LayoutSubviews& subviews, LayoutCache&) const {
+    return overlay(alignment_, proposal, subviews).size;
+}
+
+void ZStackLayout::placeSubviews(Rect bounds, ProposedViewSize proposal, const LayoutSubviews& subviews,
+                                 LayoutCache&) const {
+    Point line = overlay(alignment_, proposal, subviews).line;
+    for (LayoutSubview subview : subviews) {
+        ViewDimensions dimensions = subview.dimensions(proposal);
+        subview.place({bounds.minX() + line.x - dimensions[alignment_.horizontal],
+                       bounds.minY() + line.y - dimensions[alignment_.vertical]},
+                      UnitPoint::topLeading(), proposal);
+    }
+}
+
+// MARK: - PaddingLayout
+
+ProposedViewSize PaddingLayout::inner(ProposedViewSize proposal) const {
+    ProposedViewSize result = proposal;
+    if (result.hasWidth()) result.width = std::max(0.0, result.width - insets_.leading - insets_.trailing);
+    if (result.hasHeight()) result.height = std::max(0.0, result.height - insets_.top - insets_.bottom);
+    return result;
+}
+
+Size PaddingLayout::sizeThatFits(ProposedViewSize proposal, const LayoutSubviews& subviews, LayoutCache&) const {
+    Size content;
+    ProposedViewSize childProposal = inner(proposal);
+    for (LayoutSubview subview : subviews) {
+        Size size = subview.sizeThatFits(childProposal);
+        content.width = std::max(content.width, size.width);
+        content.height = std::max(content.height, size.height);
+    }
+    return {content.width + insets_.leading + insets_.trailing, content.height + insets_.top + insets_.bottom};
+}
+
+void PaddingLayout::placeSubviews(Rect bounds, ProposedViewSize proposal, const LayoutSubviews& subviews,
+                                  LayoutCache&) const {
+    ProposedViewSize childProposal = inner(proposal);
+    for (LayoutSubview subview : subviews) {
+        subview.place({bounds.minX() + insets_.leading, bounds.minY() + insets_.top}, UnitPoint::topLeading(),
+                      childProposal);
+    }
+}
+
+std::optional<double> PaddingLayout::explicitAlignment(VerticalAlignment guide, Rect bounds, ProposedViewSize proposal,
+                                                       const LayoutSubviews& subviews, LayoutCache&) const {
+    if (!isBaseline(guide) || subviews.empty()) return std::nullopt;
+    return bounds.minY() + insets_.top + subviews[0].dimensions(inner(proposal))[guide];
+}
+
+// MARK: - FrameLayout
+
+ProposedViewSize FrameLayout::childProposal(ProposedViewSize proposal) const {
+    return {width_ == width_ ? width_ : proposal.width, height_ == height_ ? height_ : proposal.height};
+}
+
+Size FrameLayout::sizeThatFits(ProposedViewSize proposal, const LayoutSubviews& subviews, LayoutCache&) const {
+    Size content;
+    ProposedViewSize inner = childProposal(proposal);
+    for (LayoutSubview subview : subviews) {
+        Size size = subview.sizeThatFits(inner);
+        content.width = std::max(content.width, size.width);
+        content.height = std::max(content.height, size.height);
+    }
+    return {width_ == width_ ? width_ : content.width, height_ == height_ ? height_ : content.height};
+}
+
+void FrameLayout::placeSubviews(Rect bounds, ProposedViewSize proposal, const LayoutSubviews& subviews,
+                                LayoutCache&) const {
+    ProposedViewSize inner = childProposal(proposal);
+    double x = defaultGuide(alignment_.horizontal, bounds.size.width);
+    double y = defaultGuide(alignment_.vertical, bounds.size.height);
+    for (LayoutSubview subview : subviews) {
+        ViewDimensions dimensions = subview.dimensions(inner);
+        subview.place({bounds.minX() + x - dimensions[alignment_.horizontal],
+                       bounds.minY() + y - dimensions[alignment_.vertical]},
+                      UnitPoint::topLeading(), inner);
+    }
+}
+
+std::optional<double> FrameLayout::explicitAlignment(VerticalAlignment guide, Rect bounds, ProposedViewSize proposal,
+                                                     const LayoutSubviews& subviews, LayoutCache&) const {
+    if (!isBaseline(guide) || subviews.empty()) return std::nullopt;
+    ViewDimensions dimensions = subviews[0].dimensions(childProposal(proposal));
+    double top = defaultGuide(alignment_.vertical, bounds.size.height) - dimensions[alignment_.vertical];
+    return bounds.minY() + top + dimensions[guide];
+}
+
+} // namespace manual
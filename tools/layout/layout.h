@@ -0,0 +1,222 @@
+//
+//  layout.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "layout/geometry.h"
+
+namespace manual {
+
+class LayoutEngine;
+
+/// 배치 과정 중 한 뷰의 크기와 정렬 가이드. SwiftUI `ViewDimensions`.
+class ViewDimensions {
+public:
+    ViewDimensions(LayoutEngine& engine, std::uint32_t node, Size size, ProposedViewSize proposal)
+        : width(size.width), height(size.height), engine_(&engine), node_(node), proposal_(proposal) {}
+
+    double width;
+    double height;
+
+    /// 가이드의 위치. 뷰가 명시한 값이 없으면 기본값(가장자리, 가운데, 기준선은 아래 가장자리).
+    double operator[](HorizontalAlignment guide) const;
+    double operator[](VerticalAlignment guide) const;
+    std::optional<double> explicitValue(HorizontalAlignment guide) const;
+    std::optional<double> explicitValue(VerticalAlignment guide) const;
+
+private:
+    LayoutEngine* engine_;
+    std::uint32_t node_;
+    ProposedViewSize proposal_;
+};
+
+/// 배치가 자식 하나를 다루는 손잡이. SwiftUI `LayoutSubview`. 엔진과 노드 번호뿐이라 값으로 넘긴다.
+class LayoutSubview {
+public:
+    LayoutSubview(LayoutEngine& engine, std::uint32_t node) : engine_(&engine), node_(node) {}
+
+    std::uint32_t node() const { return node_; }
+    Size sizeThatFits(ProposedViewSize proposal) const;
+    ViewDimensions dimensions(ProposedViewSize proposal) const;
+    /// 이미 `proposal`로 잰 `size`로 만든 치수. 가이드를 물을 때만 더 잰다.
+    ViewDimensions dimensions(ProposedViewSize proposal, Size size) const;
+    /// `layoutPriority(_:)`. 기본값은 0.
+    double priority() const;
+    /// 자식을 `position`에 `anchor`가 오도록 놓는다. 크기는 `proposal`로 다시 묻는다.
+    /// `placeSubviews`에서 놓지 않은 자식은 경계 가운데에 경계 크기를 제안해 놓는다.
+    void place(Point position, UnitPoint anchor = UnitPoint::topLeading(),
+               ProposedViewSize proposal = ProposedViewSize::unspecified()) const;
+
+private:
+    LayoutEngine* engine_;
+    std::uint32_t node_;
+};
+
+/// 한 노드의 자식 목록. SwiftUI `LayoutSubviews`. 엔진의 평평한 자식 번호 배열 한 구간을 가리킨다.
+class LayoutSubviews {
+public:
+    class Iterator {
+    public:
+        Iterator(LayoutEngine* engine, const std::uint32_t* at) : engine_(engine), at_(at) {}
+        LayoutSubview operator*() const { return {*engine_, *at_}; }
+        Iterator& operator++() {
+            ++at_;
+            return *this;
+        }
+        bool operator!=(const Iterator& other) const { return at_ != other.at_; }
+
+    private:
+        LayoutEngine* engine_;
+        const std::uint32_t* at_;
+    };
+
+    LayoutSubviews(LayoutEngine& engine, const std::uint32_t* begin, const std::uint32_t* end)
+        : engine_(&engine), begin_(begin), end_(end) {}
+
+    std::size_t size() const { return std::size_t(end_ - begin_); }
+    bool empty() const { return begin_ == end_; }
+    LayoutSubview operator[](std::size_t index) const { return {*engine_, begin_[index]}; }
+    Iterator begin() const { return {engine_, begin_}; }
+    Iterator end() const { return {engine_, end_}; }
+
+private:
+    LayoutEngine* engine_;
+    const std::uint32_t* begin_;
+    const std::uint32_t* end_;
+};
+
+/// 배치가 노드마다 갖는 캐시. Swift의 `Cache` 연관 타입 대신, 엔진이 노드마다 하나씩 두는 실수·번호 배열이다.
+struct LayoutCache {
+    std::vector<double> values;
+    std::vector<std::uint32_t> indices;
+};
+
+/// SwiftUI `Layout` 프로토콜.
+///
+/// 배치 객체는 상태가 없는 값이라 여러 노드와 여러 스레드가 같이 쓴다. 노드별 상태는 `cache`에 둔다.
+/// `placeSubviews`와 `explicitAlignment`의 `bounds`는 노드 자신의 좌표계라 원점이 (0, 0)이고, 자식은 그 좌표로 놓는다.
+class Layout {
+public:
+    virtual ~Layout() = default;
+
+    virtual Size sizeThatFits(ProposedViewSize proposal, const LayoutSubviews& subviews, LayoutCache& cache) const = 0;
+    virtual void placeSubviews(Rect bounds, ProposedViewSize proposal, const LayoutSubviews& subviews,
+                               LayoutCache& cache) const = 0;
+    /// 노드의 첫 배치 전에 한 번 부른다.
+    virtual void makeCache(const LayoutSubviews& subviews, LayoutCache& cache) const;
+    /// 자식 목록이나 자식의 입력이 바뀌면 부른다. 기본은 캐시를 비우고 `makeCache`를 다시 부른다.
+    virtual void updateCache(const LayoutSubviews& subviews, LayoutCache& cache) const;
+    /// 가이드 값을 정한다. 기본은 `nullopt`로, 가이드의 기본값을 쓴다.
+    virtual std::optional<double> explicitAlignment(HorizontalAlignment guide, Rect bounds, ProposedViewSize proposal,
+                                                    const LayoutSubviews& subviews, LayoutCache& cache) const;
+    virtual std::optional<double> explicitAlignment(VerticalAlignment guide, Rect bounds, ProposedViewSize proposal,
+                                                    const LayoutSubviews& subviews, LayoutCache& cache) const;
+    /// 자식 `Spacer`가 늘어나는 축. 스택만 값이 있다.
+    virtual std::optional<Axis> spacerAxis() const { return std::nullopt; }
+};
+
+// MARK: - 기본 배치
+
+/// `HStackLayout`과 `VStackLayout`의 공통 구현.
+///
+/// 자식마다 주축으로 0과 무한대를 제안해 유연성(최대 - 최소)을 재고, `layoutPriority`가 높은 무리부터,
+/// 무리 안에서는 덜 유연한 자식부터 남은 길이를 남은 자식 수로 나눠 제안한다. 낮은 무리의 최소 길이는 먼저 떼어 둔다.
+/// 교차축은 정렬 가이드 위쪽과 아래쪽 최대값의 합이다. 주축 제안별 결과는 캐시에 두어 `placeSubviews`가 다시 쓴다.
+class StackLayout : public Layout {
+public:
+    Size sizeThatFits(ProposedViewSize proposal, const LayoutSubviews& subviews, LayoutCache& cache) const override;
+    void placeSubviews(Rect bounds, ProposedViewSize proposal, const LayoutSubviews& subviews,
+                       LayoutCache& cache) const override;
+    void makeCache(const LayoutSubviews& subviews, LayoutCache& cache) const override;
+    std::optional<double> explicitAlignment(VerticalAlignment guide, Rect bounds, ProposedViewSize proposal,
+                                            const LayoutSubviews& subviews, LayoutCache& cache) const override;
+    using Layout::explicitAlignment;
+    std::optional<Axis> spacerAxis() const override { return axis_; }
+
+    static constexpr double kDefaultSpacing = 8;
+
+protected:
+    /// `alignment`는 교차축 가이드(`HorizontalAlignment`나 `VerticalAlignment`)의 값.
+    StackLayout(Axis axis, std::uint8_t alignment, double spacing)
+        : axis_(axis), alignment_(alignment), spacing_(spacing) {}
+
+private:
+    Size allocate(ProposedViewSize proposal, const LayoutSubviews& subviews, LayoutCache& cache) const;
+    double crossGuide(const ViewDimensions& dimensions) const;
+
+    Axis axis_;
+    std::uint8_t alignment_;
+    double spacing_;
+};
+
+class HStackLayout final : public StackLayout {
+public:
+    explicit HStackLayout(VerticalAlignment alignment = VerticalAlignment::Center, double spacing = kDefaultSpacing)
+        : StackLayout(Axis::Horizontal, std::uint8_t(alignment), spacing) {}
+};
+
+class VStackLayout final : public StackLayout {
+public:
+    explicit VStackLayout(HorizontalAlignment alignment = HorizontalAlignment::Center, double spacing = kDefaultSpacing)
+        : StackLayout(Axis::Vertical, std::uint8_t(alignment), spacing) {}
+};
+
+/// 자식을 정렬 가이드에 맞춰 겹친다. 크기는 가이드 양쪽 최대값의 합이다.
+class ZStackLayout final : public Layout {
+public:
+    explicit ZStackLayout(Alignment alignment = {}) : alignment_(alignment) {}
+
+    Size sizeThatFits(ProposedViewSize proposal, const LayoutSubviews& subviews, LayoutCache& cache) const override;
+    void placeSubviews(Rect bounds, ProposedViewSize proposal, const LayoutSubviews& subviews,
+                       LayoutCache& cache) const override;
+
+private:
+    Alignment alignment_;
+};
+
+/// `padding(_:)`. 자식에게 여백만큼 줄여 제안하고 여백만큼 키운다.
+class PaddingLayout final : public Layout {
+public:
+    explicit PaddingLayout(EdgeInsets insets) : insets_(insets) {}
+
+    Size sizeThatFits(ProposedViewSize proposal, const LayoutSubviews& subviews, LayoutCache& cache) const override;
+    void placeSubviews(Rect bounds, ProposedViewSize proposal, const LayoutSubviews& subviews,
+                       LayoutCache& cache) const override;
+    std::optional<double> explicitAlignment(VerticalAlignment guide, Rect bounds, ProposedViewSize proposal,
+                                            const LayoutSubviews& subviews, LayoutCache& cache) const override;
+    using Layout::explicitAlignment;
+
+private:
+    ProposedViewSize inner(ProposedViewSize proposal) const;
+
+    EdgeInsets insets_;
+};
+
+/// `frame(width:height:alignment:)`. 정한 치수는 그 값을, `nil`인 치수는 자식의 크기를 쓴다.
+class FrameLayout final : public Layout {
+public:
+    FrameLayout(double width, double height, Alignment alignment = {})
+        : width_(width), height_(height), alignment_(alignment) {}
+
+    Size sizeThatFits(ProposedViewSize proposal, const LayoutSubviews& subviews, LayoutCache& cache) const override;
+    void placeSubviews(Rect bounds, ProposedViewSize proposal, const LayoutSubviews& subviews,
+                       LayoutCache& cache) const override;
+    std::optional<double> explicitAlignment(VerticalAlignment guide, Rect bounds, ProposedViewSize proposal,
+                                            const LayoutSubviews& subviews, LayoutCache& cache) const override;
+    using Layout::explicitAlignment;
+
+private:
+    ProposedViewSize childProposal(ProposedViewSize proposal) const;
+
+    double width_;    // NaN이면 `nil`
+    double height_;
+    Alignment alignment_;
+};
+
+} // namespace manual
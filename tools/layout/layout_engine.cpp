@@ -0,0 +1,371 @@
+//
+//  layout_engine.cpp
+//  swiftUIManual tools
+//
+
+#include "layout/layout_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace manual {
+
+namespace {
+
+constexpr double kDefaultSpacerLength = 8;
+constexpr double kProposalScale = 64;   // 측정 기억 키의 양자화 단위(1/64 pt)
+constexpr std::int64_t kEmptyKey = std::numeric_limits<std::int64_t>::min() + 1;
+
+/// 제안 치수 하나를 기억 키로 바꾼다. `nil`과 무한대는 따로 둔다.
+std::int64_t proposalKey(double length) {
+    if (length != length) return std::numeric_limits<std::int64_t>::min();
+    if (length >= 1e15) return std::numeric_limits<std::int64_t>::max();
+    return std::llround(std::max(length, 0.0) * kProposalScale);
+}
+
+double keyLength(std::int64_t key) {
+    if (key == std::numeric_limits<std::int64_t>::min()) return ProposedViewSize::kUnspecified;
+    if (key == std::numeric_limits<std::int64_t>::max()) return ProposedViewSize::kInfinity;
+    return double(key) / kProposalScale;
+}
+
+} // namespace
+
+Size measureText(std::uint32_t characters, double fontSize, ProposedViewSize proposal) {
+    if (characters == 0) return {};
+    double characterWidth = fontSize * kTextCharacterWidth;
+    double lineHeight = fontSize * kTextLineHeight;
+    double natural = double(characters) * characterWidth;
+    if (!proposal.hasWidth() || proposal.width >= natural) return {natural, lineHeight};
+    double perLine = std::max(1.0, std::floor(proposal.width / characterWidth));
+    double lines = std::ceil(double(characters) / perLine);
+    if (proposal.hasHeight()) lines = std::min(lines, std::max(1.0, std::floor(proposal.height / lineHeight)));
+    return {std::min(double(characters), perLine) * characterWidth, lines * lineHeight};
+}
+
+// MARK: - LayoutTree
+
+std::uint32_t LayoutTree::add(std::uint32_t parent, NodeKind kind, Params params) {
+    auto node = std::uint32_t(kinds_.size());
+    kinds_.push_back(kind);
+    parents_.push_back(parent);
+    firstChildren_.push_back(kNoNode);
+    lastChildren_.push_back(kNoNode);
+    nextSiblings_.push_back(kNoNode);
+    priorities_.push_back(0);
+    params_.push_back(params);
+    if (parent != kNoNode) {
+        if (lastChildren_[parent] == kNoNode) {
+            firstChildren_[parent] = node;
+        } else {
+            nextSiblings_[lastChildren_[parent]] = node;
+        }
+        lastChildren_[parent] = node;
+    }
+    ++structureVersion_;
+    return node;
+}
+
+std::uint32_t LayoutTree::addContainer(std::uint32_t parent, std::uint32_t layout) {
+    return add(parent, NodeKind::Container, {layout, {}});
+}
+
+std::uint32_t LayoutTree::addText(std::uint32_t parent, std::uint32_t characters, double fontSize) {
+    return add(parent, NodeKind::Text, {0, {double(characters), fontSize}});
+}
+
+std::uint32_t LayoutTree::addImage(std::uint32_t parent, Size size) { return add(parent, NodeKind::Image, {0, size}); }
+
+std::uint32_t LayoutTree::addShape(std::uint32_t parent) { return add(parent, NodeKind::Shape, {}); }
+
+std::uint32_t LayoutTree::addSpacer(std::uint32_t parent, double minLength) {
+    return add(parent, NodeKind::Spacer, {0, {minLength == minLength ? minLength : kDefaultSpacerLength, 0}});
+}
+
+void LayoutTree::setPriority(std::uint32_t node, double priority) {
+    priorities_[node] = float(priority);
+    // 우선순위는 자기 크기가 아니라 부모가 길이를 나누는 순서를 바꾼다.
+    changes_.push_back(parents_[node] != kNoNode ? parents_[node] : node);
+}
+
+void LayoutTree::setText(std::uint32_t node, std::uint32_t characters) {
+    params_[node].content.width = double(characters);
+    changes_.push_back(node);
+}
+
+void LayoutTree::setImageSize(std::uint32_t node, Size size) {
+    params_[node].content = size;
+    changes_.push_back(node);
+}
+
+void LayoutTree::setLayout(std::uint32_t node, std::uint32_t layout) {
+    params_[node].layout = layout;
+    changes_.push_back(node);
+    // `Spacer`가 늘어나는 축은 부모의 배치가 정한다.
+    for (std::uint32_t child = firstChildren_[node]; child != kNoNode; child = nextSiblings_[child]) {
+        if (kinds_[child] == NodeKind::Spacer) changes_.push_back(child);
+    }
+}
+
+// MARK: - LayoutEngine
+
+void LayoutEngine::prepare() {
+    if (preparedVersion_ == tree_->structureVersion()) return;
+    const LayoutTree& tree = *tree_;
+    auto count = std::uint32_t(tree.size());
+    childStart_.assign(count + 1, 0);
+    for (std::uint32_t node = 0; node < count; ++node) {
+        if (tree.parent(node) != LayoutTree::kNoNode) ++childStart_[tree.parent(node) + 1];
+    }
+    for (std::uint32_t node = 0; node < count; ++node) childStart_[node + 1] += childStart_[node];
+    children_.resize(childStart_[count]);
+    for (std::uint32_t node = 0; node < count; ++node) {
+        std::uint32_t at = childStart_[node];
+        for (std::uint32_t child = tree.firstChild(node); child != LayoutTree::kNoNode; child = tree.nextSibling(child)) {
+            children_[at++] = child;
+        }
+    }
+
+    caches_.assign(count, {});
+    placements_.assign(count, {});
+    offsets_.assign(count, {});
+    sizes_.assign(count, {ProposedViewSize::kUnspecified, ProposedViewSize::kUnspecified});
+    proposals_.assign(count, {});
+    memo_.assign(count * kMemoWays, {kEmptyKey, kEmptyKey, {}});
+    memoNext_.assign(count, 0);
+    marks_.assign(count, 0);
+    queued_.clear();
+    for (std::uint32_t node = 0; node < count; ++node) {
+        if (tree.kind(node) == LayoutTree::NodeKind::Container) tree.layout(node).makeCache(subviews(node), caches_[node]);
+    }
+    preparedVersion_ = tree.structureVersion();
+    consumedChanges_ = tree.changes().size();
+    fullPass_ = true;
+}
+
+void LayoutEngine::reset() {
+    if (preparedVersion_ != tree_->structureVersion()) return;
+    std::fill(memo_.begin(), memo_.end(), MeasureEntry{kEmptyKey, kEmptyKey, {}});
+    std::fill(memoNext_.begin(), memoNext_.end(), 0);
+    std::fill(marks_.begin(), marks_.end(), 0);
+    std::fill(sizes_.begin(), sizes_.end(), Size{ProposedViewSize::kUnspecified, ProposedViewSize::kUnspecified});
+    queued_.clear();
+    for (auto node = std::uint32_t(0); node < tree_->size(); ++node) {
+        if (tree_->kind(node) == LayoutTree::NodeKind::Container) {
+            tree_->layout(node).updateCache(subviews(node), caches_[node]);
+        }
+    }
+    consumedChanges_ = tree_->changes().size();
+    fullPass_ = true;
+}
+
+void LayoutEngine::invalidate(std::uint32_t node) {
+    // 구조가 바뀌어 아직 준비하지 않았으면 다음 패스가 어차피 모두 다시 잰다.
+    if (preparedVersion_ != tree_->structureVersion() || (marks_[node] & kQueued) != 0) return;
+    marks_[node] |= kQueued;
+    queued_.push_back(node);
+}
+
+bool LayoutEngine::remeasure(std::uint32_t node) {
+    if (tree_->kind(node) == LayoutTree::NodeKind::Container) {
+        tree_->layout(node).updateCache(subviews(node), caches_[node]);
+    }
+    bool changed = false;
+    MeasureEntry* entries = memo_.data() + node * kMemoWays;
+    for (std::size_t way = 0; way < kMemoWays; ++way) {
+        if (entries[way].width == kEmptyKey) continue;
+        Size size = compute(node, {keyLength(entries[way].width), keyLength(entries[way].height)});
+        changed = changed || size != entries[way].size;
+        entries[way].size = size;
+    }
+    return changed;
+}
+
+void LayoutEngine::flushInvalidations() {
+    const std::vector<std::uint32_t>& changes = tree_->changes();
+    for (std::size_t i = consumedChanges_; i < changes.size(); ++i) invalidate(changes[i]);
+    consumedChanges_ = changes.size();
+    if (queued_.empty()) return;
+    const LayoutTree& tree = *tree_;
+
+    if (!memoize_) {
+        // 물었던 제안을 모르니 조상의 배치 캐시를 모두 비우고 처음부터 다시 배치한다.
+        for (std::uint32_t node : queued_) {
+            marks_[node] &= std::uint8_t(~kQueued);
+            for (; node != LayoutTree::kNoNode; node = tree.parent(node)) {
+                if (tree.kind(node) == LayoutTree::NodeKind::Container) {
+                    tree.layout(node).updateCache(subviews(node), caches_[node]);
+                }
+            }
+        }
+        queued_.clear();
+        fullPass_ = true;
+        return;
+    }
+
+    // 깊은 노드부터 다시 재야 부모가 새 크기를 본다.
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> order;   // (깊이, 노드)
+    order.reserve(queued_.size());
+    for (std::uint32_t node : queued_) {
+        std::uint32_t depth = 0;
+        for (std::uint32_t up = tree.parent(node); up != LayoutTree::kNoNode; up = tree.parent(up)) ++depth;
+        order.emplace_back(depth, node);
+    }
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    for (const auto& entry : order) {
+        std::uint32_t node = entry.second;
+        marks_[node] &= std::uint8_t(~kQueued);
+        for (std::uint32_t up = node; up != LayoutTree::kNoNode; up = tree.parent(up)) {
+            ++stats_.invalidated;
+            bool changed = remeasure(up);
+            marks_[up] |= kReplace;
+            if (!changed && (marks_[up] & kEvicted) == 0) break;
+        }
+        for (std::uint32_t up = node; up != LayoutTree::kNoNode && (marks_[up] & kOnPath) == 0; up = tree.parent(up)) {
+            marks_[up] |= kOnPath;
+        }
+    }
+    queued_.clear();
+}
+
+Size LayoutEngine::layout(std::uint32_t root, ProposedViewSize proposal, Point origin) {
+    prepare();
+    flushInvalidations();
+    Size size = measure(root, proposal);
+    offsets_[root] = origin;
+    place(root, size, proposal, fullPass_);
+    // 기억이 없으면 무엇이 그대로인지 알 수 없으니 매번 전체를 배치한다.
+    fullPass_ = !memoize_;
+    return size;
+}
+
+Rect LayoutEngine::frame(std::uint32_t node) const {
+    Rect frame{offsets_[node], sizes_[node]};
+    for (std::uint32_t up = tree_->parent(node); up != LayoutTree::kNoNode; up = tree_->parent(up)) {
+        frame.origin.x += offsets_[up].x;
+        frame.origin.y += offsets_[up].y;
+    }
+    return frame;
+}
+
+Size LayoutEngine::compute(std::uint32_t node, ProposedViewSize proposal) {
+    ++measurements_;
+    if (tree_->kind(node) != LayoutTree::NodeKind::Container) return measureLeaf(node, proposal);
+    return tree_->layout(node).sizeThatFits(proposal, subviews(node), caches_[node]);
+}
+
+Size LayoutEngine::measure(std::uint32_t node, ProposedViewSize proposal) {
+    if (!memoize_) return compute(node, proposal);
+    std::int64_t width = proposalKey(proposal.width);
+    std::int64_t height = proposalKey(proposal.height);
+    MeasureEntry* entries = memo_.data() + node * kMemoWays;
+    for (std::size_t way = 0; way < kMemoWays; ++way) {
+        if (entries[way].width == width && entries[way].height == height) {
+            ++stats_.hits;
+            return entries[way].size;
+        }
+    }
+    ++stats_.misses;
+    Size size = compute(node, proposal);
+    // 재는 동안 자손이 기억을 건드리지만 이 노드의 칸은 그대로다.
+    std::uint8_t& next = memoNext_[node];
+    MeasureEntry& slot = memo_[node * kMemoWays + next];
+    if (slot.width != kEmptyKey) marks_[node] |= kEvicted;
+    slot = {width, height, size};
+    next = std::uint8_t((next + 1) % kMemoWays);
+    return size;
+}
+
+Size LayoutEngine::measureLeaf(std::uint32_t node, ProposedViewSize proposal) const {
+    const LayoutTree& tree = *tree_;
+    Size content = tree.content(node);
+    switch (tree.kind(node)) {
+    case LayoutTree::NodeKind::Text:
+        return measureText(std::uint32_t(content.width), content.height, proposal);
+    case LayoutTree::NodeKind::Image:
+        return content;
+    case LayoutTree::NodeKind::Shape:
+        return proposal.replacingUnspecifiedDimensions();
+    case LayoutTree::NodeKind::Spacer: {
+        double minimum = content.width;
+        std::uint32_t parent = tree.parent(node);
+        std::optional<Axis> axis;
+        if (parent != LayoutTree::kNoNode) axis = tree.layout(parent).spacerAxis();
+        Size size;
+        for (Axis dimension : {Axis::Horizontal, Axis::Vertical}) {
+            if (axis && *axis != dimension) continue;
+            size[dimension] = proposal.has(dimension) ? std::max(minimum, proposal[dimension]) : minimum;
+        }
+        return size;
+    }
+    case LayoutTree::NodeKind::Container:
+        break;
+    }
+    return {};
+}
+
+void LayoutEngine::recordPlacement(std::uint32_t node, Point position, UnitPoint anchor, ProposedViewSize proposal) {
+    placements_[node] = {position, anchor, proposal, true};
+}
+
+void LayoutEngine::place(std::uint32_t node, Size size, ProposedViewSize proposal, bool force) {
+    bool same = sizes_[node] == size && proposals_[node] == proposal;
+    sizes_[node] = size;
+    proposals_[node] = proposal;
+    std::uint8_t mark = marks_[node];
+    marks_[node] &= std::uint8_t(~(kReplace | kOnPath));
+    if (tree_->kind(node) != LayoutTree::NodeKind::Container) return;
+    LayoutSubviews children = subviews(node);
+
+    if (!force && same && (mark & kReplace) == 0) {
+        // 이 노드의 배치는 그대로다. 안에서 바뀐 자식만 찾아 내려간다.
+        if ((mark & kOnPath) == 0) return;
+        for (LayoutSubview child : children) {
+            std::uint32_t index = child.node();
+            if ((marks_[index] & (kReplace | kOnPath)) != 0) place(index, sizes_[index], proposals_[index], false);
+        }
+        return;
+    }
+
+    ++stats_.placed;
+    for (LayoutSubview child : children) placements_[child.node()].placed = false;
+    tree_->layout(node).placeSubviews({{}, size}, proposal, children, caches_[node]);
+    for (LayoutSubview child : children) {
+        Placement placement = placements_[child.node()];
+        if (!placement.placed) {
+            placement.position = {size.width / 2, size.height / 2};
+            placement.anchor = UnitPoint::center();
+            placement.proposal = ProposedViewSize(size);
+        }
+        Size childSize = measure(child.node(), placement.proposal);
+        offsets_[child.node()] = {placement.position.x - placement.anchor.x * childSize.width,
+                                  placement.position.y - placement.anchor.y * childSize.height};
+        place(child.node(), childSize, placement.proposal, force);
+    }
+}
+
+std::optional<double> LayoutEngine::explicitGuide(std::uint32_t node, HorizontalAlignment guide, Size size,
+                                                  ProposedViewSize proposal) {
+    if (tree_->kind(node) != LayoutTree::NodeKind::Container) return std::nullopt;
+    return tree_->layout(node).explicitAlignment(guide, {{}, size}, proposal, subviews(node), caches_[node]);
+}
+
+std::optional<double> LayoutEngine::explicitGuide(std::uint32_t node, VerticalAlignment guide, Size size,
+                                                  ProposedViewSize proposal) {
+    switch (tree_->kind(node)) {
+    case LayoutTree::NodeKind::Container:
+        return tree_->layout(node).explicitAlignment(guide, {{}, size}, proposal, subviews(node), caches_[node]);
+    case LayoutTree::NodeKind::Text: {
+        double lineHeight = tree_->content(node).height * kTextLineHeight;
+        if (guide == VerticalAlignment::FirstTextBaseline) return lineHeight * kTextAscent;
+        if (guide == VerticalAlignment::LastTextBaseline) return size.height - lineHeight * (1 - kTextAscent);
+        return std::nullopt;
+    }
+    default:
+        return std::nullopt;
+    }
+}
+
+} // namespace manual
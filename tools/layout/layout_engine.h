@@ -0,0 +1,220 @@
+//
+//  layout_engine.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "layout/layout.h"
+
+namespace manual {
+
+/// 화면 없이 배치할 뷰 트리. 노드는 번호이고 속성은 노드 번호로 찾는 평평한 배열에 있다.
+///
+/// 잎은 `Text`(고정 폭 근사 글꼴), `Image`(고유 크기), `Shape`(제안을 채우는 `Rectangle`, `Color`),
+/// `Spacer`이고, 나머지 노드는 `Layout` 객체 하나로 자식을 배치한다. 배치 객체는 트리가 가지며 여러 노드가 같이 쓴다.
+class LayoutTree {
+public:
+    static constexpr std::uint32_t kNoNode = 0xFFFFFFFF;
+
+    enum class NodeKind : std::uint8_t { Container, Text, Image, Shape, Spacer };
+
+    template <class L, class... Args>
+    std::uint32_t makeLayout(Args&&... args) {
+        layouts_.push_back(std::make_unique<L>(std::forward<Args>(args)...));
+        return std::uint32_t(layouts_.size() - 1);
+    }
+
+    /// 노드를 `parent`의 마지막 자식으로 더한다. `parent`가 `kNoNode`면 뿌리다.
+    std::uint32_t addContainer(std::uint32_t parent, std::uint32_t layout);
+    /// 글자 `characters`개, 글자 크기 `fontSize`인 `Text`.
+    std::uint32_t addText(std::uint32_t parent, std::uint32_t characters, double fontSize = 17);
+    std::uint32_t addImage(std::uint32_t parent, Size size);
+    std::uint32_t addShape(std::uint32_t parent);
+    /// `minLength`가 NaN이면 기본 간격(8)이다.
+    std::uint32_t addSpacer(std::uint32_t parent, double minLength = ProposedViewSize::kUnspecified);
+
+    // 입력 바꾸기. 바뀐 노드는 변경 기록에 남고, 엔진은 다음 패스에서 그 노드부터 다시 잰다.
+    void setPriority(std::uint32_t node, double priority);
+    void setText(std::uint32_t node, std::uint32_t characters);
+    void setImageSize(std::uint32_t node, Size size);
+    /// `frame(width:height:)` 값이 바뀐 것처럼 노드의 배치 객체를 바꾼다.
+    void setLayout(std::uint32_t node, std::uint32_t layout);
+
+    std::size_t size() const { return kinds_.size(); }
+    NodeKind kind(std::uint32_t node) const { return kinds_[node]; }
+    std::uint32_t parent(std::uint32_t node) const { return parents_[node]; }
+    double priority(std::uint32_t node) const { return priorities_[node]; }
+    const Layout& layout(std::uint32_t node) const { return *layouts_[params_[node].layout]; }
+    /// 노드 구조가 바뀔 때마다 오른다. 엔진은 이 값이 달라지면 자식 배열을 다시 만든다.
+    std::uint64_t structureVersion() const { return structureVersion_; }
+    /// 입력이 바뀐 노드를 바뀐 순서대로 모은 기록. 엔진마다 어디까지 읽었는지 따로 기억한다.
+    const std::vector<std::uint32_t>& changes() const { return changes_; }
+
+    /// 잎의 입력. `Text`는 (글자 수, 글자 크기), `Image`는 크기, `Spacer`는 (최소 길이, -).
+    Size content(std::uint32_t node) const { return params_[node].content; }
+
+    /// 자식을 더한 순서대로 훑는다.
+    std::uint32_t firstChild(std::uint32_t node) const { return firstChildren_[node]; }
+    std::uint32_t nextSibling(std::uint32_t node) const { return nextSiblings_[node]; }
+
+private:
+    struct Params {
+        std::uint32_t layout = 0;   // `Container`만
+        Size content;
+    };
+
+    std::uint32_t add(std::uint32_t parent, NodeKind kind, Params params);
+
+    std::vector<NodeKind> kinds_;
+    std::vector<std::uint32_t> parents_;
+    std::vector<std::uint32_t> firstChildren_;
+    std::vector<std::uint32_t> lastChildren_;
+    std::vector<std::uint32_t> nextSiblings_;
+    std::vector<float> priorities_;
+    std::vector<Params> params_;
+    std::vector<std::unique_ptr<Layout>> layouts_;
+    std::vector<std::uint32_t> changes_;
+    std::uint64_t structureVersion_ = 0;
+};
+
+/// 측정 기억과 증분 배치의 통계.
+struct MeasureStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t invalidated = 0;   // 입력이 바뀌어 다시 잰 노드
+    std::uint64_t placed = 0;        // `placeSubviews`를 부른 노드
+
+    double hitRate() const { return hits + misses == 0 ? 0 : double(hits) / double(hits + misses); }
+    MeasureStats& operator+=(const MeasureStats& other) {
+        hits += other.hits;
+        misses += other.misses;
+        invalidated += other.invalidated;
+        placed += other.placed;
+        return *this;
+    }
+};
+
+/// `LayoutTree` 하나의 배치 패스를 돌리고 노드마다 프레임을 남긴다.
+///
+/// 자식 목록은 CSR(노드별 시작 위치 + 자식 번호 배열)로 펼쳐 두어 `LayoutSubviews`가 배열 한 구간을 가리킨다.
+/// 노드별 상태(캐시, 놓인 위치, 프레임)도 노드 번호로 찾는 배열이라 패스 중에 할당이 거의 없다.
+/// 엔진 하나는 한 스레드에서만 쓴다. 문서마다 엔진을 두면 여러 문서를 나란히 배치할 수 있다.
+///
+/// 스택은 자식을 `.zero`, `.infinity`, `nil`, 마지막 몫으로 거듭 재므로, 노드마다 최근 제안 `kMemoWays`개의
+/// 결과를 기억한다. 키는 1/64 pt로 양자화한 제안이라 부동소수 오차가 있는 같은 제안도 적중한다.
+/// 기억은 패스가 끝나도 남아 다음 패스에서도 쓴다.
+///
+/// 두 번째 패스부터는 증분이다. 입력이 바뀐 노드(트리의 변경 기록과 `invalidate`)를 깊은 것부터 기억해 둔 제안마다
+/// 다시 재고, 결과가 하나라도 달라졌을 때만 부모로 올라간다. 크기가 그대로면 조상의 기억과 배치는 그대로 맞다.
+/// 배치도 자식의 위치를 부모 기준으로 두므로, 크기·제안이 그대로이고 안에 바뀐 것이 없는 노드는 하위 트리째
+/// 건너뛴다. 그래서 잎 하나를 바꾼 패스는 트리 크기가 아니라 바뀐 경로와 그 형제 수에 비례한다.
+class LayoutEngine {
+public:
+    static constexpr std::size_t kMemoWays = 4;
+
+    explicit LayoutEngine(const LayoutTree& tree) : tree_(&tree) {}
+
+    LayoutEngine(const LayoutEngine&) = delete;
+    LayoutEngine& operator=(const LayoutEngine&) = delete;
+
+    /// `root`에 `proposal`을 제안해 크기를 정하고, `origin`에 놓은 뒤 모든 자손을 놓는다. 뿌리의 크기를 돌려준다.
+    /// 앞 패스 뒤로 바뀐 것만 다시 계산한다.
+    Size layout(std::uint32_t root, ProposedViewSize proposal, Point origin = {});
+
+    /// 마지막 패스에서 정해진 노드의 절대 좌표 프레임. 조상의 상대 위치를 더하므로 깊이에 비례한다.
+    Rect frame(std::uint32_t node) const;
+    const LayoutTree& tree() const { return *tree_; }
+
+    /// 지금까지 `sizeThatFits`(잎 포함)를 계산한 횟수. 기억에서 찾은 것은 세지 않는다.
+    std::uint64_t measurements() const { return measurements_; }
+    const MeasureStats& measureStats() const { return stats_; }
+    void resetStats() {
+        stats_ = {};
+        measurements_ = 0;
+    }
+    /// 기억과 배치 결과를 모두 버려 다음 패스를 처음부터 하게 한다.
+    void reset();
+    /// 측정 기억을 끈다. 비교용이며, 끄면 입력이 바뀔 때마다 전체를 다시 배치한다.
+    void setMemoization(bool enabled) { memoize_ = enabled; }
+
+    /// 트리 밖의 입력(사용자 배치 객체의 상태 등)이 바뀌었다. 다음 패스에서 그 노드부터 다시 잰다.
+    void invalidate(std::uint32_t node);
+
+    // `LayoutSubview`와 `ViewDimensions`가 쓴다.
+    Size measure(std::uint32_t node, ProposedViewSize proposal);
+    void recordPlacement(std::uint32_t node, Point position, UnitPoint anchor, ProposedViewSize proposal);
+    std::optional<double> explicitGuide(std::uint32_t node, HorizontalAlignment guide, Size size,
+                                        ProposedViewSize proposal);
+    std::optional<double> explicitGuide(std::uint32_t node, VerticalAlignment guide, Size size,
+                                        ProposedViewSize proposal);
+
+private:
+    struct Placement {
+        Point position;
+        UnitPoint anchor;
+        ProposedViewSize proposal;
+        bool placed = false;
+    };
+
+    /// 양자화한 제안과 그 결과.
+    struct MeasureEntry {
+        std::int64_t width;
+        std::int64_t height;
+        Size size;
+    };
+
+    /// 노드별 표시.
+    enum Mark : std::uint8_t {
+        kQueued = 1,     // 다시 잴 노드로 모아 둠
+        kReplace = 2,    // 크기를 다시 계산했으니 `placeSubviews`를 다시 부른다
+        kOnPath = 4,     // 하위 트리에 `kReplace`가 있다
+        kEvicted = 8,    // 기억을 덮어쓴 적이 있어 물었던 제안을 다 알지 못한다
+    };
+
+    void prepare();
+    void flushInvalidations();
+    /// `node`를 기억해 둔 제안마다 다시 재고 결과가 하나라도 바뀌었는지 돌려준다.
+    bool remeasure(std::uint32_t node);
+    LayoutSubviews subviews(std::uint32_t node) {
+        return {*this, children_.data() + childStart_[node], children_.data() + childStart_[node + 1]};
+    }
+    Size compute(std::uint32_t node, ProposedViewSize proposal);
+    Size measureLeaf(std::uint32_t node, ProposedViewSize proposal) const;
+    void place(std::uint32_t node, Size size, ProposedViewSize proposal, bool force);
+
+    const LayoutTree* tree_;
+    std::uint64_t preparedVersion_ = ~std::uint64_t(0);
+    std::size_t consumedChanges_ = 0;
+    bool fullPass_ = true;
+    std::vector<std::uint32_t> childStart_;   // 노드 수 + 1
+    std::vector<std::uint32_t> children_;
+    std::vector<LayoutCache> caches_;
+    std::vector<Placement> placements_;
+    std::vector<Point> offsets_;               // 부모 원점 기준 위치
+    std::vector<Size> sizes_;
+    std::vector<ProposedViewSize> proposals_;  // 배치할 때 받은 제안
+    std::vector<MeasureEntry> memo_;           // 노드 × `kMemoWays`
+    std::vector<std::uint8_t> memoNext_;       // 다음에 덮어쓸 칸
+    std::vector<std::uint8_t> marks_;
+    std::vector<std::uint32_t> queued_;
+    bool memoize_ = true;
+    MeasureStats stats_;
+    std::uint64_t measurements_ = 0;
+};
+
+constexpr double kTextCharacterWidth = 0.5;   // 글자 크기에 대한 비
+constexpr double kTextLineHeight = 1.2;
+constexpr double kTextAscent = 0.8;           // 줄 높이에 대한 첫 기준선 위치
+
+/// `Text` 잎의 치수. 글자 폭은 글자 크기의 0.5배, 줄 높이는 1.2배로 근사한다.
+/// 제안 폭이 모자라면 글자 단위로 줄을 바꾸고, 제안 높이가 모자라면 줄을 자른다.
+Size measureText(std::uint32_t characters, double fontSize, ProposedViewSize proposal);
+
+} // namespace manual
@@ -0,0 +1,262 @@
+//
+//  lazy_grid.cpp
+//  swiftUIManual tools
+//
+
+#include "layout/lazy_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace manual {
+
+namespace {
+
+constexpr double kDefaultSpacing = 8;
+
+double spacingOrDefault(double spacing) {
+    return spacing != spacing ? kDefaultSpacing : spacing;
+}
+
+double alignmentFactor(HorizontalAlignment alignment) {
+    switch (alignment) {
+    case HorizontalAlignment::Leading:
+        return 0;
+    case HorizontalAlignment::Center:
+        return 0.5;
+    case HorizontalAlignment::Trailing:
+        return 1;
+    }
+    return 0.5;
+}
+
+double alignmentFactor(VerticalAlignment alignment) {
+    switch (alignment) {
+    case VerticalAlignment::Top:
+        return 0;
+    case VerticalAlignment::Center:
+        return 0.5;
+    case VerticalAlignment::Bottom:
+    case VerticalAlignment::FirstTextBaseline:
+    case VerticalAlignment::LastTextBaseline:
+        return 1;
+    }
+    return 0.5;
+}
+
+/// `alignment`에서 `axis` 방향 성분의 비율.
+double alignmentFactor(Alignment alignment, Axis axis) {
+    return axis == Axis::Horizontal ? alignmentFactor(alignment.horizontal) : alignmentFactor(alignment.vertical);
+}
+
+Axis crossAxis(Axis axis) { return axis == Axis::Vertical ? Axis::Horizontal : Axis::Vertical; }
+
+} // namespace
+
+void resolveGridTracks(const std::vector<GridItem>& items, double length, Axis axis, Alignment alignment,
+                       std::vector<GridTrack>& tracks) {
+    tracks.clear();
+    if (items.empty()) return;
+
+    // 고정 항목과 항목 사이 간격을 먼저 뺀다.
+    double available = length;
+    std::vector<std::uint32_t> shared;
+    for (std::uint32_t i = 0; i < items.size(); ++i) {
+        if (i + 1 < items.size()) available -= spacingOrDefault(items[i].spacing);
+        if (items[i].size == GridItem::Size::Fixed) {
+            available -= items[i].minimum;
+        } else {
+            shared.push_back(i);
+        }
+    }
+
+    // 상한이 작은 항목부터 남은 몫을 가진다. `.adaptive`는 트랙 여러 개로 나뉘므로 묶음 전체의 상한은 없다.
+    auto groupMaximum = [&](std::uint32_t i) {
+        return items[i].size == GridItem::Size::Adaptive ? ProposedViewSize::kInfinity : items[i].maximum;
+    };
+    std::stable_sort(shared.begin(), shared.end(),
+                     [&](std::uint32_t a, std::uint32_t b) { return groupMaximum(a) < groupMaximum(b); });
+    std::vector<double> lengths(items.size());
+    double remaining = std::max(available, 0.0);
+    for (std::size_t k = 0; k < shared.size(); ++k) {
+        std::uint32_t i = shared[k];
+        double share = std::max(remaining, 0.0) / double(shared.size() - k);
+        lengths[i] = std::max(items[i].minimum, std::min(share, groupMaximum(i)));
+        remaining -= lengths[i];
+    }
+
+    double offset = 0;
+    for (std::uint32_t i = 0; i < items.size(); ++i) {
+        const GridItem& item = items[i];
+        double spacing = spacingOrDefault(item.spacing);
+        switch (item.size) {
+        case GridItem::Size::Fixed:
+            tracks.push_back({offset, item.minimum, i});
+            offset += item.minimum;
+            break;
+        case GridItem::Size::Flexible:
+            tracks.push_back({offset, lengths[i], i});
+            offset += lengths[i];
+            break;
+        case GridItem::Size::Adaptive: {
+            double minimum = std::max(item.minimum, 1.0);
+            auto count = std::max<std::uint32_t>(1, std::uint32_t((lengths[i] + spacing) / (minimum + spacing)));
+            double trackLength = std::min((lengths[i] - double(count - 1) * spacing) / double(count), item.maximum);
+            trackLength = std::max(trackLength, minimum);
+            for (std::uint32_t k = 0; k < count; ++k) {
+                tracks.push_back({offset, trackLength, i});
+                offset += trackLength + (k + 1 < count ? spacing : 0);
+            }
+            break;
+        }
+        }
+        if (i + 1 < items.size()) offset += spacing;
+    }
+
+    double slack = length - offset;
+    if (slack > 1e-9) {
+        double shift = slack * alignmentFactor(alignment, crossAxis(axis));
+        for (GridTrack& track : tracks) track.offset += shift;
+    }
+}
+
+// MARK: - LazyGrid
+
+LazyGrid::LazyGrid(Axis axis, std::vector<GridItem> items, double spacing, Alignment alignment,
+                   std::uint8_t pinnedViews)
+    : axis_(axis), items_(std::move(items)), spacing_(spacingOrDefault(spacing)), alignment_(alignment),
+      pinnedViews_(pinnedViews) {
+    if (items_.empty()) throw std::runtime_error("a lazy grid needs at least one grid item");
+}
+
+void LazyGrid::setSections(std::vector<LazyGridSection> sections) {
+    sections_ = std::move(sections);
+    crossLength_ = ProposedViewSize::kUnspecified;   // 다음 `resolve`에서 구역 위치를 다시 잡는다
+}
+
+void LazyGrid::resolve(double crossLength) {
+    if (crossLength == crossLength_) return;
+    crossLength_ = crossLength;
+    ++resolutions_;
+    resolveGridTracks(items_, crossLength, axis_, alignment_, tracks_);
+    trackAlignments_.resize(tracks_.size());
+    for (std::size_t t = 0; t < tracks_.size(); ++t) {
+        trackAlignments_[t] = alignmentFactor(items_[tracks_[t].item].alignment.value_or(alignment_), axis_);
+    }
+
+    double squareLength = 0;
+    for (const GridTrack& track : tracks_) squareLength = std::max(squareLength, track.length);
+    auto columns = std::uint64_t(tracks_.size());
+
+    geometry_.resize(sections_.size());
+    sectionStarts_.resize(sections_.size());
+    double position = 0;
+    itemCount_ = 0;
+    for (std::size_t s = 0; s < sections_.size(); ++s) {
+        const LazyGridSection& section = sections_[s];
+        SectionGeometry& geometry = geometry_[s];
+        if (s > 0) position += spacing_;
+        geometry.start = position;
+        geometry.firstItem = itemCount_;
+        geometry.rows = (section.items + columns - 1) / columns;
+        geometry.rowLength = section.cellLength != section.cellLength ? squareLength : section.cellLength;
+        position += section.headerLength;
+        if (section.headerLength > 0 && geometry.rows > 0) position += spacing_;
+        geometry.rowsStart = position;
+        if (geometry.rows > 0) {
+            position += double(geometry.rows) * geometry.rowLength + double(geometry.rows - 1) * spacing_;
+        }
+        if (section.footerLength > 0) position += (geometry.rows > 0 ? spacing_ : 0) + section.footerLength;
+        geometry.end = position;
+        sectionStarts_[s] = geometry.start;
+        itemCount_ += section.items;
+    }
+    contentLength_ = position;
+}
+
+Rect LazyGrid::makeRect(double main, double mainLength, double cross, double crossLength) const {
+    if (axis_ == Axis::Vertical) return {{cross, main}, {crossLength, mainLength}};
+    return {{main, cross}, {mainLength, crossLength}};
+}
+
+void LazyGrid::visibleWindow(double offset, double viewportLength, double prefetch, LazyGridWindow& window) const {
+    window.cells.clear();
+    window.supplements.clear();
+    if (geometry_.empty()) return;
+    double viewportEnd = offset + viewportLength;
+    double top = offset - prefetch;
+    double bottom = viewportEnd + prefetch;
+    auto columns = std::uint64_t(tracks_.size());
+
+    auto first = std::upper_bound(sectionStarts_.begin(), sectionStarts_.end(), top);
+    std::size_t s = first == sectionStarts_.begin() ? 0 : std::size_t(first - sectionStarts_.begin()) - 1;
+    for (; s < geometry_.size() && geometry_[s].start < bottom; ++s) {
+        const SectionGeometry& geometry = geometry_[s];
+        const LazyGridSection& section = sections_[s];
+        if (geometry.end <= top) continue;
+        bool current = geometry.start <= offset && offset < geometry.end;
+
+        if (section.headerLength > 0) {
+            double position = geometry.start;
+            bool pinned = false;
+            if ((pinnedViews_ & kPinSectionHeaders) && current && offset > position) {
+                position = std::min(offset, geometry.end - section.headerLength);
+                pinned = true;
+            }
+            if (position < bottom && position + section.headerLength > top) {
+                window.supplements.push_back(
+                    {std::uint32_t(s), makeRect(position, section.headerLength, 0, crossLength_), false, pinned});
+            }
+        }
+
+        if (geometry.rows > 0) {
+            double pitch = std::max(geometry.rowLength + spacing_, 1e-6);
+            double from = std::floor((top - geometry.rowsStart) / pitch);
+            auto firstRow = std::uint64_t(std::clamp(from, 0.0, double(geometry.rows)));
+            if (firstRow < geometry.rows && geometry.rowsStart + double(firstRow) * pitch + geometry.rowLength <= top) {
+                ++firstRow;
+            }
+            double to = std::ceil((bottom - geometry.rowsStart) / pitch);
+            auto endRow = std::uint64_t(std::clamp(to, 0.0, double(geometry.rows)));
+            for (std::uint64_t row = firstRow; row < endRow; ++row) {
+                double position = geometry.rowsStart + double(row) * pitch;
+                bool prefetched = position >= viewportEnd || position + geometry.rowLength <= offset;
+                std::uint64_t index = row * columns;
+                std::uint64_t last = std::min(index + columns, section.items);
+                for (std::uint64_t item = index; item < last; ++item) {
+                    std::size_t t = std::size_t(item - index);
+                    const GridTrack& track = tracks_[t];
+                    // 정사각형 칸은 트랙 길이만큼이고, 행의 남는 자리에서 정렬대로 놓인다.
+                    double length = section.cellLength != section.cellLength ? track.length : geometry.rowLength;
+                    double main = position + (geometry.rowLength - length) * trackAlignments_[t];
+                    window.cells.push_back({geometry.firstItem + item, std::uint32_t(s),
+                                            makeRect(main, length, track.offset, track.length), prefetched});
+                }
+            }
+        }
+
+        if (section.footerLength > 0) {
+            double natural = geometry.end - section.footerLength;
+            double position = natural;
+            bool pinned = false;
+            if ((pinnedViews_ & kPinSectionFooters) && geometry.start < viewportEnd && geometry.end > viewportEnd) {
+                double contentStart = geometry.start + section.headerLength;
+                position = std::max(contentStart, viewportEnd - section.footerLength);
+                pinned = position != natural;
+            }
+            if (position < bottom && position + section.footerLength > top) {
+                window.supplements.push_back(
+                    {std::uint32_t(s), makeRect(position, section.footerLength, 0, crossLength_), true, pinned});
+            }
+        }
+    }
+}
+
+std::size_t LazyGrid::memoryUsage() const {
+    return items_.capacity() * sizeof(GridItem) + sections_.capacity() * sizeof(LazyGridSection) +
+           geometry_.capacity() * sizeof(SectionGeometry) + sectionStarts_.capacity() * sizeof(double) +
+           tracks_.capacity() * sizeof(GridTrack) + trackAlignments_.capacity() * sizeof(double);
+}
+
+} // namespace manual
@@ -0,0 +1,149 @@
+//
+//  lazy_grid.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "layout/geometry.h"
+
+namespace manual {
+
+/// SwiftUI `GridItem`. `.fixed`는 `minimum == maximum`이다.
+struct GridItem {
+    enum class Size : std::uint8_t { Fixed, Flexible, Adaptive };
+
+    Size size = Size::Flexible;
+    double minimum = 10;
+    double maximum = ProposedViewSize::kInfinity;
+    double spacing = ProposedViewSize::kUnspecified;   // 다음 트랙과의 간격. `nil`이면 8
+    std::optional<Alignment> alignment;                // 칸 안에서 내용의 정렬. `nil`이면 격자의 정렬
+
+    static GridItem fixed(double length) { return {Size::Fixed, length, length, ProposedViewSize::kUnspecified, {}}; }
+    static GridItem flexible(double minimum = 10, double maximum = ProposedViewSize::kInfinity) {
+        return {Size::Flexible, minimum, maximum, ProposedViewSize::kUnspecified, {}};
+    }
+    static GridItem adaptive(double minimum, double maximum = ProposedViewSize::kInfinity) {
+        return {Size::Adaptive, minimum, maximum, ProposedViewSize::kUnspecified, {}};
+    }
+};
+
+/// 풀어 낸 트랙(세로 격자의 열, 가로 격자의 행) 하나. 위치는 격자의 교차축 시작 기준이다.
+struct GridTrack {
+    double offset;
+    double length;
+    std::uint32_t item;   // 이 트랙을 만든 `GridItem`
+};
+
+/// `items`를 교차축 길이 `length`에 맞춰 트랙으로 푼다.
+///
+/// `.fixed`가 먼저 자기 길이를 갖고, 남은 길이를 `.flexible`과 `.adaptive`가 나눈다. `maximum`이 작은 항목부터
+/// 남은 길이를 남은 항목 수로 나눈 몫을 `[minimum, maximum]`으로 잘라 가지므로, 상한에 걸린 항목이 남긴 길이는
+/// 뒤의 항목이 가져간다. `.adaptive`는 받은 길이에 `minimum` 트랙이 몇 개 들어가는지 세어 그만큼 나눈다.
+/// 트랙이 다 차지 않으면 `alignment`에서 교차축 성분(스크롤 축이 `axis`이므로 세로 격자는 가로 성분)대로 모은다.
+void resolveGridTracks(const std::vector<GridItem>& items, double length, Axis axis, Alignment alignment,
+                       std::vector<GridTrack>& tracks);
+
+/// `pinnedViews`.
+enum PinnedScrollableViews : std::uint8_t {
+    kPinNone = 0,
+    kPinSectionHeaders = 1,
+    kPinSectionFooters = 2,
+};
+
+/// 격자의 한 구역. 머리말·꼬리말 길이가 0이면 없는 것이다.
+struct LazyGridSection {
+    std::uint64_t items = 0;
+    double headerLength = 0;
+    double footerLength = 0;
+    /// 칸의 주축 길이. NaN이면 트랙 길이와 같은 정사각형 칸(사진 격자)이다.
+    double cellLength = ProposedViewSize::kUnspecified;
+};
+
+/// 한 프레임에 만들 칸.
+struct LazyGridCell {
+    std::uint64_t item;       // 모든 구역을 이은 번호
+    std::uint32_t section;
+    Rect frame;               // 내용 좌표
+    bool prefetch;            // 화면 밖, 미리 가져오기 창 안
+};
+
+struct LazyGridSupplement {
+    std::uint32_t section;
+    Rect frame;
+    bool footer;
+    bool pinned;              // 화면 가장자리에 붙어 본래 자리에서 옮겨졌다
+};
+
+/// `visibleWindow`의 결과. 버퍼를 재사용하므로 프레임마다 할당이 없다.
+struct LazyGridWindow {
+    std::vector<LazyGridCell> cells;
+    std::vector<LazyGridSupplement> supplements;
+};
+
+/// 가상화한 `LazyVGrid`/`LazyHGrid`.
+///
+/// 칸을 하나하나 두지 않고 구역마다 시작 위치, 행 수, 행 간격만 둔다. 행 높이가 구역 안에서 같으므로 스크롤
+/// 위치에서 보이는 행을 나눗셈으로 구하고, 이진 탐색으로 첫 구역을 찾은 뒤 보이는 칸과 미리 가져오기 창의 칸만
+/// 만든다. 메모리는 구역 수와 화면의 칸 수에만 비례하고 항목 수와는 상관없다.
+/// 트랙은 교차축 길이가 바뀔 때만 다시 푼다. 회전이나 창 크기 조절이 없으면 스크롤 중에는 풀지 않는다.
+///
+/// 정사각형 칸은 자기 트랙 길이만큼이라 트랙이 행보다 좁으면 행 안에 남는 자리가 생긴다. 칸은 그 자리 안에서
+/// 트랙을 만든 `GridItem`의 `alignment`대로, 없으면 격자의 `alignment`대로 놓인다.
+class LazyGrid {
+public:
+    /// `axis`는 스크롤 축이다. 세로 격자(`LazyVGrid(columns:alignment:)`)는 `Axis::Vertical`이고 `alignment`의
+    /// 가로 성분을, 가로 격자(`LazyHGrid(rows:alignment:)`)는 세로 성분을 트랙을 모으는 데 쓴다.
+    LazyGrid(Axis axis, std::vector<GridItem> items, double spacing = ProposedViewSize::kUnspecified,
+             Alignment alignment = {}, std::uint8_t pinnedViews = kPinNone);
+
+    void setSections(std::vector<LazyGridSection> sections);
+
+    /// 교차축 길이(세로 격자의 폭)에 맞춰 트랙과 구역 위치를 정한다. 길이가 같으면 아무것도 하지 않는다.
+    void resolve(double crossLength);
+
+    /// 스크롤 위치 `offset`부터 `viewportLength`만큼 보이는 칸과 머리말·꼬리말을 `window`에 채운다.
+    /// 앞뒤 `prefetch`만큼의 칸도 `prefetch` 표시를 달아 넣는다. 먼저 `resolve`를 불러야 한다.
+    void visibleWindow(double offset, double viewportLength, double prefetch, LazyGridWindow& window) const;
+
+    const std::vector<GridTrack>& tracks() const { return tracks_; }
+    double contentLength() const { return contentLength_; }
+    std::uint64_t itemCount() const { return itemCount_; }
+    /// 트랙을 다시 푼 횟수.
+    std::uint64_t resolutions() const { return resolutions_; }
+    /// 구역 배치가 차지하는 바이트. 항목 수와 상관없다.
+    std::size_t memoryUsage() const;
+
+private:
+    Rect makeRect(double main, double mainLength, double cross, double crossLength) const;
+
+    struct SectionGeometry {
+        double start;        // 머리말 시작
+        double rowsStart;
+        double rowLength;
+        double end;          // 꼬리말 끝
+        std::uint64_t rows;
+        std::uint64_t firstItem;
+    };
+
+    Axis axis_;
+    std::vector<GridItem> items_;
+    double spacing_;
+    Alignment alignment_;
+    std::uint8_t pinnedViews_;
+    std::vector<LazyGridSection> sections_;
+    std::vector<SectionGeometry> geometry_;
+    std::vector<double> sectionStarts_;   // 이진 탐색용
+    std::vector<GridTrack> tracks_;
+    std::vector<double> trackAlignments_;   // 트랙마다 행 안에서 칸을 주축으로 옮기는 비율
+    double crossLength_ = ProposedViewSize::kUnspecified;
+    double contentLength_ = 0;
+    std::uint64_t itemCount_ = 0;
+    std::uint64_t resolutions_ = 0;
+};
+
+} // namespace manual
@@ -0,0 +1,327 @@
+//
+//  page_layout.cpp
+//  swiftUIManual tools
+//
+
+#include "layout/page_layout.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#include "common/mapped_file.h"
+#include "common/thread_pool.h"
+
+namespace fs = std::filesystem;
+
+namespace manual {
+
+namespace {
+
+constexpr std::size_t kPagesPerTask = 16;
+
+const JsonValue* member(const JsonValue* value, std::string_view key) {
+    return value != nullptr ? value->get(key) : nullptr;
+}
+
+std::string_view stringMember(const JsonValue& value, std::string_view key) {
+    const JsonValue* found = value.get(key);
+    return found != nullptr && found->isString() ? found->text : std::string_view();
+}
+
+bool isArray(const JsonValue* value) { return value != nullptr && value->isArray(); }
+
+/// UTF-8 글자 수. 이어지는 바이트(`10xxxxxx`)는 세지 않는다.
+std::uint32_t characterCount(std::string_view text) {
+    std::uint32_t count = 0;
+    for (char c : text) count += (std::uint8_t(c) & 0xC0) != 0x80 ? 1 : 0;
+    return count;
+}
+
+/// 페이지 하나를 트리로 옮긴다. 배치 객체는 페이지마다 한 벌만 만들어 모든 노드가 같이 쓴다.
+class PageBuilder {
+public:
+    PageBuilder(const JsonValue& root, LayoutTree& tree)
+        : root_(root), tree_(tree), references_(root.get("references")) {
+        page_ = tree.makeLayout<PaddingLayout>(EdgeInsets{20, 20, 20, 20});
+        column_ = tree.makeLayout<VStackLayout>(HorizontalAlignment::Leading, 16);
+        tight_ = tree.makeLayout<VStackLayout>(HorizontalAlignment::Leading, 4);
+        lines_ = tree.makeLayout<VStackLayout>(HorizontalAlignment::Leading, 0);
+        row_ = tree.makeLayout<HStackLayout>(VerticalAlignment::Top, 8);
+        chips_ = tree.makeLayout<HStackLayout>(VerticalAlignment::FirstTextBaseline, 12);
+        card_ = tree.makeLayout<PaddingLayout>(EdgeInsets{12, 12, 12, 12});
+    }
+
+    std::uint32_t build() {
+        std::uint32_t page = tree_.addContainer(LayoutTree::kNoNode, page_);
+        std::uint32_t column = tree_.addContainer(page, column_);
+        const JsonValue* metadata = root_.get("metadata");
+        if (metadata != nullptr) {
+            if (std::string_view role = stringMember(*metadata, "roleHeading"); !role.empty()) {
+                tree_.addText(column, characterCount(role), 15);
+            }
+            tree_.addText(column, characterCount(stringMember(*metadata, "title")), 34);
+        }
+        if (const JsonValue* abstract = root_.get("abstract"); isArray(abstract)) {
+            tree_.addText(column, inlineLength(*abstract), 20);
+        }
+        if (const JsonValue* platforms = member(metadata, "platforms"); isArray(platforms)) {
+            std::uint32_t chips = tree_.addContainer(column, chips_);
+            for (const auto& platform : platforms->elements) {
+                std::uint32_t length = characterCount(stringMember(platform, "name")) +
+                                       characterCount(stringMember(platform, "introducedAt")) + 2;
+                tree_.addText(chips, length, 13);
+            }
+        }
+        if (const JsonValue* summary = root_.get("deprecationSummary"); isArray(summary)) {
+            std::uint32_t card = tree_.addContainer(column, card_);
+            std::uint32_t inner = tree_.addContainer(card, tight_);
+            tree_.addText(inner, 10, 17);
+            addBlocks(inner, *summary);
+        }
+        if (const JsonValue* sections = root_.get("primaryContentSections"); isArray(sections)) {
+            for (const auto& section : sections->elements) addPrimarySection(column, section);
+        }
+        addTopics(column, root_.get("topicSections"), 6);
+        addTopics(column, root_.get("relationshipsSections"), 13);
+        addTopics(column, root_.get("seeAlsoSections"), 8);
+        return page;
+    }
+
+private:
+    void addPrimarySection(std::uint32_t column, const JsonValue& section) {
+        std::string_view kind = stringMember(section, "kind");
+        if (kind == "declarations") {
+            const JsonValue* declarations = section.get("declarations");
+            if (!isArray(declarations)) return;
+            tree_.addText(column, 11, 28);
+            for (const auto& declaration : declarations->elements) {
+                const JsonValue* tokens = declaration.get("tokens");
+                if (!isArray(tokens)) continue;
+                std::uint32_t lines = tree_.addContainer(tree_.addContainer(column, card_), lines_);
+                std::uint32_t length = 0;
+                for (const auto& token : tokens->elements) {
+                    for (char c : stringMember(token, "text")) {
+                        if (c == '\n') {
+                            tree_.addText(lines, length, 15);
+                            length = 0;
+                        } else if ((std::uint8_t(c) & 0xC0) != 0x80) {
+                            ++length;
+                        }
+                    }
+                }
+                tree_.addText(lines, length, 15);
+            }
+        } else if (kind == "content") {
+            if (const JsonValue* content = section.get("content"); isArray(content)) addBlocks(column, *content);
+        } else if (kind == "parameters") {
+            const JsonValue* parameters = section.get("parameters");
+            if (!isArray(parameters)) return;
+            tree_.addText(column, 10, 28);
+            for (const auto& parameter : parameters->elements) {
+                std::uint32_t item = tree_.addContainer(column, tight_);
+                tree_.addText(item, characterCount(stringMember(parameter, "name")), 15);
+                if (const JsonValue* content = parameter.get("content"); isArray(content)) addBlocks(item, *content);
+            }
+        }
+    }
+
+    void addBlocks(std::uint32_t parent, const JsonValue& blocks) {
+        for (const auto& block : blocks.elements) addBlock(parent, block);
+    }
+
+    void addBlock(std::uint32_t parent, const JsonValue& block) {
+        std::string_view type = stringMember(block, "type");
+        if (type == "paragraph") {
+            const JsonValue* content = block.get("inlineContent");
+            tree_.addText(parent, isArray(content) ? inlineLength(*content) : 0, 17);
+        } else if (type == "heading") {
+            const JsonValue* level = block.get("level");
+            char digit = level != nullptr && level->text.size() == 1 ? level->text[0] : '2';
+            tree_.addText(parent, characterCount(stringMember(block, "text")), digit <= '2' ? 28 : digit == '3' ? 22 : 20);
+        } else if (type == "codeListing") {
+            const JsonValue* code = block.get("code");
+            if (!isArray(code)) return;
+            std::uint32_t lines = tree_.addContainer(tree_.addContainer(parent, card_), lines_);
+            for (const auto& line : code->elements) tree_.addText(lines, characterCount(line.text), 15);
+        } else if (type == "unorderedList" || type == "orderedList") {
+            const JsonValue* items = block.get("items");
+            if (!isArray(items)) return;
+            std::uint32_t list = tree_.addContainer(parent, tight_);
+            for (const auto& item : items->elements) {
+                std::uint32_t row = tree_.addContainer(list, row_);
+                tree_.addText(row, type == "orderedList" ? 3 : 1, 17);
+                std::uint32_t body = tree_.addContainer(row, tight_);
+                if (const JsonValue* content = item.get("content"); isArray(content)) addBlocks(body, *content);
+            }
+        } else if (type == "aside") {
+            std::uint32_t card = tree_.addContainer(tree_.addContainer(parent, card_), tight_);
+            std::string_view name = stringMember(block, "name");
+            tree_.addText(card, characterCount(name.empty() ? stringMember(block, "style") : name), 17);
+            if (const JsonValue* content = block.get("content"); isArray(content)) addBlocks(card, *content);
+        } else if (type == "table") {
+            const JsonValue* rows = block.get("rows");
+            if (!isArray(rows)) return;
+            std::uint32_t table = tree_.addContainer(parent, tight_);
+            for (const auto& cells : rows->elements) {
+                if (!cells.isArray()) continue;
+                std::uint32_t row = tree_.addContainer(table, row_);
+                for (const auto& content : cells.elements) {
+                    std::uint32_t cell = tree_.addContainer(row, tight_);
+                    if (content.isArray()) addBlocks(cell, content);
+                }
+            }
+        } else if (type == "termList") {
+            const JsonValue* items = block.get("items");
+            if (!isArray(items)) return;
+            std::uint32_t list = tree_.addContainer(parent, tight_);
+            for (const auto& item : items->elements) {
+                const JsonValue* term = member(item.get("term"), "inlineContent");
+                tree_.addText(list, isArray(term) ? inlineLength(*term) : 0, 17);
+                if (const JsonValue* content = member(item.get("definition"), "content"); isArray(content)) {
+                    addBlocks(list, *content);
+                }
+            }
+        }
+    }
+
+    std::uint32_t inlineLength(const JsonValue& content) const {
+        std::uint32_t length = 0;
+        for (const auto& item : content.elements) {
+            std::string_view type = stringMember(item, "type");
+            if (type == "text") {
+                length += characterCount(stringMember(item, "text"));
+            } else if (type == "codeVoice") {
+                length += characterCount(stringMember(item, "code"));
+            } else if (type == "reference") {
+                std::string_view title = stringMember(item, "overridingTitle");
+                if (const JsonValue* target = member(references_, stringMember(item, "identifier"));
+                    title.empty() && target != nullptr) {
+                    title = stringMember(*target, "title");
+                }
+                length += characterCount(title);
+            } else if (type == "link") {
+                std::string_view title = stringMember(item, "title");
+                length += characterCount(title.empty() ? stringMember(item, "destination") : title);
+            } else if (const JsonValue* inner = item.get("inlineContent"); isArray(inner)) {
+                length += inlineLength(*inner);
+            }
+        }
+        return length;
+    }
+
+    void addTopics(std::uint32_t column, const JsonValue* sections, std::uint32_t headingLength) {
+        if (!isArray(sections) || sections->elements.size() == 0) return;
+        tree_.addText(column, headingLength, 28);
+        for (const auto& section : sections->elements) {
+            if (std::string_view title = stringMember(section, "title"); !title.empty()) {
+                tree_.addText(column, characterCount(title), 22);
+            }
+            const JsonValue* identifiers = section.get("identifiers");
+            if (!isArray(identifiers)) continue;
+            for (const auto& identifier : identifiers->elements) {
+                const JsonValue* target = member(references_, identifier.text);
+                std::uint32_t row = tree_.addContainer(column, row_);
+                tree_.addImage(row, {16, 16});
+                std::uint32_t text = tree_.addContainer(row, tight_);
+                std::uint32_t title = characterCount(identifier.text);
+                if (target != nullptr) {
+                    const JsonValue* fragments = target->get("fragments");
+                    if (isArray(fragments) && fragments->elements.size() > 0) {
+                        title = 0;
+                        for (const auto& fragment : fragments->elements) {
+                            title += characterCount(stringMember(fragment, "text"));
+                        }
+                    } else {
+                        title = characterCount(stringMember(*target, "title"));
+                    }
+                }
+                tree_.addText(text, title, 17);
+                if (const JsonValue* abstract = member(target, "abstract");
+                    isArray(abstract) && abstract->elements.size() > 0) {
+                    tree_.addText(text, inlineLength(*abstract), 15);
+                }
+                tree_.addSpacer(row);
+            }
+        }
+    }
+
+    const JsonValue& root_;
+    LayoutTree& tree_;
+    const JsonValue* references_;
+    std::uint32_t page_, column_, tight_, lines_, row_, chips_, card_;
+};
+
+} // namespace
+
+std::uint32_t buildPageLayout(const JsonValue& root, LayoutTree& tree) { return PageBuilder(root, tree).build(); }
+
+std::uint32_t buildSyntheticLayout(std::size_t nodes, LayoutTree& tree, std::uint64_t seed) {
+    std::uint64_t state = seed * 0x9E3779B97F4A7C15ull + 1;
+    auto next = [&](std::uint32_t low, std::uint32_t high) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return low + std::uint32_t((state >> 33) % (high - low + 1));
+    };
+    std::uint32_t list = tree.makeLayout<VStackLayout>(HorizontalAlignment::Leading, 0);
+    std::uint32_t section = tree.makeLayout<VStackLayout>(HorizontalAlignment::Leading, 4);
+    std::uint32_t inset = tree.makeLayout<PaddingLayout>(EdgeInsets{8, 16, 8, 16});
+    std::uint32_t row = tree.makeLayout<HStackLayout>(VerticalAlignment::Center, 12);
+    std::uint32_t labels = tree.makeLayout<VStackLayout>(HorizontalAlignment::Leading, 2);
+
+    std::uint32_t root = tree.addContainer(LayoutTree::kNoNode, list);
+    std::uint32_t current = LayoutTree::kNoNode;
+    for (std::size_t rows = 0; tree.size() < nodes; ++rows) {
+        if (rows % 50 == 0) {
+            current = tree.addContainer(root, section);
+            tree.addText(current, next(8, 24), 22);
+        }
+        std::uint32_t item = tree.addContainer(tree.addContainer(current, inset), row);
+        tree.addImage(item, {44, 44});
+        std::uint32_t text = tree.addContainer(item, labels);
+        tree.addText(text, next(10, 60), 17);
+        tree.addText(text, next(20, 120), 15);
+        tree.addSpacer(item);
+        tree.addText(item, next(3, 8), 17);
+    }
+    return root;
+}
+
+std::uint32_t buildNestedLayout(std::size_t depth, LayoutTree& tree) {
+    std::uint32_t row = tree.makeLayout<HStackLayout>(VerticalAlignment::FirstTextBaseline, 8);
+    std::uint32_t column = tree.makeLayout<VStackLayout>(HorizontalAlignment::Leading, 8);
+    std::uint32_t root = tree.addContainer(LayoutTree::kNoNode, row);
+    std::uint32_t parent = root;
+    for (std::size_t level = 1; level < depth; ++level) {
+        tree.addText(parent, std::uint32_t(8 + level % 7 * 3), 17);
+        parent = tree.addContainer(parent, level % 2 == 1 ? column : row);
+    }
+    tree.addText(parent, 12, 17);
+    return root;
+}
+
+std::vector<PageLayout> loadPageLayouts(const std::string& dataDirectory, ThreadPool& pool) {
+    fs::path data(dataDirectory);
+    std::vector<PageLayout> pages;
+    std::string prefix = data.generic_string();
+    for (const auto& entry : fs::recursive_directory_iterator(data / "documentation")) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json") continue;
+        std::string path = entry.path().generic_string();
+        std::size_t skip = prefix.size();
+        while (skip < path.size() && path[skip] == '/') ++skip;
+        pages.emplace_back().path = path.substr(skip, path.size() - skip - 5);
+    }
+    std::sort(pages.begin(), pages.end(),
+              [](const PageLayout& a, const PageLayout& b) { return a.path < b.path; });
+
+    pool.parallelFor((pages.size() + kPagesPerTask - 1) / kPagesPerTask, [&](std::size_t task) {
+        Arena arena(1 << 16);
+        std::size_t end = std::min(pages.size(), (task + 1) * kPagesPerTask);
+        for (std::size_t i = task * kPagesPerTask; i < end; ++i) {
+            MappedFile json((data / (pages[i].path + ".json")).string());
+            pages[i].root = buildPageLayout(parseJson(json.bytes(), arena), pages[i].tree);
+            arena.release();
+        }
+    });
+    return pages;
+}
+
+} // namespace manual
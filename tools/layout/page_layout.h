@@ -0,0 +1,43 @@
+//
+//  page_layout.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/json.h"
+#include "layout/layout_engine.h"
+
+namespace manual {
+
+class ThreadPool;
+
+/// 렌더 JSON 한 페이지를 문서 화면과 같은 모양의 뷰 트리로 옮기고 뿌리 번호를 돌려준다.
+///
+/// `padding(20)` 안의 `VStack(alignment: .leading)`에 제목, 요약, 가용성 칩, 선언부, 본문 블록(문단, 제목,
+/// 코드 목록, 목록, 참고, 표), 토픽 구역의 링크 행(`HStack { Image; VStack { 제목; 요약 }; Spacer() }`)을 쌓는다.
+/// 글은 UTF-8 글자 수만 세어 `Text` 잎에 넣는다.
+std::uint32_t buildPageLayout(const JsonValue& root, LayoutTree& tree);
+
+/// 카탈로그 화면 모양의 합성 트리. 행(`HStack { Image; VStack { 이름; 설명 }; Spacer(); 값 }`)을 50개씩
+/// 구역으로 묶고, 노드가 `nodes`개 이상이 될 때까지 더한다. 같은 `seed`면 같은 트리다.
+std::uint32_t buildSyntheticLayout(std::size_t nodes, LayoutTree& tree, std::uint64_t seed = 1);
+
+/// `HStack { Text; VStack { Text; HStack { … } } }`처럼 가로·세로 스택을 `depth`단 번갈아 겹친 트리.
+/// 가로 스택마다 자식을 세 번 재므로, 측정 기억이 없으면 잴 횟수가 깊이에 지수적으로 는다.
+std::uint32_t buildNestedLayout(std::size_t depth, LayoutTree& tree);
+
+struct PageLayout {
+    std::string path;   // `documentation/swiftuimanual/contentview`
+    LayoutTree tree;
+    std::uint32_t root = LayoutTree::kNoNode;
+};
+
+/// `dataDirectory`(`docs/data`)의 `documentation` 아래 모든 페이지를 스레드 풀에서 나눠 뷰 트리로 옮긴다. 경로 순이다.
+std::vector<PageLayout> loadPageLayouts(const std::string& dataDirectory, ThreadPool& pool);
+
+} // namespace manual
@@ -0,0 +1,526 @@
+//
+//  http_server.cpp
+//  swiftUIManual tools
+//
+
+#include "serve/http_server.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <string_view>
+#include <system_error>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "serve/static_site.h"
+
+namespace manual {
+
+namespace {
+
+constexpr std::size_t kMaxHeaderBytes = 16 * 1024;
+constexpr std::size_t kMaxInputBytes = 64 * 1024;   // 처리하지 않은 입력의 상한. 넘으면 소켓에 남겨 둔다
+constexpr int kMaxEvents = 256;
+constexpr int kSweepMilliseconds = 1000;   // 유휴 연결을 훑는 간격. 닫히는 시각은 이만큼 늦을 수 있다
+
+using Clock = std::chrono::steady_clock;
+
+[[noreturn]] void fail(const char* what) { throw std::system_error(errno, std::generic_category(), what); }
+
+bool equalsIgnoringCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        char x = a[i], y = b[i];
+        if (x >= 'A' && x <= 'Z') x = char(x - 'A' + 'a');
+        if (y >= 'A' && y <= 'Z') y = char(y - 'A' + 'a');
+        if (x != y) return false;
+    }
+    return true;
+}
+
+/// 쉼표로 나뉜 헤더 값에 `token`이 있는지(대소문자 무시).
+bool hasToken(std::string_view value, std::string_view token) {
+    while (!value.empty()) {
+        std::size_t comma = value.find(',');
+        std::string_view item = value.substr(0, comma);
+        while (!item.empty() && item.front() == ' ') item.remove_prefix(1);
+        while (!item.empty() && item.back() == ' ') item.remove_suffix(1);
+        if (equalsIgnoringCase(item, token)) return true;
+        if (comma == std::string_view::npos) break;
+        value.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+    return text;
+}
+
+/// 요청 하나에서 응답을 고르는 데 필요한 것만 뽑은 것.
+struct Request {
+    std::string_view method;
+    std::string_view target;
+    std::string_view acceptEncoding;
+    std::string_view ifNoneMatch;
+    bool keepAlive = true;
+    bool hasBody = false;
+};
+
+/// `head`(빈 줄 앞까지)를 읽는다. 요청 줄이 맞지 않으면 거짓.
+bool parseRequest(std::string_view head, Request& request) {
+    std::size_t lineEnd = head.find("\r\n");
+    std::string_view line = head.substr(0, lineEnd);
+    std::size_t first = line.find(' ');
+    std::size_t second = first == std::string_view::npos ? first : line.find(' ', first + 1);
+    if (second == std::string_view::npos) return false;
+    request.method = line.substr(0, first);
+    request.target = line.substr(first + 1, second - first - 1);
+    std::string_view version = line.substr(second + 1);
+    if (version == "HTTP/1.1") {
+        request.keepAlive = true;
+    } else if (version == "HTTP/1.0") {
+        request.keepAlive = false;
+    } else {
+        return false;
+    }
+
+    while (lineEnd != std::string_view::npos) {
+        std::size_t start = lineEnd + 2;
+        lineEnd = head.find("\r\n", start);
+        std::string_view header = head.substr(start, lineEnd == std::string_view::npos ? head.npos : lineEnd - start);
+        std::size_t colon = header.find(':');
+        if (colon == std::string_view::npos) continue;
+        std::string_view name = header.substr(0, colon);
+        std::string_view value = trim(header.substr(colon + 1));
+        if (equalsIgnoringCase(name, "accept-encoding")) {
+            request.acceptEncoding = value;
+        } else if (equalsIgnoringCase(name, "if-none-match")) {
+            request.ifNoneMatch = value;
+        } else if (equalsIgnoringCase(name, "connection")) {
+            if (hasToken(value, "close")) request.keepAlive = false;
+            if (hasToken(value, "keep-alive")) request.keepAlive = true;
+        } else if (equalsIgnoringCase(name, "content-length")) {
+            request.hasBody = request.hasBody || value != "0";
+        } else if (equalsIgnoringCase(name, "transfer-encoding")) {
+            request.hasBody = true;
+        }
+    }
+    return true;
+}
+
+/// `If-None-Match` 목록에 `etag`이 있는지. 약한 비교(`W/` 무시)를 쓴다.
+bool matchesEtag(std::string_view header, std::string_view etag) {
+    while (!header.empty()) {
+        std::size_t comma = header.find(',');
+        std::string_view item = trim(header.substr(0, comma));
+        if (item.substr(0, 2) == "W/") item.remove_prefix(2);
+        if (item == etag || item == "*") return true;
+        if (comma == std::string_view::npos) break;
+        header.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+} // namespace
+
+// MARK: - 연결
+
+struct Connection {
+    int fd = -1;
+    std::string input;
+    std::size_t consumed = 0;   // `input`에서 처리한 요청 바이트
+    std::string output;         // 아직 못 보낸 헤더(오류 응답은 본문까지)
+    std::size_t outputSent = 0;
+    StaticBody body;            // 아직 못 보낸 본문
+    bool closeAfter = false;
+    bool peerClosed = false;
+    bool readable = false;      // 소켓에 아직 읽지 않은 입력이 있을 수 있다(에지 트리거라 직접 기억한다)
+    Clock::time_point lastActive;   // 마지막으로 이벤트를 받은 시각
+
+    bool pending() const { return outputSent < output.size() || body.size > 0; }
+};
+
+struct HttpServer::Worker {
+    const StaticSite* site = nullptr;
+    int listener = -1;
+    int epoll = -1;
+    int wake = -1;
+    std::vector<std::unique_ptr<Connection>> connections;   // fd로 찾는다
+    std::unique_ptr<TinyLfuCache> cache;
+    std::string_view cachePrefix;
+    const std::vector<std::pair<std::string, Handler>>* routes = nullptr;
+    Clock::duration idleTimeout{};   // 0이면 유휴 연결을 닫지 않는다
+
+    ~Worker() {
+        for (auto& connection : connections) {
+            if (connection) ::close(connection->fd);
+        }
+        for (int fd : {listener, epoll, wake}) {
+            if (fd >= 0) ::close(fd);
+        }
+    }
+
+    void run();
+    void acceptAll();
+    void serve(Connection& connection, std::uint32_t events);
+    void closeIdle(Clock::time_point now);
+    bool readInput(Connection& connection);
+    bool pump(Connection& connection);
+    bool flush(Connection& connection);
+    void respond(Connection& connection, const Request& request);
+    bool respondFromCache(Connection& connection, const StaticAsset& asset, std::size_t encoding);
+    void respondError(Connection& connection, std::string_view status, bool close);
+    void close(Connection& connection);
+};
+
+void HttpServer::Worker::run() {
+    epoll_event events[kMaxEvents];
+    // 연결마다 타이머를 두는 대신 epoll_wait를 주기적으로 깨워 한꺼번에 훑는다.
+    int timeout = idleTimeout == Clock::duration::zero() ? -1 : kSweepMilliseconds;
+    Clock::time_point nextSweep = Clock::now() + std::chrono::milliseconds(kSweepMilliseconds);
+    for (;;) {
+        int count = ::epoll_wait(epoll, events, kMaxEvents, timeout);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            std::perror("swiftui-serve: epoll_wait");
+            return;
+        }
+        if (timeout >= 0) {
+            Clock::time_point now = Clock::now();
+            if (now >= nextSweep) {
+                closeIdle(now);
+                nextSweep = now + std::chrono::milliseconds(kSweepMilliseconds);
+            }
+        }
+        for (int i = 0; i < count; ++i) {
+            int fd = int(events[i].data.u64);
+            if (fd == wake) return;
+            if (fd == listener) {
+                acceptAll();
+                continue;
+            }
+            if (std::size_t(fd) < connections.size() && connections[std::size_t(fd)]) {
+                serve(*connections[std::size_t(fd)], events[i].events);
+            }
+        }
+    }
+}
+
+void HttpServer::Worker::acceptAll() {
+    for (;;) {
+        int fd = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            return;   // EAGAIN, 또는 EMFILE 같은 일시적 오류
+        }
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
+        if (std::size_t(fd) >= connections.size()) connections.resize(std::size_t(fd) + 1);
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->lastActive = Clock::now();
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.u64 = std::uint64_t(fd);
+        if (::epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        connections[std::size_t(fd)] = std::move(connection);
+    }
+}
+
+void HttpServer::Worker::serve(Connection& connection, std::uint32_t events) {
+    connection.lastActive = Clock::now();
+    if (events & EPOLLERR) {
+        close(connection);
+        return;
+    }
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) connection.readable = true;
+    // 응답이 밀려 있는 동안은 읽지 않는다. 요청을 파이프라인으로 보내고 응답을 읽지 않는 클라이언트는
+    // 커널 소켓 버퍼가 차서 TCP 흐름 제어에 걸리고, 서버 메모리는 늘지 않는다.
+    for (;;) {
+        if (connection.readable && !connection.pending() && !readInput(connection)) {
+            close(connection);
+            return;
+        }
+        if (!pump(connection)) {
+            close(connection);
+            return;
+        }
+        if (connection.pending() || !connection.readable) return;
+    }
+}
+
+/// `idleTimeout` 넘게 이벤트가 없던 연결을 닫는다. 요청을 보내다 만 클라이언트와 응답을 읽지 않는 클라이언트가 모두 걸린다.
+void HttpServer::Worker::closeIdle(Clock::time_point now) {
+    for (auto& connection : connections) {
+        if (connection && now - connection->lastActive > idleTimeout) close(*connection);
+    }
+}
+
+/// 처리하지 않은 입력이 `kMaxInputBytes`가 될 때까지 읽는다. 소켓이 비면 `readable`을 내린다.
+bool HttpServer::Worker::readInput(Connection& connection) {
+    char buffer[16 * 1024];
+    for (;;) {
+        std::size_t unconsumed = connection.input.size() - connection.consumed;
+        if (unconsumed >= kMaxInputBytes) return true;
+        ssize_t received = ::recv(connection.fd, buffer, std::min(sizeof buffer, kMaxInputBytes - unconsumed), 0);
+        if (received > 0) {
+            connection.input.append(buffer, std::size_t(received));
+            continue;
+        }
+        if (received == 0) {
+            connection.peerClosed = true;
+            connection.readable = false;
+            return true;
+        }
+        if (errno == EINTR) continue;
+        connection.readable = false;
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+}
+
+/// 보낼 것이 밀려 있지 않은 동안 완성된 요청을 차례로 처리한다. 연결을 닫아야 하면 거짓.
+bool HttpServer::Worker::pump(Connection& connection) {
+    for (;;) {
+        if (connection.pending()) {
+            if (!flush(connection)) return false;
+            if (connection.pending()) return true;   // EPOLLOUT을 기다린다
+        }
+        if (connection.closeAfter) return false;
+
+        std::string_view input = std::string_view(connection.input).substr(connection.consumed);
+        std::size_t end = input.find("\r\n\r\n");
+        if (end == std::string_view::npos) {
+            if (input.size() > kMaxHeaderBytes) {
+                respondError(connection, "431 Request Header Fields Too Large", true);
+                continue;
+            }
+            connection.input.erase(0, connection.consumed);
+            connection.consumed = 0;
+            return !connection.peerClosed;
+        }
+        connection.consumed += end + 4;
+
+        Request request;
+        if (!parseRequest(input.substr(0, end), request)) {
+            respondError(connection, "400 Bad Request", true);
+        } else if (request.hasBody) {
+            // 정적 사이트라 본문이 있는 요청은 받지 않는다. 본문 경계를 알 수 없으니 연결을 닫는다.
+            respondError(connection, "400 Bad Request", true);
+        } else {
+            respond(connection, request);
+        }
+    }
+}
+
+bool HttpServer::Worker::flush(Connection& connection) {
+    while (connection.outputSent < connection.output.size()) {
+        int flags = MSG_NOSIGNAL | (connection.body.size > 0 ? MSG_MORE : 0);
+        ssize_t sent = ::send(connection.fd, connection.output.data() + connection.outputSent,
+                              connection.output.size() - connection.outputSent, flags);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        connection.outputSent += std::size_t(sent);
+    }
+    connection.output.clear();
+    connection.outputSent = 0;
+
+    while (connection.body.size > 0) {
+        off_t offset = off_t(connection.body.offset);
+        std::size_t chunk = std::size_t(std::min<std::uint64_t>(connection.body.size, 1u << 30));
+        ssize_t sent = ::sendfile(connection.fd, connection.body.fd, &offset, chunk);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        if (sent == 0) return false;   // 파일이 줄었다
+        connection.body.offset += std::uint64_t(sent);
+        connection.body.size -= std::uint64_t(sent);
+    }
+    return true;
+}
+
+void HttpServer::Worker::respond(Connection& connection, const Request& request) {
+    bool head = request.method == "HEAD";
+    if (!head && request.method != "GET") {
+        connection.output = "HTTP/1.1 405 Method Not Allowed\r\nAllow: GET, HEAD\r\nContent-Length: 0\r\n";
+        if (!request.keepAlive) connection.output += "Connection: close\r\n";
+        connection.output += "\r\n";
+        connection.closeAfter = !request.keepAlive;
+        return;
+    }
+    std::string_view path = request.target.substr(0, request.target.find('?'));
+    for (const auto& [route, handler] : *routes) {
+        if (route != path) continue;
+        std::string_view query = path.size() < request.target.size() ? request.target.substr(path.size() + 1) : "";
+        std::string body;
+        std::string_view contentType = handler(query, body);
+        connection.output = "HTTP/1.1 200 OK\r\nContent-Type: ";
+        connection.output += contentType;
+        connection.output += "\r\nContent-Length: " + std::to_string(body.size()) + "\r\nCache-Control: no-cache\r\n";
+        if (!request.keepAlive) connection.output += "Connection: close\r\n";
+        connection.output += "\r\n";
+        if (!head) connection.output += body;
+        connection.closeAfter = !request.keepAlive;
+        return;
+    }
+
+    const StaticAsset* asset = site->resolve(request.target);
+    if (asset == nullptr) {
+        respondError(connection, "404 Not Found", !request.keepAlive);
+        return;
+    }
+
+    auto encoding = std::size_t(negotiateEncoding(request.acceptEncoding, *asset));
+    bool notModified = !request.ifNoneMatch.empty() && matchesEtag(request.ifNoneMatch, asset->etags[encoding]);
+    connection.output = notModified ? asset->notModified[encoding] : asset->headers[encoding];
+    if (!request.keepAlive) connection.output += "Connection: close\r\n";
+    connection.output += "\r\n";
+    connection.closeAfter = !request.keepAlive;
+    if (notModified || head) return;
+    if (cache && asset->path.compare(0, cachePrefix.size(), cachePrefix) == 0 &&
+        respondFromCache(connection, *asset, encoding)) {
+        return;
+    }
+    connection.body = asset->bodies[encoding];
+}
+
+/// 본문을 캐시에서 헤더 뒤에 붙인다. 캐시에 없고 아직 두 번 이상 요청되지 않았으면 거짓(`sendfile`로 보낸다).
+bool HttpServer::Worker::respondFromCache(Connection& connection, const StaticAsset& asset, std::size_t encoding) {
+    std::uint64_t key = std::uint64_t(asset.id) << 2 | encoding;
+    const std::string* cached = cache->get(key);
+    if (cached == nullptr) {
+        if (cache->frequency(key) < 2) return false;
+        const StaticBody& body = asset.bodies[encoding];
+        std::string bytes(body.size, '\0');
+        std::size_t done = 0;
+        while (done < bytes.size()) {
+            ssize_t got = ::pread(body.fd, bytes.data() + done, bytes.size() - done, off_t(body.offset + done));
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) return false;
+            done += std::size_t(got);
+        }
+        connection.output += bytes;
+        cache->put(key, std::move(bytes));
+        return true;
+    }
+    connection.output += *cached;
+    return true;
+}
+
+void HttpServer::Worker::respondError(Connection& connection, std::string_view status, bool close) {
+    std::string_view text = status.substr(4);
+    connection.output = "HTTP/1.1 ";
+    connection.output += status;
+    connection.output += "\r\nContent-Type: text/plain; charset=utf-8\r\nContent-Length: ";
+    connection.output += std::to_string(text.size() + 1);
+    connection.output += "\r\n";
+    if (close) connection.output += "Connection: close\r\n";
+    connection.output += "\r\n";
+    connection.output += text;
+    connection.output += '\n';
+    connection.closeAfter = close;
+}
+
+void HttpServer::Worker::close(Connection& connection) {
+    int fd = connection.fd;
+    ::close(fd);   // epoll 등록도 함께 풀린다
+    connections[std::size_t(fd)].reset();
+}
+
+// MARK: - 서버
+
+HttpServer::HttpServer(const StaticSite& site, const Options& options) : site_(site), cachePrefix_(options.cachePrefix) {
+    unsigned threads = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(options.port);
+    if (::inet_pton(AF_INET, options.host.c_str(), &address.sin_addr) != 1) {
+        throw std::system_error(EINVAL, std::generic_category(), "bad IPv4 address " + options.host);
+    }
+
+    for (unsigned i = 0; i < threads; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->site = &site_;
+        worker->routes = &routes_;
+        worker->idleTimeout = std::chrono::seconds(options.idleSeconds);
+        if (options.cacheBytes > 0) {
+            // 작업 스레드마다 예산을 나눠 가지므로 캐시에 잠금이 없다.
+            worker->cache = std::make_unique<TinyLfuCache>(options.cacheBytes / threads, site.size());
+            worker->cachePrefix = cachePrefix_;
+        }
+        worker->listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (worker->listener < 0) fail("socket");
+        int one = 1;
+        ::setsockopt(worker->listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof one);
+        // 작업 스레드마다 수신 소켓을 따로 두고 커널이 연결을 나눠 준다.
+        if (::setsockopt(worker->listener, SOL_SOCKET, SO_REUSEPORT, &one, sizeof one) != 0) fail("SO_REUSEPORT");
+        if (::bind(worker->listener, reinterpret_cast<sockaddr*>(&address), sizeof address) != 0) fail("bind");
+        if (::listen(worker->listener, SOMAXCONN) != 0) fail("listen");
+        if (i == 0) {
+            // 포트 0이면 첫 소켓이 받은 포트에 나머지를 묶는다.
+            socklen_t length = sizeof address;
+            if (::getsockname(worker->listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+                fail("getsockname");
+            }
+            port_ = ntohs(address.sin_port);
+        }
+
+        worker->epoll = ::epoll_create1(EPOLL_CLOEXEC);
+        if (worker->epoll < 0) fail("epoll_create1");
+        worker->wake = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (worker->wake < 0) fail("eventfd");
+        for (int fd : {worker->listener, worker->wake}) {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = std::uint64_t(fd);
+            if (::epoll_ctl(worker->epoll, EPOLL_CTL_ADD, fd, &event) != 0) fail("epoll_ctl");
+        }
+        workers_.push_back(std::move(worker));
+    }
+}
+
+HttpServer::~HttpServer() { stop(); }
+
+TinyLfuCache::Stats HttpServer::cacheStats() const {
+    TinyLfuCache::Stats total;
+    for (const auto& worker : workers_) {
+        if (worker->cache) total += worker->cache->stats();
+    }
+    return total;
+}
+
+void HttpServer::route(std::string path, Handler handler) {
+    routes_.emplace_back(std::move(path), std::move(handler));
+}
+
+void HttpServer::start() {
+    for (auto& worker : workers_) threads_.emplace_back([&worker] { worker->run(); });
+}
+
+void HttpServer::stop() {
+    for (auto& worker : workers_) {
+        std::uint64_t one = 1;
+        ssize_t written = ::write(worker->wake, &one, sizeof one);
+        (void)written;
+    }
+    for (auto& thread : threads_) thread.join();
+    threads_.clear();
+}
+
+} // namespace manual
@@ -0,0 +1,78 @@
+//
+//  http_server.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "common/tinylfu_cache.h"
+
+namespace manual {
+
+class StaticSite;
+
+/// `StaticSite`를 내보내는 HTTP/1.1 서버.
+///
+/// 작업 스레드마다 `SO_REUSEPORT` 수신 소켓과 epoll 하나를 가지므로 스레드 사이에 공유하는 상태가 없다.
+/// 헤더는 자산마다 미리 만든 문자열을 보내고, 본문은 `sendfile`로 커널 안에서 바로 보낸다.
+/// GET과 HEAD, keep-alive, 파이프라이닝, `If-None-Match`를 지원한다. 오래 조용한 연결은 주기적으로 훑어 닫는다.
+class HttpServer {
+public:
+    struct Options {
+        std::string host = "0.0.0.0";
+        std::uint16_t port = 8080;
+        /// 0이면 하드웨어 스레드 수만큼.
+        unsigned threads = 0;
+        /// 메모리에 둘 본문의 바이트 예산(작업 스레드 전체). 0이면 캐시를 쓰지 않는다.
+        std::size_t cacheBytes = 0;
+        /// 캐시할 경로의 접두사. 요청이 한쪽에 쏠리는 렌더 JSON이 대상이다.
+        std::string cachePrefix = "/data/";
+        /// 이 시간(초) 동안 아무 일이 없는 연결을 닫는다. 0이면 닫지 않는다.
+        unsigned idleSeconds = 60;
+    };
+
+    /// 동적 응답을 만드는 함수. 질의 문자열(`?` 뒤)을 받아 본문을 `body`에 쓰고 Content-Type을 돌려준다.
+    /// 여러 작업 스레드에서 동시에 불린다.
+    using Handler = std::function<std::string_view(std::string_view query, std::string& body)>;
+
+    /// 소켓을 열고 묶는다. 실패하면 `std::system_error`를 던진다.
+    HttpServer(const StaticSite& site, const Options& options);
+    ~HttpServer();
+
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    /// 실제로 묶인 포트. `Options::port`가 0이면 커널이 고른 포트다.
+    std::uint16_t port() const { return port_; }
+    unsigned threads() const { return unsigned(workers_.size()); }
+    /// 작업 스레드들의 캐시 통계를 더한 것. 서버가 도는 동안 불러도 된다.
+    TinyLfuCache::Stats cacheStats() const;
+
+    /// `path`(질의 문자열 제외)에 처리기를 단다. 정적 파일보다 먼저 찾는다. `start()` 전에만 부를 수 있다.
+    void route(std::string path, Handler handler);
+
+    /// 작업 스레드를 띄운다.
+    void start();
+    /// 모든 작업 스레드를 깨워 멈추고 기다린다. 다른 스레드에서 불러도 된다.
+    void stop();
+
+private:
+    struct Worker;
+
+    const StaticSite& site_;
+    std::string cachePrefix_;
+    std::vector<std::pair<std::string, Handler>> routes_;
+    std::uint16_t port_ = 0;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace manual
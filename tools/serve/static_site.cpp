@@ -0,0 +1,311 @@
+//
+//  static_site.cpp
+//  swiftUIManual tools
+//
+
+#include "serve/static_site.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+
+#include <brotli/encode.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "common/hash.h"
+#include "common/mapped_file.h"
+#include "common/thread_pool.h"
+
+namespace fs = std::filesystem;
+
+namespace manual {
+
+namespace {
+
+struct ContentType {
+    std::string_view extension;
+    std::string_view mime;
+    bool compressible;
+};
+
+constexpr ContentType kContentTypes[] = {
+    {".html", "text/html; charset=utf-8", true},
+    {".js", "application/javascript; charset=utf-8", true},
+    {".css", "text/css; charset=utf-8", true},
+    {".json", "application/json", true},
+    {".svg", "image/svg+xml", true},
+    {".ico", "image/x-icon", true},
+    {".png", "image/png", false},
+    {".jpg", "image/jpeg", false},
+};
+
+ContentType contentType(const fs::path& path) {
+    std::string extension = path.extension().string();
+    for (const auto& type : kContentTypes) {
+        if (type.extension == extension) return type;
+    }
+    return {"", "application/octet-stream", false};
+}
+
+std::string gzip(std::string_view input, int level) {
+    z_stream stream{};
+    // windowBits 16 + 15: zlib 대신 gzip 머리말을 쓴다.
+    if (deflateInit2(&stream, level, Z_DEFLATED, 16 + 15, 9, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("deflateInit2 failed");
+    }
+    std::string output(deflateBound(&stream, uLong(input.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = uInt(input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = uInt(output.size());
+    int status = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (status != Z_STREAM_END) throw std::runtime_error("deflate failed");
+    output.resize(stream.total_out);
+    return output;
+}
+
+std::string brotli(std::string_view input, int quality) {
+    std::size_t size = BrotliEncoderMaxCompressedSize(input.size());
+    if (size == 0) size = input.size() + 1024;
+    std::string output(size, '\0');
+    if (!BrotliEncoderCompress(quality, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT, input.size(),
+                               reinterpret_cast<const std::uint8_t*>(input.data()), &size,
+                               reinterpret_cast<std::uint8_t*>(output.data()))) {
+        throw std::runtime_error("brotli compression failed");
+    }
+    output.resize(size);
+    return output;
+}
+
+void writeAll(int fd, std::string_view bytes) {
+    while (!bytes.empty()) {
+        ssize_t written = ::write(fd, bytes.data(), bytes.size());
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw std::system_error(errno, std::generic_category(), "write memfd");
+        }
+        bytes.remove_prefix(std::size_t(written));
+    }
+}
+
+bool isHex(char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'); }
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+constexpr std::string_view kEncodingNames[] = {"", "gzip", "br"};
+constexpr std::string_view kEtagSuffixes[] = {"", "-gz", "-br"};
+
+} // namespace
+
+bool isContentHashedName(std::string_view path) {
+    std::string_view name = path.substr(path.rfind('/') + 1);
+    std::size_t extension = name.rfind('.');
+    if (extension == std::string_view::npos || extension < 9 || name[extension - 9] != '.') return false;
+    return std::all_of(name.begin() + std::ptrdiff_t(extension - 8), name.begin() + std::ptrdiff_t(extension), isHex);
+}
+
+ContentEncoding negotiateEncoding(std::string_view accept, const StaticAsset& asset) {
+    bool gzipOk = false, brotliOk = false;
+    while (!accept.empty()) {
+        std::size_t comma = accept.find(',');
+        std::string_view item = accept.substr(0, comma);
+        accept = comma == std::string_view::npos ? std::string_view() : accept.substr(comma + 1);
+
+        std::size_t semicolon = item.find(';');
+        std::string_view coding = item.substr(0, semicolon);
+        while (!coding.empty() && (coding.front() == ' ' || coding.front() == '\t')) coding.remove_prefix(1);
+        while (!coding.empty() && (coding.back() == ' ' || coding.back() == '\t')) coding.remove_suffix(1);
+        // `q=0`은 명시적인 거부다. 그 밖의 가중치는 구분하지 않고 br을 먼저 고른다.
+        bool refused = false;
+        if (semicolon != std::string_view::npos) {
+            std::string_view params = item.substr(semicolon + 1);
+            std::size_t q = params.find("q=");
+            if (q != std::string_view::npos) {
+                std::string_view weight = params.substr(q + 2);
+                weight = weight.substr(0, weight.find_first_of(" \t;"));
+                refused = !weight.empty() && weight.find_first_not_of("0.") == std::string_view::npos;
+            }
+        }
+        if (refused) continue;
+        if (coding == "br") brotliOk = true;
+        else if (coding == "gzip" || coding == "x-gzip") gzipOk = true;
+        else if (coding == "*") gzipOk = brotliOk = true;
+    }
+    if (brotliOk && asset.has(ContentEncoding::Brotli)) return ContentEncoding::Brotli;
+    if (gzipOk && asset.has(ContentEncoding::Gzip)) return ContentEncoding::Gzip;
+    return ContentEncoding::Identity;
+}
+
+StaticSite::StaticSite(const std::string& root, const Options& options, ThreadPool& pool,
+                       std::vector<GeneratedFile> generated) {
+    struct Source {
+        fs::path path;
+        std::string sitePath;
+        ContentType type;
+        const std::string* generated = nullptr;
+        std::string compressed[std::size_t(ContentEncoding::Count)];
+        std::uint64_t hash = 0;
+        std::uint64_t size = 0;
+    };
+    std::vector<Source> sources;
+    for (const auto& entry : fs::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file()) continue;
+        Source source;
+        source.path = entry.path();
+        source.sitePath = "/" + fs::relative(entry.path(), root).generic_string();
+        source.type = contentType(entry.path());
+        sources.push_back(std::move(source));
+    }
+    for (const GeneratedFile& file : generated) {
+        auto existing = std::find_if(sources.begin(), sources.end(),
+                                     [&file](const Source& source) { return source.sitePath == file.path; });
+        Source& source = existing != sources.end() ? *existing : sources.emplace_back();
+        source.path = file.path;
+        source.sitePath = file.path;
+        source.type = contentType(file.path);
+        source.generated = &file.bytes;
+    }
+    std::sort(sources.begin(), sources.end(),
+              [](const Source& a, const Source& b) { return a.sitePath < b.sitePath; });
+
+    // 압축은 시작할 때 한 번만, 파일마다 나눠서 한다.
+    pool.parallelFor(sources.size(), [&](std::size_t index) {
+        Source& source = sources[index];
+        std::optional<MappedFile> file;
+        std::string_view bytes;
+        if (source.generated != nullptr) {
+            bytes = *source.generated;
+        } else {
+            bytes = file.emplace(source.path.string()).bytes();
+        }
+        source.size = bytes.size();
+        source.hash = fnv1a(bytes);
+        if (!source.type.compressible || bytes.size() < 256) return;
+        auto keep = [&](ContentEncoding encoding, std::string compressed) {
+            if (double(compressed.size()) <= double(bytes.size()) * options.keepRatio) {
+                source.compressed[std::size_t(encoding)] = std::move(compressed);
+            }
+        };
+        keep(ContentEncoding::Gzip, gzip(bytes, options.gzipLevel));
+        keep(ContentEncoding::Brotli, brotli(bytes, options.brotliQuality));
+    });
+
+    variants_ = ::memfd_create("swiftui-serve", MFD_CLOEXEC);
+    if (variants_ < 0) throw std::system_error(errno, std::generic_category(), "memfd_create");
+    std::uint64_t variantOffset = 0;
+
+    assets_.reserve(sources.size());
+    for (Source& source : sources) {
+        StaticAsset asset;
+        if (source.generated != nullptr) {
+            writeAll(variants_, *source.generated);
+            asset.bodies[0] = {variants_, variantOffset, source.size};
+            variantOffset += source.size;
+        } else {
+            int fd = ::open(source.path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) throw std::system_error(errno, std::generic_category(), "open " + source.path.string());
+            files_.push_back(fd);
+            asset.bodies[0] = {fd, 0, source.size};
+        }
+        asset.id = std::uint32_t(assets_.size());
+        asset.path = std::move(source.sitePath);
+        asset.immutable = isContentHashedName(asset.path);
+        bytes_[0] += source.size;
+        for (std::size_t encoding = 1; encoding < std::size_t(ContentEncoding::Count); ++encoding) {
+            const std::string& bytes = source.compressed[encoding];
+            if (bytes.empty()) continue;
+            writeAll(variants_, bytes);
+            asset.bodies[encoding] = {variants_, variantOffset, bytes.size()};
+            variantOffset += bytes.size();
+            bytes_[encoding] += bytes.size();
+        }
+
+        char hash[17];
+        std::snprintf(hash, sizeof hash, "%016llx", static_cast<unsigned long long>(source.hash));
+        bool varies = asset.has(ContentEncoding::Gzip) || asset.has(ContentEncoding::Brotli);
+        std::string cacheControl =
+            asset.immutable ? "Cache-Control: public, max-age=31536000, immutable\r\n" : "Cache-Control: no-cache\r\n";
+        for (std::size_t encoding = 0; encoding < std::size_t(ContentEncoding::Count); ++encoding) {
+            if (asset.bodies[encoding].fd < 0) continue;
+            std::string& etag = asset.etags[encoding];
+            etag = "\"";
+            etag += hash;
+            etag += kEtagSuffixes[encoding];
+            etag += '"';
+
+            std::string common = cacheControl + "ETag: " + etag + "\r\n";
+            if (varies) common += "Vary: Accept-Encoding\r\n";
+            asset.notModified[encoding] = "HTTP/1.1 304 Not Modified\r\n" + common;
+
+            std::string& headers = asset.headers[encoding];
+            headers = "HTTP/1.1 200 OK\r\nContent-Type: ";
+            headers += source.type.mime;
+            headers += "\r\nContent-Length: " + std::to_string(asset.bodies[encoding].size) + "\r\n";
+            if (encoding != 0) {
+                headers += "Content-Encoding: ";
+                headers += kEncodingNames[encoding];
+                headers += "\r\n";
+            }
+            headers += common;
+        }
+        assets_.push_back(std::move(asset));
+    }
+
+    for (std::size_t index = 0; index < assets_.size(); ++index) {
+        const std::string& path = assets_[index].path;
+        byPath_.emplace(path, index);
+        // `/documentation/x/index.html`은 `/documentation/x`와 `/documentation/x/`로도 찾는다.
+        constexpr std::string_view kIndex = "/index.html";
+        if (path.size() >= kIndex.size() && path.compare(path.size() - kIndex.size(), kIndex.size(), kIndex) == 0) {
+            std::string directory = path.substr(0, path.size() - kIndex.size());
+            if (!directory.empty()) byPath_.emplace(aliases_.emplace_back(directory), index);
+            byPath_.emplace(aliases_.emplace_back(directory + "/"), index);
+        }
+    }
+}
+
+StaticSite::~StaticSite() {
+    for (int fd : files_) ::close(fd);
+    if (variants_ >= 0) ::close(variants_);
+}
+
+const StaticAsset* StaticSite::find(std::string_view path) const {
+    auto found = byPath_.find(path);
+    return found == byPath_.end() ? nullptr : &assets_[found->second];
+}
+
+const StaticAsset* StaticSite::resolve(std::string_view target) const {
+    target = target.substr(0, target.find_first_of("?#"));
+    if (target.empty() || target[0] != '/') return nullptr;
+    if (target.find('%') == std::string_view::npos) {
+        return target.find("..") == std::string_view::npos ? find(target) : nullptr;
+    }
+    std::string decoded;
+    decoded.reserve(target.size());
+    for (std::size_t i = 0; i < target.size(); ++i) {
+        if (target[i] == '%' && i + 2 < target.size() && hexValue(target[i + 1]) >= 0 &&
+            hexValue(target[i + 2]) >= 0) {
+            decoded += char(hexValue(target[i + 1]) * 16 + hexValue(target[i + 2]));
+            i += 2;
+        } else {
+            decoded += target[i];
+        }
+    }
+    if (decoded.find("..") != std::string::npos) return nullptr;
+    return find(decoded);
+}
+
+} // namespace manual
@@ -0,0 +1,94 @@
+//
+//  static_site.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace manual {
+
+class ThreadPool;
+
+enum class ContentEncoding : std::uint8_t { Identity, Gzip, Brotli, Count };
+
+/// 미리 압축해 둔 본문 하나. 파일 디스크립터에서 그대로 `sendfile` 한다.
+struct StaticBody {
+    int fd = -1;
+    std::uint64_t offset = 0;
+    std::uint64_t size = 0;
+};
+
+/// 사이트의 파일 하나와, 인코딩마다 미리 만든 응답 헤더.
+struct StaticAsset {
+    std::uint32_t id = 0;   // 사이트 안의 번호
+    std::string path;   // `/js/chunk-vendors.00bf82af.js`처럼 사이트 기준 경로
+    bool immutable = false;   // 이름에 내용 해시가 들어 있는 자산
+    StaticBody bodies[std::size_t(ContentEncoding::Count)];
+    /// 상태 줄부터 빈 줄 직전까지. 연결 헤더와 마지막 빈 줄은 보낼 때 붙인다.
+    std::string headers[std::size_t(ContentEncoding::Count)];
+    /// 인코딩마다 다른 ETag(따옴표 포함)와, 그것이 맞을 때 보낼 304 헤더.
+    std::string etags[std::size_t(ContentEncoding::Count)];
+    std::string notModified[std::size_t(ContentEncoding::Count)];
+
+    bool has(ContentEncoding encoding) const { return bodies[std::size_t(encoding)].fd >= 0; }
+};
+
+/// 디스크에 없이 시작할 때 만든 파일(사이드바 스냅숏 등). 본문은 memfd에 옮긴다.
+struct GeneratedFile {
+    std::string path;   // 사이트 기준 경로
+    std::string bytes;
+};
+
+/// `docs/` 번들 전체를 시작할 때 한 번 훑어, 파일마다 gzip과 brotli 본문을 미리 만들어 둔다.
+///
+/// 원본은 열어 둔 파일에서, 압축본은 memfd 하나에 이어 붙인 뒤 거기서 보낸다.
+/// 요청을 처리하는 동안에는 압축하지도 파일을 열지도 않는다.
+class StaticSite {
+public:
+    struct Options {
+        int gzipLevel = 9;
+        int brotliQuality = 11;
+        /// 압축본이 원본의 이 비율보다 크면 버린다.
+        double keepRatio = 0.9;
+    };
+
+    /// `root` 아래 파일을 모두 읽는다. `generated`는 같은 경로의 파일이 있으면 그것을 대신한다.
+    /// 실패하면 `std::system_error`를 던진다.
+    StaticSite(const std::string& root, const Options& options, ThreadPool& pool,
+               std::vector<GeneratedFile> generated = {});
+    ~StaticSite();
+
+    StaticSite(const StaticSite&) = delete;
+    StaticSite& operator=(const StaticSite&) = delete;
+
+    /// 요청 경로(질의 문자열 포함 가능)에 해당하는 자산. 디렉터리는 `index.html`로 찾는다. 없으면 `nullptr`.
+    const StaticAsset* resolve(std::string_view target) const;
+
+    std::size_t size() const { return assets_.size(); }
+    std::uint64_t bytes(ContentEncoding encoding) const { return bytes_[std::size_t(encoding)]; }
+
+private:
+    const StaticAsset* find(std::string_view path) const;
+
+    std::vector<StaticAsset> assets_;
+    std::unordered_map<std::string_view, std::size_t> byPath_;
+    std::deque<std::string> aliases_;   // 디렉터리 경로(`/documentation/x`, `/documentation/x/`)
+    std::vector<int> files_;
+    int variants_ = -1;   // 압축본을 담은 memfd
+    std::uint64_t bytes_[std::size_t(ContentEncoding::Count)] = {};
+};
+
+/// 이름에 `.00bf82af.`처럼 16진 8자리 내용 해시가 있는지.
+bool isContentHashedName(std::string_view path);
+
+/// `Accept-Encoding` 값에서 보낼 수 있는 가장 좋은 인코딩을 고른다.
+ContentEncoding negotiateEncoding(std::string_view acceptEncoding, const StaticAsset& asset);
+
+} // namespace manual
@@ -0,0 +1,68 @@
+//
+//  availability_index_test.cpp
+//  swiftUIManual tools
+//
+//  빌더로 만든 작은 가용성 인덱스를 읽고, 머리와 표를 한 곳씩 망가뜨려 모두 `std::runtime_error`로 끝나는지 본다.
+//
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "interface/availability_index.h"
+#include "tests/check.h"
+
+namespace {
+
+template <class T>
+void store(std::string& bytes, std::size_t at, T value) {
+    std::memcpy(&bytes[at], &value, sizeof value);
+}
+
+manual::Availability introducedOn(manual::Platform platform, const char* version) {
+    manual::Availability availability;
+    availability.entry(platform).introduced = manual::Version::parse(version);
+    return availability;
+}
+
+} // namespace
+
+MANUAL_TEST_SUITE(availability_index) {
+    using manual::AvailabilityIndex;
+    using manual::Platform;
+    manual::AvailabilityIndexBuilder builder;
+    builder.add("View", introducedOn(Platform::iOS, "13.0"));
+    builder.add("Grid", introducedOn(Platform::iOS, "16.0"));
+    std::string bytes = builder.serialize();
+
+    AvailabilityIndex index(bytes);
+    CHECK(index.rowCount() == 2 && index.wordCount() == 1);
+    CHECK(index.name(1) == "Grid");
+    CHECK(index.versions(Platform::iOS).size() == 3);
+    CHECK(index.version(Platform::iOS, 2) == manual::Version::parse("16.0"));
+    CHECK(index.availableAt(Platform::iOS, manual::Version::parse("15.0"))[0] == 0b01);
+    CHECK_MALFORMED(index.version(Platform::iOS, 3));
+    CHECK_MALFORMED(index.version(Platform::macOS, 1));
+
+    // 머리 64바이트 바로 뒤가 버전 경계다. 파일 끝은 이름 위치 3개(8바이트로 맞춤)와 이름 8바이트다.
+    const std::size_t versions = 64;
+    const std::size_t nameOffsets = bytes.size() - 16 - 8;
+    auto corrupt = [&](std::size_t at, auto value) {
+        std::string copy = bytes;
+        store(copy, at, value);
+        return copy;
+    };
+    CHECK_MALFORMED(AvailabilityIndex(std::string_view(bytes).substr(0, 60)));
+    CHECK_MALFORMED(AvailabilityIndex(std::string_view(bytes).substr(0, bytes.size() - 8)));
+    CHECK_MALFORMED(AvailabilityIndex(corrupt(0, 'X')));                                        // 마법 수
+    CHECK_MALFORMED(AvailabilityIndex(corrupt(8, std::uint32_t(0x7FFFFFFF))));                  // 행 수
+    CHECK_MALFORMED(AvailabilityIndex(corrupt(44, std::uint32_t(0))));                          // 버전 없는 플랫폼
+    CHECK_MALFORMED(AvailabilityIndex(corrupt(44, std::uint32_t(300))));                        // 한 바이트를 넘는 버전 수
+    // 시작 + 개수가 32비트에서 넘쳐 작은 값이 되는 경우.
+    std::string wrapped = corrupt(24 + 4, std::uint32_t(0xFFFFFFFF));
+    CHECK_MALFORMED(AvailabilityIndex(wrapped));
+    CHECK_MALFORMED(AvailabilityIndex(corrupt(versions, std::uint64_t(1))));                    // 첫 경계가 0.0이 아님
+    CHECK_MALFORMED(AvailabilityIndex(corrupt(nameOffsets + 4, std::uint32_t(9))));             // 이름 위치가 거꾸로 간다
+    CHECK_MALFORMED(AvailabilityIndex(corrupt(nameOffsets + 8, std::uint32_t(7))));             // 끝이 이름 바이트 수와 다르다
+}
@@ -0,0 +1,94 @@
+//
+//  bplist_test.cpp
+//  swiftUIManual tools
+//
+//  손으로 만든 작은 `bplist00`을 읽고, 한 곳씩 망가뜨려 모두 `std::runtime_error`로 끝나는지 본다.
+//
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "common/bplist.h"
+#include "tests/check.h"
+
+namespace {
+
+/// 객체들을 차례로 이어 쓴 `bplist00`. 맨 위 객체는 0번이고, 객체 번호와 위치를 1바이트로 쓴다.
+std::string makePlist(const std::vector<std::string>& objects) {
+    std::string bytes = "bplist00";
+    std::vector<std::size_t> offsets;
+    for (const std::string& object : objects) {
+        offsets.push_back(bytes.size());
+        bytes += object;
+    }
+    std::size_t table = bytes.size();
+    for (std::size_t offset : offsets) bytes += char(offset);
+    std::string trailer(32, '\0');
+    trailer[6] = 1;   // 위치 크기
+    trailer[7] = 1;   // 객체 번호 크기
+    trailer[15] = char(offsets.size());
+    trailer[31] = char(table);
+    return bytes + trailer;
+}
+
+/// `{"a": 1, "b": [true, "xy"]}`. 객체는 8, 13, 15, 17, 19, 22, 23바이트에서 시작한다.
+std::string samplePlist() {
+    return makePlist({
+        {'\xD2', 1, 2, 3, 4},   // 딕셔너리, 키 1·2, 값 3·4
+        "\x51" "a",
+        "\x51" "b",
+        {'\x10', 1},
+        {'\xA2', 5, 6},
+        "\x09",
+        "\x52" "xy",
+    });
+}
+
+} // namespace
+
+MANUAL_TEST_SUITE(bplist) {
+    std::string bytes = samplePlist();
+    manual::PlistValue root = manual::parseBinaryPlist(bytes);
+    CHECK(root.isDict() && root.dict.size() == 2);
+    CHECK(root.get("a") != nullptr && root.get("a")->integer == 1);
+    const manual::PlistValue* list = root.get("b");
+    CHECK(list != nullptr && list->isArray() && list->array.size() == 2);
+    if (list != nullptr && list->array.size() == 2) {
+        CHECK(list->array[0].type == manual::PlistValue::Type::Bool && list->array[0].boolean);
+        CHECK(list->array[1].string == "xy");
+    }
+
+    std::size_t trailer = bytes.size() - 32;
+    auto corrupt = [&](std::size_t at, int byte) {
+        std::string copy = bytes;
+        copy[at] = char(byte);
+        return copy;
+    };
+    CHECK_MALFORMED(manual::parseBinaryPlist(""));
+    CHECK_MALFORMED(manual::parseBinaryPlist(bytes.substr(0, bytes.size() - 1)));
+    CHECK_MALFORMED(manual::parseBinaryPlist(corrupt(0, 'x')));                  // 머리
+    CHECK_MALFORMED(manual::parseBinaryPlist(corrupt(trailer + 6, 0)));          // 위치 크기 0
+    CHECK_MALFORMED(manual::parseBinaryPlist(corrupt(trailer + 23, 7)));         // 맨 위 객체가 범위 밖
+    CHECK_MALFORMED(manual::parseBinaryPlist(corrupt(trailer + 31, 0xF0)));      // 위치 표가 범위 밖
+    CHECK_MALFORMED(manual::parseBinaryPlist(corrupt(9, 3)));      // 키가 문자열이 아니다
+    CHECK_MALFORMED(manual::parseBinaryPlist(corrupt(11, 9)));     // 없는 객체 번호
+    CHECK_MALFORMED(manual::parseBinaryPlist(corrupt(20, 0)));     // 배열이 딕셔너리를 가리켜 끝없이 순환한다
+    CHECK_MALFORMED(manual::parseBinaryPlist(corrupt(22, 0x70)));  // 모르는 객체 종류
+    CHECK_MALFORMED(manual::parseBinaryPlist(corrupt(23, 0x5F)));  // 길이 표식 뒤가 정수가 아니다
+
+    // 길이가 2^64 - 1에 가까운 문자열·UTF-16 문자열·배열. 범위 검사가 덧셈이나 곱셈으로 넘쳐서는 안 된다.
+    const std::string huge = "\x13\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF";
+    CHECK_MALFORMED(manual::parseBinaryPlist(makePlist({"\x5F" + huge})));
+    CHECK_MALFORMED(manual::parseBinaryPlist(makePlist({"\x6F" + huge})));
+    CHECK_MALFORMED(manual::parseBinaryPlist(makePlist({"\xAF" + huge})));
+    CHECK_MALFORMED(manual::parseBinaryPlist(makePlist({"\xDF" + huge})));
+    CHECK_MALFORMED(manual::parseBinaryPlist(makePlist({std::string("\x5F\x1F", 2)})));   // 길이 정수가 파일 밖
+
+    // 배열마다 다음 배열을 두 번 가리킨다. 깊이는 40뿐이지만 펼치면 2^40개다.
+    std::vector<std::string> doubling;
+    for (char next = 1; next <= 40; ++next) doubling.push_back({'\xA2', next, next});
+    doubling.push_back("\x09");
+    CHECK_MALFORMED(manual::parseBinaryPlist(makePlist(doubling)));
+}
+
@@ -0,0 +1,44 @@
+//
+//  check.h
+//  swiftUIManual tools
+//
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+namespace manual::test {
+
+/// 실패 하나를 위치와 함께 알리고 센다. 검사는 실패해도 멈추지 않고 묶음 끝까지 돈다.
+void fail(const char* file, int line, const std::string& what);
+
+/// 이름 붙은 검사 묶음. `ctest`는 묶음마다 실행 파일을 따로 부른다.
+struct Suite {
+    Suite(const char* name, void (*run)());
+};
+
+} // namespace manual::test
+
+#define MANUAL_TEST_SUITE(name)                                                   \
+    static void name##Suite();                                                    \
+    static const manual::test::Suite name##Registration(#name, name##Suite);      \
+    static void name##Suite()
+
+#define CHECK(condition)                                                          \
+    do {                                                                          \
+        if (!(condition)) manual::test::fail(__FILE__, __LINE__, #condition);     \
+    } while (0)
+
+/// 식 `statement`가 `std::runtime_error`를 던져야 한다. 다른 예외나 정상 종료는 실패다.
+#define CHECK_MALFORMED(statement)                                                \
+    do {                                                                          \
+        bool thrown = false;                                                      \
+        try {                                                                     \
+            static_cast<void>(statement);                                         \
+        } catch (const std::runtime_error&) {                                     \
+            thrown = true;                                                        \
+        } catch (...) {                                                           \
+        }                                                                         \
+        if (!thrown) manual::test::fail(__FILE__, __LINE__, "no runtime_error from " #statement); \
+    } while (0)
@@ -0,0 +1,53 @@
+//
+//  grid_layout_test.cpp
+//  swiftUIManual tools
+//
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "layout/grid_layout.h"
+#include "tests/check.h"
+
+namespace {
+
+bool near(double a, double b) { return std::abs(a - b) < 1e-9; }
+
+} // namespace
+
+MANUAL_TEST_SUITE(grid_solver) {
+    // 이미지 칸은 폭이 곧 이상적인 폭이라 열 폭을 손으로 셀 수 있다.
+    manual::GridSolver grid;
+    grid.addRow();
+    grid.addImage({20, 10});
+    grid.addImage({30, 10});
+    grid.addImage({10, 10});
+    grid.addRow();
+    std::uint32_t wide = grid.addImage({100, 10}, 2);   // 20 + 8 + 30 = 58이라 42가 모자란다
+    grid.addImage({12, 10});
+    manual::Size size = grid.place({manual::ProposedViewSize::kUnspecified, manual::ProposedViewSize::kUnspecified});
+    const std::vector<double>& widths = grid.columnWidths();
+    CHECK(widths.size() == 3);
+    if (widths.size() != 3) return;
+    CHECK(near(widths[0], 41) && near(widths[1], 51) && near(widths[2], 12));
+    CHECK(near(size.width, 41 + 8 + 51 + 8 + 12));
+    CHECK(near(grid.frame(wide).minX(), 0));
+    CHECK(near(grid.frame(wide).size.width, 100));
+
+    // 좁은 걸침부터 반영한다. 두 열 걸침이 먼저 넓힌 열 위에서 세 열 걸침의 모자람을 센다.
+    manual::GridSolver nested;
+    nested.addRow();
+    for (int i = 0; i < 3; ++i) nested.addImage({10, 10});
+    nested.addRow();
+    nested.addImage({190, 10}, 3);   // 2단계: (50 + 8 + 50 + 8 + 10) = 126, 64 모자라 열마다 +64/3
+    nested.addRow();
+    nested.addImage({108, 10}, 2);   // 1단계: 10 + 8 + 10 = 28, 80 모자라 열마다 +40
+    nested.place({manual::ProposedViewSize::kUnspecified, manual::ProposedViewSize::kUnspecified});
+    const std::vector<double>& spans = nested.columnWidths();
+    CHECK(spans.size() == 3);
+    if (spans.size() == 3) {
+        CHECK(near(spans[0], 50 + 64.0 / 3) && near(spans[1], 50 + 64.0 / 3) && near(spans[2], 10 + 64.0 / 3));
+        CHECK(near(spans[0] + spans[1] + spans[2] + 16, 190));
+    }
+}
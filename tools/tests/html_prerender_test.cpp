@@ -0,0 +1,47 @@
+//
+//  html_prerender_test.cpp
+//  swiftUIManual tools
+//
+
+#include <string>
+#include <string_view>
+
+#include "bundle/html_prerender.h"
+#include "common/arena.h"
+#include "common/json.h"
+#include "tests/check.h"
+
+namespace {
+
+/// 요약에 `link` 인라인 하나만 있는 페이지를 렌더링한다.
+std::string renderLink(std::string_view destination) {
+    std::string json = R"({"abstract":[{"type":"link","title":"here","destination":")" + std::string(destination) + R"("}]})";
+    manual::Arena arena(1 << 12);
+    manual::JsonValue root = manual::parseJson(json, arena);
+    manual::HtmlPageRenderer renderer("/swiftui/");
+    std::string out;
+    renderer.render(root, out);
+    return out;
+}
+
+bool linked(std::string_view destination) { return renderLink(destination).find("<a href=") != std::string::npos; }
+
+} // namespace
+
+MANUAL_TEST_SUITE(html_prerender) {
+    CHECK(linked("https://developer.apple.com/swiftui/"));
+    CHECK(linked("HTTP://example.com"));
+    CHECK(linked("mailto:someone@example.com"));
+    CHECK(linked("/documentation/swiftui/view"));
+    CHECK(linked("../view#overview"));
+    CHECK(linked("view?a=b:c"));
+    CHECK(!linked("javascript:alert(1)"));
+    CHECK(!linked("JavaScript:alert(1)"));
+    CHECK(!linked(" javascript:alert(1)"));
+    CHECK(!linked("java\\tscript:alert(1)"));
+    CHECK(!linked("data:text/html,<script>"));
+    CHECK(!linked("vbscript:x"));
+
+    std::string text = renderLink("javascript:alert(1)");
+    CHECK(text.find("here") != std::string::npos);
+}
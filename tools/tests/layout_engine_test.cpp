@@ -0,0 +1,110 @@
+//
+//  layout_engine_test.cpp
+//  swiftUIManual tools
+//
+
+#include <cstdint>
+#include <vector>
+
+#include "layout/layout.h"
+#include "layout/layout_engine.h"
+#include "layout/page_layout.h"
+#include "tests/check.h"
+
+namespace {
+
+bool sameFrames(const manual::LayoutEngine& a, const manual::LayoutEngine& b, std::size_t nodes) {
+    for (std::uint32_t node = 0; node < nodes; ++node) {
+        manual::Rect x = a.frame(node), y = b.frame(node);
+        if (x.minX() != y.minX() || x.minY() != y.minY() || x.size.width != y.size.width ||
+            x.size.height != y.size.height) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+MANUAL_TEST_SUITE(incremental_layout) {
+    // 잎을 하나씩 바꾼 증분 패스의 프레임이 매번 처음부터 배치한 프레임과 같아야 한다.
+    manual::LayoutTree tree;
+    std::uint32_t root = manual::buildSyntheticLayout(3000, tree);
+    std::vector<std::uint32_t> texts, images, spacers;
+    for (std::uint32_t node = 0; node < tree.size(); ++node) {
+        switch (tree.kind(node)) {
+        case manual::LayoutTree::NodeKind::Text: texts.push_back(node); break;
+        case manual::LayoutTree::NodeKind::Image: images.push_back(node); break;
+        case manual::LayoutTree::NodeKind::Spacer: spacers.push_back(node); break;
+        default: break;
+        }
+    }
+    CHECK(!texts.empty() && !images.empty());
+    if (texts.empty() || images.empty()) return;
+
+    manual::ProposedViewSize proposal{800, manual::ProposedViewSize::kUnspecified};
+    manual::LayoutEngine engine(tree);
+    engine.layout(root, proposal);
+    std::uint64_t state = 3;
+    for (int edit = 0; edit < 200; ++edit) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        std::uint64_t pick = state >> 33;
+        switch (edit % 4) {
+        case 0:
+        case 1: tree.setText(texts[pick % texts.size()], std::uint32_t(1 + (state >> 20) % 160)); break;
+        case 2: tree.setImageSize(images[pick % images.size()], {double(8 + pick % 40), double(8 + pick % 30)}); break;
+        case 3: tree.setPriority(texts[pick % texts.size()], double(pick % 3)); break;
+        }
+        // 폭도 가끔 바꿔 기억한 제안이 달라지는 경로를 지나게 한다.
+        if (edit % 25 == 24) proposal.width = proposal.width == 800 ? 640 : 800;
+        engine.layout(root, proposal);
+        if (edit % 20 != 19) continue;
+        manual::LayoutEngine fresh(tree);
+        fresh.layout(root, proposal);
+        CHECK(sameFrames(engine, fresh, tree.size()));
+    }
+
+    // 기억을 끈 엔진도 같은 결과를 낸다.
+    manual::LayoutEngine plain(tree);
+    plain.setMemoization(false);
+    plain.layout(root, proposal);
+    CHECK(sameFrames(engine, plain, tree.size()));
+
+    // 하위 트리의 배치 객체를 바꾸면(`frame` 값이 바뀐 경우) 그 아래 자식 위치를 모두 다시 놓아야 한다.
+    // 폭을 자주 바꿔 기억을 덮어쓴 노드(`kEvicted`)도 지나게 한다.
+    std::vector<std::uint32_t> containers, singles;
+    for (std::uint32_t node = 0; node < tree.size(); ++node) {
+        if (node == root || tree.kind(node) != manual::LayoutTree::NodeKind::Container) continue;
+        std::uint32_t child = tree.firstChild(node);
+        if (child == manual::LayoutTree::kNoNode) continue;
+        (tree.nextSibling(child) == manual::LayoutTree::kNoNode ? singles : containers).push_back(node);
+    }
+    CHECK(!containers.empty() && !singles.empty());
+    if (containers.empty() || singles.empty()) return;
+    const std::uint32_t stacks[] = {
+        tree.makeLayout<manual::HStackLayout>(manual::VerticalAlignment::Center, 4),
+        tree.makeLayout<manual::VStackLayout>(manual::HorizontalAlignment::Trailing, 10),
+        tree.makeLayout<manual::ZStackLayout>(),
+    };
+    const std::uint32_t frames[] = {
+        tree.makeLayout<manual::FrameLayout>(240, manual::ProposedViewSize::kUnspecified),
+        tree.makeLayout<manual::FrameLayout>(manual::ProposedViewSize::kUnspecified, 60),
+        tree.makeLayout<manual::PaddingLayout>(manual::EdgeInsets{4, 30, 4, 30}),
+    };
+    for (int edit = 0; edit < 120; ++edit) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        std::uint64_t pick = state >> 33;
+        if (edit % 2 == 0) {
+            tree.setLayout(containers[pick % containers.size()], stacks[(state >> 20) % 3]);
+        } else {
+            tree.setLayout(singles[pick % singles.size()], frames[(state >> 20) % 3]);
+        }
+        if (edit % 3 == 2) tree.setText(texts[pick % texts.size()], std::uint32_t(1 + (state >> 24) % 160));
+        if (edit % 7 == 6) proposal.width = proposal.width == 800 ? 520 : 800;
+        engine.layout(root, proposal);
+        if (edit % 10 != 9) continue;
+        manual::LayoutEngine fresh(tree);
+        fresh.layout(root, proposal);
+        CHECK(sameFrames(engine, fresh, tree.size()));
+    }
+}
@@ -0,0 +1,33 @@
+//
+//  lazy_grid_test.cpp
+//  swiftUIManual tools
+//
+
+#include <vector>
+
+#include "layout/lazy_grid.h"
+#include "tests/check.h"
+
+MANUAL_TEST_SUITE(lazy_grid) {
+    // 트랙 폭이 다른 정사각형 칸은 행 안에서 항목 정렬대로, 트랙 묶음은 교차축 정렬대로 놓인다.
+    std::vector<manual::GridItem> items = {manual::GridItem::fixed(40), manual::GridItem::fixed(100)};
+    items[0].alignment = manual::Alignment{manual::HorizontalAlignment::Center, manual::VerticalAlignment::Bottom};
+    manual::LazyGrid grid(manual::Axis::Vertical, items, manual::ProposedViewSize::kUnspecified,
+                          manual::Alignment{manual::HorizontalAlignment::Leading, manual::VerticalAlignment::Top});
+    grid.setSections({manual::LazyGridSection{4, 0, 0}});
+    grid.resolve(300);
+    CHECK(grid.tracks().size() == 2);
+    manual::LazyGridWindow window;
+    grid.visibleWindow(0, 1000, 0, window);
+    CHECK(window.cells.size() == 4);
+    if (window.cells.size() != 4) return;
+    CHECK(window.cells[0].frame.minX() == 0 && window.cells[0].frame.minY() == 60);
+    CHECK(window.cells[0].frame.size.width == 40 && window.cells[0].frame.size.height == 40);
+    CHECK(window.cells[1].frame.minX() == 48 && window.cells[1].frame.minY() == 0);
+    CHECK(window.cells[2].frame.minY() == 108 + 60);
+
+    manual::LazyGrid rows(manual::Axis::Horizontal, {manual::GridItem::fixed(50)}, manual::ProposedViewSize::kUnspecified,
+                          manual::Alignment{manual::HorizontalAlignment::Leading, manual::VerticalAlignment::Bottom});
+    rows.resolve(200);
+    CHECK(rows.tracks().size() == 1 && rows.tracks()[0].offset == 150);
+}
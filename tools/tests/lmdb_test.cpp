@@ -0,0 +1,183 @@
+//
+//  lmdb_test.cpp
+//  swiftUIManual tools
+//
+//  메타 페이지 둘과 잎 페이지 하나로 된 `data.mdb`를 만들어 찾아보고, 한 곳씩 망가뜨려 모두 `std::runtime_error`로
+//  끝나는지 본다.
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "bundle/lmdb.h"
+#include "tests/check.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+template <class T>
+void store(std::string& bytes, std::size_t at, T value) {
+    std::memcpy(&bytes[at], &value, sizeof value);
+}
+
+constexpr std::size_t kPageSize = 4096;
+
+/// 메타 페이지 둘과 잎 페이지 하나(2번)로 된 `data.mdb`. 잎에는 정렬한 `entries`가 들어간다.
+std::string sampleLmdb(const std::vector<std::pair<std::string, std::string>>& entries) {
+    std::string bytes(kPageSize * 3, '\0');
+    for (std::uint64_t number = 0; number < 2; ++number) {
+        std::size_t page = number * kPageSize;
+        store<std::uint64_t>(bytes, page, number);
+        store<std::uint16_t>(bytes, page + 10, 0x08);
+        store<std::uint32_t>(bytes, page + 16, 0xBEEFC0DE);
+        store<std::uint32_t>(bytes, page + 20, 1);
+        store<std::uint32_t>(bytes, page + 40, std::uint32_t(kPageSize));    // FREE_DBI의 md_pad
+        store<std::uint64_t>(bytes, page + 40 + 40, ~std::uint64_t(0));     // FREE_DBI 루트 없음
+        store<std::uint16_t>(bytes, page + 88 + 6, 1);                      // MAIN_DBI 깊이
+        store<std::uint64_t>(bytes, page + 88 + 32, entries.size());
+        store<std::uint64_t>(bytes, page + 88 + 40, 2);                     // MAIN_DBI 루트
+        store<std::uint64_t>(bytes, page + 144, number + 1);                // 트랜잭션 번호
+    }
+    std::size_t leaf = 2 * kPageSize;
+    store<std::uint64_t>(bytes, leaf, 2);
+    store<std::uint16_t>(bytes, leaf + 10, 0x02);
+    store<std::uint16_t>(bytes, leaf + 12, std::uint16_t(16 + 2 * entries.size()));
+    std::size_t at = 256;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        const auto& [key, value] = entries[i];
+        store<std::uint16_t>(bytes, leaf + 16 + 2 * i, std::uint16_t(at));
+        store<std::uint16_t>(bytes, leaf + at, std::uint16_t(value.size()));
+        store<std::uint16_t>(bytes, leaf + at + 6, std::uint16_t(key.size()));
+        bytes.replace(leaf + at + 8, key.size(), key);
+        bytes.replace(leaf + at + 8 + key.size(), value.size(), value);
+        at += 8 + key.size() + value.size();
+    }
+    return bytes;
+}
+
+/// 바이트를 임시 파일에 써서 연다. `LmdbEnvironment`는 경로로만 연다.
+class TemporaryFile {
+public:
+    explicit TemporaryFile(const std::string& bytes)
+        : path_(fs::temp_directory_path() / ("manual-tests-" + std::to_string(::getpid()) + ".mdb")) {
+        std::FILE* file = std::fopen(path_.c_str(), "wb");
+        if (file == nullptr) throw std::runtime_error("cannot write " + path_.string());
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+    }
+    ~TemporaryFile() {
+        std::error_code ignored;
+        fs::remove(path_, ignored);
+    }
+    std::string path() const { return path_.string(); }
+
+private:
+    fs::path path_;
+};
+
+/// 환경을 열고 `key`를 찾는다. 망가진 곳에 따라 여는 중에도, 찾는 중에도 던질 수 있다.
+std::string lookup(const std::string& bytes, std::string_view key) {
+    TemporaryFile file(bytes);
+    manual::LmdbEnvironment environment(file.path());
+    manual::LmdbTransaction transaction = environment.begin();
+    std::string_view value;
+    if (!transaction.get(transaction.main(), key, value)) return "<missing>";
+    return std::string(value);
+}
+
+/// 환경을 열고 주 데이터베이스의 항목 수를 센다.
+std::size_t count(const std::string& bytes) {
+    TemporaryFile file(bytes);
+    manual::LmdbEnvironment environment(file.path());
+    manual::LmdbTransaction transaction = environment.begin();
+    std::size_t entries = 0;
+    transaction.forEach(transaction.main(), [&](std::string_view, std::string_view) { ++entries; });
+    return entries;
+}
+
+} // namespace
+
+MANUAL_TEST_SUITE(lmdb) {
+    std::vector<std::pair<std::string, std::string>> entries = {{"alpha", "1"}, {"beta", "two"}, {"gamma", "three"}};
+    std::string bytes = sampleLmdb(entries);
+    CHECK(lookup(bytes, "beta") == "two");
+    CHECK(lookup(bytes, "gamma") == "three");
+    CHECK(lookup(bytes, "delta") == "<missing>");
+    CHECK(count(bytes) == entries.size());
+
+    std::size_t leaf = 2 * kPageSize;
+    auto corrupt = [&](std::size_t at, auto value) {
+        std::string copy = bytes;
+        store(copy, at, value);
+        return copy;
+    };
+    CHECK_MALFORMED(lookup(bytes.substr(0, 100), "beta"));
+    CHECK_MALFORMED(lookup(bytes.substr(0, kPageSize), "beta"));                          // 메타 페이지 하나
+    CHECK_MALFORMED(lookup(corrupt(40, std::uint32_t(1000)), "beta"));                    // 페이지 크기
+    std::string noMeta = corrupt(16, std::uint32_t(0));
+    store(noMeta, kPageSize + 16, std::uint32_t(0));
+    CHECK_MALFORMED(lookup(noMeta, "beta"));                                               // 맞는 메타가 없다
+    std::string farRoot = corrupt(88 + 40, std::uint64_t(99));
+    store(farRoot, kPageSize + 88 + 40, std::uint64_t(99));
+    CHECK_MALFORMED(lookup(farRoot, "beta"));                                              // 루트가 파일 밖
+    CHECK_MALFORMED(lookup(corrupt(leaf + 10, std::uint16_t(0x04)), "beta"));             // 잎이 아닌 페이지
+    CHECK_MALFORMED(lookup(corrupt(leaf + 12, std::uint16_t(kPageSize + 2)), "beta"));    // 노드 수가 페이지 밖
+    CHECK_MALFORMED(lookup(corrupt(leaf + 18, std::uint16_t(kPageSize - 4)), "beta"));    // 노드가 페이지 끝에 걸친다
+    std::string longKey = corrupt(leaf + 16, std::uint16_t(kPageSize - 9));
+    store(longKey, leaf + kPageSize - 9 + 6, std::uint16_t(5));
+    CHECK_MALFORMED(lookup(longKey, "alpha"));                                             // 키가 페이지 끝을 넘는다
+
+    // 값 크기가 페이지를 넘는다.
+    std::size_t beta = 256 + 8 + 5 + 1;
+    CHECK_MALFORMED(lookup(corrupt(leaf + beta, std::uint16_t(kPageSize)), "beta"));
+
+    // 큰 값 노드인데 오버플로 페이지 번호 8바이트가 페이지 끝을 넘는다.
+    std::string overflow = bytes;
+    std::size_t last = kPageSize - 8 - 4;
+    store(overflow, leaf + 16 + 2 * 2, std::uint16_t(last));
+    store(overflow, leaf + last, std::uint16_t(100));
+    store(overflow, leaf + last + 4, std::uint16_t(0x01));
+    store(overflow, leaf + last + 6, std::uint16_t(4));
+    overflow.replace(leaf + last + 8, 4, "zeta");
+    CHECK_MALFORMED(lookup(overflow, "zeta"));
+    // 번호는 들어오지만 가리키는 페이지가 오버플로 페이지가 아니다.
+    std::string wrongKind = bytes;
+    std::size_t big = 2048;
+    store(wrongKind, leaf + 16 + 2 * 2, std::uint16_t(big));
+    store(wrongKind, leaf + big, std::uint16_t(100));
+    store(wrongKind, leaf + big + 4, std::uint16_t(0x01));
+    store(wrongKind, leaf + big + 6, std::uint16_t(4));
+    wrongKind.replace(leaf + big + 8, 4, "zeta");
+    store(wrongKind, leaf + big + 12, std::uint64_t(2));
+    CHECK_MALFORMED(lookup(wrongKind, "zeta"));
+
+    // 트리 깊이가 상한을 넘는다.
+    std::string deep = corrupt(88 + 6, std::uint16_t(65));
+    store(deep, kPageSize + 88 + 6, std::uint16_t(65));
+    CHECK_MALFORMED(count(deep));
+    // 가지 페이지(3번)의 두 노드가 모두 자기 자신을 가리킨다. 깊이 40이면 펼쳐서 2^40 페이지가 된다.
+    std::string loop = bytes + std::string(kPageSize, '\0');
+    std::size_t branch = 3 * kPageSize;
+    store(loop, branch, std::uint64_t(3));
+    store(loop, branch + 10, std::uint16_t(0x01));
+    store(loop, branch + 12, std::uint16_t(16 + 2 * 2));
+    for (std::size_t i = 0; i < 2; ++i) {
+        store(loop, branch + 16 + 2 * i, std::uint16_t(256 + 8 * i));
+        store(loop, branch + 256 + 8 * i, std::uint16_t(3));
+    }
+    for (std::size_t meta = 0; meta < 2; ++meta) {
+        store(loop, meta * kPageSize + 88 + 6, std::uint16_t(40));
+        store(loop, meta * kPageSize + 88 + 40, std::uint64_t(3));
+    }
+    CHECK_MALFORMED(count(loop));
+}
@@ -0,0 +1,85 @@
+//
+//  navigator_test.cpp
+//  swiftUIManual tools
+//
+//  손으로 만든 작은 `navigator.index`를 읽고, 한 곳씩 망가뜨려 모두 `std::runtime_error`로 끝나는지 본다.
+//
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bundle/navigator_index.h"
+#include "tests/check.h"
+
+namespace {
+
+template <class T>
+void store(std::string& bytes, std::size_t at, T value) {
+    std::memcpy(&bytes[at], &value, sizeof value);
+}
+
+void appendRecord(std::string& bytes, std::uint32_t parent, std::uint8_t type, std::string_view title,
+                  std::string_view path) {
+    std::string record(8 + 34, '\0');
+    store<std::uint32_t>(record, 0, parent);
+    store<std::uint32_t>(record, 4, std::uint32_t(34 + title.size() + path.size()));
+    record[8] = char(type);
+    store<std::uint64_t>(record, 8 + 18, title.size());
+    store<std::uint64_t>(record, 8 + 26, path.size());
+    bytes += record;
+    bytes += title;
+    bytes += path;
+}
+
+std::string sampleNavigator() {
+    std::string bytes;
+    appendRecord(bytes, 0, 0, "SwiftUI", "/documentation/swiftui");
+    appendRecord(bytes, 0, 22, "View", "/documentation/swiftui/view");
+    appendRecord(bytes, 0, 21, "Text", "/documentation/swiftui/text");
+    appendRecord(bytes, 1, 35, "body", "/documentation/swiftui/view/body");
+    return bytes;
+}
+
+} // namespace
+
+MANUAL_TEST_SUITE(navigator) {
+    std::string bytes = sampleNavigator();
+    manual::NavigatorIndex index(bytes);
+    CHECK(index.size() == 4);
+    std::uint32_t view = index.find("/documentation/swiftui/view");
+    CHECK(view == 1);
+    CHECK(index.find("/documentation/swiftui/missing") == manual::kNoNode);
+    std::vector<std::uint32_t> children;
+    for (std::uint32_t child : index.children(0)) children.push_back(child);
+    CHECK((children == std::vector<std::uint32_t>{1, 2}));
+    CHECK(index[3].parent == 1 && index[3].title == "body");
+
+    std::size_t second = 8 + 34 + 7 + 22;   // 두 번째 레코드 시작
+    auto corrupt = [&](std::size_t at, auto value) {
+        std::string copy = bytes;
+        store(copy, at, value);
+        return copy;
+    };
+    CHECK_MALFORMED(manual::NavigatorIndex(std::string_view()));
+    CHECK_MALFORMED(manual::NavigatorIndex(std::string_view(bytes).substr(0, bytes.size() - 1)));
+    CHECK_MALFORMED(manual::NavigatorIndex(std::string_view(bytes).substr(0, 20)));
+    CHECK_MALFORMED(manual::NavigatorIndex(corrupt(second, std::uint32_t(1))));                  // 부모가 자기 자신
+    CHECK_MALFORMED(manual::NavigatorIndex(corrupt(second, std::uint32_t(7))));                  // 부모가 뒤에 나온다
+    CHECK_MALFORMED(manual::NavigatorIndex(corrupt(4, std::uint32_t(0xFFFFFFF0))));              // 레코드 길이
+    CHECK_MALFORMED(manual::NavigatorIndex(corrupt(8 + 18, std::uint64_t(8))));                 // 제목 + 경로 ≠ 길이
+    // 제목 길이와 경로 길이의 합이 넘쳐 레코드 길이와 같아지는 경우.
+    std::string wrapped = corrupt(8 + 18, std::uint64_t(0) - 1);
+    store(wrapped, 8 + 26, std::uint64_t(7 + 22 + 1));
+    CHECK_MALFORMED(manual::NavigatorIndex(wrapped));
+
+    // 노드마다 앞 노드의 자식인 100단계 사슬. 읽기는 되지만 JSON으로 쓰면 깊이 상한에 걸린다.
+    std::string chain;
+    for (std::uint32_t node = 0; node < 100; ++node) appendRecord(chain, node == 0 ? 0 : node - 1, 22, "n", "/n");
+    manual::NavigatorIndex deep(chain);
+    std::string json;
+    CHECK_MALFORMED(deep.renderIndexJson(json));
+    CHECK_MALFORMED(deep.appendNodeJson(1, json));
+}
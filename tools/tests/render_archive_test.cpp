@@ -0,0 +1,119 @@
+//
+//  render_archive_test.cpp
+//  swiftUIManual tools
+//
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "bundle/render_archive.h"
+#include "tests/check.h"
+
+namespace {
+
+// 선언 토큰 조각이 두 문서에 겹치고, 숫자 원문·값에서만 이스케이프한 `/`·한글·키 순서가 다른 객체가 섞인 렌더 JSON.
+constexpr std::string_view kDocuments[][2] = {
+    {"documentation/swiftui/view",
+     R"({"schemaVersion":{"major":0,"minor":3,"patch":0},"identifier":{"url":"doc:\/\/com.apple.SwiftUI\/documentation\/SwiftUI\/View","interfaceLanguage":"swift"},)"
+     R"("abstract":[{"type":"text","text":"뷰를 나타내는 형식."},{"type":"code","code":"body"}],)"
+     R"("primaryContentSections":[{"kind":"declarations","declarations":[{"tokens":[{"kind":"keyword","text":"protocol"},{"kind":"text","text":" "},)"
+     R"({"kind":"identifier","text":"View"}],"languages":["swift"],"platforms":["iOS","macOS"]}]},{"kind":"content","content":[]}],)"
+     R"("metadata":{"title":"View","role":"symbol","platforms":[{"introducedAt":"13.0","name":"iOS","beta":false}]},)"
+     R"("references":{"doc://a":{"title":"Text","type":"topic","identifier":"doc:\/\/a","deprecated":true},"weird":{"type":"image","variants":[]}},)"
+     R"("hierarchy":{"paths":[[]]},"ratio":1.50,"big":12345678901234567890,"none":null})"},
+    {"documentation/swiftui/text",
+     R"({"primaryContentSections":[{"kind":"declarations","declarations":[{"tokens":[{"kind":"keyword","text":"protocol"},{"kind":"text","text":" "},)"
+     R"({"kind":"identifier","text":"View"}],"languages":["swift"],"platforms":["iOS","macOS"]}]}],"abstract":[{"type":"emphasis","inlineContent":[]}],"kind":"symbol"})"},
+    {"scalar", R"("just a string\n")"},
+};
+
+std::uint32_t load(const std::string& bytes, std::size_t at) {
+    std::uint32_t value;
+    std::memcpy(&value, &bytes[at], sizeof value);
+    return value;
+}
+
+void store(std::string& bytes, std::size_t at, std::uint32_t value) {
+    std::memcpy(&bytes[at], &value, sizeof value);
+}
+
+std::size_t align8(std::size_t size) { return (size + 7) & ~std::size_t(7); }
+
+/// 머리(32바이트) 뒤 각 영역의 시작 위치. 순서는 문자열 위치, 문자열, 조각 위치, 조각 해시, 문서 표, 값이다.
+struct Layout {
+    std::size_t stringOffsets, fragmentOffsets, documents, values;
+
+    explicit Layout(const std::string& bytes) {
+        std::uint32_t documentCount = load(bytes, 8), stringCount = load(bytes, 12), stringBytes = load(bytes, 16);
+        std::uint32_t fragmentCount = load(bytes, 24);
+        stringOffsets = 32;
+        fragmentOffsets = align8(stringOffsets + (stringCount + 1) * 4) + align8(stringBytes);
+        documents = align8(fragmentOffsets + (fragmentCount + 1) * 4) + align8(fragmentCount * 8);
+        values = align8(documents + documentCount * 8);
+    }
+};
+
+} // namespace
+
+MANUAL_TEST_SUITE(render_archive) {
+    manual::RenderArchiveBuilder builder;
+    for (const auto& document : kDocuments) builder.add(document[0], document[1]);
+    std::string bytes = builder.serialize();
+    manual::RenderArchive archive(bytes);
+    CHECK(archive.size() == std::size(kDocuments));
+    CHECK(archive.fragmentCount() == 1);   // 같은 선언 조각은 한 번만 둔다
+
+    for (const auto& document : kDocuments) {
+        std::size_t index = archive.find(document[0]);
+        CHECK(index < archive.size());
+        if (index >= archive.size()) continue;
+        std::string out;
+        archive.root(index).appendJson(out);
+        CHECK(out == document[1]);
+    }
+    CHECK(archive.find("documentation/swiftui/missing") == archive.size());
+    CHECK(archive.root(archive.find("documentation/swiftui/view")).get("metadata").get("title").text() == "View");
+
+    CHECK_MALFORMED(manual::RenderArchive(std::string_view(bytes).substr(0, 16)));
+    CHECK_MALFORMED(builder.add("broken", R"({"a":[1,2)"));
+
+    // 문서 하나짜리 아카이브. 값은 [객체 2 길이 | "a" 배열 1 길이 | 정수 1 | "t" 토큰 조각 0]이다.
+    manual::RenderArchiveBuilder small;
+    small.add("d", R"({"a":[1],"t":[{"kind":"text","text":"x"}]})");
+    std::string clean = small.serialize();
+    Layout layout(clean);
+    std::size_t root = layout.values + load(clean, layout.documents + 4);
+    auto corrupt = [&](std::size_t at, char byte) {
+        std::string copy = clean;
+        copy[at] = byte;
+        return copy;
+    };
+    auto json = [](const std::string& bytes) {
+        manual::RenderArchive archive(bytes);
+        std::string out;
+        archive.root(0).appendJson(out);
+        return out;
+    };
+    CHECK(json(clean) == R"({"a":[1],"t":[{"kind":"text","text":"x"}]})");
+    CHECK_MALFORMED(json(corrupt(root + 4, 0x7F)));                                      // 모르는 태그
+    CHECK_MALFORMED(json(corrupt(root + 11, 5)));                                        // 없는 조각 번호
+    CHECK_MALFORMED(manual::RenderArchive(corrupt(root + 6, 0x7F)).root(0).get("t"));    // 배열 길이가 값 영역 밖
+    CHECK_MALFORMED(json(corrupt(root + 1, 9)));                                         // 항목 수가 값 영역을 넘는다
+
+    // 값 영역 끝에 놓인 배열 [1]의 항목 수를 늘리면 두 번째 항목의 태그가 영역 바로 뒤가 된다.
+    manual::RenderArchiveBuilder tail;
+    tail.add("e", "[1]");
+    std::string last = tail.serialize();
+    last[Layout(last).values + load(last, Layout(last).documents + 4) + 1] = 2;
+    CHECK_MALFORMED(json(last));
+
+    std::string strings = clean;
+    store(strings, layout.stringOffsets + 4, load(clean, 16) + 1);                       // 문자열 위치가 거꾸로 간다
+    CHECK_MALFORMED(manual::RenderArchive(strings));
+    std::string fragments = clean;
+    store(fragments, layout.fragmentOffsets, load(clean, 28) + 1);                       // 조각 위치가 거꾸로 간다
+    CHECK_MALFORMED(manual::RenderArchive(fragments));
+}
@@ -0,0 +1,48 @@
+//
+//  render_page_test.cpp
+//  swiftUIManual tools
+//
+
+#include <string>
+#include <string_view>
+
+#include "bundle/render_page.h"
+#include "common/arena.h"
+#include "common/json.h"
+#include "tests/check.h"
+
+namespace {
+
+// 스키마를 따르는 멤버와 벗어난 멤버(모양이 다른 참조 항목과 요약, 객체가 아닌 뿌리)가 섞인 렌더 JSON.
+constexpr std::string_view kDocuments[][2] = {
+    {"documentation/swiftui/view",
+     R"({"schemaVersion":{"major":0,"minor":3,"patch":0},"identifier":{"url":"doc:\/\/com.apple.SwiftUI\/documentation\/SwiftUI\/View","interfaceLanguage":"swift"},)"
+     R"("abstract":[{"type":"text","text":"뷰를 나타내는 형식."},{"type":"code","code":"body"}],)"
+     R"("primaryContentSections":[{"kind":"declarations","declarations":[{"tokens":[{"kind":"keyword","text":"protocol"},{"kind":"text","text":" "},)"
+     R"({"kind":"identifier","text":"View"}],"languages":["swift"],"platforms":["iOS","macOS"]}]},{"kind":"content","content":[]}],)"
+     R"("metadata":{"title":"View","role":"symbol","platforms":[{"introducedAt":"13.0","name":"iOS","beta":false}]},)"
+     R"("references":{"doc://a":{"title":"Text","type":"topic","identifier":"doc:\/\/a","deprecated":true},"weird":{"type":"image","variants":[]}},)"
+     R"("hierarchy":{"paths":[[]]},"ratio":1.50,"big":12345678901234567890,"none":null})"},
+    {"documentation/swiftui/text",
+     R"({"primaryContentSections":[{"kind":"declarations","declarations":[{"tokens":[{"kind":"keyword","text":"protocol"},{"kind":"text","text":" "},)"
+     R"({"kind":"identifier","text":"View"}],"languages":["swift"],"platforms":["iOS","macOS"]}]}],"abstract":[{"type":"emphasis","inlineContent":[]}],"kind":"symbol"})"},
+    {"scalar", R"("just a string\n")"},
+};
+
+} // namespace
+
+MANUAL_TEST_SUITE(render_page) {
+    // 스키마를 따르는 멤버는 타입 경로로, 벗어난 멤버와 참조 항목은 파싱한 값 그대로 쓰되 결과는 같은 바이트다.
+    manual::Arena arena(1 << 16);
+    manual::RenderPage page;
+    for (const auto& document : kDocuments) {
+        manual::JsonValue root = manual::parseJson(document[1], arena);
+        page.read(root);
+        std::string out;
+        page.write(out);
+        CHECK(out == document[1]);
+    }
+    manual::JsonValue root = manual::parseJson(kDocuments[0][1], arena);
+    page.read(root);
+    CHECK(page.typedMemberCount() == 5);   // identifier, abstract, primaryContentSections, metadata, references
+}
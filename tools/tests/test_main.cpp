@@ -0,0 +1,63 @@
+//
+//  test_main.cpp
+//  swiftUIManual tools
+//
+//  `manual-tests [SUITE…]`. 이름을 주지 않으면 모든 묶음을 돈다. 실패가 하나라도 있으면 1로 끝난다.
+//
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <vector>
+
+#include "tests/check.h"
+
+namespace manual::test {
+
+namespace {
+
+struct Entry {
+    const char* name;
+    void (*run)();
+};
+
+std::vector<Entry>& suites() {
+    static std::vector<Entry> registered;
+    return registered;
+}
+
+int failures = 0;
+
+} // namespace
+
+void fail(const char* file, int line, const std::string& what) {
+    std::fprintf(stderr, "%s:%d: %s\n", file, line, what.c_str());
+    ++failures;
+}
+
+Suite::Suite(const char* name, void (*run)()) { suites().push_back({name, run}); }
+
+} // namespace manual::test
+
+int main(int argc, char** argv) {
+    using namespace manual::test;
+    int ran = 0;
+    for (const Entry& suite : suites()) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) selected |= std::strcmp(argv[i], suite.name) == 0;
+        if (!selected) continue;
+        int before = failures;
+        try {
+            suite.run();
+        } catch (const std::exception& error) {
+            fail(__FILE__, __LINE__, std::string("uncaught exception: ") + error.what());
+        }
+        std::printf("%s: %s\n", suite.name, failures == before ? "ok" : "FAILED");
+        ++ran;
+    }
+    if (ran == 0) {
+        std::fprintf(stderr, "manual-tests: no such suite\n");
+        return 2;
+    }
+    return failures == 0 ? 0 : 1;
+}